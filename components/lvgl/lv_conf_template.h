@@ -187,6 +187,10 @@
         #define  LV_DRAW_SW_ASM_CUSTOM_INCLUDE ""
     #endif
 
+    /* Use portable C kernels processing 2-4 pixels per machine word for the RGB565
+     * fills and RGB565 image blends which are not accelerated by `LV_USE_DRAW_SW_ASM` */
+    #define LV_USE_DRAW_SW_SWAR         0
+
     /* Enable drawing complex gradients in software: linear at an angle, radial or conical */
     #define LV_USE_DRAW_SW_COMPLEX_GRADIENTS    0
 #endif
@@ -532,6 +536,20 @@
 /*Enable drawing placeholders when glyph dsc is not found*/
 #define LV_USE_FONT_PLACEHOLDER 1
 
+/*Size of the cache of decoded A8 glyph bitmaps of `lv_font_fmt_txt` fonts in bytes.
+ *Redrawing a cached letter blends its bitmap directly instead of expanding or decompressing it again.
+ *0 to disable; can be changed at runtime with `lv_font_glyph_cache_resize()`*/
+#define LV_FONT_GLYPH_CACHE_SIZE 0
+
+/*Build hash tables for large `lv_font_fmt_txt` fonts on first use to find the glyph ID of a letter
+ *and the kerning value of a glyph pair in O(1) instead of walking the cmaps and binary searching.
+ *Needs 8..16 bytes of RAM per glyph and 5..10 bytes per kerning pair.*/
+#define LV_USE_FONT_FMT_TXT_LUT 0
+#if LV_USE_FONT_FMT_TXT_LUT
+    /*Build the tables only for fonts with at least this many glyphs (or kerning pairs)*/
+    #define LV_FONT_FMT_TXT_LUT_MIN_ENTRIES 256
+#endif
+
 /*=================
  *  TEXT SETTINGS
  *=================*/
@@ -626,6 +644,8 @@
 #if LV_USE_LABEL
     #define LV_LABEL_TEXT_SELECTION 1 /*Enable selecting text of the label*/
     #define LV_LABEL_LONG_TXT_HINT 1  /*Store some extra info in labels to speed up drawing of very long texts*/
+    #define LV_LABEL_LAYOUT_CACHE 0   /*Cache the line breaks and letter widths of labels to redraw and measure them faster.
+                                       *Needs 12 bytes per line and 2 bytes per letter of RAM.*/
     #define LV_LABEL_WAIT_CHAR_COUNT 3  /*The count of wait chart*/
 #endif
 
@@ -894,6 +914,9 @@
     #if LV_USE_PROFILER_BUILTIN
         /*Default profiler trace buffer size*/
         #define LV_PROFILER_BUILTIN_BUF_SIZE (16 * 1024)     /*[bytes]*/
+
+        /*Maximum number of threads with their own trace ring; the buffer is split between them*/
+        #define LV_PROFILER_BUILTIN_THREAD_MAX 4
     #endif
 
     /*Header to include for the profiler*/
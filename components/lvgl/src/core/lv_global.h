@@ -121,6 +121,10 @@ typedef struct lv_global_t {
     lv_cache_t * img_cache;
     lv_cache_t * img_header_cache;
 
+    lv_cache_t * font_glyph_cache;
+    uint32_t font_glyph_cache_hits;
+    uint32_t font_glyph_cache_misses;
+
     lv_draw_global_info_t draw_info;
 #if defined(LV_DRAW_SW_SHADOW_CACHE_SIZE) && LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
     lv_draw_sw_shadow_cache_t sw_shadow_cache;
@@ -189,6 +193,12 @@ typedef struct lv_global_t {
     lv_font_fmt_rle_t font_fmt_rle;
 #endif
 
+#if LV_USE_FONT_FMT_TXT_LUT
+    lv_font_fmt_txt_lut_reg_t font_fmt_txt_lut_reg;
+    lv_mutex_t font_fmt_txt_lut_lock;
+    bool font_fmt_txt_lut_disabled;
+#endif
+
 #if LV_USE_SPAN != 0
     struct _snippet_stack * span_snippet_stack;
 #endif
@@ -317,6 +317,9 @@ void lv_inv_area(lv_display_t * disp, const lv_area_t * area_p)
 
     /*Save the area*/
     lv_area_t * tmp_area_p = &com_area;
+    if(disp->inv_p >= LV_INV_BUF_SIZE && disp->merge_areas_cb) { /*Try to make place by merging*/
+        disp->inv_p = disp->merge_areas_cb(disp, disp->inv_areas, disp->inv_p, LV_INV_BUF_SIZE / 2);
+    }
     if(disp->inv_p >= LV_INV_BUF_SIZE) { /*If no place for the area add the screen*/
         disp->inv_p = 0;
         tmp_area_p = &scr_area;
@@ -441,6 +444,13 @@ refr_finish:
 static void lv_refr_join_area(void)
 {
     LV_PROFILER_BEGIN;
+    if(disp_refr->merge_areas_cb) {
+        disp_refr->inv_p = disp_refr->merge_areas_cb(disp_refr, disp_refr->inv_areas, disp_refr->inv_p,
+                                                     disp_refr->inv_p);
+        LV_PROFILER_END;
+        return;
+    }
+
     uint32_t join_from;
     uint32_t join_in;
     lv_area_t joined_area;
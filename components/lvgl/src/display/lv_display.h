@@ -80,6 +80,8 @@ typedef enum {
 
 typedef void (*lv_display_flush_cb_t)(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map);
 typedef void (*lv_display_flush_wait_cb_t)(lv_display_t * disp);
+typedef uint32_t (*lv_display_merge_areas_cb_t)(lv_display_t * disp, lv_area_t * areas, uint32_t area_cnt,
+                                                uint32_t max_cnt);
 
 /**********************
  * GLOBAL PROTOTYPES
@@ -273,6 +275,16 @@ void lv_display_set_flush_cb(lv_display_t * disp, lv_display_flush_cb_t flush_cb
  */
 void lv_display_set_flush_wait_cb(lv_display_t * disp, lv_display_flush_wait_cb_t wait_cb);
 
+/**
+ * Set a callback to merge the invalidated areas instead of the built-in joining.
+ * It's called before rendering with all invalidated areas, and when the invalidated area buffer
+ * (`LV_INV_BUF_SIZE`) is full to make room for new areas instead of redrawing the whole screen.
+ * @param disp      pointer to a display
+ * @param merge_cb  a callback which merges `areas` in place so that they still cover all the original areas
+ *                  and returns the new count, at most `max_cnt`. NULL to use the built-in joining.
+ */
+void lv_display_set_merge_areas_cb(lv_display_t * disp, lv_display_merge_areas_cb_t merge_cb);
+
 /**
  * Set the color format of the display.
  * @param disp              pointer to a display
@@ -79,6 +79,9 @@ struct lv_display_t {
      * If not set `flushing` flag is used which can be cleared with `lv_display_flush_ready()` */
     lv_display_flush_wait_cb_t flush_wait_cb;
 
+    /** Merge the invalidated areas instead of the built-in joining. See `lv_display_set_merge_areas_cb()` */
+    lv_display_merge_areas_cb_t merge_areas_cb;
+
     /** 1: flushing is in progress. (It can't be a bit field because when it's cleared from IRQ
      * Read-Modify-Write issue might occur) */
     volatile int flushing;
@@ -164,6 +167,12 @@ struct lv_display_t {
     lv_obj_t * mem_label;
 #endif
 
+#if LV_USE_SYSMON
+    lv_obj_t * port_label;
+    lv_sysmon_backend_data_t port_sysmon_backend;
+    lv_sysmon_port_info_t port_sysmon_info;
+#endif
+
 };
 
 /**********************
@@ -20,6 +20,7 @@
 #include "../stdlib/lv_mem.h"
 #include "../stdlib/lv_string.h"
 #include "../core/lv_global.h"
+#include "../font/lv_font_glyph_cache.h"
 
 /*********************
  *      DEFINES
@@ -38,6 +39,8 @@
  **********************/
 static void draw_letter(lv_draw_unit_t * draw_unit, lv_draw_glyph_dsc_t * dsc,  const lv_point_t * pos,
                         const lv_font_t * font, uint32_t letter, lv_draw_glyph_cb_t cb);
+static bool layout_reserve(lv_draw_label_layout_t * layout, uint32_t line_cnt, uint32_t letter_cnt,
+                           uint32_t * line_cap, uint32_t * letter_cap);
 
 /**********************
  *  STATIC VARIABLES
@@ -162,6 +165,18 @@ void lv_draw_label_iterate_characters(lv_draw_unit_t * draw_unit, const lv_draw_
 
     lv_bidi_calculate_align(&align, &base_dir, dsc->text);
 
+    int32_t line_height_font = lv_font_get_line_height(font);
+    int32_t line_height = line_height_font + dsc->line_space;
+
+    /*Use the cached line breaks and letter widths if they were built for this text*/
+    const lv_draw_label_layout_t * layout = NULL;
+    if(dsc->layout && line_height > 0 &&
+       lv_draw_label_layout_is_valid(dsc->layout, dsc->text, font, dsc->letter_space, lv_area_get_width(coords),
+                                     dsc->flag)) {
+        if(dsc->layout->line_cnt == 0) return;
+        layout = dsc->layout;
+    }
+
     if((dsc->flag & LV_TEXT_FLAG_EXPAND) == 0) {
         /*Normally use the label's width as width*/
         w = lv_area_get_width(coords);
@@ -169,13 +184,18 @@ void lv_draw_label_iterate_characters(lv_draw_unit_t * draw_unit, const lv_draw_
     else {
         /*If EXPAND is enabled then not limit the text's width to the object's width*/
         lv_point_t p;
-        lv_text_get_size(&p, dsc->text, dsc->font, dsc->letter_space, dsc->line_space, LV_COORD_MAX,
-                         dsc->flag);
+        if(layout) {
+            lv_draw_label_layout_get_size(layout, dsc->line_space, &p);
+        }
+        else {
+            lv_text_get_size(&p, dsc->text, dsc->font, dsc->letter_space, dsc->line_space, LV_COORD_MAX,
+                             dsc->flag);
+        }
         w = p.x;
     }
 
-    int32_t line_height_font = lv_font_get_line_height(font);
-    int32_t line_height = line_height_font + dsc->line_space;
+    uint32_t line_idx = 0;
+    uint32_t letter_idx = 0;
 
     /*Init variables for the first line*/
     int32_t line_width = 0;
@@ -201,16 +221,29 @@ void lv_draw_label_iterate_characters(lv_draw_unit_t * draw_unit, const lv_draw_
     }
 
     /*Use the hint if it's valid*/
-    if(dsc->hint && last_line_start >= 0) {
+    if(dsc->hint && last_line_start >= 0 && layout == NULL) {
         line_start = last_line_start;
         pos.y += dsc->hint->y;
     }
 
-    uint32_t line_end = line_start + lv_text_get_next_line(&dsc->text[line_start], font, dsc->letter_space, w, NULL,
-                                                           dsc->flag);
+    uint32_t line_end;
+    if(layout) {
+        /*Jump to the first visible line*/
+        if(pos.y + line_height_font < draw_unit->clip_area->y1) {
+            line_idx = (draw_unit->clip_area->y1 - line_height_font - pos.y + line_height - 1) / line_height;
+            if(line_idx >= layout->line_cnt) return;
+            pos.y += (int32_t)line_idx * line_height;
+        }
+        line_start = layout->lines[line_idx].start;
+        line_end = layout->lines[line_idx + 1].start;
+    }
+    else {
+        line_end = line_start + lv_text_get_next_line(&dsc->text[line_start], font, dsc->letter_space, w, NULL,
+                                                      dsc->flag);
+    }
 
     /*Go the first visible line*/
-    while(pos.y + line_height_font < draw_unit->clip_area->y1) {
+    while(layout == NULL && pos.y + line_height_font < draw_unit->clip_area->y1) {
         /*Go to next line*/
         line_start = line_end;
         line_end += lv_text_get_next_line(&dsc->text[line_start], font, dsc->letter_space, w, NULL, dsc->flag);
@@ -228,14 +261,16 @@ void lv_draw_label_iterate_characters(lv_draw_unit_t * draw_unit, const lv_draw_
 
     /*Align to middle*/
     if(align == LV_TEXT_ALIGN_CENTER) {
-        line_width = lv_text_get_width(&dsc->text[line_start], line_end - line_start, font, dsc->letter_space);
+        line_width = layout ? layout->lines[line_idx].width :
+                     lv_text_get_width(&dsc->text[line_start], line_end - line_start, font, dsc->letter_space);
 
         pos.x += (lv_area_get_width(coords) - line_width) / 2;
 
     }
     /*Align to the right*/
     else if(align == LV_TEXT_ALIGN_RIGHT) {
-        line_width = lv_text_get_width(&dsc->text[line_start], line_end - line_start, font, dsc->letter_space);
+        line_width = layout ? layout->lines[line_idx].width :
+                     lv_text_get_width(&dsc->text[line_start], line_end - line_start, font, dsc->letter_space);
         pos.x += lv_area_get_width(coords) - line_width;
     }
 
@@ -269,6 +304,7 @@ void lv_draw_label_iterate_characters(lv_draw_unit_t * draw_unit, const lv_draw_
 
         /*Write all letter of a line*/
         i = 0;
+        if(layout) letter_idx = layout->lines[line_idx].letter;
 #if LV_USE_BIDI
         char * bidi_txt = lv_malloc(line_end - line_start + 1);
         LV_ASSERT_MALLOC(bidi_txt);
@@ -293,7 +329,12 @@ void lv_draw_label_iterate_characters(lv_draw_unit_t * draw_unit, const lv_draw_
             uint32_t letter_next;
             lv_text_encoded_letter_next_2(bidi_txt, &letter, &letter_next, &i);
 
-            letter_w = lv_font_get_glyph_width(font, letter, letter_next);
+#if LV_USE_BIDI == 0
+            /*The letter widths are cached in logical order*/
+            if(layout) letter_w = layout->letter_w[letter_idx++];
+            else
+#endif
+                letter_w = lv_font_get_glyph_width(font, letter, letter_next);
 
             /*Always set the bg_coordinates for placeholder drawing*/
             bg_coords.x1 = pos.x;
@@ -346,20 +387,27 @@ void lv_draw_label_iterate_characters(lv_draw_unit_t * draw_unit, const lv_draw_
 #endif
         /*Go to next line*/
         line_start = line_end;
-        line_end += lv_text_get_next_line(&dsc->text[line_start], font, dsc->letter_space, w, NULL, dsc->flag);
+        if(layout) {
+            line_idx++;
+            if(line_idx >= layout->line_cnt) break;
+            line_end = layout->lines[line_idx + 1].start;
+        }
+        else {
+            line_end += lv_text_get_next_line(&dsc->text[line_start], font, dsc->letter_space, w, NULL, dsc->flag);
+        }
 
         pos.x = coords->x1;
         /*Align to middle*/
         if(align == LV_TEXT_ALIGN_CENTER) {
-            line_width =
-                lv_text_get_width(&dsc->text[line_start], line_end - line_start, font, dsc->letter_space);
+            line_width = layout ? layout->lines[line_idx].width :
+                         lv_text_get_width(&dsc->text[line_start], line_end - line_start, font, dsc->letter_space);
 
             pos.x += (lv_area_get_width(coords) - line_width) / 2;
         }
         /*Align to the right*/
         else if(align == LV_TEXT_ALIGN_RIGHT) {
-            line_width =
-                lv_text_get_width(&dsc->text[line_start], line_end - line_start, font, dsc->letter_space);
+            line_width = layout ? layout->lines[line_idx].width :
+                         lv_text_get_width(&dsc->text[line_start], line_end - line_start, font, dsc->letter_space);
             pos.x += lv_area_get_width(coords) - line_width;
         }
 
@@ -374,10 +422,156 @@ void lv_draw_label_iterate_characters(lv_draw_unit_t * draw_unit, const lv_draw_
     LV_ASSERT_MEM_INTEGRITY();
 }
 
+void lv_draw_label_layout_update(lv_draw_label_layout_t * layout, const char * text, const lv_font_t * font,
+                                 int32_t letter_space, int32_t max_width, lv_text_flag_t flag)
+{
+    LV_ASSERT_NULL(layout);
+
+    if(lv_draw_label_layout_is_valid(layout, text, font, letter_space, max_width, flag)) return;
+    if(text == NULL || font == NULL) {
+        layout->valid = 0;
+        return;
+    }
+
+    LV_PROFILER_BEGIN;
+
+    /*The same normalization as in `lv_text_get_next_line`*/
+    if(flag & LV_TEXT_FLAG_EXPAND) max_width = LV_COORD_MAX;
+
+    /*The arrays are only grown; start from their current size which is at least the old text's*/
+    uint32_t line_cap = layout->lines ? layout->line_cnt + 1 : 0;
+    uint32_t letter_cap = layout->letter_w ? layout->lines[layout->line_cnt].letter : 0;
+    layout->valid = 0;
+
+    uint32_t line_cnt = 0;
+    uint32_t letter_cnt = 0;
+    uint32_t line_start = 0;
+    while(text[line_start] != '\0') {
+        uint32_t line_end = line_start + lv_text_get_next_line(&text[line_start], font, letter_space, max_width, NULL,
+                                                               flag);
+        if(!layout_reserve(layout, line_cnt + 2, letter_cnt + (line_end - line_start), &line_cap, &letter_cap)) {
+            LV_PROFILER_END;
+            return;
+        }
+
+        lv_draw_label_layout_line_t * line = &layout->lines[line_cnt];
+        line->start = line_start;
+        line->letter = letter_cnt;
+        line->width = lv_text_get_width(&text[line_start], line_end - line_start, font, letter_space);
+
+        /*Measure the letters as the drawing does: the next letter can be on the next line*/
+        const char * line_txt = &text[line_start];
+        uint32_t i = 0;
+        while(i < line_end - line_start) {
+            uint32_t letter;
+            uint32_t letter_next;
+            lv_text_encoded_letter_next_2(line_txt, &letter, &letter_next, &i);
+            layout->letter_w[letter_cnt++] = lv_font_get_glyph_width(font, letter, letter_next);
+        }
+
+        line_cnt++;
+        line_start = line_end;
+    }
+
+    if(!layout_reserve(layout, line_cnt + 1, letter_cnt, &line_cap, &letter_cap)) {
+        LV_PROFILER_END;
+        return;
+    }
+    layout->lines[line_cnt].start = line_start;
+    layout->lines[line_cnt].letter = letter_cnt;
+    layout->lines[line_cnt].width = 0;
+
+    layout->line_cnt = line_cnt;
+    layout->text = text;
+    layout->font = font;
+    layout->letter_space = letter_space;
+    layout->max_width = max_width;
+    layout->flag = flag;
+    layout->valid = 1;
+
+    LV_PROFILER_END;
+}
+
+bool lv_draw_label_layout_is_valid(const lv_draw_label_layout_t * layout, const char * text, const lv_font_t * font,
+                                   int32_t letter_space, int32_t max_width, lv_text_flag_t flag)
+{
+    if(flag & LV_TEXT_FLAG_EXPAND) max_width = LV_COORD_MAX;
+
+    return layout->valid && layout->text == text && layout->font == font && layout->letter_space == letter_space &&
+           layout->max_width == max_width && layout->flag == flag;
+}
+
+void lv_draw_label_layout_get_size(const lv_draw_label_layout_t * layout, int32_t line_space, lv_point_t * size_res)
+{
+    LV_ASSERT(layout->valid);
+
+    int32_t letter_height = lv_font_get_line_height(layout->font);
+    uint32_t i;
+    size_res->x = 0;
+    for(i = 0; i < layout->line_cnt; i++) {
+        size_res->x = LV_MAX(size_res->x, layout->lines[i].width);
+    }
+    size_res->y = (int32_t)layout->line_cnt * (letter_height + line_space);
+
+    /*Make the text one line taller if the last character is '\n' or '\r'*/
+    uint32_t end = layout->lines[layout->line_cnt].start;
+    if(end != 0 && (layout->text[end - 1] == '\n' || layout->text[end - 1] == '\r')) {
+        size_res->y += letter_height + line_space;
+    }
+
+    /*Correction with the last line space or set the height manually if the text is empty*/
+    if(size_res->y == 0) size_res->y = letter_height;
+    else size_res->y -= line_space;
+}
+
+void lv_draw_label_layout_invalidate(lv_draw_label_layout_t * layout)
+{
+    layout->valid = 0;
+}
+
+void lv_draw_label_layout_reset(lv_draw_label_layout_t * layout)
+{
+    lv_free(layout->lines);
+    lv_free(layout->letter_w);
+    lv_memzero(layout, sizeof(lv_draw_label_layout_t));
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Grow the arrays of a layout to hold at least the given number of lines and letters
+ * @return          false if the memory couldn't be allocated. The layout is reset then.
+ */
+static bool layout_reserve(lv_draw_label_layout_t * layout, uint32_t line_cnt, uint32_t letter_cnt,
+                           uint32_t * line_cap, uint32_t * letter_cap)
+{
+    if(line_cnt > *line_cap) {
+        uint32_t cap = LV_MAX(line_cnt, *line_cap * 2);
+        lv_draw_label_layout_line_t * lines = lv_realloc(layout->lines, cap * sizeof(lv_draw_label_layout_line_t));
+        if(lines == NULL) {
+            lv_draw_label_layout_reset(layout);
+            return false;
+        }
+        layout->lines = lines;
+        *line_cap = cap;
+    }
+
+    if(letter_cnt > *letter_cap) {
+        uint32_t cap = LV_MAX(letter_cnt, *letter_cap * 2);
+        uint16_t * letter_w = lv_realloc(layout->letter_w, cap * sizeof(uint16_t));
+        if(letter_w == NULL) {
+            lv_draw_label_layout_reset(layout);
+            return false;
+        }
+        layout->letter_w = letter_w;
+        *letter_cap = cap;
+    }
+
+    return true;
+}
+
 static void draw_letter(lv_draw_unit_t * draw_unit, lv_draw_glyph_dsc_t * dsc,  const lv_point_t * pos,
                         const lv_font_t * font, uint32_t letter, lv_draw_glyph_cb_t cb)
 {
@@ -412,7 +606,14 @@ static void draw_letter(lv_draw_unit_t * draw_unit, lv_draw_glyph_dsc_t * dsc,
         return;
     }
 
-    if(g.resolved_font) {
+    lv_cache_entry_t * cache_entry = NULL;
+    lv_draw_buf_t * cached_buf = g.resolved_font ? lv_font_glyph_cache_acquire(&g, &cache_entry) : NULL;
+    if(cached_buf) {
+        /*Blend the already decoded bitmap*/
+        dsc->glyph_data = cached_buf;
+        dsc->format = g.format;
+    }
+    else if(g.resolved_font) {
         lv_draw_buf_t * draw_buf = NULL;
         if(LV_FONT_GLYPH_FORMAT_NONE < g.format && g.format < LV_FONT_GLYPH_FORMAT_IMAGE) {
             /*Only check draw buf for bitmap glyph*/
@@ -440,7 +641,8 @@ static void draw_letter(lv_draw_unit_t * draw_unit, lv_draw_glyph_dsc_t * dsc,
     dsc->g = &g;
     cb(draw_unit, dsc, NULL, NULL);
 
-    lv_font_glyph_release_draw_data(&g);
+    if(cache_entry) lv_font_glyph_cache_release(cache_entry);
+    else lv_font_glyph_release_draw_data(&g);
 
     LV_PROFILER_END;
 }
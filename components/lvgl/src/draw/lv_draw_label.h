@@ -54,6 +54,8 @@ typedef struct {
      * 0: `text` is const and it's pointer will be valid during rendering.*/
     uint8_t text_local : 1;
     lv_draw_label_hint_t * hint;
+    /** Cached line breaks and letter widths of `text`. Used only if it was built with the same parameters.*/
+    lv_draw_label_layout_t * layout;
 } lv_draw_label_dsc_t;
 
 /**
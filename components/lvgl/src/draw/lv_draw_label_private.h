@@ -41,6 +41,30 @@ struct lv_draw_label_hint_t {
     int32_t coord_y;
 };
 
+/** A line of a cached text layout*/
+typedef struct {
+    uint32_t start;     /**< Byte index of the first letter of the line*/
+    uint32_t letter;    /**< Index of the first letter of the line in `letter_w`*/
+    int32_t width;      /**< Width of the line as `lv_text_get_width` returns it*/
+} lv_draw_label_layout_line_t;
+
+/** Store the line breaks and letter widths of a text to draw and measure it without
+ * breaking it into lines and looking up the glyphs again.
+ * The layout is valid only for the text, font, letter space, max. width and flags it was built with.
+ * If the text is modified in place, invalidate the layout with `lv_draw_label_layout_invalidate`.*/
+struct lv_draw_label_layout_t {
+    const char * text;
+    const lv_font_t * font;
+    int32_t letter_space;
+    int32_t max_width;
+    lv_text_flag_t flag;
+
+    uint32_t line_cnt;
+    lv_draw_label_layout_line_t * lines;    /**< `line_cnt + 1` lines, the last one marks the end of the text*/
+    uint16_t * letter_w;                    /**< Width of each letter with kerning and without letter space*/
+    uint8_t valid : 1;
+};
+
 struct lv_draw_glyph_dsc_t {
     void * glyph_data;  /**< Depends on `format` field, it could be image source or draw buf of bitmap or vector data. */
     lv_font_glyph_format_t format;
@@ -57,6 +81,45 @@ struct lv_draw_glyph_dsc_t {
  * GLOBAL PROTOTYPES
  **********************/
 
+/**
+ * Build a text layout unless it was already built with the same parameters
+ * @param layout        pointer to a layout
+ * @param text          the text
+ * @param font          font of the text
+ * @param letter_space  letter space of the text
+ * @param max_width     max width of the lines (as in `lv_text_get_size`)
+ * @param flag          settings for the text from ::lv_text_flag_t
+ */
+void lv_draw_label_layout_update(lv_draw_label_layout_t * layout, const char * text, const lv_font_t * font,
+                                 int32_t letter_space, int32_t max_width, lv_text_flag_t flag);
+
+/**
+ * Check if a layout was built with the given parameters
+ * @return          true: the layout can be used
+ */
+bool lv_draw_label_layout_is_valid(const lv_draw_label_layout_t * layout, const char * text, const lv_font_t * font,
+                                   int32_t letter_space, int32_t max_width, lv_text_flag_t flag);
+
+/**
+ * Get the size of the text of a valid layout, the same as `lv_text_get_size` would return
+ * @param layout        pointer to a valid layout
+ * @param line_space    line space of the text
+ * @param size_res      store the result here
+ */
+void lv_draw_label_layout_get_size(const lv_draw_label_layout_t * layout, int32_t line_space, lv_point_t * size_res);
+
+/**
+ * Mark a layout invalid, e.g. because its text was modified in place
+ * @param layout        pointer to a layout
+ */
+void lv_draw_label_layout_invalidate(lv_draw_label_layout_t * layout);
+
+/**
+ * Free the memory of a layout
+ * @param layout        pointer to a layout
+ */
+void lv_draw_label_layout_reset(lv_draw_label_layout_t * layout);
+
 /**********************
  *      MACROS
  **********************/
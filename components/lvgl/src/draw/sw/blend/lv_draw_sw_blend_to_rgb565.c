@@ -26,6 +26,10 @@
     #include LV_DRAW_SW_ASM_CUSTOM_INCLUDE
 #endif
 
+#if LV_USE_DRAW_SW_SWAR
+    #include "swar/lv_blend_swar.h"
+#endif
+
 /*********************
  *      DEFINES
  *********************/
@@ -0,0 +1,506 @@
+/**
+ * @file lv_blend_swar.c
+ *
+ * RGB565 blend kernels working on several pixels per machine word (SIMD within a register).
+ *
+ * `lv_color_16_16_mix` spreads a pixel to `0x07E0F81F` (G moved above R and B) and computes
+ * `((fg - bg) * m >> 5) + bg` with `m = (mix + 4) >> 3`. The bits kept by the mask are the same as of
+ * `(fg * m + bg * (32 - m)) >> 5` which never gets negative and stays below 2^32 for every pixel.
+ * So two spread pixels can be mixed in the two halves of a 64-bit word without carries between them,
+ * and the special cases (mix 0 or 255, same colors) need no branches: the formula gives the same result.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "lv_blend_swar.h"
+#if LV_USE_DRAW_SW && LV_USE_DRAW_SW_SWAR && LV_DRAW_SW_SUPPORT_RGB565
+
+#include "../../../../misc/lv_color.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define SPREAD_MASK     0x07E0F81FU
+
+#ifdef LV_ARCH_64
+    #define SPREAD_MASK_2   0x07E0F81F07E0F81FULL
+#endif
+
+/*The same rounding as in `lv_color_16_16_mix`*/
+#define MIX_WEIGHT(mix) (((uint32_t)(mix) + 4) >> 3)
+
+/*Two neighboring pixels of a buffer with any alignment in a 32-bit word, the first in the low half*/
+#define PAIR(buf, x) ((uint32_t)(buf)[x] | ((uint32_t)(buf)[(x) + 1] << 16))
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*The buffers are accessed both per pixel and per word*/
+#if defined(__GNUC__)
+    typedef uint32_t __attribute__((may_alias)) word32_t;
+    #ifdef LV_ARCH_64
+        typedef uint64_t __attribute__((may_alias)) fill_word_t;
+    #else
+        typedef uint32_t __attribute__((may_alias)) fill_word_t;
+    #endif
+#else
+    typedef uint32_t word32_t;
+    #ifdef LV_ARCH_64
+        typedef uint64_t fill_word_t;
+    #else
+        typedef uint32_t fill_word_t;
+    #endif
+#endif
+
+/*Mix a fixed color with a fixed weight to 2 pixels*/
+typedef struct {
+#ifdef LV_ARCH_64
+    uint64_t fg_m_2;    /**< Both spread pixels of the color multiplied by the weight*/
+#endif
+    uint32_t fg_m;      /**< The spread color multiplied by the weight*/
+    uint32_t m_inv;     /**< 32 - weight*/
+} const_mix_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static inline uint32_t /* LV_ATTRIBUTE_FAST_MEM */ spread(uint16_t c);
+static inline uint16_t /* LV_ATTRIBUTE_FAST_MEM */ pack(uint32_t s);
+static inline uint16_t /* LV_ATTRIBUTE_FAST_MEM */ mix_px(uint32_t fg_s, uint16_t bg, uint32_t m);
+static inline uint16_t /* LV_ATTRIBUTE_FAST_MEM */ const_mix_px(const const_mix_t * c, uint16_t bg);
+static inline uint32_t /* LV_ATTRIBUTE_FAST_MEM */ const_mix_2px(const const_mix_t * c, uint32_t bg_2);
+static inline uint32_t /* LV_ATTRIBUTE_FAST_MEM */ mix_2px(uint32_t fg_2, uint32_t bg_2, uint32_t m);
+static void const_mix_init(const_mix_t * c, uint16_t color, uint32_t m);
+static inline void * /* LV_ATTRIBUTE_FAST_MEM */ next_row(const void * buf, int32_t stride);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_result_t LV_ATTRIBUTE_FAST_MEM lv_color_blend_to_rgb565_swar(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    int32_t w = dsc->dest_w;
+    int32_t h = dsc->dest_h;
+    uint16_t color16 = lv_color_to_u16(dsc->color);
+    uint16_t * dest_buf_u16 = dsc->dest_buf;
+    int32_t dest_stride = dsc->dest_stride;
+
+    fill_word_t cw = (fill_word_t)color16 * (fill_word_t)0x0001000100010001ULL;
+    const int32_t px_per_word = sizeof(fill_word_t) / 2;
+
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        int32_t x = 0;
+        while(x < w && ((lv_uintptr_t)&dest_buf_u16[x] & (sizeof(fill_word_t) - 1))) {
+            dest_buf_u16[x] = color16;
+            x++;
+        }
+
+        fill_word_t * dest_w = (fill_word_t *)&dest_buf_u16[x];
+        int32_t words = (w - x) / px_per_word;
+        x += words * px_per_word;
+        while(words >= 4) {
+            dest_w[0] = cw;
+            dest_w[1] = cw;
+            dest_w[2] = cw;
+            dest_w[3] = cw;
+            dest_w += 4;
+            words -= 4;
+        }
+        while(words > 0) {
+            *dest_w = cw;
+            dest_w++;
+            words--;
+        }
+
+        for(; x < w; x++) {
+            dest_buf_u16[x] = color16;
+        }
+
+        dest_buf_u16 = next_row(dest_buf_u16, dest_stride);
+    }
+
+    return LV_RESULT_OK;
+}
+
+lv_result_t LV_ATTRIBUTE_FAST_MEM lv_color_blend_to_rgb565_with_opa_swar(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    int32_t w = dsc->dest_w;
+    int32_t h = dsc->dest_h;
+    uint16_t * dest_buf_u16 = dsc->dest_buf;
+    int32_t dest_stride = dsc->dest_stride;
+
+    const_mix_t c;
+    const_mix_init(&c, lv_color_to_u16(dsc->color), MIX_WEIGHT(dsc->opa));
+
+    /*Backgrounds are often plain so remember the last result*/
+    uint32_t last_dest32 = 0;
+    uint32_t last_res32 = const_mix_2px(&c, last_dest32);
+
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        int32_t x = 0;
+        if(w > 0 && ((lv_uintptr_t)dest_buf_u16 & 0x3)) {
+            dest_buf_u16[0] = const_mix_px(&c, dest_buf_u16[0]);
+            x = 1;
+        }
+
+        for(; x < w - 1; x += 2) {
+            word32_t * dest32 = (word32_t *)&dest_buf_u16[x];
+            uint32_t d = *dest32;
+            if(d != last_dest32) {
+                last_dest32 = d;
+                last_res32 = const_mix_2px(&c, d);
+            }
+            *dest32 = last_res32;
+        }
+
+        if(x < w) {
+            dest_buf_u16[x] = const_mix_px(&c, dest_buf_u16[x]);
+        }
+
+        dest_buf_u16 = next_row(dest_buf_u16, dest_stride);
+    }
+
+    return LV_RESULT_OK;
+}
+
+lv_result_t LV_ATTRIBUTE_FAST_MEM lv_color_blend_to_rgb565_with_mask_swar(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    int32_t w = dsc->dest_w;
+    int32_t h = dsc->dest_h;
+    uint16_t color16 = lv_color_to_u16(dsc->color);
+    uint32_t fg_s = spread(color16);
+    uint32_t c32 = (uint32_t)color16 | ((uint32_t)color16 << 16);
+    uint16_t * dest_buf_u16 = dsc->dest_buf;
+    int32_t dest_stride = dsc->dest_stride;
+    const lv_opa_t * mask = dsc->mask_buf;
+    int32_t mask_stride = dsc->mask_stride;
+
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        int32_t x = 0;
+        if(w > 0 && ((lv_uintptr_t)dest_buf_u16 & 0x3)) {
+            dest_buf_u16[0] = mix_px(fg_s, dest_buf_u16[0], MIX_WEIGHT(mask[0]));
+            x = 1;
+        }
+
+        for(; x < w - 3; x += 4) {
+            lv_opa_t m0 = mask[x];
+            lv_opa_t m1 = mask[x + 1];
+            lv_opa_t m2 = mask[x + 2];
+            lv_opa_t m3 = mask[x + 3];
+            if((m0 & m1 & m2 & m3) == LV_OPA_COVER) {
+                word32_t * dest32 = (word32_t *)&dest_buf_u16[x];
+                dest32[0] = c32;
+                dest32[1] = c32;
+            }
+            else if((m0 | m1 | m2 | m3) != LV_OPA_TRANSP) {
+                dest_buf_u16[x + 0] = mix_px(fg_s, dest_buf_u16[x + 0], MIX_WEIGHT(m0));
+                dest_buf_u16[x + 1] = mix_px(fg_s, dest_buf_u16[x + 1], MIX_WEIGHT(m1));
+                dest_buf_u16[x + 2] = mix_px(fg_s, dest_buf_u16[x + 2], MIX_WEIGHT(m2));
+                dest_buf_u16[x + 3] = mix_px(fg_s, dest_buf_u16[x + 3], MIX_WEIGHT(m3));
+            }
+        }
+
+        for(; x < w; x++) {
+            dest_buf_u16[x] = mix_px(fg_s, dest_buf_u16[x], MIX_WEIGHT(mask[x]));
+        }
+
+        dest_buf_u16 = next_row(dest_buf_u16, dest_stride);
+        mask += mask_stride;
+    }
+
+    return LV_RESULT_OK;
+}
+
+lv_result_t LV_ATTRIBUTE_FAST_MEM lv_color_blend_to_rgb565_mix_mask_opa_swar(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    int32_t w = dsc->dest_w;
+    int32_t h = dsc->dest_h;
+    uint32_t fg_s = spread(lv_color_to_u16(dsc->color));
+    lv_opa_t opa = dsc->opa;
+    uint16_t * dest_buf_u16 = dsc->dest_buf;
+    int32_t dest_stride = dsc->dest_stride;
+    const lv_opa_t * mask = dsc->mask_buf;
+    int32_t mask_stride = dsc->mask_stride;
+
+    /*Fully covered pixels are mixed with the same weight everywhere, 2 at once*/
+    const_mix_t c;
+    const_mix_init(&c, lv_color_to_u16(dsc->color), MIX_WEIGHT(LV_OPA_MIX2(LV_OPA_COVER, opa)));
+
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        int32_t x = 0;
+        for(; x < w - 3; x += 4) {
+            lv_opa_t m0 = mask[x];
+            lv_opa_t m1 = mask[x + 1];
+            lv_opa_t m2 = mask[x + 2];
+            lv_opa_t m3 = mask[x + 3];
+            if((m0 & m1 & m2 & m3) == LV_OPA_COVER) {
+                uint32_t res01 = const_mix_2px(&c, PAIR(dest_buf_u16, x));
+                uint32_t res23 = const_mix_2px(&c, PAIR(dest_buf_u16, x + 2));
+                dest_buf_u16[x + 0] = (uint16_t)res01;
+                dest_buf_u16[x + 1] = (uint16_t)(res01 >> 16);
+                dest_buf_u16[x + 2] = (uint16_t)res23;
+                dest_buf_u16[x + 3] = (uint16_t)(res23 >> 16);
+            }
+            else if((m0 | m1 | m2 | m3) != LV_OPA_TRANSP) {
+                dest_buf_u16[x + 0] = mix_px(fg_s, dest_buf_u16[x + 0], MIX_WEIGHT(LV_OPA_MIX2(m0, opa)));
+                dest_buf_u16[x + 1] = mix_px(fg_s, dest_buf_u16[x + 1], MIX_WEIGHT(LV_OPA_MIX2(m1, opa)));
+                dest_buf_u16[x + 2] = mix_px(fg_s, dest_buf_u16[x + 2], MIX_WEIGHT(LV_OPA_MIX2(m2, opa)));
+                dest_buf_u16[x + 3] = mix_px(fg_s, dest_buf_u16[x + 3], MIX_WEIGHT(LV_OPA_MIX2(m3, opa)));
+            }
+        }
+
+        for(; x < w; x++) {
+            dest_buf_u16[x] = mix_px(fg_s, dest_buf_u16[x], MIX_WEIGHT(LV_OPA_MIX2(mask[x], opa)));
+        }
+
+        dest_buf_u16 = next_row(dest_buf_u16, dest_stride);
+        mask += mask_stride;
+    }
+
+    return LV_RESULT_OK;
+}
+
+lv_result_t LV_ATTRIBUTE_FAST_MEM lv_rgb565_blend_normal_to_rgb565_with_opa_swar(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    int32_t w = dsc->dest_w;
+    int32_t h = dsc->dest_h;
+    uint32_t m = MIX_WEIGHT(dsc->opa);
+    uint16_t * dest_buf_u16 = dsc->dest_buf;
+    int32_t dest_stride = dsc->dest_stride;
+    const uint16_t * src_buf_u16 = dsc->src_buf;
+    int32_t src_stride = dsc->src_stride;
+
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        int32_t x = 0;
+        if(w > 0 && ((lv_uintptr_t)dest_buf_u16 & 0x3)) {
+            dest_buf_u16[0] = mix_px(spread(src_buf_u16[0]), dest_buf_u16[0], m);
+            x = 1;
+        }
+
+        for(; x < w - 1; x += 2) {
+            word32_t * dest32 = (word32_t *)&dest_buf_u16[x];
+            uint32_t src32 = PAIR(src_buf_u16, x);
+            *dest32 = mix_2px(src32, *dest32, m);
+        }
+
+        if(x < w) {
+            dest_buf_u16[x] = mix_px(spread(src_buf_u16[x]), dest_buf_u16[x], m);
+        }
+
+        dest_buf_u16 = next_row(dest_buf_u16, dest_stride);
+        src_buf_u16 = next_row(src_buf_u16, src_stride);
+    }
+
+    return LV_RESULT_OK;
+}
+
+lv_result_t LV_ATTRIBUTE_FAST_MEM lv_rgb565_blend_normal_to_rgb565_with_mask_swar(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    int32_t w = dsc->dest_w;
+    int32_t h = dsc->dest_h;
+    uint16_t * dest_buf_u16 = dsc->dest_buf;
+    int32_t dest_stride = dsc->dest_stride;
+    const uint16_t * src_buf_u16 = dsc->src_buf;
+    int32_t src_stride = dsc->src_stride;
+    const lv_opa_t * mask = dsc->mask_buf;
+    int32_t mask_stride = dsc->mask_stride;
+
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        int32_t x = 0;
+        for(; x < w - 3; x += 4) {
+            lv_opa_t m0 = mask[x];
+            lv_opa_t m1 = mask[x + 1];
+            lv_opa_t m2 = mask[x + 2];
+            lv_opa_t m3 = mask[x + 3];
+            if((m0 & m1 & m2 & m3) == LV_OPA_COVER) {
+                dest_buf_u16[x + 0] = src_buf_u16[x + 0];
+                dest_buf_u16[x + 1] = src_buf_u16[x + 1];
+                dest_buf_u16[x + 2] = src_buf_u16[x + 2];
+                dest_buf_u16[x + 3] = src_buf_u16[x + 3];
+            }
+            else if((m0 | m1 | m2 | m3) != LV_OPA_TRANSP) {
+                dest_buf_u16[x + 0] = mix_px(spread(src_buf_u16[x + 0]), dest_buf_u16[x + 0], MIX_WEIGHT(m0));
+                dest_buf_u16[x + 1] = mix_px(spread(src_buf_u16[x + 1]), dest_buf_u16[x + 1], MIX_WEIGHT(m1));
+                dest_buf_u16[x + 2] = mix_px(spread(src_buf_u16[x + 2]), dest_buf_u16[x + 2], MIX_WEIGHT(m2));
+                dest_buf_u16[x + 3] = mix_px(spread(src_buf_u16[x + 3]), dest_buf_u16[x + 3], MIX_WEIGHT(m3));
+            }
+        }
+
+        for(; x < w; x++) {
+            dest_buf_u16[x] = mix_px(spread(src_buf_u16[x]), dest_buf_u16[x], MIX_WEIGHT(mask[x]));
+        }
+
+        dest_buf_u16 = next_row(dest_buf_u16, dest_stride);
+        src_buf_u16 = next_row(src_buf_u16, src_stride);
+        mask += mask_stride;
+    }
+
+    return LV_RESULT_OK;
+}
+
+lv_result_t LV_ATTRIBUTE_FAST_MEM lv_rgb565_blend_normal_to_rgb565_mix_mask_opa_swar(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    int32_t w = dsc->dest_w;
+    int32_t h = dsc->dest_h;
+    lv_opa_t opa = dsc->opa;
+    uint16_t * dest_buf_u16 = dsc->dest_buf;
+    int32_t dest_stride = dsc->dest_stride;
+    const uint16_t * src_buf_u16 = dsc->src_buf;
+    int32_t src_stride = dsc->src_stride;
+    const lv_opa_t * mask = dsc->mask_buf;
+    int32_t mask_stride = dsc->mask_stride;
+
+    uint32_t m_cover = MIX_WEIGHT(LV_OPA_MIX2(LV_OPA_COVER, opa));
+
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        int32_t x = 0;
+        for(; x < w - 3; x += 4) {
+            lv_opa_t m0 = mask[x];
+            lv_opa_t m1 = mask[x + 1];
+            lv_opa_t m2 = mask[x + 2];
+            lv_opa_t m3 = mask[x + 3];
+            if((m0 & m1 & m2 & m3) == LV_OPA_COVER) {
+                uint32_t res01 = mix_2px(PAIR(src_buf_u16, x), PAIR(dest_buf_u16, x), m_cover);
+                uint32_t res23 = mix_2px(PAIR(src_buf_u16, x + 2), PAIR(dest_buf_u16, x + 2), m_cover);
+                dest_buf_u16[x + 0] = (uint16_t)res01;
+                dest_buf_u16[x + 1] = (uint16_t)(res01 >> 16);
+                dest_buf_u16[x + 2] = (uint16_t)res23;
+                dest_buf_u16[x + 3] = (uint16_t)(res23 >> 16);
+            }
+            else if((m0 | m1 | m2 | m3) != LV_OPA_TRANSP) {
+                dest_buf_u16[x + 0] = mix_px(spread(src_buf_u16[x + 0]), dest_buf_u16[x + 0], MIX_WEIGHT(LV_OPA_MIX2(m0, opa)));
+                dest_buf_u16[x + 1] = mix_px(spread(src_buf_u16[x + 1]), dest_buf_u16[x + 1], MIX_WEIGHT(LV_OPA_MIX2(m1, opa)));
+                dest_buf_u16[x + 2] = mix_px(spread(src_buf_u16[x + 2]), dest_buf_u16[x + 2], MIX_WEIGHT(LV_OPA_MIX2(m2, opa)));
+                dest_buf_u16[x + 3] = mix_px(spread(src_buf_u16[x + 3]), dest_buf_u16[x + 3], MIX_WEIGHT(LV_OPA_MIX2(m3, opa)));
+            }
+        }
+
+        for(; x < w; x++) {
+            dest_buf_u16[x] = mix_px(spread(src_buf_u16[x]), dest_buf_u16[x], MIX_WEIGHT(LV_OPA_MIX2(mask[x], opa)));
+        }
+
+        dest_buf_u16 = next_row(dest_buf_u16, dest_stride);
+        src_buf_u16 = next_row(src_buf_u16, src_stride);
+        mask += mask_stride;
+    }
+
+    return LV_RESULT_OK;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Move the green channel of an RGB565 pixel above red and blue to make room for the multiplication
+ */
+static inline uint32_t LV_ATTRIBUTE_FAST_MEM spread(uint16_t c)
+{
+    return ((uint32_t)c | ((uint32_t)c << 16)) & SPREAD_MASK;
+}
+
+/**
+ * Pack a spread pixel back to RGB565
+ */
+static inline uint16_t LV_ATTRIBUTE_FAST_MEM pack(uint32_t s)
+{
+    return (uint16_t)(s | (s >> 16));
+}
+
+/**
+ * Mix a spread foreground pixel to a background pixel
+ * @param fg_s      the spread foreground
+ * @param bg        the background
+ * @param m         weight of the foreground in 0..32
+ * @return          the same as `lv_color_16_16_mix`
+ */
+static inline uint16_t LV_ATTRIBUTE_FAST_MEM mix_px(uint32_t fg_s, uint16_t bg, uint32_t m)
+{
+    return pack(((fg_s * m + spread(bg) * (32 - m)) >> 5) & SPREAD_MASK);
+}
+
+static inline uint16_t LV_ATTRIBUTE_FAST_MEM const_mix_px(const const_mix_t * c, uint16_t bg)
+{
+    return pack(((c->fg_m + spread(bg) * c->m_inv) >> 5) & SPREAD_MASK);
+}
+
+#ifdef LV_ARCH_64
+
+/**
+ * Spread 2 pixels of a 32-bit word to the two halves of a 64-bit word
+ */
+static inline uint64_t LV_ATTRIBUTE_FAST_MEM spread_2px(uint32_t c_2)
+{
+    uint64_t x = (c_2 & 0xFFFF) | ((uint64_t)(c_2 >> 16) << 32);
+    return (x | (x << 16)) & SPREAD_MASK_2;
+}
+
+/**
+ * Pack 2 spread pixels back to 2 RGB565 pixels in a 32-bit word
+ */
+static inline uint32_t LV_ATTRIBUTE_FAST_MEM pack_2px(uint64_t s)
+{
+    s |= s >> 16;
+    return (uint32_t)(s & 0xFFFF) | ((uint32_t)(s >> 16) & 0xFFFF0000);
+}
+
+static inline uint32_t LV_ATTRIBUTE_FAST_MEM const_mix_2px(const const_mix_t * c, uint32_t bg_2)
+{
+    return pack_2px(((c->fg_m_2 + spread_2px(bg_2) * c->m_inv) >> 5) & SPREAD_MASK_2);
+}
+
+static inline uint32_t LV_ATTRIBUTE_FAST_MEM mix_2px(uint32_t fg_2, uint32_t bg_2, uint32_t m)
+{
+    return pack_2px(((spread_2px(fg_2) * m + spread_2px(bg_2) * (32 - m)) >> 5) & SPREAD_MASK_2);
+}
+
+#else
+
+static inline uint32_t LV_ATTRIBUTE_FAST_MEM const_mix_2px(const const_mix_t * c, uint32_t bg_2)
+{
+    return (uint32_t)const_mix_px(c, (uint16_t)bg_2) | ((uint32_t)const_mix_px(c, (uint16_t)(bg_2 >> 16)) << 16);
+}
+
+static inline uint32_t LV_ATTRIBUTE_FAST_MEM mix_2px(uint32_t fg_2, uint32_t bg_2, uint32_t m)
+{
+    return (uint32_t)mix_px(spread((uint16_t)fg_2), (uint16_t)bg_2, m) |
+           ((uint32_t)mix_px(spread((uint16_t)(fg_2 >> 16)), (uint16_t)(bg_2 >> 16), m) << 16);
+}
+
+#endif /*LV_ARCH_64*/
+
+static void const_mix_init(const_mix_t * c, uint16_t color, uint32_t m)
+{
+    c->fg_m = spread(color) * m;
+    c->m_inv = 32 - m;
+#ifdef LV_ARCH_64
+    c->fg_m_2 = ((uint64_t)c->fg_m << 32) | c->fg_m;
+#endif
+}
+
+static inline void * LV_ATTRIBUTE_FAST_MEM next_row(const void * buf, int32_t stride)
+{
+    return (void *)((uint8_t *)buf + stride);
+}
+
+#endif /*LV_USE_DRAW_SW && LV_USE_DRAW_SW_SWAR && LV_DRAW_SW_SUPPORT_RGB565*/
@@ -0,0 +1,133 @@
+/**
+ * @file lv_blend_swar.h
+ *
+ */
+
+#ifndef LV_BLEND_SWAR_H
+#define LV_BLEND_SWAR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "../../../../lv_conf_internal.h"
+
+#if LV_USE_DRAW_SW && LV_USE_DRAW_SW_SWAR && LV_DRAW_SW_SUPPORT_RGB565
+
+#include "../lv_draw_sw_blend_private.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/* Only the hooks not provided by the selected asm mode are set.
+ * The plain RGB565 image copy is left to `lv_memcpy` which already copies whole words.*/
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_RGB565
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565(dsc) \
+    lv_color_blend_to_rgb565_swar(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_OPA
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_OPA(dsc) \
+    lv_color_blend_to_rgb565_with_opa_swar(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_MASK
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_MASK(dsc) \
+    lv_color_blend_to_rgb565_with_mask_swar(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_RGB565_MIX_MASK_OPA
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565_MIX_MASK_OPA(dsc) \
+    lv_color_blend_to_rgb565_mix_mask_opa_swar(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_OPA
+#define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_OPA(dsc)  \
+    lv_rgb565_blend_normal_to_rgb565_with_opa_swar(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_MASK
+#define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_MASK(dsc)  \
+    lv_rgb565_blend_normal_to_rgb565_with_mask_swar(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA
+#define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA(dsc)  \
+    lv_rgb565_blend_normal_to_rgb565_mix_mask_opa_swar(dsc)
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Fill an RGB565 area with a color, storing 2 (32-bit) or 4 (64-bit) pixels at once
+ * @param dsc       the fill descriptor
+ * @return          LV_RESULT_OK
+ */
+lv_result_t lv_color_blend_to_rgb565_swar(lv_draw_sw_blend_fill_dsc_t * dsc);
+
+/**
+ * Mix a color to an RGB565 area with `dsc->opa`. The result equals `lv_color_16_16_mix` bit by bit.
+ * @param dsc       the fill descriptor
+ * @return          LV_RESULT_OK
+ */
+lv_result_t lv_color_blend_to_rgb565_with_opa_swar(lv_draw_sw_blend_fill_dsc_t * dsc);
+
+/**
+ * Mix a color to an RGB565 area with `dsc->mask_buf`. Fully covered and fully transparent
+ * groups of pixels are stored or skipped without mixing.
+ * @param dsc       the fill descriptor
+ * @return          LV_RESULT_OK
+ */
+lv_result_t lv_color_blend_to_rgb565_with_mask_swar(lv_draw_sw_blend_fill_dsc_t * dsc);
+
+/**
+ * Mix a color to an RGB565 area with `dsc->mask_buf` and `dsc->opa`
+ * @param dsc       the fill descriptor
+ * @return          LV_RESULT_OK
+ */
+lv_result_t lv_color_blend_to_rgb565_mix_mask_opa_swar(lv_draw_sw_blend_fill_dsc_t * dsc);
+
+/**
+ * Blend an RGB565 image to an RGB565 area with `dsc->opa`
+ * @param dsc       the image descriptor
+ * @return          LV_RESULT_OK
+ */
+lv_result_t lv_rgb565_blend_normal_to_rgb565_with_opa_swar(lv_draw_sw_blend_image_dsc_t * dsc);
+
+/**
+ * Blend an RGB565 image to an RGB565 area with `dsc->mask_buf`
+ * @param dsc       the image descriptor
+ * @return          LV_RESULT_OK
+ */
+lv_result_t lv_rgb565_blend_normal_to_rgb565_with_mask_swar(lv_draw_sw_blend_image_dsc_t * dsc);
+
+/**
+ * Blend an RGB565 image to an RGB565 area with `dsc->mask_buf` and `dsc->opa`
+ * @param dsc       the image descriptor
+ * @return          LV_RESULT_OK
+ */
+lv_result_t lv_rgb565_blend_normal_to_rgb565_mix_mask_opa_swar(lv_draw_sw_blend_image_dsc_t * dsc);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_DRAW_SW && LV_USE_DRAW_SW_SWAR && LV_DRAW_SW_SUPPORT_RGB565*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_BLEND_SWAR_H*/
@@ -118,9 +118,16 @@ void lv_binfont_destroy(lv_font_t * font)
 {
     if(font == NULL) return;
 
+    /*A new font could be allocated at the same address and match the cached glyphs*/
+    lv_font_glyph_cache_drop();
+
     const lv_font_fmt_txt_dsc_t * dsc = font->dsc;
     if(dsc == NULL) return;
 
+#if LV_USE_FONT_FMT_TXT_LUT
+    lv_font_fmt_txt_lut_drop(font);
+#endif
+
     if(dsc->kern_classes == 0) {
         const lv_font_fmt_txt_kern_pair_t * kern_dsc = dsc->kern_dsc;
         if(NULL != kern_dsc) {
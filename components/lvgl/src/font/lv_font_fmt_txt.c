@@ -14,6 +14,7 @@
 #include "../misc/lv_log.h"
 #include "../misc/lv_utils.h"
 #include "../stdlib/lv_mem.h"
+#include "../stdlib/lv_string.h"
 
 /*********************
  *      DEFINES
@@ -22,6 +23,26 @@
     #define font_rle LV_GLOBAL_DEFAULT()->font_fmt_rle
 #endif /*LV_USE_FONT_COMPRESSED*/
 
+#if LV_USE_FONT_FMT_TXT_LUT
+    #define lut_reg_p &(LV_GLOBAL_DEFAULT()->font_fmt_txt_lut_reg)
+    #define lut_lock_p &(LV_GLOBAL_DEFAULT()->font_fmt_txt_lut_lock)
+    #define lut_disabled LV_GLOBAL_DEFAULT()->font_fmt_txt_lut_disabled
+
+    /*Fibonacci hashing: the top bits of the product are well mixed even for consecutive keys*/
+    #define LUT_HASH(key, shift) (((uint32_t)(key) * 2654435761U) >> (shift))
+    #define LUT_MIN_SLOTS 16
+
+    /*The registry slots are written under the lock and read without it*/
+    #if defined(__GNUC__)
+        #define LUT_LOAD_ACQUIRE(p)     __atomic_load_n(p, __ATOMIC_ACQUIRE)
+        #define LUT_STORE_RELEASE(p, v) __atomic_store_n(p, v, __ATOMIC_RELEASE)
+    #else
+        /*Relies on aligned pointer stores being atomic and not reordered*/
+        #define LUT_LOAD_ACQUIRE(p)     (*(p))
+        #define LUT_STORE_RELEASE(p, v) (*(p) = (v))
+    #endif
+#endif /*LV_USE_FONT_FMT_TXT_LUT*/
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -30,10 +51,25 @@ typedef struct {
     uint32_t gid_right;
 } kern_pair_ref_t;
 
+#if LV_USE_FONT_FMT_TXT_LUT
+/*Open addressing hash tables of a font with linear probing. A key of 0 marks an empty slot.*/
+typedef struct {
+    const lv_font_fmt_txt_dsc_t * fdsc;
+    uint32_t * gid_keys;        /*Code points*/
+    uint16_t * gid_values;      /*Glyph IDs of the code points*/
+    uint32_t * kern_keys;       /*`gid_left << 16 | gid_right`*/
+    int8_t * kern_values;       /*Kerning values of the pairs*/
+    uint8_t gid_shift;          /*32 - log2(number of slots)*/
+    uint8_t kern_shift;
+    uint32_t size;              /*Bytes allocated for the tables*/
+} font_lut_t;
+#endif /*LV_USE_FONT_FMT_TXT_LUT*/
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter);
+static uint32_t search_glyph_dsc_id(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t letter);
 static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t gid_right);
 static int unicode_list_compare(const void * ref, const void * element);
 static int kern_pair_8_compare(const void * ref, const void * element);
@@ -47,6 +83,17 @@ static int kern_pair_16_compare(const void * ref, const void * element);
     static inline uint8_t rle_next(void);
 #endif /*LV_USE_FONT_COMPRESSED*/
 
+#if LV_USE_FONT_FMT_TXT_LUT
+    static const font_lut_t * lut_get(const lv_font_fmt_txt_dsc_t * fdsc);
+    static const font_lut_t * lut_create(const lv_font_fmt_txt_dsc_t * fdsc);
+    static void lut_build_gids(font_lut_t * lut, uint32_t glyph_cnt);
+    static void lut_build_kern(font_lut_t * lut, const lv_font_fmt_txt_kern_pair_t * kdsc);
+    static uint32_t lut_find_gid(const font_lut_t * lut, uint32_t letter);
+    static int8_t lut_find_kern(const font_lut_t * lut, uint32_t gid_left, uint32_t gid_right);
+    static uint8_t lut_shift(uint32_t entry_cnt);
+    static void lut_free_slot(uint32_t i);
+#endif /*LV_USE_FONT_FMT_TXT_LUT*/
+
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -63,6 +110,11 @@ static const uint8_t opa3_table[8] = {0, 36, 73, 109, 146, 182, 218, 255};
 
 static const uint8_t opa2_table[4] = {0, 85, 170, 255};
 
+#if LV_USE_FONT_FMT_TXT_LUT
+/*Marks the fonts which are too small for tables, they are searched without taking the lock*/
+static const font_lut_t lut_none;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -210,6 +262,65 @@ bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t *
     return true;
 }
 
+#if LV_USE_FONT_FMT_TXT_LUT
+
+void lv_font_fmt_txt_lut_init(void)
+{
+    lv_memzero(lut_reg_p, sizeof(lv_font_fmt_txt_lut_reg_t));
+    lv_mutex_init(lut_lock_p);
+    lut_disabled = false;
+}
+
+void lv_font_fmt_txt_lut_deinit(void)
+{
+    uint32_t i;
+    for(i = 0; i < LV_FONT_FMT_TXT_LUT_FONT_MAX; i++) lut_free_slot(i);
+    lv_mutex_delete(lut_lock_p);
+}
+
+void lv_font_fmt_txt_lut_set_enabled(bool en)
+{
+    lv_mutex_lock(lut_lock_p);
+    LUT_STORE_RELEASE(&lut_disabled, !en);
+    if(!en) {
+        uint32_t i;
+        for(i = 0; i < LV_FONT_FMT_TXT_LUT_FONT_MAX; i++) lut_free_slot(i);
+    }
+    lv_mutex_unlock(lut_lock_p);
+}
+
+void lv_font_fmt_txt_lut_drop(const lv_font_t * font)
+{
+    LV_ASSERT_NULL(font);
+
+    lv_mutex_lock(lut_lock_p);
+    uint32_t i;
+    for(i = 0; i < LV_FONT_FMT_TXT_LUT_FONT_MAX; i++) {
+        if((lut_reg_p)->fdsc_arr[i] == font->dsc) {
+            lut_free_slot(i);
+            break;
+        }
+    }
+    lv_mutex_unlock(lut_lock_p);
+}
+
+uint32_t lv_font_fmt_txt_lut_get_size(void)
+{
+    uint32_t size = 0;
+
+    lv_mutex_lock(lut_lock_p);
+    uint32_t i;
+    for(i = 0; i < LV_FONT_FMT_TXT_LUT_FONT_MAX; i++) {
+        const font_lut_t * lut = (lut_reg_p)->lut_arr[i];
+        if(lut) size += lut->size;
+    }
+    lv_mutex_unlock(lut_lock_p);
+
+    return size;
+}
+
+#endif /*LV_USE_FONT_FMT_TXT_LUT*/
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -220,6 +331,24 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
 
     lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
 
+#if LV_USE_FONT_FMT_TXT_LUT
+    const font_lut_t * lut = lut_get(fdsc);
+    if(lut && lut->gid_keys) return lut_find_gid(lut, letter);
+#endif
+
+    return search_glyph_dsc_id(fdsc, letter);
+}
+
+/**
+ * Find the glyph ID of a letter by walking the cmaps
+ * @param fdsc      descriptor of the font
+ * @param letter    a UNICODE letter code
+ * @return          the glyph ID or 0 if the font doesn't contain the letter
+ */
+static uint32_t search_glyph_dsc_id(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t letter)
+{
+    if(letter == '\0') return 0;
+
     uint16_t i;
     for(i = 0; i < fdsc->cmap_num; i++) {
 
@@ -272,6 +401,13 @@ static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t
     if(fdsc->kern_classes == 0) {
         /*Kern pairs*/
         const lv_font_fmt_txt_kern_pair_t * kdsc = fdsc->kern_dsc;
+#if LV_USE_FONT_FMT_TXT_LUT
+        const font_lut_t * lut = lut_get(fdsc);
+        if(lut && lut->kern_keys) {
+            value = lut_find_kern(lut, gid_left, gid_right);
+        }
+        else
+#endif
         if(kdsc->glyph_ids_size == 0) {
             /*Use binary search to find the kern value.
              *The pairs are ordered left_id first, then right_id secondly.*/
@@ -339,6 +475,258 @@ static int kern_pair_16_compare(const void * ref, const void * element)
     else return ref16_p->gid_right - element16_p[1];
 }
 
+#if LV_USE_FONT_FMT_TXT_LUT
+
+/**
+ * Get the lookup tables of a font, building them if the font is used first time.
+ * The tables of a font are published once and don't change until the font is dropped or the tables are disabled,
+ * so they are found without taking the lock.
+ * @param fdsc      descriptor of the font
+ * @return          the tables (their pointers are NULL for small fonts) or NULL if the tables are disabled
+ */
+static const font_lut_t * lut_get(const lv_font_fmt_txt_dsc_t * fdsc)
+{
+    if(LUT_LOAD_ACQUIRE(&lut_disabled)) return NULL;
+
+    lv_font_fmt_txt_lut_reg_t * reg = lut_reg_p;
+    uint32_t i;
+    for(i = 0; i < LV_FONT_FMT_TXT_LUT_FONT_MAX; i++) {
+        if(LUT_LOAD_ACQUIRE(&reg->fdsc_arr[i]) == fdsc) {
+            const font_lut_t * lut = LUT_LOAD_ACQUIRE(&reg->lut_arr[i]);
+            if(lut) return lut;
+            break;  /*Being built by another thread*/
+        }
+    }
+
+    return lut_create(fdsc);
+}
+
+/**
+ * Take a slot for a font and build its tables, or wait for the thread building them.
+ * @param fdsc      descriptor of the font
+ * @return          the tables or NULL if the tables are disabled or all slots are taken
+ */
+static const font_lut_t * lut_create(const lv_font_fmt_txt_dsc_t * fdsc)
+{
+    lv_font_fmt_txt_lut_reg_t * reg = lut_reg_p;
+    const font_lut_t * res = NULL;
+
+    lv_mutex_lock(lut_lock_p);
+
+    uint32_t free_i = LV_FONT_FMT_TXT_LUT_FONT_MAX;
+    uint32_t i;
+    for(i = 0; i < LV_FONT_FMT_TXT_LUT_FONT_MAX; i++) {
+        if(reg->fdsc_arr[i] == fdsc) break;
+        if(reg->fdsc_arr[i] == NULL && free_i == LV_FONT_FMT_TXT_LUT_FONT_MAX) free_i = i;
+    }
+
+    if(lut_disabled) {
+        /*Disabled meanwhile*/
+    }
+    else if(i < LV_FONT_FMT_TXT_LUT_FONT_MAX) {
+        /*Built meanwhile*/
+        res = reg->lut_arr[i];
+    }
+    else if(free_i == LV_FONT_FMT_TXT_LUT_FONT_MAX) {
+        LV_LOG_WARN("more than %d fonts, the cmaps are searched", LV_FONT_FMT_TXT_LUT_FONT_MAX);
+    }
+    else {
+        LUT_STORE_RELEASE(&reg->fdsc_arr[free_i], (const void *)fdsc);
+
+        uint32_t glyph_cnt = 0;
+        for(i = 0; i < fdsc->cmap_num; i++) {
+            const lv_font_fmt_txt_cmap_t * cmap = &fdsc->cmaps[i];
+            glyph_cnt += cmap->unicode_list ? cmap->list_length : cmap->range_length;
+        }
+        const lv_font_fmt_txt_kern_pair_t * kdsc = fdsc->kern_dsc;
+        bool kern = kdsc && fdsc->kern_classes == 0 && kdsc->pair_cnt >= LV_FONT_FMT_TXT_LUT_MIN_ENTRIES;
+
+        font_lut_t * lut = NULL;
+        if(glyph_cnt >= LV_FONT_FMT_TXT_LUT_MIN_ENTRIES || kern) {
+            lut = lv_malloc_zeroed(sizeof(font_lut_t));
+            if(lut) {
+                lut->fdsc = fdsc;
+                if(glyph_cnt >= LV_FONT_FMT_TXT_LUT_MIN_ENTRIES) lut_build_gids(lut, glyph_cnt);
+                if(kern) lut_build_kern(lut, kdsc);
+            }
+        }
+
+        res = lut ? lut : &lut_none;
+        LUT_STORE_RELEASE(&reg->lut_arr[free_i], (void *)res);
+    }
+
+    lv_mutex_unlock(lut_lock_p);
+
+    return res;
+}
+
+/**
+ * Add every letter of the cmaps to the glyph ID table. The glyph IDs are found with the
+ * same search as without the table, so letters mapped by more cmaps get the same ID.
+ * @param lut       the tables of the font
+ * @param glyph_cnt number of letters in the cmaps
+ */
+static void lut_build_gids(font_lut_t * lut, uint32_t glyph_cnt)
+{
+    const lv_font_fmt_txt_dsc_t * fdsc = lut->fdsc;
+    uint8_t shift = lut_shift(glyph_cnt);
+    uint32_t mask = UINT32_MAX >> shift;
+
+    uint32_t * keys = lv_malloc_zeroed((mask + 1) * sizeof(uint32_t));
+    uint16_t * values = lv_malloc((mask + 1) * sizeof(uint16_t));
+    if(keys == NULL || values == NULL) {
+        LV_LOG_WARN("couldn't allocate the glyph ID table of %" LV_PRIu32 " letters", glyph_cnt);
+        lv_free(keys);
+        lv_free(values);
+        return;
+    }
+
+    uint16_t i;
+    for(i = 0; i < fdsc->cmap_num; i++) {
+        const lv_font_fmt_txt_cmap_t * cmap = &fdsc->cmaps[i];
+        uint32_t cnt = cmap->unicode_list ? cmap->list_length : cmap->range_length;
+        uint32_t j;
+        for(j = 0; j < cnt; j++) {
+            uint32_t letter = cmap->range_start + (cmap->unicode_list ? cmap->unicode_list[j] : j);
+            uint32_t gid = search_glyph_dsc_id(fdsc, letter);
+            if(gid == 0) continue;
+            if(gid > UINT16_MAX) {
+                /*Can't be stored, keep searching the cmaps*/
+                lv_free(keys);
+                lv_free(values);
+                return;
+            }
+
+            uint32_t slot = LUT_HASH(letter, shift);
+            while(keys[slot] != 0 && keys[slot] != letter) slot = (slot + 1) & mask;
+            keys[slot] = letter;
+            values[slot] = (uint16_t)gid;
+        }
+    }
+
+    lut->gid_keys = keys;
+    lut->gid_values = values;
+    lut->gid_shift = shift;
+    lut->size += (mask + 1) * (sizeof(uint32_t) + sizeof(uint16_t));
+}
+
+/**
+ * Add the kerning pairs to the kerning table
+ * @param lut       the tables of the font
+ * @param kdsc      the kerning pairs of the font
+ */
+static void lut_build_kern(font_lut_t * lut, const lv_font_fmt_txt_kern_pair_t * kdsc)
+{
+    if(kdsc->glyph_ids_size > 1) return;
+
+    uint8_t shift = lut_shift(kdsc->pair_cnt);
+    uint32_t mask = UINT32_MAX >> shift;
+
+    uint32_t * keys = lv_malloc_zeroed((mask + 1) * sizeof(uint32_t));
+    int8_t * values = lv_malloc((mask + 1) * sizeof(int8_t));
+    if(keys == NULL || values == NULL) {
+        LV_LOG_WARN("couldn't allocate the kerning table of %" LV_PRIu32 " pairs", (uint32_t)kdsc->pair_cnt);
+        lv_free(keys);
+        lv_free(values);
+        return;
+    }
+
+    uint32_t i;
+    for(i = 0; i < kdsc->pair_cnt; i++) {
+        uint32_t gid_left;
+        uint32_t gid_right;
+        if(kdsc->glyph_ids_size == 0) {
+            const uint8_t * g_ids = kdsc->glyph_ids;
+            gid_left = g_ids[i * 2];
+            gid_right = g_ids[i * 2 + 1];
+        }
+        else {
+            const uint16_t * g_ids = kdsc->glyph_ids;
+            gid_left = g_ids[i * 2];
+            gid_right = g_ids[i * 2 + 1];
+        }
+
+        uint32_t key = (gid_left << 16) | gid_right;
+        if(key == 0) continue;
+
+        /*Keep the first of duplicated pairs*/
+        uint32_t slot = LUT_HASH(key, shift);
+        while(keys[slot] != 0 && keys[slot] != key) slot = (slot + 1) & mask;
+        if(keys[slot] == key) continue;
+        keys[slot] = key;
+        values[slot] = kdsc->values[i];
+    }
+
+    lut->kern_keys = keys;
+    lut->kern_values = values;
+    lut->kern_shift = shift;
+    lut->size += (mask + 1) * (sizeof(uint32_t) + sizeof(int8_t));
+}
+
+static uint32_t lut_find_gid(const font_lut_t * lut, uint32_t letter)
+{
+    uint32_t mask = UINT32_MAX >> lut->gid_shift;
+    uint32_t slot = LUT_HASH(letter, lut->gid_shift);
+    while(lut->gid_keys[slot] != 0) {
+        if(lut->gid_keys[slot] == letter) return lut->gid_values[slot];
+        slot = (slot + 1) & mask;
+    }
+
+    return 0;
+}
+
+static int8_t lut_find_kern(const font_lut_t * lut, uint32_t gid_left, uint32_t gid_right)
+{
+    if(gid_left > UINT16_MAX || gid_right > UINT16_MAX) return 0;
+
+    uint32_t key = (gid_left << 16) | gid_right;
+    uint32_t mask = UINT32_MAX >> lut->kern_shift;
+    uint32_t slot = LUT_HASH(key, lut->kern_shift);
+    while(lut->kern_keys[slot] != 0) {
+        if(lut->kern_keys[slot] == key) return lut->kern_values[slot];
+        slot = (slot + 1) & mask;
+    }
+
+    return 0;
+}
+
+/**
+ * Get the hash shift of a table which keeps the load factor at most 3/4
+ * @param entry_cnt number of entries to store
+ * @return          32 - log2(number of slots)
+ */
+static uint8_t lut_shift(uint32_t entry_cnt)
+{
+    uint32_t slot_cnt = LUT_MIN_SLOTS;
+    uint8_t shift = 32 - 4;
+    while(slot_cnt * 3 < entry_cnt * 4) {
+        slot_cnt <<= 1;
+        shift--;
+    }
+    return shift;
+}
+
+/**
+ * Free the tables in a slot and make the slot free, called with the lock held.
+ * @param i         index of the slot
+ */
+static void lut_free_slot(uint32_t i)
+{
+    lv_font_fmt_txt_lut_reg_t * reg = lut_reg_p;
+    font_lut_t * lut = reg->lut_arr[i];
+    LUT_STORE_RELEASE(&reg->lut_arr[i], NULL);
+    LUT_STORE_RELEASE(&reg->fdsc_arr[i], NULL);
+    if(lut == NULL || lut == &lut_none) return;
+
+    lv_free(lut->gid_keys);
+    lv_free(lut->gid_values);
+    lv_free(lut->kern_keys);
+    lv_free(lut->kern_values);
+    lv_free(lut);
+}
+
+#endif /*LV_USE_FONT_FMT_TXT_LUT*/
+
 #if LV_USE_FONT_COMPRESSED
 
 /**
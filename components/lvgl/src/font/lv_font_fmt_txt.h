@@ -209,6 +209,32 @@ const void * lv_font_get_bitmap_fmt_txt(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf
 bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t unicode_letter,
                                    uint32_t unicode_letter_next);
 
+#if LV_USE_FONT_FMT_TXT_LUT
+/**
+ * Enable or disable the lookup tables. When enabled, the tables of a font with at least
+ * `LV_FONT_FMT_TXT_LUT_MIN_ENTRIES` glyphs or kerning pairs are built when a glyph of it is looked up first.
+ * Disabling frees all tables and the cmaps and kerning pairs are searched again.
+ * The glyph lookups read the tables without a lock, so disable them only while nothing is rendered,
+ * e.g. from the LVGL task outside of `lv_timer_handler`.
+ * @param en    true: enable (default), false: disable
+ */
+void lv_font_fmt_txt_lut_set_enabled(bool en);
+
+/**
+ * Free the lookup tables of a font. Call it before freeing a font which was used while the tables were enabled.
+ * Like freeing the font itself, call it only when no glyph of the font is being looked up or drawn;
+ * the other fonts can be used meanwhile. The tables are built again when the font is used next time.
+ * @param font  pointer to a font
+ */
+void lv_font_fmt_txt_lut_drop(const lv_font_t * font);
+
+/**
+ * Get the memory used by the lookup tables of all fonts.
+ * @return      size in bytes
+ */
+uint32_t lv_font_fmt_txt_lut_get_size(void);
+#endif
+
 /**********************
  *      MACROS
  **********************/
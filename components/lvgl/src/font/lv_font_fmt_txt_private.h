@@ -41,10 +41,35 @@ typedef struct {
 } lv_font_fmt_rle_t;
 #endif
 
+#if LV_USE_FONT_FMT_TXT_LUT
+#define LV_FONT_FMT_TXT_LUT_FONT_MAX 16 /*Number of fonts whose lookup tables are remembered*/
+
+/**
+ * Registry of the lookup tables. A font takes a slot the first time it is used: first its descriptor,
+ * then its tables are published, so glyph lookups can read the slots without a lock.
+ */
+typedef struct {
+    const void * fdsc_arr[LV_FONT_FMT_TXT_LUT_FONT_MAX]; /**< `lv_font_fmt_txt_dsc_t` of the fonts, NULL: free*/
+    void * lut_arr[LV_FONT_FMT_TXT_LUT_FONT_MAX];        /**< Tables of the fonts, NULL: being built*/
+} lv_font_fmt_txt_lut_reg_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
 
+#if LV_USE_FONT_FMT_TXT_LUT
+/**
+ * Initialize the registry of glyph ID and kerning lookup tables.
+ */
+void lv_font_fmt_txt_lut_init(void);
+
+/**
+ * Free all lookup tables and deinitialize the registry.
+ */
+void lv_font_fmt_txt_lut_deinit(void);
+#endif
+
 /**********************
  *      MACROS
  **********************/
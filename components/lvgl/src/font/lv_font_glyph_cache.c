@@ -0,0 +1,224 @@
+/**
+ * @file lv_font_glyph_cache.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "lv_font_glyph_cache.h"
+#include "lv_font_fmt_txt.h"
+#include "../misc/cache/lv_cache_private.h"
+#include "../misc/lv_assert.h"
+#include "../core/lv_global.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define CACHE_NAME  "FONT_GLYPH"
+
+#define glyph_cache_p (LV_GLOBAL_DEFAULT()->font_glyph_cache)
+#define glyph_cache_hits (LV_GLOBAL_DEFAULT()->font_glyph_cache_hits)
+#define glyph_cache_misses (LV_GLOBAL_DEFAULT()->font_glyph_cache_misses)
+#define font_draw_buf_handlers &(LV_GLOBAL_DEFAULT()->font_draw_buf_handlers)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    lv_cache_slot_size_t slot;  /**< Bitmap and descriptor bytes, counted against the budget*/
+
+    const lv_font_t * font;
+    uint32_t glyph_index;
+    lv_font_glyph_format_t format;  /**< Source bpp of the glyph*/
+
+    lv_draw_buf_t * draw_buf;   /**< The decoded A8 bitmap*/
+} lv_font_glyph_cache_data_t;
+
+typedef struct {
+    lv_font_glyph_dsc_t * g_dsc;
+    bool created;               /**< Set by the create callback: this call decoded the glyph*/
+} lv_font_glyph_cache_create_ctx_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static bool glyph_cache_create_cb(lv_font_glyph_cache_data_t * data, lv_font_glyph_cache_create_ctx_t * ctx);
+static void glyph_cache_free_cb(lv_font_glyph_cache_data_t * data, void * user_data);
+static lv_cache_compare_res_t glyph_cache_compare_cb(const lv_font_glyph_cache_data_t * lhs,
+                                                     const lv_font_glyph_cache_data_t * rhs);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_result_t lv_font_glyph_cache_init(uint32_t size)
+{
+    if(glyph_cache_p != NULL) {
+        return LV_RESULT_OK;
+    }
+
+    glyph_cache_p = lv_cache_create(&lv_cache_class_lru_rb_size,
+    sizeof(lv_font_glyph_cache_data_t), size, (lv_cache_ops_t) {
+        .compare_cb = (lv_cache_compare_cb_t) glyph_cache_compare_cb,
+        .create_cb = (lv_cache_create_cb_t) glyph_cache_create_cb,
+        .free_cb = (lv_cache_free_cb_t) glyph_cache_free_cb,
+    });
+
+    lv_cache_set_name(glyph_cache_p, CACHE_NAME);
+    return glyph_cache_p != NULL ? LV_RESULT_OK : LV_RESULT_INVALID;
+}
+
+void lv_font_glyph_cache_deinit(void)
+{
+    if(glyph_cache_p == NULL) return;
+
+    lv_cache_destroy(glyph_cache_p, NULL);
+    glyph_cache_p = NULL;
+}
+
+void lv_font_glyph_cache_resize(uint32_t new_size, bool evict_now)
+{
+    lv_cache_set_max_size(glyph_cache_p, new_size, NULL);
+    if(evict_now) {
+        lv_cache_reserve(glyph_cache_p, new_size, NULL);
+    }
+}
+
+void lv_font_glyph_cache_drop(void)
+{
+    if(glyph_cache_p == NULL) return;
+
+    lv_cache_drop_all(glyph_cache_p, NULL);
+}
+
+bool lv_font_glyph_cache_is_enabled(void)
+{
+    return glyph_cache_p != NULL && lv_cache_is_enabled(glyph_cache_p);
+}
+
+void lv_font_glyph_cache_get_stats(lv_font_glyph_cache_stats_t * stats)
+{
+    LV_ASSERT_NULL(stats);
+
+    if(glyph_cache_p) lv_mutex_lock(&glyph_cache_p->lock);
+    stats->hits = glyph_cache_hits;
+    stats->misses = glyph_cache_misses;
+    if(glyph_cache_p) lv_mutex_unlock(&glyph_cache_p->lock);
+    stats->size = glyph_cache_p ? (uint32_t)lv_cache_get_size(glyph_cache_p, NULL) : 0;
+    stats->max_size = glyph_cache_p ? (uint32_t)lv_cache_get_max_size(glyph_cache_p, NULL) : 0;
+}
+
+void lv_font_glyph_cache_reset_stats(void)
+{
+    if(glyph_cache_p) lv_mutex_lock(&glyph_cache_p->lock);
+    glyph_cache_hits = 0;
+    glyph_cache_misses = 0;
+    if(glyph_cache_p) lv_mutex_unlock(&glyph_cache_p->lock);
+}
+
+lv_draw_buf_t * lv_font_glyph_cache_acquire(const lv_font_glyph_dsc_t * g_dsc, lv_cache_entry_t ** entry)
+{
+    LV_ASSERT_NULL(g_dsc);
+    LV_ASSERT_NULL(entry);
+
+    *entry = NULL;
+
+    const lv_font_t * font = g_dsc->resolved_font;
+    if(!lv_font_glyph_cache_is_enabled() || font == NULL) return NULL;
+
+    /*Other fonts either draw into the scratch buffer differently or have their own cache (FreeType, Tiny TTF)*/
+    if(font->get_glyph_bitmap != lv_font_get_bitmap_fmt_txt) return NULL;
+    if(g_dsc->format < LV_FONT_GLYPH_FORMAT_A1 || g_dsc->format > LV_FONT_GLYPH_FORMAT_A8) return NULL;
+    if(g_dsc->box_w == 0 || g_dsc->box_h == 0) return NULL;
+
+    lv_font_glyph_cache_data_t search_key = {
+        .font = font,
+        .glyph_index = g_dsc->gid.index,
+        .format = g_dsc->format,
+    };
+    search_key.slot.size = lv_draw_buf_width_to_stride(g_dsc->box_w, LV_COLOR_FORMAT_A8) * g_dsc->box_h +
+                           sizeof(lv_draw_buf_t);
+
+    lv_font_glyph_cache_create_ctx_t ctx = {
+        .g_dsc = (lv_font_glyph_dsc_t *)g_dsc,
+        .created = false,
+    };
+    *entry = lv_cache_acquire_or_create(glyph_cache_p, &search_key, &ctx);
+    if(*entry == NULL) return NULL;
+
+    /*Several draw units can acquire glyphs in parallel, so count under the cache's lock*/
+    lv_mutex_lock(&glyph_cache_p->lock);
+    if(ctx.created) glyph_cache_misses++;
+    else glyph_cache_hits++;
+    lv_mutex_unlock(&glyph_cache_p->lock);
+
+    lv_font_glyph_cache_data_t * data = lv_cache_entry_get_data(*entry);
+    return data->draw_buf;
+}
+
+void lv_font_glyph_cache_release(lv_cache_entry_t * entry)
+{
+    if(entry == NULL) return;
+
+    lv_cache_release(glyph_cache_p, entry, NULL);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static bool glyph_cache_create_cb(lv_font_glyph_cache_data_t * data, lv_font_glyph_cache_create_ctx_t * ctx)
+{
+    lv_font_glyph_dsc_t * g_dsc = ctx->g_dsc;
+
+    lv_draw_buf_t * draw_buf = lv_draw_buf_create_ex(font_draw_buf_handlers, g_dsc->box_w, g_dsc->box_h,
+                                                     LV_COLOR_FORMAT_A8, LV_STRIDE_AUTO);
+    if(draw_buf == NULL) {
+        LV_LOG_WARN("couldn't allocate the bitmap of glyph %" LV_PRIu32, data->glyph_index);
+        return false;
+    }
+
+    if(lv_font_get_glyph_bitmap(g_dsc, draw_buf) == NULL) {
+        lv_draw_buf_destroy(draw_buf);
+        return false;
+    }
+
+    data->draw_buf = draw_buf;
+    ctx->created = true;
+    return true;
+}
+
+static void glyph_cache_free_cb(lv_font_glyph_cache_data_t * data, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_draw_buf_destroy(data->draw_buf);
+}
+
+static lv_cache_compare_res_t glyph_cache_compare_cb(const lv_font_glyph_cache_data_t * lhs,
+                                                     const lv_font_glyph_cache_data_t * rhs)
+{
+    if(lhs->font != rhs->font) {
+        return lhs->font > rhs->font ? 1 : -1;
+    }
+    if(lhs->glyph_index != rhs->glyph_index) {
+        return lhs->glyph_index > rhs->glyph_index ? 1 : -1;
+    }
+    if(lhs->format != rhs->format) {
+        return lhs->format > rhs->format ? 1 : -1;
+    }
+    return 0;
+}
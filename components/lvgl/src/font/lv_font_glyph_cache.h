@@ -0,0 +1,112 @@
+/**
+ * @file lv_font_glyph_cache.h
+ *
+ */
+
+#ifndef LV_FONT_GLYPH_CACHE_H
+#define LV_FONT_GLYPH_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "../lv_conf_internal.h"
+#include "../misc/lv_types.h"
+#include "lv_font.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * Statistics of the glyph cache.
+ * Each acquired glyph is counted once, as a hit or a miss, also with several draw units.
+ */
+typedef struct {
+    uint32_t hits;      /**< Glyphs blended from the cache*/
+    uint32_t misses;    /**< Glyphs decoded and added to the cache*/
+    uint32_t size;      /**< Bytes currently held by the cache*/
+    uint32_t max_size;  /**< Byte budget of the cache. 0: disabled*/
+} lv_font_glyph_cache_stats_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize the glyph cache. The cache holds the decoded A8 bitmaps of `lv_font_fmt_txt` glyphs
+ * so that redrawing the same letters doesn't expand or decompress them again.
+ * @param size      byte budget of the cache. 0: the cache is created disabled.
+ * @return          LV_RESULT_OK: initialization succeeded, LV_RESULT_INVALID: failed.
+ */
+lv_result_t lv_font_glyph_cache_init(uint32_t size);
+
+/**
+ * Deinitialize the glyph cache and free all cached glyphs.
+ */
+void lv_font_glyph_cache_deinit(void);
+
+/**
+ * Resize the glyph cache.
+ * If set to 0, the cache will be disabled.
+ * @param new_size  new byte budget of the cache
+ * @param evict_now true: evict the glyphs exceeding the new budget now, false: evict them when new glyphs are added
+ */
+void lv_font_glyph_cache_resize(uint32_t new_size, bool evict_now);
+
+/**
+ * Drop all cached glyphs. Call it before deleting a font (e.g. one created by `lv_binfont_create`)
+ * which was drawn while the cache was enabled.
+ */
+void lv_font_glyph_cache_drop(void);
+
+/**
+ * Return true if the glyph cache is enabled.
+ * @return true: enabled, false: disabled.
+ */
+bool lv_font_glyph_cache_is_enabled(void);
+
+/**
+ * Get the statistics of the glyph cache.
+ * @param stats     store the statistics here
+ */
+void lv_font_glyph_cache_get_stats(lv_font_glyph_cache_stats_t * stats);
+
+/**
+ * Reset the hit and miss counters.
+ */
+void lv_font_glyph_cache_reset_stats(void);
+
+/**
+ * Get the decoded A8 bitmap of a glyph from the cache, decoding and adding it on a miss.
+ * Only bitmap glyphs of `lv_font_fmt_txt` fonts are cached.
+ * @param g_dsc     the glyph descriptor from `lv_font_get_glyph_dsc`
+ * @param entry     store the cache entry here. Release it with `lv_font_glyph_cache_release`
+ *                  when the bitmap is not used anymore.
+ * @return          the A8 bitmap or NULL if the glyph is not cacheable, the cache is disabled or decoding failed
+ */
+lv_draw_buf_t * lv_font_glyph_cache_acquire(const lv_font_glyph_dsc_t * g_dsc, lv_cache_entry_t ** entry);
+
+/**
+ * Release a glyph acquired by `lv_font_glyph_cache_acquire`.
+ * @param entry     the cache entry
+ */
+void lv_font_glyph_cache_release(lv_cache_entry_t * entry);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_FONT_GLYPH_CACHE_H*/
@@ -558,6 +558,16 @@
         #endif
     #endif
 
+    /* Use portable C kernels processing 2-4 pixels per machine word for the RGB565
+     * fills and RGB565 image blends which are not accelerated by `LV_USE_DRAW_SW_ASM` */
+    #ifndef LV_USE_DRAW_SW_SWAR
+        #ifdef CONFIG_LV_USE_DRAW_SW_SWAR
+            #define LV_USE_DRAW_SW_SWAR CONFIG_LV_USE_DRAW_SW_SWAR
+        #else
+            #define LV_USE_DRAW_SW_SWAR         0
+        #endif
+    #endif
+
     /* Enable drawing complex gradients in software: linear at an angle, radial or conical */
     #ifndef LV_USE_DRAW_SW_COMPLEX_GRADIENTS
         #ifdef CONFIG_LV_USE_DRAW_SW_COMPLEX_GRADIENTS
@@ -1649,6 +1659,38 @@
     #endif
 #endif
 
+/*Size of the cache of decoded A8 glyph bitmaps of `lv_font_fmt_txt` fonts in bytes.
+ *Redrawing a cached letter blends its bitmap directly instead of expanding or decompressing it again.
+ *0 to disable; can be changed at runtime with `lv_font_glyph_cache_resize()`*/
+#ifndef LV_FONT_GLYPH_CACHE_SIZE
+    #ifdef CONFIG_LV_FONT_GLYPH_CACHE_SIZE
+        #define LV_FONT_GLYPH_CACHE_SIZE CONFIG_LV_FONT_GLYPH_CACHE_SIZE
+    #else
+        #define LV_FONT_GLYPH_CACHE_SIZE 0
+    #endif
+#endif
+
+/*Build hash tables for large `lv_font_fmt_txt` fonts on first use to find the glyph ID of a letter
+ *and the kerning value of a glyph pair in O(1) instead of walking the cmaps and binary searching.
+ *Needs 8..16 bytes of RAM per glyph and 5..10 bytes per kerning pair.*/
+#ifndef LV_USE_FONT_FMT_TXT_LUT
+    #ifdef CONFIG_LV_USE_FONT_FMT_TXT_LUT
+        #define LV_USE_FONT_FMT_TXT_LUT CONFIG_LV_USE_FONT_FMT_TXT_LUT
+    #else
+        #define LV_USE_FONT_FMT_TXT_LUT 0
+    #endif
+#endif
+#if LV_USE_FONT_FMT_TXT_LUT
+    /*Build the tables only for fonts with at least this many glyphs (or kerning pairs)*/
+    #ifndef LV_FONT_FMT_TXT_LUT_MIN_ENTRIES
+        #ifdef CONFIG_LV_FONT_FMT_TXT_LUT_MIN_ENTRIES
+            #define LV_FONT_FMT_TXT_LUT_MIN_ENTRIES CONFIG_LV_FONT_FMT_TXT_LUT_MIN_ENTRIES
+        #else
+            #define LV_FONT_FMT_TXT_LUT_MIN_ENTRIES 256
+        #endif
+    #endif
+#endif
+
 /*=================
  *  TEXT SETTINGS
  *=================*/
@@ -2011,6 +2053,14 @@
             #define LV_LABEL_LONG_TXT_HINT 1  /*Store some extra info in labels to speed up drawing of very long texts*/
         #endif
     #endif
+    #ifndef LV_LABEL_LAYOUT_CACHE
+        #ifdef CONFIG_LV_LABEL_LAYOUT_CACHE
+            #define LV_LABEL_LAYOUT_CACHE CONFIG_LV_LABEL_LAYOUT_CACHE
+        #else
+            #define LV_LABEL_LAYOUT_CACHE 0   /*Cache the line breaks and letter widths of labels to redraw and measure them faster.
+                                       *Needs 12 bytes per line and 2 bytes per letter of RAM.*/
+        #endif
+    #endif
     #ifndef LV_LABEL_WAIT_CHAR_COUNT
         #ifdef CONFIG_LV_LABEL_WAIT_CHAR_COUNT
             #define LV_LABEL_WAIT_CHAR_COUNT CONFIG_LV_LABEL_WAIT_CHAR_COUNT
@@ -2909,6 +2959,15 @@
                 #define LV_PROFILER_BUILTIN_BUF_SIZE (16 * 1024)     /*[bytes]*/
             #endif
         #endif
+
+        /*Maximum number of threads with their own trace ring; the buffer is split between them*/
+        #ifndef LV_PROFILER_BUILTIN_THREAD_MAX
+            #ifdef CONFIG_LV_PROFILER_BUILTIN_THREAD_MAX
+                #define LV_PROFILER_BUILTIN_THREAD_MAX CONFIG_LV_PROFILER_BUILTIN_THREAD_MAX
+            #else
+                #define LV_PROFILER_BUILTIN_THREAD_MAX 4
+            #endif
+        #endif
     #endif
 
     /*Header to include for the profiler*/
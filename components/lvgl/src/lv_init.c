@@ -12,6 +12,8 @@
 #include "misc/lv_anim_private.h"
 #include "draw/lv_image_decoder_private.h"
 #include "draw/lv_draw_buf_private.h"
+#include "font/lv_font_glyph_cache.h"
+#include "font/lv_font_fmt_txt_private.h"
 #include "core/lv_refr_private.h"
 #include "core/lv_obj_style_private.h"
 #include "core/lv_group_private.h"
@@ -230,6 +232,12 @@ void lv_init(void)
     lv_image_decoder_init(LV_CACHE_DEF_SIZE, LV_IMAGE_HEADER_CACHE_DEF_CNT);
     lv_bin_decoder_init();  /*LVGL built-in binary image decoder*/
 
+    lv_font_glyph_cache_init(LV_FONT_GLYPH_CACHE_SIZE);
+
+#if LV_USE_FONT_FMT_TXT_LUT
+    lv_font_fmt_txt_lut_init();
+#endif
+
 #if LV_USE_DRAW_VG_LITE
     lv_draw_vg_lite_init();
 #endif
@@ -383,6 +391,12 @@ void lv_deinit(void)
     lv_theme_mono_deinit();
 #endif
 
+    lv_font_glyph_cache_deinit();
+
+#if LV_USE_FONT_FMT_TXT_LUT
+    lv_font_fmt_txt_lut_deinit();
+#endif
+
     lv_image_decoder_deinit();
 
     lv_refr_deinit();
@@ -34,6 +34,25 @@
     #define LV_PROFILER_MULTEX_UNLOCK
 #endif
 
+/*Rings are owned by a thread: the thread only advances `head`, `lv_profiler_builtin_flush` only `tail`*/
+#if defined(__GNUC__)
+    #define LV_PROFILER_THREAD_LOCAL __thread
+    #define LV_PROFILER_LOAD_ACQUIRE(p)     __atomic_load_n(p, __ATOMIC_ACQUIRE)
+    #define LV_PROFILER_STORE_RELEASE(p, v) __atomic_store_n(p, v, __ATOMIC_RELEASE)
+    #define LV_PROFILER_FETCH_ADD(p, v)     __atomic_fetch_add(p, v, __ATOMIC_RELAXED)
+#else
+    /*Without thread-local storage and atomics only one thread may record*/
+    #define LV_PROFILER_THREAD_LOCAL
+    #define LV_PROFILER_LOAD_ACQUIRE(p)     (*(p))
+    #define LV_PROFILER_STORE_RELEASE(p, v) (*(p) = (v))
+    #define LV_PROFILER_FETCH_ADD(p, v)     ((*(p) += (v)) - (v))
+#endif
+
+#define LV_PROFILER_NAME_SLOTS  512 /*Open addressing table of the names sent in the binary stream*/
+#define LV_PROFILER_NAME_NONE   0xFFFF
+#define LV_PROFILER_BIN_BUF_LEN 256
+#define LV_PROFILER_THREAD_OVER 0xFF
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -42,29 +61,60 @@
  * @brief Structure representing a built-in profiler item in LVGL
  */
 typedef struct {
-    char tag;          /**< The tag of the profiler item */
-    uint32_t tick;     /**< The tick value of the profiler item */
     const char * func; /**< A pointer to the function associated with the profiler item */
-#if LV_USE_OS
-    int tid;           /**< The thread ID of the profiler item */
-    int cpu;         /**< The CPU ID of the profiler item */
-#endif
+    uint32_t tick;     /**< The tick value of the profiler item */
+    char tag;          /**< The tag of the profiler item */
+    uint8_t cpu;       /**< The CPU ID of the profiler item */
 } lv_profiler_builtin_item_t;
 
+/**
+ * @brief Single producer, single consumer ring of one thread
+ */
+typedef struct {
+    lv_profiler_builtin_item_t * item_arr; /**< Items, `item_mask + 1` of them */
+    uint32_t item_mask;                    /**< Number of items - 1, a power of 2 */
+    uint32_t head;                         /**< Items written, only changed by the owner thread */
+    uint32_t tail;                         /**< Items flushed, only changed by the flush */
+    uint32_t dropped;                      /**< Items dropped because the ring was full, owner thread */
+    uint32_t dropped_flushed;              /**< `dropped` at the last flush */
+    uint32_t claimed;                      /**< Set when `tid` is valid and the ring has an owner */
+    int tid;                               /**< The thread ID of the owner */
+} lv_profiler_builtin_ring_t;
+
+/**
+ * @brief A name sent in the binary stream
+ */
+typedef struct {
+    const char * func;
+    uint16_t id;
+} lv_profiler_builtin_name_t;
+
 /**
  * @brief Structure representing a context for the LVGL built-in profiler
  */
 typedef struct lv_profiler_builtin_ctx_t {
-    lv_profiler_builtin_item_t * item_arr; /**< Pointer to an array of profiler items */
-    uint32_t item_num;                     /**< Number of profiler items in the array */
-    uint32_t cur_index;                    /**< Index of the current profiler item */
+    lv_profiler_builtin_ring_t ring_arr[LV_PROFILER_BUILTIN_THREAD_MAX]; /**< Per thread rings */
+    uint32_t ring_cnt;                     /**< Number of claimed rings, may exceed the maximum */
+    uint32_t lost;                         /**< Items of threads over the maximum */
+    uint32_t lost_flushed;                 /**< `lost` at the last flush */
+    uint32_t generation;                   /**< Distinguishes the rings of successive inits */
+    lv_profiler_builtin_name_t * name_arr; /**< Names already sent in the binary stream */
+    uint32_t name_cnt;                     /**< Number of ids given out */
     lv_profiler_builtin_config_t config;   /**< Configuration for the built-in profiler */
     bool enable;                           /**< Whether the built-in profiler is enabled */
 #if LV_USE_OS
-    lv_mutex_t mutex;                      /**< Mutex to protect the built-in profiler */
+    lv_mutex_t mutex;                      /**< Serializes flushes */
 #endif
 } lv_profiler_builtin_ctx_t;
 
+/**
+ * @brief Output buffer of the binary stream
+ */
+typedef struct {
+    uint8_t data[LV_PROFILER_BIN_BUF_LEN];
+    uint32_t len;
+} lv_profiler_builtin_bin_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -72,12 +122,25 @@ typedef struct lv_profiler_builtin_ctx_t {
 static void default_flush_cb(const char * buf);
 static int default_tid_get_cb(void);
 static int default_cpu_get_cb(void);
+static lv_profiler_builtin_ring_t * ring_claim(lv_profiler_builtin_ctx_t * ctx);
+static void restart(const lv_profiler_builtin_config_t * config, uint32_t num);
+static void write_header(void);
 static void flush_no_lock(void);
+static void flush_ring_text(lv_profiler_builtin_ring_t * ring, uint32_t tail, uint32_t head);
+static void flush_ring_bin(lv_profiler_builtin_bin_t * bin, lv_profiler_builtin_ring_t * ring, uint32_t index,
+                           uint32_t tail, uint32_t head);
+static void bin_record(lv_profiler_builtin_bin_t * bin, char type, uint8_t b1, uint16_t id, uint32_t val);
+static void bin_flush(lv_profiler_builtin_bin_t * bin);
+static uint16_t name_id_get(lv_profiler_builtin_bin_t * bin, const char * func);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 
+static LV_PROFILER_THREAD_LOCAL lv_profiler_builtin_ring_t * ring_local; /*Ring of this thread*/
+static LV_PROFILER_THREAD_LOCAL uint32_t ring_local_generation;         /*Init it was claimed in*/
+static uint32_t generation_cnt;
+
 /**********************
  *      MACROS
  **********************/
@@ -103,54 +166,85 @@ void lv_profiler_builtin_init(const lv_profiler_builtin_config_t * config)
     LV_ASSERT_NULL(config);
     LV_ASSERT_NULL(config->tick_get_cb);
 
-    uint32_t num = config->buf_size / sizeof(lv_profiler_builtin_item_t);
-    if(num == 0) {
-        LV_LOG_WARN("buf_size must > %d", (int)sizeof(lv_profiler_builtin_item_t));
+    /*Each thread gets an equal share of the buffer, rounded down to a power of 2 items*/
+    uint32_t num = config->buf_size / LV_PROFILER_BUILTIN_THREAD_MAX / sizeof(lv_profiler_builtin_item_t);
+    if(num < 2) {
+        LV_LOG_WARN("buf_size must > %d", (int)(2 * LV_PROFILER_BUILTIN_THREAD_MAX * sizeof(lv_profiler_builtin_item_t)));
         return;
     }
+    while(num & (num - 1)) num &= num - 1;
 
     if(config->tick_per_sec == 0 || config->tick_per_sec > LV_PROFILER_TICK_PER_SEC_MAX) {
         LV_LOG_WARN("tick_per_sec range must be between 1~%d", LV_PROFILER_TICK_PER_SEC_MAX);
         return;
     }
 
-    /*Free the old item_arr memory*/
+    /*Other threads may be recording at any time, e.g. the drivers' trace points outside of `lv_lock`.
+     *So the context and the rings are allocated only once and an init on a running profiler only restarts
+     *the output; the memory is freed only by `lv_profiler_builtin_uninit`*/
     if(profiler_ctx) {
-        lv_profiler_builtin_uninit();
+        restart(config, num);
+        lv_profiler_builtin_set_enable(true);
+        return;
     }
 
-    profiler_ctx = lv_malloc_zeroed(sizeof(lv_profiler_builtin_ctx_t));
-    LV_ASSERT_MALLOC(profiler_ctx);
+    lv_profiler_builtin_ctx_t * ctx = lv_malloc_zeroed(sizeof(lv_profiler_builtin_ctx_t));
+    LV_ASSERT_MALLOC(ctx);
+    if(ctx == NULL) {
+        LV_LOG_ERROR("malloc failed for profiler_ctx");
+        return;
+    }
 
-    profiler_ctx->item_arr = lv_malloc(num * sizeof(lv_profiler_builtin_item_t));
-    LV_ASSERT_MALLOC(profiler_ctx->item_arr);
-    if(profiler_ctx->item_arr == NULL) {
-        lv_free(profiler_ctx);
-        profiler_ctx = NULL;
+    lv_profiler_builtin_item_t * item_arr = lv_malloc(LV_PROFILER_BUILTIN_THREAD_MAX * num * sizeof(
+                                                          lv_profiler_builtin_item_t));
+    LV_ASSERT_MALLOC(item_arr);
+    if(item_arr == NULL) {
+        lv_free(ctx);
         LV_LOG_ERROR("malloc failed for item_arr");
         return;
     }
 
-    LV_PROFILER_MULTEX_INIT;
-    profiler_ctx->item_num = num;
-    profiler_ctx->config = *config;
+    if(config->flush_bin_cb) {
+        ctx->name_arr = lv_malloc_zeroed(LV_PROFILER_NAME_SLOTS * sizeof(lv_profiler_builtin_name_t));
+        LV_ASSERT_MALLOC(ctx->name_arr);
+        if(ctx->name_arr == NULL) {
+            lv_free(item_arr);
+            lv_free(ctx);
+            LV_LOG_ERROR("malloc failed for name_arr");
+            return;
+        }
+    }
 
-    if(profiler_ctx->config.flush_cb) {
-        /* add profiler header for perfetto */
-        profiler_ctx->config.flush_cb("# tracer: nop\n");
-        profiler_ctx->config.flush_cb("#\n");
+    for(uint32_t i = 0; i < LV_PROFILER_BUILTIN_THREAD_MAX; i++) {
+        ctx->ring_arr[i].item_arr = item_arr + i * num;
+        ctx->ring_arr[i].item_mask = num - 1;
     }
 
+#if LV_USE_OS
+    lv_mutex_init(&ctx->mutex);
+#endif
+    ctx->config = *config;
+    ctx->generation = ++generation_cnt;
+
+    /*Publish the context only when it is complete, recorders read it without a lock*/
+    LV_PROFILER_STORE_RELEASE(&profiler_ctx, ctx);
+
+    LV_PROFILER_MULTEX_LOCK;
+    write_header();
+    LV_PROFILER_MULTEX_UNLOCK;
+
     lv_profiler_builtin_set_enable(true);
 
-    LV_LOG_INFO("init OK, item_num = %d", (int)num);
+    LV_LOG_INFO("init OK, %d items per thread", (int)num);
 }
 
 void lv_profiler_builtin_uninit(void)
 {
+    /*Frees the memory the recorders use: only call it when no other thread records anymore, e.g. in `lv_deinit`*/
     LV_ASSERT_NULL(profiler_ctx);
     LV_PROFILER_MULTEX_DEINIT;
-    lv_free(profiler_ctx->item_arr);
+    lv_free(profiler_ctx->ring_arr[0].item_arr);
+    lv_free(profiler_ctx->name_arr);
     lv_free(profiler_ctx);
     profiler_ctx = NULL;
 }
@@ -175,33 +269,42 @@ void lv_profiler_builtin_flush(void)
 
 void lv_profiler_builtin_write(const char * func, char tag)
 {
-    LV_ASSERT_NULL(profiler_ctx);
     LV_ASSERT_NULL(func);
 
-    if(!profiler_ctx->enable) {
+    /*Read the context once: driver trace points may run before lv_init, e.g. the SPI layer used on its own*/
+    lv_profiler_builtin_ctx_t * ctx = LV_PROFILER_LOAD_ACQUIRE(&profiler_ctx);
+    if(!ctx || !ctx->enable) {
         return;
     }
 
-    LV_PROFILER_MULTEX_LOCK;
+    lv_profiler_builtin_ring_t * ring = ring_local;
+    if(ring_local_generation != LV_PROFILER_LOAD_ACQUIRE(&ctx->generation)) {
+        ring = ring_claim(ctx);
+    }
+
+    if(ring == NULL) {
+        LV_PROFILER_FETCH_ADD(&ctx->lost, 1);
+        return;
+    }
 
-    if(profiler_ctx->cur_index >= profiler_ctx->item_num) {
-        flush_no_lock();
-        profiler_ctx->cur_index = 0;
+    uint32_t head = ring->head;
+    if(head - LV_PROFILER_LOAD_ACQUIRE(&ring->tail) > ring->item_mask) {
+        /*Full: never wait for the flush, it would distort the timings being measured*/
+        LV_PROFILER_STORE_RELEASE(&ring->dropped, ring->dropped + 1);
+        return;
     }
 
-    lv_profiler_builtin_item_t * item = &profiler_ctx->item_arr[profiler_ctx->cur_index];
+    lv_profiler_builtin_item_t * item = &ring->item_arr[head & ring->item_mask];
     item->func = func;
     item->tag = tag;
-    item->tick = profiler_ctx->config.tick_get_cb();
-
+    item->tick = LV_PROFILER_LOAD_ACQUIRE(&ctx->config.tick_get_cb)();
 #if LV_USE_OS
-    item->tid = profiler_ctx->config.tid_get_cb();
-    item->cpu = profiler_ctx->config.cpu_get_cb();
+    item->cpu = (uint8_t)LV_PROFILER_LOAD_ACQUIRE(&ctx->config.cpu_get_cb)();
+#else
+    item->cpu = 0;
 #endif
 
-    profiler_ctx->cur_index++;
-
-    LV_PROFILER_MULTEX_UNLOCK;
+    LV_PROFILER_STORE_RELEASE(&ring->head, head + 1);
 }
 
 /**********************
@@ -223,40 +326,239 @@ static int default_cpu_get_cb(void)
     return 0;
 }
 
+/**
+ * Give the calling thread the next free ring.
+ * @param ctx the context read by the caller
+ * @return the ring or NULL if all the rings are taken
+ */
+static lv_profiler_builtin_ring_t * ring_claim(lv_profiler_builtin_ctx_t * ctx)
+{
+    /*Read the generation before taking a ring: a restart in between makes the thread claim again*/
+    uint32_t generation = LV_PROFILER_LOAD_ACQUIRE(&ctx->generation);
+    uint32_t index = LV_PROFILER_FETCH_ADD(&ctx->ring_cnt, 1);
+    lv_profiler_builtin_ring_t * ring = NULL;
+    if(index < LV_PROFILER_BUILTIN_THREAD_MAX) {
+        ring = &ctx->ring_arr[index];
+        int (*tid_get_cb)(void) = LV_PROFILER_LOAD_ACQUIRE(&ctx->config.tid_get_cb);
+        ring->tid = tid_get_cb ? tid_get_cb() : 0;
+        LV_PROFILER_STORE_RELEASE(&ring->claimed, 1);
+    }
+    else {
+        LV_LOG_WARN("more than %d threads, increase LV_PROFILER_BUILTIN_THREAD_MAX", LV_PROFILER_BUILTIN_THREAD_MAX);
+    }
+
+    ring_local = ring;
+    ring_local_generation = generation;
+    return ring;
+}
+
+/**
+ * Restart the output of a running profiler: drop the recorded items and send a new header.
+ * The rings stay allocated, threads still recording keep writing into valid memory.
+ * @param config the new configuration, all but the buffer size is taken
+ * @param num    items per thread the new configuration asks for
+ */
+static void restart(const lv_profiler_builtin_config_t * config, uint32_t num)
+{
+    lv_profiler_builtin_ctx_t * ctx = profiler_ctx;
+    if(num != ctx->ring_arr[0].item_mask + 1) {
+        LV_LOG_WARN("buf_size can't change while running, keeping %d items per thread",
+                    (int)(ctx->ring_arr[0].item_mask + 1));
+    }
+
+    LV_PROFILER_MULTEX_LOCK;
+
+    if(config->flush_bin_cb && ctx->name_arr == NULL) {
+        /*Only the flush uses the names, it is serialized by the mutex*/
+        ctx->name_arr = lv_malloc(LV_PROFILER_NAME_SLOTS * sizeof(lv_profiler_builtin_name_t));
+        LV_ASSERT_MALLOC(ctx->name_arr);
+    }
+    if(ctx->name_arr) {
+        lv_memzero(ctx->name_arr, LV_PROFILER_NAME_SLOTS * sizeof(lv_profiler_builtin_name_t));
+    }
+    ctx->name_cnt = 0;
+
+    ctx->config.flush_cb = config->flush_cb;
+    ctx->config.flush_bin_cb = ctx->name_arr ? config->flush_bin_cb : NULL;
+    ctx->config.tick_per_sec = config->tick_per_sec;
+
+    /*The recorders read the callbacks without a lock, each store replaces one valid function with another*/
+    LV_PROFILER_STORE_RELEASE(&ctx->config.tick_get_cb, config->tick_get_cb);
+    LV_PROFILER_STORE_RELEASE(&ctx->config.tid_get_cb, config->tid_get_cb);
+    LV_PROFILER_STORE_RELEASE(&ctx->config.cpu_get_cb, config->cpu_get_cb);
+
+    /*Drop what was recorded for the old output. The threads claim the rings again in the new generation,
+     *so the rings of threads that have exited are given out again*/
+    for(uint32_t i = 0; i < LV_PROFILER_BUILTIN_THREAD_MAX; i++) {
+        lv_profiler_builtin_ring_t * ring = &ctx->ring_arr[i];
+        LV_PROFILER_STORE_RELEASE(&ring->claimed, 0);
+        LV_PROFILER_STORE_RELEASE(&ring->tail, LV_PROFILER_LOAD_ACQUIRE(&ring->head));
+        ring->dropped_flushed = LV_PROFILER_LOAD_ACQUIRE(&ring->dropped);
+    }
+    ctx->lost_flushed = LV_PROFILER_LOAD_ACQUIRE(&ctx->lost);
+    LV_PROFILER_STORE_RELEASE(&ctx->ring_cnt, 0);
+    LV_PROFILER_STORE_RELEASE(&ctx->generation, ++generation_cnt);
+
+    write_header();
+
+    LV_PROFILER_MULTEX_UNLOCK;
+}
+
+/**
+ * Send the header of the output, called with the mutex held.
+ */
+static void write_header(void)
+{
+    if(profiler_ctx->config.flush_bin_cb) {
+        uint8_t header[LV_PROFILER_BUILTIN_BIN_HEADER_SIZE] = {0};
+        lv_memcpy(header, LV_PROFILER_BUILTIN_BIN_MAGIC, 4);
+        header[4] = LV_PROFILER_BUILTIN_BIN_VERSION;
+        for(uint32_t i = 0; i < 4; i++) header[8 + i] = (uint8_t)(profiler_ctx->config.tick_per_sec >> (8 * i));
+        profiler_ctx->config.flush_bin_cb(header, sizeof(header));
+    }
+    else if(profiler_ctx->config.flush_cb) {
+        /* add profiler header for perfetto */
+        profiler_ctx->config.flush_cb("# tracer: nop\n");
+        profiler_ctx->config.flush_cb("#\n");
+    }
+}
+
 static void flush_no_lock(void)
 {
-    if(!profiler_ctx->config.flush_cb) {
+    if(!profiler_ctx->config.flush_bin_cb && !profiler_ctx->config.flush_cb) {
         LV_LOG_WARN("flush_cb is not registered");
         return;
     }
 
-    uint32_t cur = 0;
+    lv_profiler_builtin_bin_t bin;
+    bin.len = 0;
+
+    for(uint32_t i = 0; i < LV_PROFILER_BUILTIN_THREAD_MAX; i++) {
+        lv_profiler_builtin_ring_t * ring = &profiler_ctx->ring_arr[i];
+        if(!LV_PROFILER_LOAD_ACQUIRE(&ring->claimed)) continue;
+
+        uint32_t head = LV_PROFILER_LOAD_ACQUIRE(&ring->head);
+        uint32_t tail = ring->tail;
+        uint32_t dropped = LV_PROFILER_LOAD_ACQUIRE(&ring->dropped);
+        if(head == tail && dropped == ring->dropped_flushed) continue;
+
+        if(profiler_ctx->config.flush_bin_cb) {
+            flush_ring_bin(&bin, ring, i, tail, head);
+            if(dropped != ring->dropped_flushed) {
+                bin_record(&bin, 'D', (uint8_t)i, 0, dropped - ring->dropped_flushed);
+            }
+        }
+        else {
+            flush_ring_text(ring, tail, head);
+            if(dropped != ring->dropped_flushed) {
+                LV_LOG_WARN("thread %d: %" LV_PRIu32 " items dropped", ring->tid, dropped - ring->dropped_flushed);
+            }
+        }
+
+        ring->dropped_flushed = dropped;
+        LV_PROFILER_STORE_RELEASE(&ring->tail, head);
+    }
+
+    uint32_t lost = LV_PROFILER_LOAD_ACQUIRE(&profiler_ctx->lost);
+    if(lost != profiler_ctx->lost_flushed) {
+        if(profiler_ctx->config.flush_bin_cb) {
+            bin_record(&bin, 'D', LV_PROFILER_THREAD_OVER, 0, lost - profiler_ctx->lost_flushed);
+        }
+        profiler_ctx->lost_flushed = lost;
+    }
+
+    bin_flush(&bin);
+}
+
+static void flush_ring_text(lv_profiler_builtin_ring_t * ring, uint32_t tail, uint32_t head)
+{
     char buf[LV_PROFILER_STR_MAX_LEN];
     uint32_t tick_per_sec = profiler_ctx->config.tick_per_sec;
-    while(cur < profiler_ctx->cur_index) {
-        lv_profiler_builtin_item_t * item = &profiler_ctx->item_arr[cur++];
+    for(uint32_t cur = tail; cur != head; cur++) {
+        lv_profiler_builtin_item_t * item = &ring->item_arr[cur & ring->item_mask];
         uint32_t sec = item->tick / tick_per_sec;
         uint32_t usec = (item->tick % tick_per_sec) * (LV_PROFILER_TICK_PER_SEC_MAX / tick_per_sec);
 
-#if LV_USE_OS
         lv_snprintf(buf, sizeof(buf),
                     "   LVGL-%d [%d] %" LV_PRIu32 ".%06" LV_PRIu32 ": tracing_mark_write: %c|1|%s\n",
-                    item->tid,
+                    ring->tid,
                     item->cpu,
                     sec,
                     usec,
                     item->tag,
                     item->func);
-#else
-        lv_snprintf(buf, sizeof(buf),
-                    "   LVGL-1 [0] %" LV_PRIu32 ".%06" LV_PRIu32 ": tracing_mark_write: %c|1|%s\n",
-                    sec,
-                    usec,
-                    item->tag,
-                    item->func);
-#endif
         profiler_ctx->config.flush_cb(buf);
     }
 }
 
+static void flush_ring_bin(lv_profiler_builtin_bin_t * bin, lv_profiler_builtin_ring_t * ring, uint32_t index,
+                           uint32_t tail, uint32_t head)
+{
+    bin_record(bin, 'T', (uint8_t)index, 0, (uint32_t)ring->tid);
+    for(uint32_t cur = tail; cur != head; cur++) {
+        lv_profiler_builtin_item_t * item = &ring->item_arr[cur & ring->item_mask];
+        uint16_t id = name_id_get(bin, item->func);
+        bin_record(bin, item->tag, item->cpu, id, item->tick);
+    }
+}
+
+static void bin_record(lv_profiler_builtin_bin_t * bin, char type, uint8_t b1, uint16_t id, uint32_t val)
+{
+    if(bin->len + LV_PROFILER_BUILTIN_BIN_RECORD_SIZE > sizeof(bin->data)) bin_flush(bin);
+
+    uint8_t * p = &bin->data[bin->len];
+    p[0] = (uint8_t)type;
+    p[1] = b1;
+    p[2] = (uint8_t)id;
+    p[3] = (uint8_t)(id >> 8);
+    p[4] = (uint8_t)val;
+    p[5] = (uint8_t)(val >> 8);
+    p[6] = (uint8_t)(val >> 16);
+    p[7] = (uint8_t)(val >> 24);
+    bin->len += LV_PROFILER_BUILTIN_BIN_RECORD_SIZE;
+}
+
+static void bin_flush(lv_profiler_builtin_bin_t * bin)
+{
+    if(bin->len == 0) return;
+    profiler_ctx->config.flush_bin_cb(bin->data, bin->len);
+    bin->len = 0;
+}
+
+/**
+ * Get the id of a name in the binary stream, sending an 'N' record the first time.
+ * @return the id or LV_PROFILER_NAME_NONE if the table is full
+ */
+static uint16_t name_id_get(lv_profiler_builtin_bin_t * bin, const char * func)
+{
+    uint32_t slot = (uint32_t)(((uintptr_t)func >> 2) * 2654435761u) % LV_PROFILER_NAME_SLOTS;
+    for(uint32_t probe = 0; probe < LV_PROFILER_NAME_SLOTS; probe++) {
+        lv_profiler_builtin_name_t * name = &profiler_ctx->name_arr[slot];
+        if(name->func == func) return name->id;
+        if(name->func == NULL) {
+            /*Keep the table at most half full, the probes stay short*/
+            if(profiler_ctx->name_cnt >= LV_PROFILER_NAME_SLOTS / 2) return LV_PROFILER_NAME_NONE;
+
+            name->func = func;
+            name->id = (uint16_t)profiler_ctx->name_cnt++;
+
+            uint32_t len = lv_strlen(func);
+            if(len > 255) len = 255;
+            if(bin->len + LV_PROFILER_BUILTIN_BIN_RECORD_SIZE + len > sizeof(bin->data)) bin_flush(bin);
+            bin_record(bin, 'N', (uint8_t)len, name->id, 0);
+            if(bin->len + len > sizeof(bin->data)) {
+                bin_flush(bin);
+                profiler_ctx->config.flush_bin_cb(func, len);
+            }
+            else {
+                lv_memcpy(&bin->data[bin->len], func, len);
+                bin->len += len;
+            }
+            return name->id;
+        }
+        slot = (slot + 1) % LV_PROFILER_NAME_SLOTS;
+    }
+    return LV_PROFILER_NAME_NONE;
+}
+
 #endif /*LV_USE_PROFILER_BUILTIN*/
@@ -29,6 +29,24 @@ extern "C" {
 #define LV_PROFILER_BUILTIN_BEGIN           LV_PROFILER_BUILTIN_BEGIN_TAG(__func__)
 #define LV_PROFILER_BUILTIN_END             LV_PROFILER_BUILTIN_END_TAG(__func__)
 
+/**
+ * Binary trace stream, written to `flush_bin_cb` when it is set. All fields are little-endian.
+ * The stream starts with a 12 byte header: the magic "LVPT", the version byte, 3 reserved bytes
+ * and `tick_per_sec` as uint32. It is followed by 8 byte records, the first byte being the type:
+ *  - 'B' / 'E':  uint8 CPU, uint16 name id, uint32 tick. Begin / end of a trace point
+ *                on the thread selected by the last 'T' record.
+ *  - 'T':        uint8 thread index, uint16 reserved, int32 thread ID (`tid_get_cb`).
+ *  - 'N':        uint8 name length, uint16 name id, uint32 reserved, then the name bytes.
+ *                Sent once, before the first event using the id.
+ *  - 'D':        uint8 thread index (0xFF: threads over the limit), uint16 reserved,
+ *                uint32 number of events dropped since the last 'D' because the ring was full.
+ * Ticks are 32 bit and wrap around.
+ */
+#define LV_PROFILER_BUILTIN_BIN_MAGIC       "LVPT"
+#define LV_PROFILER_BUILTIN_BIN_VERSION     1
+#define LV_PROFILER_BUILTIN_BIN_HEADER_SIZE 12
+#define LV_PROFILER_BUILTIN_BIN_RECORD_SIZE 8
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -46,11 +64,15 @@ void lv_profiler_builtin_config_init(lv_profiler_builtin_config_t * config);
 /**
  * @brief Initialize the built-in profiler with the given configuration
  * @param config Pointer to the configuration structure of the built-in profiler
+ * @note Calling it again while the profiler runs only restarts the output: the recorded items are dropped,
+ *       the new callbacks are taken and the header is sent again.
+ *       The buffer is kept with its old size, as other threads may be recording meanwhile.
  */
 void lv_profiler_builtin_init(const lv_profiler_builtin_config_t * config);
 
 /**
  * @brief Uninitialize the built-in profiler
+ * @note It frees the buffer, call it only when no other thread records anymore
  */
 void lv_profiler_builtin_uninit(void);
 
@@ -61,13 +83,16 @@ void lv_profiler_builtin_uninit(void);
 void lv_profiler_builtin_set_enable(bool enable);
 
 /**
- * @brief Flush the profiling data to the console
+ * @brief Flush the recorded events of all threads to `flush_bin_cb` or `flush_cb`.
+ * Recording does not wait for this: when a thread's ring is full its new events are dropped and counted.
+ * Safe to call from any thread, concurrently with recording.
  */
 void lv_profiler_builtin_flush(void);
 
 /**
- * @brief Write the profiling data for a function with the given tag
- * @param func Name of the function being profiled
+ * @brief Write the profiling data for a function with the given tag.
+ * Lock-free: each thread appends to its own ring, which is claimed on the first write.
+ * @param func Name of the function being profiled, must stay valid (compared by address)
  * @param tag Tag to associate with the profiling data for the function
  */
 void lv_profiler_builtin_write(const char * func, char tag);
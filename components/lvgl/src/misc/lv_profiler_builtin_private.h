@@ -34,6 +34,8 @@ struct lv_profiler_builtin_config_t {
     uint32_t tick_per_sec;              /**< The number of ticks per second */
     uint32_t (*tick_get_cb)(void);      /**< Callback function to get the current tick count */
     void (*flush_cb)(const char * buf); /**< Callback function to flush the profiling data */
+    void (*flush_bin_cb)(const void * buf, uint32_t size); /**< If set, flush the binary trace stream
+                                                                 *   here instead of text to `flush_cb`*/
     int (*tid_get_cb)(void);            /**< Callback function to get the current thread ID */
     int (*cpu_get_cb)(void);            /**< Callback function to get the current CPU */
 };
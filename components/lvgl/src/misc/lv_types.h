@@ -150,6 +150,7 @@ typedef struct lv_draw_mask_t lv_draw_mask_t;
 typedef struct lv_grad_t lv_grad_t;
 
 typedef struct lv_draw_label_hint_t lv_draw_label_hint_t;
+typedef struct lv_draw_label_layout_t lv_draw_label_layout_t;
 
 typedef struct lv_draw_glyph_dsc_t lv_draw_glyph_dsc_t;
 
@@ -331,6 +332,7 @@ typedef struct lv_property_name_t lv_property_name_t;
 #if LV_USE_SYSMON
 
 typedef struct lv_sysmon_backend_data_t lv_sysmon_backend_data_t;
+typedef struct lv_sysmon_port_info_t lv_sysmon_port_info_t;
 
 #if LV_USE_PERF_MONITOR
 typedef struct lv_sysmon_perf_info_t lv_sysmon_perf_info_t;
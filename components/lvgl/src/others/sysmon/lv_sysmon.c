@@ -25,6 +25,10 @@
     #define LV_SYSMON_REFR_PERIOD_DEF 300 /* ms */
 #endif
 
+#ifndef LV_SYSMON_PORT_POS
+    #define LV_SYSMON_PORT_POS LV_ALIGN_TOP_RIGHT
+#endif
+
 #if LV_USE_MEM_MONITOR
     #define sysmon_mem LV_GLOBAL_DEFAULT()->sysmon_mem
 #endif
@@ -48,6 +52,10 @@
     static void mem_observer_cb(lv_observer_t * observer, lv_subject_t * subject);
 #endif
 
+static void port_update_timer_cb(lv_timer_t * t);
+static void port_observer_cb(lv_observer_t * observer, lv_subject_t * subject);
+static void port_monitor_disp_event_cb(lv_event_t * e);
+
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -172,10 +180,90 @@ void lv_sysmon_hide_memory(lv_display_t * disp)
 
 #endif
 
+void lv_sysmon_show_port(lv_display_t * disp, lv_sysmon_port_cb_t cb, void * user_data, bool log_mode)
+{
+    LV_ASSERT_NULL(cb);
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL) {
+        LV_LOG_WARN("There is no default display");
+        return;
+    }
+
+    lv_sysmon_port_info_t * info = &disp->port_sysmon_info;
+    info->cb = cb;
+    info->user_data = user_data;
+    info->log_mode = log_mode;
+
+    if(disp->port_label == NULL) {
+        disp->port_label = lv_sysmon_create(disp);
+        if(disp->port_label == NULL) {
+            LV_LOG_WARN("Couldn't create sysmon");
+            return;
+        }
+
+        lv_subject_init_pointer(&disp->port_sysmon_backend.subject, info);
+        lv_obj_align(disp->port_label, LV_SYSMON_PORT_POS, 0, 0);
+        lv_subject_add_observer_obj(&disp->port_sysmon_backend.subject, port_observer_cb, disp->port_label, NULL);
+        disp->port_sysmon_backend.timer = lv_timer_create(port_update_timer_cb, LV_SYSMON_REFR_PERIOD_DEF, disp);
+        lv_display_add_event_cb(disp, port_monitor_disp_event_cb, LV_EVENT_DELETE, NULL);
+    }
+    else {
+        lv_timer_resume(disp->port_sysmon_backend.timer);
+    }
+
+    if(log_mode) lv_obj_add_flag(disp->port_label, LV_OBJ_FLAG_HIDDEN);
+    else lv_obj_remove_flag(disp->port_label, LV_OBJ_FLAG_HIDDEN);
+}
+
+void lv_sysmon_hide_port(lv_display_t * disp)
+{
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL) {
+        LV_LOG_WARN("There is no default display");
+        return;
+    }
+
+    if(disp->port_label == NULL) return;
+
+    lv_obj_add_flag(disp->port_label, LV_OBJ_FLAG_HIDDEN);
+    lv_timer_pause(disp->port_sysmon_backend.timer);
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
+static void port_monitor_disp_event_cb(lv_event_t * e)
+{
+    lv_display_t * disp = lv_event_get_target(e);
+    lv_timer_delete(disp->port_sysmon_backend.timer);
+    lv_subject_deinit(&disp->port_sysmon_backend.subject);
+}
+
+static void port_update_timer_cb(lv_timer_t * t)
+{
+    lv_display_t * disp = lv_timer_get_user_data(t);
+    lv_sysmon_port_info_t * info = &disp->port_sysmon_info;
+
+    info->text[0] = '\0';
+    info->cb(info->text, sizeof(info->text), info->user_data);
+    info->text[sizeof(info->text) - 1] = '\0';
+    lv_subject_set_pointer(&disp->port_sysmon_backend.subject, info);
+}
+
+static void port_observer_cb(lv_observer_t * observer, lv_subject_t * subject)
+{
+    const lv_sysmon_port_info_t * info = lv_subject_get_pointer(subject);
+    if(info->text[0] == '\0') return; /*Not formatted yet*/
+
+    if(info->log_mode) {
+        LV_LOG("sysmon: %s\n", info->text);
+    }
+    else {
+        lv_label_set_text(lv_observer_get_target(observer), info->text);
+    }
+}
+
 #if LV_USE_PERF_MONITOR
 
 static void perf_monitor_disp_event_cb(lv_event_t * e)
@@ -31,10 +31,20 @@ extern "C" {
  *      DEFINES
  *********************/
 
+#define LV_SYSMON_PORT_TEXT_MAX 160
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+/**
+ * Format the text of the port monitor. Called once per refresh period.
+ * @param buf       write the text here, at most `buf_size` bytes with the terminating 0
+ * @param buf_size  size of `buf`
+ * @param user_data the `user_data` passed to `lv_sysmon_show_port`
+ */
+typedef void (*lv_sysmon_port_cb_t)(char * buf, uint32_t buf_size, void * user_data);
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -78,6 +88,21 @@ void lv_sysmon_hide_memory(lv_display_t * disp);
 
 #endif /*LV_USE_MEM_MONITOR*/
 
+/**
+ * Show a monitor with statistics of the display/input port (e.g. bus load), formatted by a callback
+ * @param disp      target display, NULL: use the default displays
+ * @param cb        formats the text once per refresh period
+ * @param user_data passed to `cb`
+ * @param log_mode  true: print the text with `LV_LOG` instead of showing it on a label
+ */
+void lv_sysmon_show_port(lv_display_t * disp, lv_sysmon_port_cb_t cb, void * user_data, bool log_mode);
+
+/**
+ * Hide the port monitor and stop calling its callback
+ * @param disp      target display, NULL: use the default displays
+ */
+void lv_sysmon_hide_port(lv_display_t * disp);
+
 /**********************
  *      MACROS
  **********************/
@@ -31,6 +31,13 @@ struct lv_sysmon_backend_data_t {
     lv_timer_t * timer;
 };
 
+struct lv_sysmon_port_info_t {
+    lv_sysmon_port_cb_t cb;
+    void * user_data;
+    bool log_mode;
+    char text[LV_SYSMON_PORT_TEXT_MAX];
+};
+
 #if LV_USE_PERF_MONITOR
 struct lv_sysmon_perf_info_t {
     struct {
@@ -49,6 +49,7 @@ static void draw_main(lv_event_t * e);
 
 static void lv_label_refr_text(lv_obj_t * obj);
 static void lv_label_revert_dots(lv_obj_t * label);
+static void lv_label_invalidate_layout(lv_obj_t * obj);
 
 static bool lv_label_set_dot_tmp(lv_obj_t * label, char * data, uint32_t len);
 static char * lv_label_get_dot_tmp(lv_obj_t * label);
@@ -172,6 +173,7 @@ void lv_label_set_text(lv_obj_t * obj, const char * text)
         label->static_txt = 0;
     }
 
+    lv_label_invalidate_layout(obj);
     lv_label_refr_text(obj);
 }
 
@@ -185,6 +187,7 @@ void lv_label_set_text_fmt(lv_obj_t * obj, const char * fmt, ...)
 
     /*If text is NULL then refresh*/
     if(fmt == NULL) {
+        lv_label_invalidate_layout(obj);
         lv_label_refr_text(obj);
         return;
     }
@@ -200,6 +203,7 @@ void lv_label_set_text_fmt(lv_obj_t * obj, const char * fmt, ...)
     va_end(args);
     label->static_txt = 0; /*Now the text is dynamically allocated*/
 
+    lv_label_invalidate_layout(obj);
     lv_label_refr_text(obj);
 }
 
@@ -218,6 +222,8 @@ void lv_label_set_text_static(lv_obj_t * obj, const char * text)
         label->text       = (char *)text;
     }
 
+    /*The same static text might have been modified*/
+    lv_label_invalidate_layout(obj);
     lv_label_refr_text(obj);
 }
 
@@ -666,6 +672,7 @@ void lv_label_cut_text(lv_obj_t * obj, uint32_t pos, uint32_t cnt)
     lv_text_cut(label_txt, pos, cnt);
 
     /*Refresh the label*/
+    lv_label_invalidate_layout(obj);
     lv_label_refr_text(obj);
 }
 
@@ -714,6 +721,10 @@ static void lv_label_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     lv_label_dot_tmp_free(obj);
     if(!label->static_txt) lv_free(label->text);
     label->text = NULL;
+
+#if LV_LABEL_LAYOUT_CACHE
+    lv_draw_label_layout_reset(&label->layout);
+#endif
 }
 
 static void lv_label_event(const lv_obj_class_t * class_p, lv_event_t * e)
@@ -793,6 +804,11 @@ static void draw_main(lv_event_t * e)
 
     label_draw_dsc.flag = flag;
     lv_obj_init_draw_label_dsc(obj, LV_PART_MAIN, &label_draw_dsc);
+#if LV_LABEL_LAYOUT_CACHE
+    lv_draw_label_layout_update(&label->layout, label->text, label_draw_dsc.font, label_draw_dsc.letter_space,
+                                lv_area_get_width(&txt_coords), flag);
+    label_draw_dsc.layout = &label->layout;
+#endif
     lv_bidi_calculate_align(&label_draw_dsc.align, &label_draw_dsc.bidi_dir, label->text);
 
     label_draw_dsc.sel_start = lv_label_get_text_selection_start(obj);
@@ -913,7 +929,17 @@ static void lv_label_refr_text(lv_obj_t * obj)
     lv_point_t size;
     lv_text_flag_t flag = get_label_flags(label);
 
+#if LV_LABEL_LAYOUT_CACHE
+    lv_draw_label_layout_update(&label->layout, label->text, font, letter_space, max_w, flag);
+    if(lv_draw_label_layout_is_valid(&label->layout, label->text, font, letter_space, max_w, flag)) {
+        lv_draw_label_layout_get_size(&label->layout, line_space, &size);
+    }
+    else {
+        lv_text_get_size(&size, label->text, font, letter_space, line_space, max_w, flag);
+    }
+#else
     lv_text_get_size(&size, label->text, font, letter_space, line_space, max_w, flag);
+#endif
 
     lv_obj_refresh_self_size(obj);
 
@@ -1165,6 +1191,7 @@ static void lv_label_refr_text(lv_obj_t * obj)
                 }
                 label->text[byte_id_ori + LV_LABEL_DOT_NUM] = '\0';
                 label->dot_end                              = letter_id + LV_LABEL_DOT_NUM;
+                lv_label_invalidate_layout(obj);
             }
         }
     }
@@ -1197,6 +1224,22 @@ static void lv_label_revert_dots(lv_obj_t * obj)
     lv_label_dot_tmp_free(obj);
 
     label->dot_end = LV_LABEL_DOT_END_INV;
+    lv_label_invalidate_layout(obj);
+}
+
+/**
+ * Mark the cached layout of the text invalid. Needs to be called if the text is modified
+ * as the text pointer might remain the same.
+ * @param obj   pointer to a label object
+ */
+static void lv_label_invalidate_layout(lv_obj_t * obj)
+{
+#if LV_LABEL_LAYOUT_CACHE
+    lv_label_t * label = (lv_label_t *)obj;
+    lv_draw_label_layout_invalidate(&label->layout);
+#else
+    LV_UNUSED(obj);
+#endif
 }
 
 /**
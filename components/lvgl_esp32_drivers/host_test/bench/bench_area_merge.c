@@ -0,0 +1,219 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "lvgl_port.h"
+#include "area_merge.h"
+#include "spi_sim.h"
+#include "esp_timer.h"
+#include "src/misc/lv_area_private.h"
+#include "src/display/lv_display_private.h"
+
+// 脏区域合并基准：先录制遥测界面每帧的失效区域序列，再用不同的合并策略回放
+//   lvgl   LVGL自带：去掉被包含的区域，超过LV_INV_BUF_SIZE个后整屏刷新，刷新前按面积两两合并
+//   cost   lvgl_port：缓冲区满时按代价合并腾出一半位置，刷新前再按代价合并一次
+//   whole  一次合并整帧的全部区域，即失效区域缓冲区足够大时cost的结果
+// 按代价模型（每个区域固定开销 + 每像素开销）统计每帧的区域数、像素数和预计耗时，以及合并本身的CPU时间
+
+#define COLS            8
+#define ROWS            15
+#define FRAMES          60
+#define MAX_INV         1024        // 每帧录制的失效区域上限
+#define MERGE_ROUNDS    20          // 每条轨迹回放的次数，用于测CPU时间
+
+// 与lvgl_port模型建立前的默认值相同：每个区域100us，每像素为40MHz下16位的线上时间
+static const area_merge_cost_t cost = {.window_ns = LV_PORT_AREA_FIXED_US * 1000, .px_ns = 400};
+
+typedef enum {
+    MERGE_LVGL,
+    MERGE_COST,
+    MERGE_WHOLE,
+} merge_mode_t;
+
+typedef struct {
+    uint32_t cnt;
+    lv_area_t areas[MAX_INV];
+} inv_trace_t;
+
+static inv_trace_t traces[FRAMES];
+static inv_trace_t *recording;      // 正在录制的帧，NULL表示不录制
+
+static const lv_area_t screen = {0, 0, LV_HOR_RES_MAX - 1, LV_VER_RES_MAX - 1};
+
+/**
+ * @brief 录制LVGL收到的每个失效区域（已裁剪到屏幕内）
+ */
+static void record_cb(lv_event_t *e)
+{
+    if (recording != NULL && recording->cnt < MAX_INV) {
+        recording->areas[recording->cnt++] = *(const lv_area_t *)lv_event_get_param(e);
+    }
+}
+
+/**
+ * @brief lv_refr.c中lv_refr_join_area的算法
+ */
+static uint32_t lvgl_join(lv_area_t *areas, uint32_t cnt)
+{
+    uint8_t joined[LV_INV_BUF_SIZE] = {0};
+    lv_area_t tmp;
+    for (uint32_t in = 0; in < cnt; in++) {
+        if (joined[in]) continue;
+        for (uint32_t from = 0; from < cnt; from++) {
+            if (joined[from] || in == from) continue;
+            if (!lv_area_is_on(&areas[in], &areas[from])) continue;
+            lv_area_join(&tmp, &areas[in], &areas[from]);
+            if (lv_area_get_size(&tmp) < lv_area_get_size(&areas[in]) + lv_area_get_size(&areas[from])) {
+                areas[in] = tmp;
+                joined[from] = 1;
+            }
+        }
+    }
+    uint32_t out = 0;
+    for (uint32_t i = 0; i < cnt; i++) {
+        if (!joined[i]) areas[out++] = areas[i];
+    }
+    return out;
+}
+
+/**
+ * @brief 按lv_refr.c中lv_inv_area的方式逐个加入区域，再按策略在刷新前合并
+ * @param trace 一帧的失效区域
+ * @param out 合并结果，至少MAX_INV个
+ * @param mode 合并策略
+ * @param full_screen 输出是否退化为整屏
+ * @return 结果区域数
+ */
+static uint32_t replay(const inv_trace_t *trace, lv_area_t *out, merge_mode_t mode, bool *full_screen)
+{
+    uint32_t cnt = 0;
+    *full_screen = false;
+
+    if (mode == MERGE_WHOLE) {
+        for (uint32_t i = 0; i < trace->cnt; i++) out[i] = trace->areas[i];
+        return area_merge(out, trace->cnt, trace->cnt, &cost);
+    }
+
+    for (uint32_t i = 0; i < trace->cnt; i++) {
+        const lv_area_t *a = &trace->areas[i];
+        bool inside = false;
+        for (uint32_t j = 0; j < cnt && !inside; j++) {
+            inside = lv_area_is_in(a, &out[j], 0);
+        }
+        if (inside) continue;
+
+        if (cnt >= LV_INV_BUF_SIZE && mode == MERGE_COST) {
+            cnt = area_merge(out, cnt, LV_INV_BUF_SIZE / 2, &cost);
+        }
+        if (cnt >= LV_INV_BUF_SIZE) {
+            cnt = 0;
+            a = &screen;
+            *full_screen = true;
+        }
+        out[cnt++] = *a;
+    }
+    return mode == MERGE_COST ? area_merge(out, cnt, cnt, &cost) : lvgl_join(out, cnt);
+}
+
+/**
+ * @brief 回放全部帧并输出统计
+ * @return 0表示每帧的结果都覆盖了全部失效区域
+ */
+static int run_strategy(const char *trace_name, const char *name, merge_mode_t mode)
+{
+    static lv_area_t out[MAX_INV];
+    uint64_t windows = 0, px = 0, model_ns = 0, inputs = 0;
+    uint32_t fallbacks = 0;
+    int failed = 0;
+
+    for (int f = 0; f < FRAMES; f++) {
+        bool full;
+        uint32_t cnt = replay(&traces[f], out, mode, &full);
+        inputs += traces[f].cnt;
+        windows += cnt;
+        fallbacks += full;
+        model_ns += area_merge_total_cost(out, cnt, &cost);
+        for (uint32_t i = 0; i < cnt; i++) px += lv_area_get_size(&out[i]);
+
+        for (uint32_t i = 0; i < traces[f].cnt; i++) {
+            bool covered = false;
+            for (uint32_t j = 0; j < cnt && !covered; j++) {
+                covered = lv_area_is_in(&traces[f].areas[i], &out[j], 0);
+            }
+            if (!covered) {
+                printf("[bench_area_merge] %s/%s: frame %d area %u not covered\n", trace_name, name, f, (unsigned)i);
+                failed = 1;
+                break;
+            }
+        }
+    }
+
+    int64_t start = esp_timer_get_time();
+    for (int r = 0; r < MERGE_ROUNDS; r++) {
+        for (int f = 0; f < FRAMES; f++) {
+            bool full;
+            replay(&traces[f], out, mode, &full);
+        }
+    }
+    double cpu_us = (double)(esp_timer_get_time() - start) / (MERGE_ROUNDS * FRAMES);
+
+    printf("[bench_area_merge] %-9s %-5s %6.1f inv -> %5.1f areas %7.0f px  model %6.2f ms  merge %6.1f us  "
+           "full-screen %u/%d\n", trace_name, name, (double)inputs / FRAMES, (double)windows / FRAMES,
+           (double)px / FRAMES, model_ns / 1e6 / FRAMES, cpu_us, (unsigned)fallbacks, FRAMES);
+    return failed;
+}
+
+/**
+ * @brief 录制一条轨迹：每帧随机改写部分读数标签的文本
+ * @param labels 标签
+ * @param percent 每帧更新的标签比例
+ */
+static void record(lv_obj_t **labels, int percent)
+{
+    for (int f = 0; f < FRAMES; f++) {
+        traces[f].cnt = 0;
+        recording = &traces[f];
+        for (int i = 0; i < COLS * ROWS; i++) {
+            if (rand() % 100 < percent) {
+                lv_label_set_text_fmt(labels[i], "%d", rand() % (rand() % 2 ? 100 : 100000));
+            }
+        }
+        lv_refr_now(NULL);
+        recording = NULL;
+    }
+}
+
+int main(void)
+{
+    static lv_obj_t *labels[COLS * ROWS];
+    int failed = 0;
+
+    lv_port_init();
+    spi_sim_set_time_scale(0);
+    spi_sim_set_bypass(LCD_SPI_HOST, true);
+
+    // 遥测界面：COLS x ROWS个读数标签，宽度随内容变化
+    lv_obj_t *scr = lv_screen_active();
+    for (int i = 0; i < COLS * ROWS; i++) {
+        labels[i] = lv_label_create(scr);
+        lv_obj_set_pos(labels[i], (i % COLS) * (LV_HOR_RES_MAX / COLS), (i / COLS) * (LV_VER_RES_MAX / ROWS));
+        lv_label_set_text(labels[i], "0");
+    }
+    lv_display_add_event_cb(lv_display_get_default(), record_cb, LV_EVENT_INVALIDATE_AREA, NULL);
+    lv_refr_now(NULL);
+
+    static const struct {
+        const char *name;
+        int percent;
+    } loads[] = {
+        {"sparse", 10},
+        {"telemetry", 50},
+        {"all", 100},
+    };
+    srand(1);
+    for (size_t i = 0; i < sizeof(loads) / sizeof(loads[0]); i++) {
+        record(labels, loads[i].percent);
+        failed |= run_strategy(loads[i].name, "lvgl", MERGE_LVGL);
+        failed |= run_strategy(loads[i].name, "cost", MERGE_COST);
+        failed |= run_strategy(loads[i].name, "whole", MERGE_WHOLE);
+    }
+    return failed;
+}
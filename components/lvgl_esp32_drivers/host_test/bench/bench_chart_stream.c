@@ -0,0 +1,109 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "lvgl_port.h"
+#include "chart_stream.h"
+#include "spi_sim.h"
+#include "esp_timer.h"
+
+// 高速曲线基准：10000个样本的曲线，比较lv_chart自带的曲线和数据流曲线（chart_stream.h）
+//   insert  追加一个样本的耗时（含失效区域登记，不刷新）
+//   draw    按500Hz采样、30fps刷新，每帧追加17个样本后刷新一帧的CPU时间，以及每帧发送的像素数
+//   full    整个图表重绘一次的CPU时间（lv_chart遍历全部样本，数据流曲线每列一条线）
+// SPI仿真为直通模式，不计总线时间
+
+#define CAPACITY        10000
+#define SAMPLES_FRAME   17
+#define FRAMES          60
+#define INSERTS         (CAPACITY * 5)
+
+static lv_obj_t *chart;
+static lv_chart_series_t *series;
+static chart_stream_t stream;
+static int32_t phase;
+
+static int32_t next_sample(void)
+{
+    phase++;
+    return 500 + (phase % 200) - 100 + (rand() % 40 == 0 ? rand() % 400 - 200 : 0);
+}
+
+static void push(bool use_stream)
+{
+    if (use_stream) {
+        chart_stream_push(&stream, next_sample());
+    } else {
+        lv_chart_set_next_value(chart, series, next_sample());
+    }
+}
+
+static void setup(bool use_stream, lv_chart_update_mode_t mode)
+{
+    chart = lv_chart_create(lv_screen_active());
+    lv_obj_set_size(chart, LV_HOR_RES_MAX - 20, LV_VER_RES_MAX - 40);
+    lv_obj_center(chart);
+    lv_chart_set_range(chart, LV_CHART_AXIS_PRIMARY_Y, 0, 1000);
+    lv_chart_set_update_mode(chart, mode);
+    if (use_stream) {
+        lv_chart_set_point_count(chart, 2);
+        chart_stream_init(&stream, chart, lv_palette_main(LV_PALETTE_RED), LV_CHART_AXIS_PRIMARY_Y, CAPACITY);
+    } else {
+        lv_chart_set_point_count(chart, CAPACITY);
+        series = lv_chart_add_series(chart, lv_palette_main(LV_PALETTE_RED), LV_CHART_AXIS_PRIMARY_Y);
+    }
+    srand(1);
+    phase = 0;
+    for (int i = 0; i < CAPACITY; i++) push(use_stream);
+    lv_refr_now(NULL);
+}
+
+static void run(bool use_stream, lv_chart_update_mode_t mode)
+{
+    const char *name = use_stream ? "chart_stream" : "lv_chart";
+    const char *mode_name = mode == LV_CHART_UPDATE_MODE_SHIFT ? "shift" : "circular";
+
+    setup(use_stream, mode);
+
+    int64_t start = esp_timer_get_time();
+    for (int i = 0; i < INSERTS; i++) push(use_stream);
+    double insert_ns = (esp_timer_get_time() - start) * 1000.0 / INSERTS;
+    lv_refr_now(NULL);
+
+    lv_port_stripe_stats_t stats;
+    lv_port_reset_stripe_stats();
+    int64_t draw_us = 0;
+    for (int f = 0; f < FRAMES; f++) {
+        for (int i = 0; i < SAMPLES_FRAME; i++) push(use_stream);
+        start = esp_timer_get_time();
+        lv_refr_now(NULL);
+        draw_us += esp_timer_get_time() - start;
+    }
+    lv_port_get_stripe_stats(&stats);
+
+    int64_t full_us = 0;
+    for (int f = 0; f < FRAMES; f++) {
+        lv_obj_invalidate(chart);
+        start = esp_timer_get_time();
+        lv_refr_now(NULL);
+        full_us += esp_timer_get_time() - start;
+    }
+
+    printf("[bench_chart_stream] %-12s %-8s insert %6.1f ns/sample  draw %7.1f us/frame  sent %6.0f px/frame  "
+           "full %7.1f us\n", name, mode_name, insert_ns, (double)draw_us / FRAMES, stats.bytes_sent / 2.0 / FRAMES,
+           (double)full_us / FRAMES);
+
+    if (use_stream) chart_stream_deinit(&stream);
+    lv_obj_delete(chart);
+}
+
+int main(void)
+{
+    lv_port_init();
+    spi_sim_set_time_scale(0);
+    spi_sim_set_bypass(LCD_SPI_HOST, true);
+
+    run(false, LV_CHART_UPDATE_MODE_SHIFT);
+    run(true, LV_CHART_UPDATE_MODE_SHIFT);
+    run(false, LV_CHART_UPDATE_MODE_CIRCULAR);
+    run(true, LV_CHART_UPDATE_MODE_CIRCULAR);
+    return 0;
+}
@@ -0,0 +1,71 @@
+#include <stdio.h>
+#include "disp_spi.h"
+#include "spi_sim.h"
+#include "esp_timer.h"
+
+// 微基准：disp_spi队列事务的驱动侧开销
+// SPI仿真设为直通模式，事务排队即完成，测得的只有事务池/队列、构造和回收的开销
+
+#define ROUNDS          200000
+#define STRIPE_BYTES    (DISP_BUF_SIZE * 2)
+
+static uint8_t stripe[STRIPE_BYTES];
+
+/**
+ * @brief 统计一段事务的平均开销
+ * @return 0表示完成的事务数与预期一致
+ */
+static int report(const char *name, int64_t start_us, uint32_t trans_before, uint32_t expected, uint32_t ops)
+{
+    spi_sim_stats_t stats;
+    int64_t elapsed_us = esp_timer_get_time() - start_us;
+
+    spi_sim_get_stats(LCD_SPI_HOST, &stats);
+    uint32_t done = stats.trans_count - trans_before;
+    printf("[bench_disp_spi] %-14s %8u trans  %7.1f ns/trans  %7.1f ns/op\n", name, (unsigned)done,
+           elapsed_us * 1000.0 / done, elapsed_us * 1000.0 / ops);
+    if (done != expected) {
+        printf("[bench_disp_spi] %s: expected %u transactions, got %u\n", name, (unsigned)expected, (unsigned)done);
+        return 1;
+    }
+    return 0;
+}
+
+int main(void)
+{
+    static const uint8_t window[4] = {0x00, 0x00, 0x01, 0x3F};
+    spi_sim_stats_t stats;
+    int64_t start;
+    int failed = 0;
+
+    disp_spi_init();
+    spi_sim_set_time_scale(0);
+    spi_sim_set_bypass(LCD_SPI_HOST, true);
+
+    // 预热：填满并回收一轮事务
+    for (int i = 0; i < 64; i++) disp_spi_queue_cmd(0x2A, window, 4);
+    disp_wait_for_pending_transactions();
+
+    // 单条命令+4字节参数（窗口设置的基本单元）
+    spi_sim_get_stats(LCD_SPI_HOST, &stats);
+    start = esp_timer_get_time();
+    for (int i = 0; i < ROUNDS; i++) {
+        disp_spi_queue_cmd(0x2A, window, 4);
+    }
+    disp_wait_for_pending_transactions();
+    failed |= report("cmd+param", start, stats.trans_count, ROUNDS * 2, ROUNDS);
+
+    // 完整的一块刷新：CASET/PASET/RAMWR + 颜色数据，共6个事务
+    spi_sim_get_stats(LCD_SPI_HOST, &stats);
+    start = esp_timer_get_time();
+    for (int i = 0; i < ROUNDS / 6; i++) {
+        disp_spi_queue_cmd(0x2A, window, 4);
+        disp_spi_queue_cmd(0x2B, window, 4);
+        disp_spi_queue_cmd(0x2C, NULL, 0);
+        disp_spi_send_colors(stripe, STRIPE_BYTES);
+    }
+    disp_wait_for_pending_transactions();
+    failed |= report("stripe flush", start, stats.trans_count, ROUNDS / 6 * 6, ROUNDS / 6);
+
+    return failed;
+}
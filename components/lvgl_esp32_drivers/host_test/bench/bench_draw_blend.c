@@ -0,0 +1,132 @@
+#include <stdio.h>
+#include <string.h>
+#include "lvgl.h"
+#include "disp_spi.h"
+#include "esp_timer.h"
+#include "../test_cases/blend_ref.h"
+#include "src/draw/sw/blend/swar/lv_blend_swar.h"
+
+// RGB565混合内核的吞吐量：LVGL参考循环与SWAR实现，每个内核处理一个显示条带（DISP_BUF_SIZE像素）
+// 目标为噪声图像（不利于参考循环的相同像素缓存），遮罩为圆角矩形的抗锯齿边缘：大部分全覆盖或全透明
+// 每个内核先校验两种实现的结果逐位一致，不一致时返回1
+
+#define STRIPE_W        320
+#define STRIPE_H        (DISP_BUF_SIZE / STRIPE_W)
+#define STRIPE_PX       (STRIPE_W * STRIPE_H)
+#define TARGET_US       200000      // 每种实现的测量时长
+
+static uint16_t background[STRIPE_PX];
+static uint16_t dest_ref[STRIPE_PX];
+static uint16_t dest_swar[STRIPE_PX];
+static uint16_t src[STRIPE_PX];
+static lv_opa_t mask[STRIPE_PX];
+
+typedef enum {
+    KIND_FILL,
+    KIND_IMAGE,
+} kernel_kind_t;
+
+typedef struct {
+    const char *name;
+    kernel_kind_t kind;
+    lv_opa_t opa;
+    bool masked;
+    lv_result_t (*swar_fill)(lv_draw_sw_blend_fill_dsc_t *dsc);
+    lv_result_t (*swar_image)(lv_draw_sw_blend_image_dsc_t *dsc);
+} kernel_t;
+
+static const kernel_t kernels[] = {
+    { "fill",                 KIND_FILL,  LV_OPA_COVER, false, lv_color_blend_to_rgb565_swar, NULL },
+    { "fill opa",             KIND_FILL,  LV_OPA_50,    false, lv_color_blend_to_rgb565_with_opa_swar, NULL },
+    { "fill mask",            KIND_FILL,  LV_OPA_COVER, true,  lv_color_blend_to_rgb565_with_mask_swar, NULL },
+    { "fill mask opa",        KIND_FILL,  LV_OPA_50,    true,  lv_color_blend_to_rgb565_mix_mask_opa_swar, NULL },
+    { "rgb565 image opa",     KIND_IMAGE, LV_OPA_50,    false, NULL, lv_rgb565_blend_normal_to_rgb565_with_opa_swar },
+    { "rgb565 image mask",    KIND_IMAGE, LV_OPA_COVER, true,  NULL, lv_rgb565_blend_normal_to_rgb565_with_mask_swar },
+    { "rgb565 image mask opa", KIND_IMAGE, LV_OPA_50,   true,  NULL, lv_rgb565_blend_normal_to_rgb565_mix_mask_opa_swar },
+};
+
+static void init_buffers(void)
+{
+    uint32_t seed = 1;
+    for (int i = 0; i < STRIPE_PX; i++) {
+        seed = seed * 1103515245u + 12345u;
+        background[i] = (uint16_t)(seed >> 16);
+        seed = seed * 1103515245u + 12345u;
+        src[i] = (uint16_t)(seed >> 16);
+    }
+
+    // 半径为条带高度的圆角：每行左右两端各一段抗锯齿过渡，中间全覆盖，外侧全透明
+    for (int y = 0; y < STRIPE_H; y++) {
+        for (int x = 0; x < STRIPE_W; x++) {
+            int d = x < STRIPE_W / 2 ? x : STRIPE_W - 1 - x;
+            int edge = 8 + (y * 3) % 24;
+            int v = (d - edge) * 64;
+            mask[y * STRIPE_W + x] = (lv_opa_t)(v <= 0 ? 0 : v >= 255 ? 255 : v);
+        }
+    }
+}
+
+static void run_kernel(const kernel_t *k, bool swar, uint16_t *dest)
+{
+    if (k->kind == KIND_FILL) {
+        lv_draw_sw_blend_fill_dsc_t dsc = {
+            .dest_buf = dest, .dest_w = STRIPE_W, .dest_h = STRIPE_H, .dest_stride = STRIPE_W * 2,
+            .mask_buf = k->masked ? mask : NULL, .mask_stride = STRIPE_W,
+            .color = lv_color_hex(0x3a7bd5), .opa = k->opa,
+        };
+        if (swar) k->swar_fill(&dsc);
+        else blend_ref_color_to_rgb565(&dsc);
+    }
+    else {
+        lv_draw_sw_blend_image_dsc_t dsc = {
+            .dest_buf = dest, .dest_w = STRIPE_W, .dest_h = STRIPE_H, .dest_stride = STRIPE_W * 2,
+            .mask_buf = k->masked ? mask : NULL, .mask_stride = STRIPE_W,
+            .src_buf = src, .src_stride = STRIPE_W * 2, .src_color_format = LV_COLOR_FORMAT_RGB565,
+            .opa = k->opa, .blend_mode = LV_BLEND_MODE_NORMAL,
+        };
+        if (swar) k->swar_image(&dsc);
+        else blend_ref_rgb565_to_rgb565(&dsc);
+    }
+}
+
+/**
+ * @brief 测量一种实现，返回百万像素/秒。每轮先恢复背景，恢复的时间不计入
+ */
+static double measure(const kernel_t *k, bool swar)
+{
+    uint16_t *dest = swar ? dest_swar : dest_ref;
+    int64_t spent = 0;
+    uint32_t rounds = 0;
+    while (spent < TARGET_US) {
+        memcpy(dest, background, sizeof(background));
+        int64_t start = esp_timer_get_time();
+        for (int i = 0; i < 16; i++) run_kernel(k, swar, dest);
+        spent += esp_timer_get_time() - start;
+        rounds += 16;
+    }
+    return (double)rounds * STRIPE_PX / spent;
+}
+
+int main(void)
+{
+    lv_init();
+    init_buffers();
+
+    int failures = 0;
+    for (size_t i = 0; i < sizeof(kernels) / sizeof(kernels[0]); i++) {
+        const kernel_t *k = &kernels[i];
+
+        memcpy(dest_ref, background, sizeof(background));
+        memcpy(dest_swar, background, sizeof(background));
+        run_kernel(k, false, dest_ref);
+        run_kernel(k, true, dest_swar);
+        bool same = memcmp(dest_ref, dest_swar, sizeof(dest_ref)) == 0;
+
+        double ref_mpx = measure(k, false);
+        double swar_mpx = measure(k, true);
+        printf("[bench_draw_blend] %-22s ref %8.1f Mpx/s  swar %8.1f Mpx/s  (%.2fx)%s\n",
+               k->name, ref_mpx, swar_mpx, swar_mpx / ref_mpx, same ? "" : "  PIXELS DIFFER");
+        if (!same) failures++;
+    }
+    return failures ? 1 : 0;
+}
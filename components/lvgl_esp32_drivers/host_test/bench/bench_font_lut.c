@@ -0,0 +1,125 @@
+#include <stdio.h>
+#include "lvgl_port.h"
+#include "esp_timer.h"
+#include "src/misc/lv_text_private.h"
+
+// 字体查找表基准：测量字符串的lv_text_get_size，比较关闭/启用查找表时每次测量的时间。
+// 测量不绘制，时间几乎全在逐字查找字形描述上
+//   cjk     lv_font_simsun_16_cjk的中文：在稀疏cmap里二分查找，建表后直接查表
+//   latin   lv_font_montserrat_14的英文：字形少不建表，启用时只多一次无锁的“不建表”判断，应与关闭时相当
+
+#define ROUNDS          2000
+#define MAX_WIDTH       200         // 换行测量的宽度
+#define REPEATS         9           // 关闭/启用交替测量的次数，各取最快的一次，减少主机负载的影响
+
+static const char *cjk_texts[] = {
+    "今天天气很好，我們去公園走走吧。",
+    "電池電壓正常，信息強度良好。",
+    "連接失敗，請重新試一次。",
+    "目前高度一百二十米，速度每分三百米。",
+    "飛行模式已開始",
+    "請查看網絡設定",
+    "系統時間",
+    "位置資訊更新中",
+    "高度 速度 電壓 電流 設定 返回",
+};
+
+static const char *latin_texts[] = {
+    "The weather is fine today, let's go for a walk.",
+    "Battery voltage normal, signal strength good.",
+    "Connection failed, please try again.",
+    "Altitude 120 m, climb rate 300 m/min.",
+    "Flight mode started",
+    "Check the network settings",
+    "System time",
+    "Updating position",
+    "ALT SPD VOLT AMP SETUP BACK",
+};
+
+/**
+ * @brief 一组测量：字体和它的字符串
+ */
+typedef struct {
+    const char *name;
+    const lv_font_t *font;
+    const char **texts;
+    size_t text_cnt;
+} text_set_t;
+
+static const text_set_t sets[] = {
+    { "cjk", &lv_font_simsun_16_cjk, cjk_texts, sizeof(cjk_texts) / sizeof(cjk_texts[0]) },
+    { "latin", &lv_font_montserrat_14, latin_texts, sizeof(latin_texts) / sizeof(latin_texts[0]) },
+};
+
+/**
+ * @brief 测量全部字符串ROUNDS轮，返回每次lv_text_get_size的时间（us）；总尺寸写入checksum
+ */
+static double run(const text_set_t *set, int32_t max_width, uint32_t *checksum)
+{
+    lv_point_t size;
+    uint32_t sum = 0;
+
+    int64_t start = esp_timer_get_time();
+    for (int r = 0; r < ROUNDS; r++) {
+        for (size_t i = 0; i < set->text_cnt; i++) {
+            lv_text_get_size(&size, set->texts[i], set->font, 0, 0, max_width, LV_TEXT_FLAG_NONE);
+            sum += (uint32_t)(size.x + size.y);
+        }
+    }
+    *checksum = sum;
+    return (double)(esp_timer_get_time() - start) / (ROUNDS * set->text_cnt);
+}
+
+/**
+ * @brief 字体中没有的字数（不算空格），有时测到的是占位符
+ */
+static uint32_t missing_letters(const text_set_t *set)
+{
+    uint32_t missing = 0;
+    for (size_t i = 0; i < set->text_cnt; i++) {
+        uint32_t ofs = 0;
+        uint32_t letter;
+        while ((letter = lv_text_encoded_next(set->texts[i], &ofs)) != 0) {
+            lv_font_glyph_dsc_t dsc;
+            if (letter != ' ' && (!lv_font_get_glyph_dsc(set->font, &dsc, letter, 0) || dsc.is_placeholder)) {
+                missing++;
+            }
+        }
+    }
+    return missing;
+}
+
+int main(void)
+{
+    lv_port_init();
+
+    int failures = 0;
+    for (size_t s = 0; s < sizeof(sets) / sizeof(sets[0]); s++) {
+        uint32_t missing = missing_letters(&sets[s]);
+        if (missing) {
+            printf("[bench_font_lut] %s: %u letters are missing from the font\n", sets[s].name, (unsigned)missing);
+            return 1;
+        }
+
+        const int32_t widths[] = { LV_COORD_MAX, MAX_WIDTH };
+        for (size_t w = 0; w < sizeof(widths) / sizeof(widths[0]); w++) {
+            uint32_t sum_off, sum_on;
+            double off_us = 0, on_us = 0;
+            for (int r = 0; r < REPEATS; r++) {
+                lv_font_fmt_txt_lut_set_enabled(false);
+                double us = run(&sets[s], widths[w], &sum_off);
+                if (r == 0 || us < off_us) off_us = us;
+                lv_font_fmt_txt_lut_set_enabled(true);
+                us = run(&sets[s], widths[w], &sum_on);
+                if (r == 0 || us < on_us) on_us = us;
+            }
+
+            printf("[bench_font_lut] %-5s lv_text_get_size %-9s off %6.2f us  on %6.2f us  (%.2fx)  "
+                   "table %u bytes%s\n", sets[s].name, widths[w] == LV_COORD_MAX ? "one line" : "wrapped",
+                   off_us, on_us, off_us / on_us, (unsigned)lv_font_fmt_txt_lut_get_size(),
+                   sum_off == sum_on ? "" : "  SIZES DIFFER");
+            if (sum_off != sum_on) failures++;
+        }
+    }
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,107 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lvgl_port.h"
+#include "spi_sim.h"
+#include "esp_timer.h"
+
+// 字形缓存基准：标签密集的遥测界面每帧改写全部读数，比较关闭/启用字形缓存时每帧的CPU时间（渲染和flush_cb）
+//   montserrat_14             A4字形，每次绘制展开为A8
+//   montserrat_28_compressed  RLE压缩的3bpp字形，每次绘制解压
+// 两种模式按相同的随机序列刷新（命中统计不含预热的第一帧），最后比较整屏快照，缓存不能改变任何像素。
+// SPI仿真为直通模式，不计总线时间
+
+#define COLS        6
+#define ROWS        10
+#define FRAMES      120
+
+typedef struct {
+    const char *name;
+    const lv_font_t *font;
+    int cols;
+    int rows;
+} font_case_t;
+
+static const font_case_t cases[] = {
+    { "montserrat_14", &lv_font_montserrat_14, COLS, ROWS },
+    { "montserrat_28_compressed", &lv_font_montserrat_28_compressed, COLS / 2, ROWS / 2 },
+};
+
+static lv_obj_t *labels[COLS * ROWS];
+
+/**
+ * @brief 按网格创建读数标签
+ */
+static int create_labels(const font_case_t *fc)
+{
+    lv_obj_t *scr = lv_screen_active();
+    lv_obj_clean(scr);
+    int32_t w = LV_HOR_RES_MAX / fc->cols;
+    int32_t h = LV_VER_RES_MAX / fc->rows;
+    int n = 0;
+    for (int r = 0; r < fc->rows; r++) {
+        for (int c = 0; c < fc->cols; c++) {
+            lv_obj_t *label = lv_label_create(scr);
+            lv_obj_set_style_text_font(label, fc->font, 0);
+            lv_obj_set_pos(label, c * w + 2, r * h);
+            labels[n++] = label;
+        }
+    }
+    return n;
+}
+
+/**
+ * @brief 刷新FRAMES帧，返回每帧的CPU时间（us）
+ */
+static double run(const font_case_t *fc, bool cache)
+{
+    lv_font_glyph_cache_resize(cache ? LV_PORT_GLYPH_CACHE_SIZE : 0, true);
+    lv_font_glyph_cache_drop();
+    int n = create_labels(fc);
+    srand(1);
+    for (int i = 0; i < n; i++) {
+        lv_label_set_text_fmt(labels[i], "%d.%d", rand() % 1000, rand() % 10);
+    }
+    lv_refr_now(NULL);
+    lv_font_glyph_cache_reset_stats();
+
+    int64_t start = esp_timer_get_time();
+    for (int f = 0; f < FRAMES; f++) {
+        for (int i = 0; i < n; i++) {
+            lv_label_set_text_fmt(labels[i], "%d.%d", rand() % 1000, rand() % 10);
+        }
+        lv_refr_now(NULL);
+    }
+    return (double)(esp_timer_get_time() - start) / FRAMES;
+}
+
+int main(void)
+{
+    lv_port_init();
+    spi_sim_set_time_scale(0);
+    spi_sim_set_bypass(LCD_SPI_HOST, true);
+
+    int failures = 0;
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        const font_case_t *fc = &cases[c];
+        lv_font_glyph_cache_stats_t stats;
+
+        double off_us = run(fc, false);
+        lv_draw_buf_t *off = lv_snapshot_take(lv_screen_active(), LV_COLOR_FORMAT_RGB565);
+        double on_us = run(fc, true);
+        lv_font_glyph_cache_get_stats(&stats);
+        lv_draw_buf_t *on = lv_snapshot_take(lv_screen_active(), LV_COLOR_FORMAT_RGB565);
+
+        bool same = off != NULL && on != NULL && off->data_size == on->data_size &&
+                    memcmp(off->data, on->data, off->data_size) == 0;
+        uint32_t lookups = stats.hits + stats.misses;
+        printf("[bench_glyph_cache] %-26s off %8.1f us/frame  on %8.1f us/frame  (%.2fx)  "
+               "hits %u misses %u (%.1f%%)  %u/%u bytes%s\n", fc->name, off_us, on_us, off_us / on_us,
+               (unsigned)stats.hits, (unsigned)stats.misses, lookups ? 100.0 * stats.hits / lookups : 0.0,
+               (unsigned)stats.size, (unsigned)stats.max_size, same ? "" : "  PIXELS DIFFER");
+        if (!same || stats.hits == 0 || stats.size > stats.max_size) failures++;
+        lv_draw_buf_destroy(off);
+        lv_draw_buf_destroy(on);
+    }
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,109 @@
+#include <stdio.h>
+#include <string.h>
+#include "lvgl_port.h"
+#include "spi_sim.h"
+#include "esp_timer.h"
+
+// 标签布局缓存基准：整屏几个长的多行标签（日志、说明文字）每帧重绘但文本不变，比较不用/使用布局缓存时
+// 每帧的CPU时间。不用缓存时每次绘制都要重新换行、逐字查找字宽；居中对齐还要再测一遍每行的宽度。
+// 两种模式最后比较整屏快照，缓存不能改变任何像素。SPI仿真为直通模式，不计总线时间。
+// 整屏快照约150KB，LVGL堆里不同时保留两张：字形缓存的小块分配会把堆切碎，第二张可能分配不到
+
+#define FRAMES      60
+
+static const char *paragraph =
+    "Flight log: the telemetry link reports altitude, speed and battery voltage every 100 ms. "
+    "When the link is lost the aircraft holds its position for 30 s and then returns home. "
+    "飛行模式已開始，目前高度一百二十米，速度每分三百米。電池電壓正常，信息強度良好。"
+    "Check the propellers, the compass calibration and the GPS fix before every take-off.";
+
+typedef struct {
+    const char *name;
+    const lv_font_t *font;
+    lv_text_align_t align;
+} layout_case_t;
+
+static const layout_case_t cases[] = {
+    { "montserrat_14 left", &lv_font_montserrat_14, LV_TEXT_ALIGN_LEFT },
+    { "montserrat_14 center", &lv_font_montserrat_14, LV_TEXT_ALIGN_CENTER },
+    { "simsun_16_cjk left", &lv_font_simsun_16_cjk, LV_TEXT_ALIGN_LEFT },
+};
+
+static bool layout_off;
+static uint8_t off_pixels[LV_HOR_RES_MAX * LV_VER_RES_MAX * 2];
+
+static void draw_task_cb(lv_event_t *e)
+{
+    lv_draw_label_dsc_t *dsc = lv_draw_task_get_label_dsc(lv_event_get_draw_task(e));
+    if (dsc && layout_off) dsc->layout = NULL;
+}
+
+/**
+ * @brief 创建两列长标签，每个标签包含同一段文字的两遍
+ */
+static void create_labels(const layout_case_t *lc)
+{
+    lv_obj_t *scr = lv_screen_active();
+    lv_obj_clean(scr);
+    static char text[1024];
+    snprintf(text, sizeof(text), "%s\n%s", paragraph, paragraph);
+
+    for (int c = 0; c < 2; c++) {
+        lv_obj_t *label = lv_label_create(scr);
+        lv_obj_set_style_text_font(label, lc->font, 0);
+        lv_obj_set_style_text_align(label, lc->align, 0);
+        lv_obj_set_width(label, LV_HOR_RES_MAX / 2 - 4);
+        lv_obj_set_pos(label, c * LV_HOR_RES_MAX / 2 + 2, 0);
+        lv_label_set_text(label, text);
+        lv_obj_add_flag(label, LV_OBJ_FLAG_SEND_DRAW_TASK_EVENTS);
+        lv_obj_add_event_cb(label, draw_task_cb, LV_EVENT_DRAW_TASK_ADDED, NULL);
+    }
+}
+
+/**
+ * @brief 重绘FRAMES帧，返回每帧的CPU时间（us）
+ */
+static double run(bool off)
+{
+    layout_off = off;
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+
+    int64_t start = esp_timer_get_time();
+    for (int f = 0; f < FRAMES; f++) {
+        lv_obj_invalidate(lv_screen_active());
+        lv_refr_now(NULL);
+    }
+    return (double)(esp_timer_get_time() - start) / FRAMES;
+}
+
+int main(void)
+{
+    lv_port_init();
+    spi_sim_set_time_scale(0);
+    spi_sim_set_bypass(LCD_SPI_HOST, true);
+
+    int failures = 0;
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        create_labels(&cases[c]);
+
+        double off_us = run(true);
+        lv_draw_buf_t *off = lv_snapshot_take(lv_screen_active(), LV_COLOR_FORMAT_RGB565);
+        bool same = off != NULL && off->data_size == sizeof(off_pixels);
+        if (off) {
+            if (same) memcpy(off_pixels, off->data, sizeof(off_pixels));
+            lv_draw_buf_destroy(off);
+        }
+
+        double on_us = run(false);
+        lv_draw_buf_t *on = lv_snapshot_take(lv_screen_active(), LV_COLOR_FORMAT_RGB565);
+        same = same && on != NULL && on->data_size == sizeof(off_pixels) &&
+               memcmp(off_pixels, on->data, sizeof(off_pixels)) == 0;
+        if (on) lv_draw_buf_destroy(on);
+
+        printf("[bench_label_layout] %-22s off %8.1f us/frame  on %8.1f us/frame  (%.2fx)%s\n",
+               cases[c].name, off_us, on_us, off_us / on_us, same ? "" : "  PIXELS DIFFER");
+        if (!same) failures++;
+    }
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,94 @@
+#include <stdio.h>
+#include <pthread.h>
+#include "lvgl.h"
+#include "lvgl_port.h"
+#include "esp_cpu.h"
+#include "esp_timer.h"
+
+// 微基准：一对LV_PROFILER_BEGIN/END的开销（周期/对）
+//   off     未设置跟踪输出，只有enable判断
+//   ring    lv_port_set_trace_output后写入本线程的无锁环（时间戳为esp_timer微秒）
+//   mutex   对照：原先的写法，每个事件加锁后写入共用的数组
+// 每批写BATCH对后在计时之外输出一次，环不会满；主机上周期数来自TSC，只看各写法之间的比例
+
+#define ROUNDS      500
+#define BATCH       200         // 小于每个线程环的一半（LV_PORT_TRACE_BUF_SIZE / 线程数 / 16字节）
+
+typedef struct {
+    const char *func;
+    uint32_t tick;
+    char tag;
+} mutex_item_t;
+
+static pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+static mutex_item_t mutex_items[BATCH * 2];
+static uint32_t mutex_index;
+static uint32_t trace_bytes;
+
+static void trace_write(const void *buf, uint32_t size)
+{
+    (void)buf;
+    trace_bytes += size;
+}
+
+static void mutex_write(const char *func, char tag)
+{
+    pthread_mutex_lock(&mutex);
+    mutex_item_t *item = &mutex_items[mutex_index++ % (BATCH * 2)];
+    item->func = func;
+    item->tag = tag;
+    item->tick = (uint32_t)esp_timer_get_time();
+    pthread_mutex_unlock(&mutex);
+}
+
+static void profiler_pairs(void)
+{
+    for (int i = 0; i < BATCH; i++) {
+        LV_PROFILER_BEGIN;
+        LV_PROFILER_END;
+    }
+}
+
+static void mutex_pairs(void)
+{
+    for (int i = 0; i < BATCH; i++) {
+        mutex_write(__func__, 'B');
+        mutex_write(__func__, 'E');
+    }
+}
+
+/**
+ * @brief 运行ROUNDS批，返回每对的平均周期数
+ * @param flush 每批后输出；未设置跟踪输出时分析器尚未分配，不能输出
+ */
+static double measure(void (*pairs)(void), bool flush)
+{
+    uint64_t cycles = 0;
+    for (int i = 0; i < ROUNDS; i++) {
+        esp_cpu_cycle_count_t start = esp_cpu_get_cycle_count();
+        pairs();
+        cycles += (esp_cpu_cycle_count_t)(esp_cpu_get_cycle_count() - start);
+        if (flush) lv_profiler_builtin_flush();
+    }
+    return (double)cycles / ((uint64_t)ROUNDS * BATCH);
+}
+
+int main(void)
+{
+    lv_port_init();
+
+    double off = measure(profiler_pairs, false);
+    if (!lv_port_set_trace_output(trace_write)) return 1;
+    double ring = measure(profiler_pairs, true);
+    double locked = measure(mutex_pairs, true);
+    lv_port_set_trace_output(NULL);
+
+    printf("[bench_profiler] off    %7.1f cycles/pair\n", off);
+    printf("[bench_profiler] ring   %7.1f cycles/pair\n", ring);
+    printf("[bench_profiler] mutex  %7.1f cycles/pair  %5.2fx ring\n", locked, locked / ring);
+
+    // 每对两条8字节的记录，另有线程和名字记录；少于这个数说明有事件被丢弃
+    uint32_t expect = (uint32_t)ROUNDS * BATCH * 2 * LV_PROFILER_BUILTIN_BIN_RECORD_SIZE;
+    printf("[bench_profiler] %u bytes streamed\n", (unsigned)trace_bytes);
+    return trace_bytes < expect;
+}
@@ -0,0 +1,104 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "lvgl_port.h"
+#include "spi_sim.h"
+#include "esp_timer.h"
+#include "demos/lv_demos.h"
+
+// 帧时间基准：运行lv_demo_benchmark，统计每帧从LV_EVENT_REFR_START到LV_EVENT_REFR_READY的时间
+// 分别以-DLV_PORT_DRAW_UNIT_CNT=1和=2构建运行，比较单个和两个软件绘制单元
+// SPI仿真为直通模式，测得的是渲染和flush_cb本身的耗时；LVGL时基加速TICK_SCALE倍，
+// 演示的场景切换和动画随之加快，每帧的绘制量不变
+
+#define TICK_SCALE      10          // 演示全程约75s，加速后约7.5s
+#define TIMEOUT_S       120
+#define MAX_FRAMES      20000
+
+static int64_t tick_origin_us;
+static int64_t frame_start_us;
+static bool frame_rendered;
+static uint32_t frame_us[MAX_FRAMES];
+static uint32_t frame_cnt;
+
+static uint32_t scaled_tick_cb(void)
+{
+    return (uint32_t)((esp_timer_get_time() - tick_origin_us) * TICK_SCALE / 1000);
+}
+
+static void refr_event_cb(lv_event_t *e)
+{
+    switch (lv_event_get_code(e)) {
+    case LV_EVENT_REFR_START:
+        frame_start_us = esp_timer_get_time();
+        frame_rendered = false;
+        break;
+    case LV_EVENT_RENDER_START:
+        frame_rendered = true;
+        break;
+    case LV_EVENT_REFR_READY:
+        // 没有脏区域的刷新不计入
+        if (frame_rendered && frame_cnt < MAX_FRAMES) {
+            frame_us[frame_cnt++] = (uint32_t)(esp_timer_get_time() - frame_start_us);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+static int cmp_u32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief 演示结束时在屏幕上创建汇总表格
+ */
+static bool benchmark_done(void)
+{
+    lv_obj_t *child = lv_obj_get_child(lv_screen_active(), 0);
+    return child != NULL && lv_obj_check_type(child, &lv_table_class);
+}
+
+int main(void)
+{
+    lv_port_init();
+    spi_sim_set_time_scale(0);
+    spi_sim_set_bypass(LCD_SPI_HOST, true);
+
+    tick_origin_us = esp_timer_get_time();
+    lv_tick_set_cb(scaled_tick_cb);
+    lv_display_t *disp = lv_display_get_default();
+    lv_display_add_event_cb(disp, refr_event_cb, LV_EVENT_REFR_START, NULL);
+    lv_display_add_event_cb(disp, refr_event_cb, LV_EVENT_RENDER_START, NULL);
+    lv_display_add_event_cb(disp, refr_event_cb, LV_EVENT_REFR_READY, NULL);
+
+    lv_demo_benchmark();
+    int64_t start = esp_timer_get_time();
+    int64_t end = start + TIMEOUT_S * 1000000LL;
+    while (!benchmark_done() && esp_timer_get_time() < end) {
+        uint32_t next_ms = lv_port_handler();
+        lv_port_sleep(next_ms / TICK_SCALE);
+    }
+    int64_t elapsed_us = esp_timer_get_time() - start;
+
+    if (!benchmark_done() || frame_cnt == 0) {
+        printf("[bench_render] benchmark did not finish within %d s (%u frames)\n", TIMEOUT_S, (unsigned)frame_cnt);
+        return 1;
+    }
+
+    uint64_t total = 0;
+    for (uint32_t i = 0; i < frame_cnt; i++) total += frame_us[i];
+    qsort(frame_us, frame_cnt, sizeof(frame_us[0]), cmp_u32);
+
+    // 多个绘制单元只有在主机有多个CPU时才能并行，CPU数一并输出
+    printf("[bench_render] %d draw unit(s), %s, %ld CPU(s): %u frames in %.1f s\n", LV_DRAW_SW_DRAW_UNIT_CNT,
+           LV_USE_OS == LV_OS_NONE ? "LV_OS_NONE" : "LV_OS_PTHREAD", sysconf(_SC_NPROCESSORS_ONLN),
+           (unsigned)frame_cnt, elapsed_us / 1e6);
+    printf("[bench_render] frame time avg %.3f ms  p50 %.3f ms  p95 %.3f ms  max %.3f ms\n",
+           total / 1000.0 / frame_cnt, frame_us[frame_cnt / 2] / 1000.0, frame_us[frame_cnt * 95 / 100] / 1000.0,
+           frame_us[frame_cnt - 1] / 1000.0);
+    return 0;
+}
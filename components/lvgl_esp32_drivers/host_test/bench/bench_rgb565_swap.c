@@ -0,0 +1,92 @@
+#include <stdio.h>
+#include <string.h>
+#include "lvgl.h"
+#include "disp_spi.h"
+#include "rgb565_swap.h"
+#include "esp_cpu.h"
+
+// 微基准：RGB565字节交换的吞吐量（字节/周期）
+// 对照为逐像素实现和LVGL的lv_draw_sw_rgb565_swap（原先在刷新时对整块调用）
+// 主机上周期数来自TSC，与目标板不可直接比较，只看各实现之间的比例
+
+#define ROUNDS          2000
+#define STRIPE_PX       DISP_BUF_SIZE
+
+static uint16_t stripe[STRIPE_PX + 8] __attribute__((aligned(16)));
+static uint16_t expect[STRIPE_PX + 8];
+
+static void lvgl_swap(void *buf, size_t px)
+{
+    lv_draw_sw_rgb565_swap(buf, (uint32_t)px);
+}
+
+typedef struct {
+    const char *name;
+    void (*swap)(void *buf, size_t px);
+} swap_impl_t;
+
+static void fill(uint16_t *buf, size_t px, uint32_t seed)
+{
+    for (size_t i = 0; i < px; i++) {
+        seed = seed * 1103515245u + 12345u;
+        buf[i] = (uint16_t)(seed >> 16);
+    }
+}
+
+/**
+ * @brief 与逐像素实现比较，覆盖各种起始对齐和奇数长度
+ * @return 0表示一致
+ */
+static int check(const swap_impl_t *impl)
+{
+    for (size_t offset = 0; offset < 8; offset++) {
+        for (size_t px = 0; px < 100; px += 7) {
+            fill(stripe, STRIPE_PX + 8, (uint32_t)(offset * 131 + px));
+            memcpy(expect, stripe, sizeof(stripe));
+            rgb565_swap_ref(&expect[offset], px);
+            impl->swap(&stripe[offset], px);
+            if (memcmp(stripe, expect, sizeof(stripe)) != 0) {
+                printf("[bench_rgb565_swap] %s: mismatch at offset %u, %u px\n", impl->name,
+                       (unsigned)offset, (unsigned)px);
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief 交换一整块（320x40）ROUNDS次，统计每周期字节数
+ */
+static double measure(const swap_impl_t *impl)
+{
+    uint64_t cycles = 0;
+    fill(stripe, STRIPE_PX, 1);
+    for (int i = 0; i < ROUNDS; i++) {
+        esp_cpu_cycle_count_t start = esp_cpu_get_cycle_count();
+        impl->swap(stripe, STRIPE_PX);
+        cycles += (esp_cpu_cycle_count_t)(esp_cpu_get_cycle_count() - start);
+    }
+    return (double)STRIPE_PX * 2 * ROUNDS / cycles;
+}
+
+int main(void)
+{
+    const swap_impl_t impls[] = {
+        {"scalar", rgb565_swap_ref},
+        {"lvgl", lvgl_swap},
+        {"swar", rgb565_swap_swar},
+        {rgb565_swap_impl_name(), rgb565_swap},
+    };
+    int failed = 0;
+
+    rgb565_swap_init();
+    double base = 0;
+    for (size_t i = 0; i < sizeof(impls) / sizeof(impls[0]); i++) {
+        failed |= check(&impls[i]);
+        double bpc = measure(&impls[i]);
+        if (i == 0) base = bpc;
+        printf("[bench_rgb565_swap] %-8s %6.2f bytes/cycle  %5.2fx scalar\n", impls[i].name, bpc, bpc / base);
+    }
+    return failed;
+}
@@ -0,0 +1,163 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "lvgl_port.h"
+#include "spi_sim.h"
+#include "esp_timer.h"
+#include "demos/lv_demos.h"
+#include "src/misc/lv_timer_private.h"
+
+// 影子帧缓冲比较基准：统计启用比较后总线上实际发送的颜色数据字节数，与渲染出的全部字节数比较
+//   benchmark  lv_demo_benchmark的各个场景（时基加速，与bench_render.c相同）
+//   telemetry  遥测界面（与bench_area_merge.c相同）：每帧随机改写一半读数标签，
+//              比较关闭/启用时的字节数，以及每帧的CPU时间（渲染和flush_cb，含逐行比较）
+// SPI仿真为直通模式，不计总线时间
+
+#define TICK_SCALE      10
+#define TIMEOUT_S       120
+#define COLS            8
+#define ROWS            15
+#define FRAMES          60
+
+// 与lv_demo_benchmark.c中scenes的顺序相同
+static const char *scene_names[] = {
+    "Empty screen", "Moving wallpaper", "Single rectangle", "Multiple rectangles", "Multiple RGB images",
+    "Multiple ARGB images", "Rotated ARGB images", "Multiple labels", "Screen sized text", "Multiple arcs",
+    "Containers", "Containers with overlay", "Containers with opa", "Containers with opa_layer",
+    "Containers with scrolling", "Widgets demo",
+};
+#define SCENE_CNT   (sizeof(scene_names) / sizeof(scene_names[0]))
+
+static int64_t tick_origin_us;
+static lv_timer_cb_t next_scene_cb;     // 演示切换场景的定时器回调
+static uint32_t scene;
+static uint64_t total_sent, total_rendered;
+static uint32_t frames;                 // 有脏区域的刷新数（不论是否发送）
+
+static void render_start_cb(lv_event_t *e)
+{
+    frames++;
+}
+
+static uint32_t scaled_tick_cb(void)
+{
+    return (uint32_t)((esp_timer_get_time() - tick_origin_us) * TICK_SCALE / 1000);
+}
+
+/**
+ * @brief 输出一段的字节统计并清零
+ */
+static void report(const char *scene_name, const char *mode)
+{
+    lv_port_stripe_stats_t stats;
+    lv_port_get_stripe_stats(&stats);
+    uint64_t rendered = stats.bytes_sent + stats.bytes_skipped;
+    uint32_t n = frames > 0 ? frames : 1;
+
+    printf("[bench_shadow_diff] %-26s %-4s %4u frames  rendered %7.1f KB/frame  sent %7.1f KB/frame  "
+           "saved %5.1f%%  %5.1f windows/frame\n", scene_name, mode, (unsigned)frames,
+           rendered / 1024.0 / n, stats.bytes_sent / 1024.0 / n,
+           rendered > 0 ? 100.0 * stats.bytes_skipped / rendered : 0.0, (double)stats.windows / n);
+    total_sent += stats.bytes_sent;
+    total_rendered += rendered;
+    frames = 0;
+    lv_port_reset_stripe_stats();
+}
+
+/**
+ * @brief 替换演示的场景切换回调：先输出上一个场景的统计，再切换
+ */
+static void scene_timer_cb(lv_timer_t *timer)
+{
+    report(scene < SCENE_CNT ? scene_names[scene] : "?", "diff");
+    scene++;
+    next_scene_cb(timer);
+}
+
+static bool benchmark_done(void)
+{
+    lv_obj_t *child = lv_obj_get_child(lv_screen_active(), 0);
+    return child != NULL && lv_obj_check_type(child, &lv_table_class);
+}
+
+static int run_benchmark(void)
+{
+    tick_origin_us = esp_timer_get_time();
+    lv_tick_set_cb(scaled_tick_cb);
+    lv_port_set_shadow_diff(true);
+
+    lv_demo_benchmark();
+    // 演示最后创建的定时器在链表头部
+    lv_timer_t *timer = lv_timer_get_next(NULL);
+    next_scene_cb = timer->timer_cb;
+    lv_timer_set_cb(timer, scene_timer_cb);
+    lv_port_reset_stripe_stats();
+    frames = 0;
+
+    int64_t end = esp_timer_get_time() + TIMEOUT_S * 1000000LL;
+    while (!benchmark_done() && esp_timer_get_time() < end) {
+        uint32_t next_ms = lv_port_handler();
+        lv_port_sleep(next_ms / TICK_SCALE);
+    }
+    if (!benchmark_done()) {
+        printf("[bench_shadow_diff] benchmark did not finish within %d s\n", TIMEOUT_S);
+        return 1;
+    }
+    printf("[bench_shadow_diff] %-26s diff sent %.1f of %.1f MB (saved %.1f%%)\n", "benchmark total",
+           total_sent / 1048576.0, total_rendered / 1048576.0, 100.0 - 100.0 * total_sent / total_rendered);
+
+    lv_obj_clean(lv_screen_active());
+    lv_obj_clean(lv_layer_top());
+    lv_tick_set_cb(NULL);
+    lv_port_set_shadow_diff(false);
+    return 0;
+}
+
+/**
+ * @brief 遥测界面：按相同的随机序列刷新FRAMES帧
+ */
+static void run_telemetry(lv_obj_t **labels, bool diff)
+{
+    lv_port_set_shadow_diff(diff);
+    lv_refr_now(NULL);
+    lv_port_reset_stripe_stats();
+    frames = 0;
+
+    srand(1);
+    int64_t start = esp_timer_get_time();
+    for (int f = 0; f < FRAMES; f++) {
+        for (int i = 0; i < COLS * ROWS; i++) {
+            if (rand() % 100 < 50) {
+                lv_label_set_text_fmt(labels[i], "%d", rand() % (rand() % 2 ? 100 : 100000));
+            }
+        }
+        lv_refr_now(NULL);
+    }
+    double cpu_us = (double)(esp_timer_get_time() - start) / FRAMES;
+
+    report("telemetry", diff ? "diff" : "off");
+    printf("[bench_shadow_diff] %-26s %-4s cpu %.1f us/frame\n", "telemetry", diff ? "diff" : "off", cpu_us);
+}
+
+int main(void)
+{
+    static lv_obj_t *labels[COLS * ROWS];
+
+    lv_port_init();
+    spi_sim_set_time_scale(0);
+    spi_sim_set_bypass(LCD_SPI_HOST, true);
+    lv_display_add_event_cb(lv_display_get_default(), render_start_cb, LV_EVENT_RENDER_START, NULL);
+
+    if (run_benchmark() != 0) return 1;
+
+    lv_obj_t *scr = lv_screen_active();
+    lv_obj_remove_style_all(scr);
+    lv_obj_set_style_bg_opa(scr, LV_OPA_COVER, 0);
+    for (int i = 0; i < COLS * ROWS; i++) {
+        labels[i] = lv_label_create(scr);
+        lv_obj_set_pos(labels[i], (i % COLS) * (LV_HOR_RES_MAX / COLS), (i / COLS) * (LV_VER_RES_MAX / ROWS));
+        lv_label_set_text(labels[i], "0");
+    }
+    run_telemetry(labels, false);
+    run_telemetry(labels, true);
+    return 0;
+}
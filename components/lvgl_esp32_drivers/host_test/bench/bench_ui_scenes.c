@@ -0,0 +1,476 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include "lvgl_port.h"
+#include "subject_pub.h"
+#include "chart_stream.h"
+#include "spi_sim.h"
+#include "xpt2046_sim.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+
+// 手持终端界面的帧时间回归基准：在无头的320x240 RGB565显示（仿真SPI上的ILI9341）上搭建与main.c相同风格的
+// 界面（状态栏、遥测读数、遥测曲线、设置列表），按脚本回放遥测和触摸场景，每个场景输出：
+//   frames        有脏区域的刷新数
+//   render_us     每帧从LV_EVENT_REFR_START到LV_EVENT_REFR_READY的平均/最大时间（渲染和flush_cb；
+//                 最大值受主机调度影响，只供参考）
+//   pixels        ili9341发送的像素数（port_stats）
+//   draw_tasks    创建的绘制任务数（链接时--wrap=lv_draw_add_task）
+//   heap_peak     场景期间LVGL堆的峰值（链接时包装lv_malloc_core等，按申请的字节数）
+// 结果写入JSON（默认bench_ui_scenes.json，可由第一个参数指定），由tools/lv_bench_check.py与
+// ui_scenes_thresholds.json中的阈值比较。
+// LVGL时基为虚拟时钟，由脚本逐毫秒推进，刷新和动画的帧数与主机快慢无关；按压期间虚拟时钟与触摸采样同步，
+// 每个采样周期等采样任务产生一个点再推进。按代价的区域合并依赖实测耗时，像素数会随主机负载变化，
+// 这里关闭以保证计数可重复（合并的效果见bench_area_merge.c）。SPI仿真不计线上时间
+
+#define RAW_FOR(px, res, min, max)  ((uint16_t)(2 * ((min) + ((px) * ((max) - (min)) + (res) - 1) / (res))))
+#define TELEMETRY_CNT   6
+#define TELEMETRY_MS    5           // 遥测200Hz
+#define CHART_MS        2           // 曲线500Hz
+#define CHART_CAPACITY  2000
+#define LIST_ITEMS      24
+#define DRAG_SAMPLES    30
+#define HEAP_HDR        16          // 包装分配时在块前记录大小，保持对齐
+#define TOUCH_WAIT_MS   50          // 等一个触摸点的最长时间（滤波可能丢弃按下和松开时的采样）
+
+/**
+ * @brief 一个脚本场景
+ */
+typedef struct {
+    const char *name;
+    uint32_t duration_ms;
+    void (*start)(void);            // 场景开始时调用一次
+    void (*step)(uint32_t t_ms);    // 每个虚拟毫秒调用一次
+} scene_t;
+
+/**
+ * @brief 一个场景的结果
+ */
+typedef struct {
+    uint32_t frames;
+    uint64_t render_us_sum;
+    uint32_t render_us_max;
+    uint32_t pixels;
+    uint32_t draw_tasks;
+    size_t heap_peak;
+} scene_result_t;
+
+static const char *telemetry_names[TELEMETRY_CNT] = { "ALT", "SPD", "VOLT", "CUR", "PITCH", "ROLL" };
+
+static uint32_t virtual_ms;
+static bool touch_active;               // 按下到松开点交给LVGL之前
+static bool touch_releasing;
+static lv_obj_t *home_page, *settings_page, *status_bar, *menu_btn, *back_btn, *list;
+static lv_subject_t telemetry[TELEMETRY_CNT], rssi, battery;
+static subject_pub_t telemetry_pub[TELEMETRY_CNT], rssi_pub, battery_pub;
+static chart_stream_t stream;
+static uint32_t chart_phase;
+
+static scene_result_t *cur;             // 正在统计的场景
+static int64_t frame_start_us;
+static bool frame_rendered;
+static uint32_t draw_task_cnt;
+static atomic_size_t heap_used;
+static atomic_size_t heap_peak;
+
+/* ---------- 绘制任务和堆的统计（链接时--wrap） ---------- */
+
+lv_draw_task_t *__real_lv_draw_add_task(lv_layer_t *layer, const lv_area_t *coords);
+void *__real_lv_malloc_core(size_t size);
+void *__real_lv_realloc_core(void *p, size_t new_size);
+void __real_lv_free_core(void *p);
+
+lv_draw_task_t *__wrap_lv_draw_add_task(lv_layer_t *layer, const lv_area_t *coords)
+{
+    draw_task_cnt++;
+    return __real_lv_draw_add_task(layer, coords);
+}
+
+static void heap_add(size_t size)
+{
+    size_t used = atomic_fetch_add(&heap_used, size) + size;
+    size_t peak = atomic_load(&heap_peak);
+    while (used > peak && !atomic_compare_exchange_weak(&heap_peak, &peak, used)) {
+    }
+}
+
+void *__wrap_lv_malloc_core(size_t size)
+{
+    size_t *hdr = __real_lv_malloc_core(size + HEAP_HDR);
+    if (hdr == NULL) return NULL;
+    *hdr = size;
+    heap_add(size);
+    return (uint8_t *)hdr + HEAP_HDR;
+}
+
+void *__wrap_lv_realloc_core(void *p, size_t new_size)
+{
+    if (p == NULL) return __wrap_lv_malloc_core(new_size);
+
+    size_t *hdr = (size_t *)((uint8_t *)p - HEAP_HDR);
+    size_t old_size = *hdr;
+    hdr = __real_lv_realloc_core(hdr, new_size + HEAP_HDR);
+    if (hdr == NULL) return NULL;
+    *hdr = new_size;
+    atomic_fetch_sub(&heap_used, old_size);
+    heap_add(new_size);
+    return (uint8_t *)hdr + HEAP_HDR;
+}
+
+void __wrap_lv_free_core(void *p)
+{
+    if (p == NULL) return;
+    size_t *hdr = (size_t *)((uint8_t *)p - HEAP_HDR);
+    atomic_fetch_sub(&heap_used, *hdr);
+    __real_lv_free_core(hdr);
+}
+
+/* ---------- 帧时间 ---------- */
+
+static uint32_t virtual_tick_cb(void)
+{
+    return virtual_ms;
+}
+
+static void refr_event_cb(lv_event_t *e)
+{
+    switch (lv_event_get_code(e)) {
+    case LV_EVENT_REFR_START:
+        frame_start_us = esp_timer_get_time();
+        frame_rendered = false;
+        break;
+    case LV_EVENT_RENDER_START:
+        frame_rendered = true;
+        break;
+    case LV_EVENT_REFR_READY:
+        // 没有脏区域的刷新不计入
+        if (frame_rendered && cur != NULL) {
+            uint32_t us = (uint32_t)(esp_timer_get_time() - frame_start_us);
+            cur->frames++;
+            cur->render_us_sum += us;
+            if (us > cur->render_us_max) cur->render_us_max = us;
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+/* ---------- 界面 ---------- */
+
+static void screen_style(lv_obj_t *scr)
+{
+    lv_obj_set_style_bg_color(scr, lv_color_hex(0x003a57), LV_PART_MAIN);
+    lv_obj_set_style_text_color(scr, lv_color_hex(0xffffff), LV_PART_MAIN);
+}
+
+static void menu_clicked_cb(lv_event_t *e)
+{
+    lv_screen_load_anim(settings_page, LV_SCR_LOAD_ANIM_MOVE_LEFT, 200, 0, false);
+}
+
+static void back_clicked_cb(lv_event_t *e)
+{
+    lv_screen_load_anim(home_page, LV_SCR_LOAD_ANIM_MOVE_RIGHT, 200, 0, false);
+}
+
+/**
+ * @brief 状态栏：信号强度和电池电压，挂在顶层，两页共用
+ */
+static void status_bar_create(void)
+{
+    status_bar = lv_obj_create(lv_layer_top());
+    lv_obj_remove_style_all(status_bar);
+    lv_obj_set_size(status_bar, LV_HOR_RES_MAX, 24);
+    lv_obj_set_style_bg_color(status_bar, lv_color_hex(0x00202f), 0);
+    lv_obj_set_style_bg_opa(status_bar, LV_OPA_COVER, 0);
+    lv_obj_set_style_text_color(status_bar, lv_color_hex(0xffffff), 0);
+    lv_obj_set_style_pad_hor(status_bar, 6, 0);
+
+    lv_subject_init_int(&rssi, -60);
+    lv_subject_init_int(&battery, 74);
+    lv_obj_t *label = lv_label_create(status_bar);
+    lv_obj_align(label, LV_ALIGN_LEFT_MID, 0, 0);
+    lv_label_bind_text(label, &rssi, "RSSI %d dBm");
+    label = lv_label_create(status_bar);
+    lv_obj_align(label, LV_ALIGN_RIGHT_MID, 0, 0);
+    lv_label_bind_text(label, &battery, "BAT %d");
+    subject_pub_init(&rssi_pub, &rssi);
+    subject_pub_init(&battery_pub, &battery);
+}
+
+/**
+ * @brief 主页：遥测读数、遥测曲线和菜单按钮
+ */
+static void home_page_create(void)
+{
+    home_page = lv_obj_create(NULL);
+    screen_style(home_page);
+
+    for (int i = 0; i < TELEMETRY_CNT; i++) {
+        lv_subject_init_int(&telemetry[i], 0);
+        lv_obj_t *name = lv_label_create(home_page);
+        lv_obj_set_pos(name, 8 + (i % 3) * 104, 30 + (i / 3) * 36);
+        lv_label_set_text(name, telemetry_names[i]);
+        lv_obj_set_style_text_color(name, lv_color_hex(0x8fb8ca), 0);
+        lv_obj_t *value = lv_label_create(home_page);
+        lv_obj_set_pos(value, 56 + (i % 3) * 104, 30 + (i / 3) * 36);
+        lv_label_bind_text(value, &telemetry[i], "%d");
+        subject_pub_init(&telemetry_pub[i], &telemetry[i]);
+    }
+
+    lv_obj_t *chart = lv_chart_create(home_page);
+    lv_obj_set_size(chart, 230, 130);
+    lv_obj_set_pos(chart, 6, 104);
+    lv_chart_set_range(chart, LV_CHART_AXIS_PRIMARY_Y, 0, 1000);
+    lv_chart_set_point_count(chart, 2);
+    chart_stream_init(&stream, chart, lv_palette_main(LV_PALETTE_ORANGE), LV_CHART_AXIS_PRIMARY_Y, CHART_CAPACITY);
+
+    menu_btn = lv_button_create(home_page);
+    lv_obj_set_size(menu_btn, 70, 50);
+    lv_obj_align(menu_btn, LV_ALIGN_BOTTOM_RIGHT, -6, -6);
+    lv_obj_add_event_cb(menu_btn, menu_clicked_cb, LV_EVENT_CLICKED, NULL);
+    lv_obj_t *label = lv_label_create(menu_btn);
+    lv_label_set_text(label, "Menu");
+    lv_obj_center(label);
+}
+
+/**
+ * @brief 设置页：可滚动的列表和返回按钮
+ */
+static void settings_page_create(void)
+{
+    settings_page = lv_obj_create(NULL);
+    screen_style(settings_page);
+
+    list = lv_list_create(settings_page);
+    lv_obj_set_size(list, 230, LV_VER_RES_MAX - 30);
+    lv_obj_set_pos(list, 6, 28);
+    for (int i = 0; i < LIST_ITEMS; i++) {
+        if (i % 8 == 0) lv_list_add_text(list, i == 0 ? "Radio" : i == 8 ? "Display" : "System");
+        lv_obj_t *btn = lv_list_add_button(list, LV_SYMBOL_SETTINGS, "Setting");
+        lv_label_set_text_fmt(lv_obj_get_child(btn, 1), "Setting %d", i + 1);
+    }
+
+    back_btn = lv_button_create(settings_page);
+    lv_obj_set_size(back_btn, 70, 50);
+    lv_obj_align(back_btn, LV_ALIGN_BOTTOM_RIGHT, -6, -6);
+    lv_obj_add_event_cb(back_btn, back_clicked_cb, LV_EVENT_CLICKED, NULL);
+    lv_obj_t *label = lv_label_create(back_btn);
+    lv_label_set_text(label, "Back");
+    lv_obj_center(label);
+}
+
+/* ---------- 脚本 ---------- */
+
+static xpt2046_sim_sample_t touch_sample(int32_t x, int32_t y)
+{
+    xpt2046_sim_sample_t s = {
+        .x = RAW_FOR(x, LV_HOR_RES_MAX, XPT2046_X_MIN, XPT2046_X_MAX),
+        .y = RAW_FOR(y, LV_VER_RES_MAX, XPT2046_Y_MIN, XPT2046_Y_MAX),
+        .z1 = 600,
+        .z2 = 3000,
+    };
+    return s;
+}
+
+static void touch_press(const xpt2046_sim_sample_t *samples, size_t count)
+{
+    xpt2046_sim_press(samples, count);
+    touch_active = true;
+    touch_releasing = false;
+}
+
+static void touch_release(void)
+{
+    xpt2046_sim_release();
+    touch_releasing = true;
+}
+
+/**
+ * @brief 按压期间每个采样周期等采样任务产生一个点，松开点到达后结束同步
+ */
+static void touch_sync(void)
+{
+    int64_t end = esp_timer_get_time() + TOUCH_WAIT_MS * 1000LL;
+    while (xpt2046_pending() == 0 && esp_timer_get_time() < end) {
+        vTaskDelay(pdMS_TO_TICKS(1));
+    }
+    if (touch_releasing) touch_active = false;
+}
+
+/**
+ * @brief 在对象中心按下，100ms后松开
+ */
+static void tap_step(lv_obj_t *obj, uint32_t t)
+{
+    static xpt2046_sim_sample_t sample;
+    if (t == 0) {
+        lv_area_t a;
+        lv_obj_get_coords(obj, &a);
+        sample = touch_sample((a.x1 + a.x2) / 2, (a.y1 + a.y2) / 2);
+        touch_press(&sample, 1);
+    } else if (t == 100) {
+        touch_release();
+    }
+}
+
+static void boot_start(void)
+{
+    status_bar_create();
+    home_page_create();
+    settings_page_create();
+    lv_screen_load(home_page);
+}
+
+static void telemetry_step(uint32_t t)
+{
+    if (t % TELEMETRY_MS != 0) return;
+    for (int i = 0; i < TELEMETRY_CNT; i++) {
+        // 姿态变化快，其余读数变化慢
+        int32_t v = i >= 4 ? rand() % 360 - 180 : (int32_t)(t / 50) * (i + 1) + rand() % 3;
+        subject_pub_int(&telemetry_pub[i], v);
+    }
+    if (t % 500 == 0) {
+        subject_pub_int(&rssi_pub, -60 - rand() % 20);
+        subject_pub_int(&battery_pub, 74 - (int32_t)(t / 1000));
+    }
+}
+
+static void chart_step(uint32_t t)
+{
+    if (t % CHART_MS != 0) return;
+    chart_phase++;
+    chart_stream_push(&stream, 500 + (int32_t)(chart_phase % 200) - 100 + (rand() % 40 == 0 ? rand() % 400 - 200 : 0));
+}
+
+static void flight_step(uint32_t t)
+{
+    telemetry_step(t);
+    chart_step(t);
+}
+
+static void menu_tap_step(uint32_t t)
+{
+    tap_step(menu_btn, t);
+}
+
+static void back_tap_step(uint32_t t)
+{
+    tap_step(back_btn, t);
+}
+
+/**
+ * @brief 在列表上从下往上拖动约300ms，松开后惯性滚动
+ */
+static void scroll_step(uint32_t t)
+{
+    static xpt2046_sim_sample_t path[DRAG_SAMPLES];
+    if (t == 0) {
+        for (int i = 0; i < DRAG_SAMPLES; i++) path[i] = touch_sample(120, 200 - i * 5);
+        touch_press(path, DRAG_SAMPLES);
+    } else if (t == DRAG_SAMPLES * XPT2046_SAMPLE_PERIOD_MS) {
+        touch_release();
+    }
+}
+
+static const scene_t scenes[] = {
+    { "boot",        300,  boot_start, NULL },
+    { "idle",        1000, NULL,       NULL },
+    { "telemetry",   2000, NULL,       telemetry_step },
+    { "chart",       2000, NULL,       chart_step },
+    { "flight",      2000, NULL,       flight_step },
+    { "menu_open",   600,  NULL,       menu_tap_step },
+    { "list_scroll", 1200, NULL,       scroll_step },
+    { "menu_close",  600,  NULL,       back_tap_step },
+};
+#define SCENE_CNT   (sizeof(scenes) / sizeof(scenes[0]))
+
+static scene_result_t results[SCENE_CNT];
+
+/**
+ * @brief 运行一个场景：逐个虚拟毫秒推进时钟并处理LVGL
+ */
+static void run_scene(const scene_t *scene, scene_result_t *res)
+{
+    port_stats_mark_t mark;
+    port_stats_period_t stats;
+
+    port_stats_mark(&mark);
+    draw_task_cnt = 0;
+    atomic_store(&heap_peak, atomic_load(&heap_used));
+    cur = res;
+
+    if (scene->start) scene->start();
+    for (uint32_t t = 0; t < scene->duration_ms; t++) {
+        if (scene->step) scene->step(t);
+        if (touch_active && t % XPT2046_SAMPLE_PERIOD_MS == 0) touch_sync();
+        lv_port_handler();
+        disp_wait_for_pending_transactions();
+        virtual_ms++;
+    }
+
+    cur = NULL;
+    port_stats_read(&mark, &stats);
+    res->pixels = stats.pixels;
+    res->draw_tasks = draw_task_cnt;
+    res->heap_peak = atomic_load(&heap_peak);
+}
+
+static int write_json(const char *path)
+{
+    FILE *f = fopen(path, "w");
+    if (f == NULL) {
+        printf("[bench_ui_scenes] cannot write %s\n", path);
+        return 1;
+    }
+    fprintf(f, "{\n  \"display\": {\"hor_res\": %d, \"ver_res\": %d, \"color_format\": \"RGB565\", "
+            "\"draw_units\": %d},\n  \"scenes\": [\n", LV_HOR_RES_MAX, LV_VER_RES_MAX, LV_DRAW_SW_DRAW_UNIT_CNT);
+    for (size_t i = 0; i < SCENE_CNT; i++) {
+        const scene_result_t *r = &results[i];
+        fprintf(f, "    {\"name\": \"%s\", \"duration_ms\": %u, \"frames\": %u, \"render_us_avg\": %u, "
+                "\"render_us_max\": %u, \"pixels\": %u, \"draw_tasks\": %u, \"heap_peak\": %zu}%s\n",
+                scenes[i].name, (unsigned)scenes[i].duration_ms, (unsigned)r->frames,
+                (unsigned)(r->frames > 0 ? r->render_us_sum / r->frames : 0), (unsigned)r->render_us_max,
+                (unsigned)r->pixels, (unsigned)r->draw_tasks, r->heap_peak, i + 1 < SCENE_CNT ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+    fclose(f);
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    const char *out_path = argc > 1 ? argv[1] : "bench_ui_scenes.json";
+
+    lv_port_init();
+    xpt2046_sim_init(TP_SPI_CS, TP_SPI_IRQ);
+    spi_sim_set_time_scale(0);
+    lv_tick_set_cb(virtual_tick_cb);
+    lv_display_t *disp = lv_display_get_default();
+    lv_display_add_event_cb(disp, refr_event_cb, LV_EVENT_REFR_START, NULL);
+    lv_display_add_event_cb(disp, refr_event_cb, LV_EVENT_RENDER_START, NULL);
+    lv_display_add_event_cb(disp, refr_event_cb, LV_EVENT_REFR_READY, NULL);
+    lv_port_set_area_merge(false);
+    srand(1);
+
+    for (size_t i = 0; i < SCENE_CNT; i++) {
+        run_scene(&scenes[i], &results[i]);
+        const scene_result_t *r = &results[i];
+        printf("[bench_ui_scenes] %-12s %4u frames  render avg %6.1f us  max %6u us  %7u px  %5u draw tasks  "
+               "heap peak %6zu B\n", scenes[i].name, (unsigned)r->frames,
+               r->frames > 0 ? (double)r->render_us_sum / r->frames : 0.0, (unsigned)r->render_us_max,
+               (unsigned)r->pixels, (unsigned)r->draw_tasks, r->heap_peak);
+    }
+
+    // 每个场景都应有画面：主页、遥测变化、页面切换和滚动都会产生刷新
+    for (size_t i = 0; i < SCENE_CNT; i++) {
+        if (strcmp(scenes[i].name, "idle") != 0 && results[i].frames == 0) {
+            printf("[bench_ui_scenes] scene %s rendered nothing\n", scenes[i].name);
+            return 1;
+        }
+    }
+    return write_json(out_path);
+}
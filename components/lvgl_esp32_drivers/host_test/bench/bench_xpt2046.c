@@ -0,0 +1,79 @@
+#include <stdio.h>
+#include "touch_spi.h"
+#include "xpt2046.h"
+#include "xpt2046_sim.h"
+#include "spi_sim.h"
+#include "esp_timer.h"
+
+// 微基准：XPT2046逐通道读取与突发读取的每采样开销
+// 线上时间缩放为0，测得的是驱动和事务开销；线上时间按2MHz时钟由总线统计折算
+
+#define ROUNDS          20000
+#define CHANNELS        4
+#define BURST_LEN       (CHANNELS * XPT2046_OVERSAMPLE * 2 + 1)
+
+// 与xpt2046.c中的命令定义一致
+static const uint8_t channel_cmds[CHANNELS] = {0b10010000, 0b11010000, 0b10110000, 0b11000000};
+
+/**
+ * @brief 输出一种读取方式的每采样开销
+ */
+static void report(const char *name, int64_t elapsed_us, const spi_sim_stats_t *before, const spi_sim_stats_t *after)
+{
+    uint32_t trans = after->trans_count - before->trans_count;
+    uint64_t wire_ns = after->wire_time_ns - before->wire_time_ns;
+    printf("[bench_xpt2046] %-10s %6.1f trans/sample  %8.1f ns cpu/sample  %7.1f us wire/sample  %8.0f samples/s cpu-bound\n",
+           name, (double)trans / ROUNDS, elapsed_us * 1000.0 / ROUNDS, wire_ns / 1000.0 / ROUNDS,
+           ROUNDS * 1e6 / elapsed_us);
+}
+
+int main(void)
+{
+    static uint8_t tx[BURST_LEN], rx[BURST_LEN];
+    const xpt2046_sim_sample_t sample = {.x = 1000, .y = 2000, .z1 = 600, .z2 = 3000};
+    const uint16_t expected[CHANNELS] = {sample.x, sample.y, sample.z1, sample.z2};
+    spi_sim_stats_t before, after;
+    int64_t start;
+    int failed = 0;
+
+    tp_spi_init();
+    xpt2046_sim_init(TP_SPI_CS, TP_SPI_IRQ);
+    spi_sim_set_time_scale(0);
+    xpt2046_sim_press(&sample, 1);
+
+    for (int i = 0; i < CHANNELS * XPT2046_OVERSAMPLE; i++) {
+        tx[2 * i] = channel_cmds[i % CHANNELS];
+    }
+
+    // 逐通道：每个通道每次转换一个tp_spi_read_reg事务（原实现）
+    spi_sim_get_stats(TP_SPI_HOST, &before);
+    start = esp_timer_get_time();
+    for (int r = 0; r < ROUNDS; r++) {
+        for (int o = 0; o < XPT2046_OVERSAMPLE; o++) {
+            for (int c = 0; c < CHANNELS; c++) {
+                uint8_t data[2];
+                tp_spi_read_reg(channel_cmds[c], data, 2);
+                if ((((data[0] << 8) | data[1]) >> 3) != expected[c]) failed = 1;
+            }
+        }
+    }
+    int64_t elapsed = esp_timer_get_time() - start;
+    spi_sim_get_stats(TP_SPI_HOST, &after);
+    report("per-channel", elapsed, &before, &after);
+
+    // 突发：全部通道的过采样在一个全双工事务中完成
+    spi_sim_get_stats(TP_SPI_HOST, &before);
+    start = esp_timer_get_time();
+    for (int r = 0; r < ROUNDS; r++) {
+        tp_spi_xchg(tx, rx, BURST_LEN);
+        for (int i = 0; i < CHANNELS * XPT2046_OVERSAMPLE; i++) {
+            if ((((rx[2 * i + 1] << 8) | rx[2 * i + 2]) >> 3) != expected[i % CHANNELS]) failed = 1;
+        }
+    }
+    elapsed = esp_timer_get_time() - start;
+    spi_sim_get_stats(TP_SPI_HOST, &after);
+    report("burst", elapsed, &before, &after);
+
+    if (failed) printf("[bench_xpt2046] conversion results do not match the script\n");
+    return failed;
+}
@@ -0,0 +1,70 @@
+/**
+ * @file lv_conf.h
+ * 主机仿真构建使用的LVGL配置，与ESP32-S3目标上的menuconfig保持一致：
+ * RGB565、无操作系统、单个软件绘制单元。未列出的选项取lv_conf_internal.h中的默认值。
+ * LV_PORT_DRAW_UNIT_CNT由CMake传入，大于1时对应目标板的双核渲染模式，线程用lv_pthread。
+ */
+
+#ifndef LV_CONF_H
+#define LV_CONF_H
+
+#define LV_COLOR_DEPTH              16
+
+#define LV_USE_STDLIB_MALLOC        LV_STDLIB_BUILTIN
+#define LV_USE_STDLIB_STRING        LV_STDLIB_BUILTIN
+#define LV_USE_STDLIB_SPRINTF       LV_STDLIB_BUILTIN
+#define LV_MEM_SIZE                 (512 * 1024U)   /* 比目标板大，容纳整屏快照 */
+
+#define LV_DEF_REFR_PERIOD          33
+#define LV_DPI_DEF                  130
+
+/* RGB565填充和图像混合使用按字并行的SWAR内核 */
+#define LV_USE_DRAW_SW_SWAR         1
+
+/* LV_PORT_DRAW_SW_ASM_CUSTOM由CMake传入：钩子改用rgb565_blend.h（PIE内核的调度，主机上为C参考模型） */
+#if LV_PORT_DRAW_SW_ASM_CUSTOM
+#define LV_USE_DRAW_SW_ASM              LV_DRAW_SW_ASM_CUSTOM
+#define LV_DRAW_SW_ASM_CUSTOM_INCLUDE   "lvgl_esp32_drivers/lvgl_port/include/rgb565_blend.h"
+#endif
+
+#ifndef LV_PORT_DRAW_UNIT_CNT
+#define LV_PORT_DRAW_UNIT_CNT       1
+#endif
+
+#if LV_PORT_DRAW_UNIT_CNT > 1
+#define LV_USE_OS                   LV_OS_PTHREAD
+#define LV_DRAW_SW_DRAW_UNIT_CNT    LV_PORT_DRAW_UNIT_CNT
+#else
+#define LV_USE_OS                   LV_OS_NONE
+#endif
+
+#define LV_USE_LOG                  0
+#define LV_USE_ASSERT_NULL          1
+#define LV_USE_ASSERT_MALLOC        1
+
+#define LV_FONT_MONTSERRAT_14       1
+#define LV_FONT_MONTSERRAT_24       1       /* lv_demo_benchmark需要 */
+#define LV_FONT_MONTSERRAT_28_COMPRESSED 1  /* bench_glyph_cache：压缩字形的解码代价 */
+#define LV_USE_FONT_COMPRESSED      1
+#define LV_FONT_SIMSUN_16_CJK       1       /* 中文标签 */
+#define LV_USE_FONT_FMT_TXT_LUT     1       /* 大字体的字形ID和字距哈希表 */
+#define LV_FONT_DEFAULT             &lv_font_montserrat_14
+
+#define LV_LABEL_LAYOUT_CACHE       1       /* 标签缓存换行位置和字宽，重绘时不再逐字测量 */
+
+#define LV_USE_SNAPSHOT             1
+
+/* 内置分析器编译进来，lv_port_set_trace_output设置输出后才记录 */
+#define LV_USE_PROFILER             1
+#define LV_PROFILER_INCLUDE         "src/misc/lv_profiler_builtin.h"
+
+/* lv_port_show_perf_stats的sysmon叠加层；不启用FPS/CPU和内存监视器 */
+#define LV_USE_SYSMON               1
+
+#define LV_BUILD_EXAMPLES           0
+
+/* bench_render运行lv_demo_benchmark */
+#define LV_USE_DEMO_WIDGETS         1
+#define LV_USE_DEMO_BENCHMARK       1
+
+#endif /* LV_CONF_H */
@@ -0,0 +1,179 @@
+#ifndef __BLEND_REF_H
+#define __BLEND_REF_H
+
+#include <string.h>
+#include "lvgl.h"
+#include "src/draw/sw/blend/lv_draw_sw_blend_private.h"
+
+// LVGL的RGB565参考循环（lv_draw_sw_blend_to_rgb565.c中钩子返回LV_RESULT_INVALID时执行的代码），
+// 原样复制：启用加速内核后库里的这部分不再编译，test_draw_blend和bench_draw_blend用它校验和对照
+
+static inline void *blend_ref_next_row(const void *buf, int32_t stride)
+{
+    return (void *)((uint8_t *)buf + stride);
+}
+
+/**
+ * @brief 纯色填充：按mask和opa分为四种情况
+ */
+static void blend_ref_color_to_rgb565(lv_draw_sw_blend_fill_dsc_t *dsc)
+{
+    int32_t w = dsc->dest_w;
+    int32_t h = dsc->dest_h;
+    uint16_t color16 = lv_color_to_u16(dsc->color);
+    lv_opa_t opa = dsc->opa;
+    const lv_opa_t *mask = dsc->mask_buf;
+    int32_t mask_stride = dsc->mask_stride;
+    uint16_t *dest_buf_u16 = dsc->dest_buf;
+    int32_t dest_stride = dsc->dest_stride;
+    int32_t x, y;
+
+    if (mask == NULL && opa >= LV_OPA_MAX) {
+        for (y = 0; y < h; y++) {
+            uint16_t *dest_end_final = dest_buf_u16 + w;
+            uint32_t *dest_end_mid = (uint32_t *)((uint16_t *)dest_buf_u16 + ((w - 1) & ~(0xF)));
+            if ((lv_uintptr_t)&dest_buf_u16[0] & 0x3) {
+                dest_buf_u16[0] = color16;
+                dest_buf_u16++;
+            }
+
+            uint32_t c32 = (uint32_t)color16 + ((uint32_t)color16 << 16);
+            uint32_t *dest32 = (uint32_t *)dest_buf_u16;
+            while (dest32 < dest_end_mid) {
+                dest32[0] = c32;
+                dest32[1] = c32;
+                dest32[2] = c32;
+                dest32[3] = c32;
+                dest32[4] = c32;
+                dest32[5] = c32;
+                dest32[6] = c32;
+                dest32[7] = c32;
+                dest32 += 8;
+            }
+
+            dest_buf_u16 = (uint16_t *)dest32;
+            while (dest_buf_u16 < dest_end_final) {
+                *dest_buf_u16 = color16;
+                dest_buf_u16++;
+            }
+
+            dest_buf_u16 = blend_ref_next_row(dest_buf_u16, dest_stride);
+            dest_buf_u16 -= w;
+        }
+    }
+    else if (mask == NULL && opa < LV_OPA_MAX) {
+        uint32_t last_dest32_color = dest_buf_u16[0] + 1;
+        uint32_t last_res32_color = 0;
+
+        for (y = 0; y < h; y++) {
+            x = 0;
+            if ((lv_uintptr_t)&dest_buf_u16[0] & 0x3) {
+                dest_buf_u16[0] = lv_color_16_16_mix(color16, dest_buf_u16[0], opa);
+                x = 1;
+            }
+
+            for (; x < w - 2; x += 2) {
+                if (dest_buf_u16[x] != dest_buf_u16[x + 1]) {
+                    dest_buf_u16[x + 0] = lv_color_16_16_mix(color16, dest_buf_u16[x + 0], opa);
+                    dest_buf_u16[x + 1] = lv_color_16_16_mix(color16, dest_buf_u16[x + 1], opa);
+                }
+                else {
+                    volatile uint32_t *dest32 = (uint32_t *)&dest_buf_u16[x];
+                    if (last_dest32_color == *dest32) {
+                        *dest32 = last_res32_color;
+                    }
+                    else {
+                        last_dest32_color = *dest32;
+                        dest_buf_u16[x] = lv_color_16_16_mix(color16, dest_buf_u16[x + 0], opa);
+                        dest_buf_u16[x + 1] = dest_buf_u16[x];
+                        last_res32_color = *dest32;
+                    }
+                }
+            }
+
+            for (; x < w; x++) {
+                dest_buf_u16[x] = lv_color_16_16_mix(color16, dest_buf_u16[x], opa);
+            }
+            dest_buf_u16 = blend_ref_next_row(dest_buf_u16, dest_stride);
+        }
+    }
+    else if (mask && opa >= LV_OPA_MAX) {
+        for (y = 0; y < h; y++) {
+            x = 0;
+            if ((lv_uintptr_t)(mask) & 0x1) {
+                dest_buf_u16[x] = lv_color_16_16_mix(color16, dest_buf_u16[x], mask[x]);
+                x++;
+            }
+
+            for (; x <= w - 2; x += 2) {
+                uint16_t mask16 = *((uint16_t *)&mask[x]);
+                if (mask16 == 0xFFFF) {
+                    dest_buf_u16[x + 0] = color16;
+                    dest_buf_u16[x + 1] = color16;
+                }
+                else if (mask16 != 0) {
+                    dest_buf_u16[x + 0] = lv_color_16_16_mix(color16, dest_buf_u16[x + 0], mask[x + 0]);
+                    dest_buf_u16[x + 1] = lv_color_16_16_mix(color16, dest_buf_u16[x + 1], mask[x + 1]);
+                }
+            }
+
+            for (; x < w; x++) {
+                dest_buf_u16[x] = lv_color_16_16_mix(color16, dest_buf_u16[x], mask[x]);
+            }
+            dest_buf_u16 = blend_ref_next_row(dest_buf_u16, dest_stride);
+            mask += mask_stride;
+        }
+    }
+    else {
+        for (y = 0; y < h; y++) {
+            for (x = 0; x < w; x++) {
+                dest_buf_u16[x] = lv_color_16_16_mix(color16, dest_buf_u16[x], LV_OPA_MIX2(mask[x], opa));
+            }
+            dest_buf_u16 = blend_ref_next_row(dest_buf_u16, dest_stride);
+            mask += mask_stride;
+        }
+    }
+}
+
+/**
+ * @brief RGB565图像以NORMAL模式混合到RGB565
+ */
+static void blend_ref_rgb565_to_rgb565(lv_draw_sw_blend_image_dsc_t *dsc)
+{
+    int32_t w = dsc->dest_w;
+    int32_t h = dsc->dest_h;
+    lv_opa_t opa = dsc->opa;
+    uint16_t *dest_buf_u16 = dsc->dest_buf;
+    int32_t dest_stride = dsc->dest_stride;
+    const uint16_t *src_buf_u16 = dsc->src_buf;
+    int32_t src_stride = dsc->src_stride;
+    const lv_opa_t *mask_buf = dsc->mask_buf;
+    int32_t mask_stride = dsc->mask_stride;
+    int32_t x, y;
+
+    for (y = 0; y < h; y++) {
+        if (mask_buf == NULL && opa >= LV_OPA_MAX) {
+            memcpy(dest_buf_u16, src_buf_u16, w * 2);
+        }
+        else if (mask_buf == NULL) {
+            for (x = 0; x < w; x++) {
+                dest_buf_u16[x] = lv_color_16_16_mix(src_buf_u16[x], dest_buf_u16[x], opa);
+            }
+        }
+        else if (opa >= LV_OPA_MAX) {
+            for (x = 0; x < w; x++) {
+                dest_buf_u16[x] = lv_color_16_16_mix(src_buf_u16[x], dest_buf_u16[x], mask_buf[x]);
+            }
+        }
+        else {
+            for (x = 0; x < w; x++) {
+                dest_buf_u16[x] = lv_color_16_16_mix(src_buf_u16[x], dest_buf_u16[x], LV_OPA_MIX2(mask_buf[x], opa));
+            }
+        }
+        dest_buf_u16 = blend_ref_next_row(dest_buf_u16, dest_stride);
+        src_buf_u16 = blend_ref_next_row(src_buf_u16, src_stride);
+        if (mask_buf) mask_buf += mask_stride;
+    }
+}
+
+#endif /* __BLEND_REF_H */
@@ -0,0 +1,138 @@
+#include <stdlib.h>
+#include "unity.h"
+#include "lvgl_port.h"
+#include "area_merge.h"
+#include "spi_sim.h"
+#include "ili9341_sim.h"
+#include "src/misc/lv_area_private.h"
+
+// 脏区域合并：代价模型下的合并决定、结果覆盖全部输入，以及大量小区域失效时不退化为整屏刷新
+
+#define GRID_COLS   16
+#define GRID_ROWS   10
+#define DOT_SIZE    6
+
+static const area_merge_cost_t cost = {.window_ns = 100000, .px_ns = 400};
+
+static lv_obj_t *dots[GRID_ROWS * GRID_COLS];
+
+void setUp(void)
+{
+    disp_wait_for_pending_transactions();
+    spi_sim_set_time_scale(0);
+}
+
+void tearDown(void)
+{
+}
+
+void test_nearby_small_areas_merge(void)
+{
+    lv_area_t areas[] = {
+        {10, 10, 19, 19},
+        {22, 10, 31, 19},   // 右侧间隔2列
+        {10, 22, 31, 25},   // 下方间隔2行
+    };
+    TEST_ASSERT_EQUAL_UINT32(1, area_merge(areas, 3, 3, &cost));
+    TEST_ASSERT_EQUAL_INT32(10, areas[0].x1);
+    TEST_ASSERT_EQUAL_INT32(10, areas[0].y1);
+    TEST_ASSERT_EQUAL_INT32(31, areas[0].x2);
+    TEST_ASSERT_EQUAL_INT32(25, areas[0].y2);
+}
+
+void test_distant_large_areas_stay_separate(void)
+{
+    lv_area_t areas[] = {
+        {0, 180, 99, 229},
+        {0, 0, 99, 49},
+    };
+    // 外接矩形多出100x130个像素，远超一次固定开销
+    TEST_ASSERT_EQUAL_UINT32(2, area_merge(areas, 2, 2, &cost));
+    // 按max_cnt强制合并
+    TEST_ASSERT_EQUAL_UINT32(1, area_merge(areas, 2, 1, &cost));
+    TEST_ASSERT_EQUAL_INT32(0, areas[0].y1);
+    TEST_ASSERT_EQUAL_INT32(229, areas[0].y2);
+}
+
+void test_result_covers_inputs_within_max(void)
+{
+    enum { N = 300, MAX = 16 };
+    static lv_area_t input[N], merged[N];
+
+    srand(1);
+    for (int i = 0; i < N; i++) {
+        int32_t x = rand() % (LV_HOR_RES_MAX - 20), y = rand() % (LV_VER_RES_MAX - 20);
+        lv_area_set(&input[i], x, y, x + rand() % 20, y + rand() % 20);
+        merged[i] = input[i];
+    }
+
+    // 不限个数时只做划算的合并，总开销不增加
+    uint32_t cnt = area_merge(merged, N, N, &cost);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT64(area_merge_total_cost(input, N, &cost), area_merge_total_cost(merged, cnt, &cost));
+    cnt = area_merge(merged, cnt, MAX, &cost);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(MAX, cnt);
+    for (int i = 0; i < N; i++) {
+        bool covered = false;
+        for (uint32_t j = 0; j < cnt && !covered; j++) {
+            covered = lv_area_is_in(&input[i], &merged[j], 0);
+        }
+        TEST_ASSERT_TRUE_MESSAGE(covered, "input area not covered");
+    }
+}
+
+/**
+ * @brief 使所有小方块失效并刷新，返回写入面板的像素数
+ */
+static uint64_t refresh_dots(ili9341_sim_frame_t *frame)
+{
+    for (int i = 0; i < GRID_ROWS * GRID_COLS; i++) {
+        lv_obj_invalidate(dots[i]);
+    }
+    ili9341_sim_frame_begin();
+    lv_refr_now(NULL);
+    disp_wait_for_pending_transactions();
+    ili9341_sim_frame_end(frame);
+    return frame->pixels_written;
+}
+
+void test_many_small_invalidations_avoid_full_screen(void)
+{
+    ili9341_sim_frame_t frame;
+
+    // LVGL自带规则：超过LV_INV_BUF_SIZE个区域后整屏刷新
+    lv_port_set_area_merge(false);
+    TEST_ASSERT_EQUAL_UINT64(LV_HOR_RES_MAX * LV_VER_RES_MAX, refresh_dots(&frame));
+
+    // 按代价合并：同一行的小方块合并为一条，各行之间不合并
+    lv_port_set_area_merge(true);
+    uint64_t px = refresh_dots(&frame);
+    TEST_PRINTF("%d dots: %u windows, %u px", GRID_ROWS * GRID_COLS, (unsigned)frame.window_count, (unsigned)px);
+    TEST_ASSERT_LESS_THAN_UINT64(LV_HOR_RES_MAX * LV_VER_RES_MAX / 2, px);
+    TEST_ASSERT_GREATER_THAN_UINT32(1, frame.window_count);
+}
+
+int main(void)
+{
+    ili9341_sim_init(LCD_SPI_HOST, LCD_SPI_CS, LCD_SPI_DC, LCD_SPI_RST);
+    lv_port_init();
+
+    lv_obj_t *scr = lv_screen_active();
+    for (int r = 0; r < GRID_ROWS; r++) {
+        for (int c = 0; c < GRID_COLS; c++) {
+            lv_obj_t *dot = lv_obj_create(scr);
+            lv_obj_remove_style_all(dot);
+            lv_obj_set_style_bg_opa(dot, LV_OPA_COVER, 0);
+            lv_obj_set_pos(dot, c * (LV_HOR_RES_MAX / GRID_COLS) + 4, r * (LV_VER_RES_MAX / GRID_ROWS) + 4);
+            lv_obj_set_size(dot, DOT_SIZE, DOT_SIZE);
+            dots[r * GRID_COLS + c] = dot;
+        }
+    }
+    lv_refr_now(NULL);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_nearby_small_areas_merge);
+    RUN_TEST(test_distant_large_areas_stay_separate);
+    RUN_TEST(test_result_covers_inputs_within_max);
+    RUN_TEST(test_many_small_invalidations_avoid_full_screen);
+    return UNITY_END();
+}
@@ -0,0 +1,196 @@
+#include <stdlib.h>
+#include "unity.h"
+#include "lvgl_port.h"
+#include "src/misc/lv_area_private.h"
+#include "chart_stream.h"
+#include "spi_sim.h"
+#include "ili9341_sim.h"
+
+// 数据流曲线：列聚合与逐样本计算一致，循环模式只重绘新列，单个样本的尖峰在面板上可见
+
+#define CHART_X     10
+#define CHART_Y     20
+#define CHART_W     300
+#define CHART_H     200
+#define CAPACITY    10000
+#define PER_COL     ((CAPACITY + CHART_W - 1) / CHART_W)
+#define RED565      0xF800
+
+static lv_obj_t *chart;
+static chart_stream_t stream;
+static int32_t pushed[3 * CAPACITY];    // 按追加顺序保存的样本
+static uint32_t pushed_cnt;
+static lv_area_t invalidated;           // 自上次清零以来失效区域的外接矩形
+static bool any_invalidated;
+
+static void invalidate_event_cb(lv_event_t *e)
+{
+    const lv_area_t *area = lv_event_get_param(e);
+    if (!any_invalidated) {
+        invalidated = *area;
+    } else {
+        lv_area_join(&invalidated, &invalidated, area);
+    }
+    any_invalidated = true;
+}
+
+static void push(int32_t value)
+{
+    pushed[pushed_cnt++] = value;
+    chart_stream_push(&stream, value);
+}
+
+static void refresh(void)
+{
+    lv_refr_now(NULL);
+    disp_wait_for_pending_transactions();
+    any_invalidated = false;
+}
+
+/**
+ * @brief 逐样本计算序号为seq的列，与列聚合比较
+ */
+static void assert_column(uint32_t pos, uint32_t seq)
+{
+    chart_stream_col_t col;
+    TEST_ASSERT_TRUE(chart_stream_get_column(&stream, pos, &col));
+
+    int32_t min = INT32_MAX, max = INT32_MIN;
+    uint32_t end = LV_MIN((seq + 1) * PER_COL, pushed_cnt);
+    for (uint32_t i = seq * PER_COL; i < end; i++) {
+        min = LV_MIN(min, pushed[i]);
+        max = LV_MAX(max, pushed[i]);
+    }
+    TEST_ASSERT_EQUAL_INT32(min, col.min);
+    TEST_ASSERT_EQUAL_INT32(max, col.max);
+    TEST_ASSERT_EQUAL_INT32(pushed[end - 1], col.last);
+}
+
+void setUp(void)
+{
+    disp_wait_for_pending_transactions();
+    spi_sim_set_time_scale(0);
+    lv_chart_set_update_mode(chart, LV_CHART_UPDATE_MODE_SHIFT);
+    TEST_ASSERT_TRUE(chart_stream_init(&stream, chart, lv_color_hex(0xFF0000), LV_CHART_AXIS_PRIMARY_Y, CAPACITY));
+    pushed_cnt = 0;
+}
+
+void tearDown(void)
+{
+    chart_stream_deinit(&stream);
+}
+
+void test_columns_match_per_sample_minmax(void)
+{
+    TEST_ASSERT_EQUAL_UINT32(CHART_W, stream.col_cnt);
+    TEST_ASSERT_EQUAL_UINT32(PER_COL, stream.per_col);
+
+    // 超过一圈，最新一列未满
+    srand(1);
+    for (uint32_t i = 0; i < CAPACITY * 2 + PER_COL / 2; i++) {
+        push(rand() % 20 == 0 ? rand() % 1000 : 400 + rand() % 50);
+    }
+    uint32_t newest = (pushed_cnt - 1) / PER_COL;
+
+    // 移动模式：最新一列在最右侧
+    for (uint32_t pos = 0; pos < CHART_W; pos++) {
+        assert_column(pos, newest - (CHART_W - 1 - pos));
+    }
+
+    // 循环模式：列按序号取模放置
+    lv_chart_set_update_mode(chart, LV_CHART_UPDATE_MODE_CIRCULAR);
+    for (uint32_t pos = 0; pos < CHART_W; pos++) {
+        uint32_t seq = newest - (newest % CHART_W + CHART_W - pos) % CHART_W;
+        assert_column(pos, seq);
+    }
+}
+
+void test_circular_mode_invalidates_new_columns_only(void)
+{
+    lv_area_t content;
+    lv_obj_get_content_coords(chart, &content);
+
+    lv_chart_set_update_mode(chart, LV_CHART_UPDATE_MODE_CIRCULAR);
+    for (uint32_t i = 0; i < PER_COL * 100; i++) push(500);
+    refresh();
+
+    // 新的一列：开始时失效一次，之后只有范围扩大时失效
+    for (uint32_t i = 0; i < PER_COL / 2; i++) push(500 + (int32_t)i);
+    TEST_ASSERT_TRUE(any_invalidated);
+    TEST_PRINTF("circular: %d px wide invalidated for one column", (int)lv_area_get_width(&invalidated));
+    TEST_ASSERT_LESS_OR_EQUAL_INT32(8, lv_area_get_width(&invalidated));
+    TEST_ASSERT_INT32_WITHIN(4, content.x1 + 100, invalidated.x1);
+    refresh();
+
+    // 样本不改变最新一列的范围时不失效
+    for (uint32_t i = PER_COL / 2; i < PER_COL; i++) push(500);
+    TEST_ASSERT_FALSE(any_invalidated);
+    refresh();
+
+    // 移动模式：整个绘图区左移
+    lv_chart_set_update_mode(chart, LV_CHART_UPDATE_MODE_SHIFT);
+    refresh();
+    for (uint32_t i = 0; i < PER_COL; i++) push(500);
+    TEST_ASSERT_TRUE(any_invalidated);
+    TEST_ASSERT_GREATER_OR_EQUAL_INT32(lv_area_get_width(&content), lv_area_get_width(&invalidated));
+    refresh();
+}
+
+void test_single_sample_spike_is_drawn(void)
+{
+    lv_area_t content;
+    lv_obj_get_content_coords(chart, &content);
+
+    for (uint32_t i = 0; i < CAPACITY; i++) push(i == CAPACITY / 2 ? 900 : 100);
+    refresh();
+
+    // 尖峰所在的列：最新一列在最右侧
+    uint32_t newest = (pushed_cnt - 1) / PER_COL;
+    uint32_t pos = CHART_W - 1 - (newest - (CAPACITY / 2) / PER_COL);
+    int32_t y_mid = content.y2 + 1 - 500 * lv_area_get_height(&content) / 1000;
+    TEST_ASSERT_EQUAL_HEX16(RED565, ili9341_sim_get_pixel(content.x1 + pos, y_mid));
+    // 相邻的列只有基线
+    TEST_ASSERT_NOT_EQUAL_UINT16(RED565, ili9341_sim_get_pixel(content.x1 + pos - 3, y_mid));
+}
+
+void test_one_pixel_wide_content_draws_nothing(void)
+{
+    // 内边距把内容区压到一个像素宽：没有可连的线，绘制直接返回
+    lv_obj_set_style_pad_left(chart, CHART_W / 2, 0);
+    lv_obj_set_style_pad_right(chart, CHART_W / 2 - 1, 0);
+    TEST_ASSERT_EQUAL_INT32(1, lv_obj_get_content_width(chart));
+
+    for (uint32_t i = 0; i < 100; i++) push(900);
+    lv_obj_invalidate(chart);
+    refresh();
+
+    lv_area_t content;
+    lv_obj_get_content_coords(chart, &content);
+    int32_t y = content.y2 + 1 - 900 * lv_area_get_height(&content) / 1000;
+    TEST_ASSERT_NOT_EQUAL_UINT16(RED565, ili9341_sim_get_pixel(content.x1, y));
+
+    lv_obj_set_style_pad_hor(chart, 0, 0);
+    refresh();
+}
+
+int main(void)
+{
+    ili9341_sim_init(LCD_SPI_HOST, LCD_SPI_CS, LCD_SPI_DC, LCD_SPI_RST);
+    lv_port_init();
+
+    chart = lv_chart_create(lv_screen_active());
+    lv_obj_set_pos(chart, CHART_X, CHART_Y);
+    lv_obj_set_size(chart, CHART_W, CHART_H);
+    lv_obj_set_style_pad_all(chart, 0, 0);
+    lv_obj_set_style_border_width(chart, 0, 0);
+    lv_chart_set_range(chart, LV_CHART_AXIS_PRIMARY_Y, 0, 1000);
+    lv_display_add_event_cb(lv_display_get_default(), invalidate_event_cb, LV_EVENT_INVALIDATE_AREA, NULL);
+    refresh();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_columns_match_per_sample_minmax);
+    RUN_TEST(test_circular_mode_invalidates_new_columns_only);
+    RUN_TEST(test_single_sample_spike_is_drawn);
+    RUN_TEST(test_one_pixel_wide_content_draws_nothing);
+    return UNITY_END();
+}
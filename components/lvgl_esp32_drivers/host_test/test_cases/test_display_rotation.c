@@ -0,0 +1,194 @@
+#include "unity.h"
+#include "lvgl_port.h"
+#include "spi_sim.h"
+#include "ili9341_sim.h"
+#include "xpt2046_sim.h"
+#include "esp_timer.h"
+
+// 显示旋转：lv_display_set_rotation改由面板的MADCTL完成，面板上看到的画面与LVGL的旋转约定一致，
+// 触摸点经LVGL换算后落在旋转后的控件上
+
+#define RAW_FOR(px, res, min, max)  ((uint16_t)(2 * ((min) + ((px) * ((max) - (min)) + (res) - 1) / (res))))
+
+#define MARK_X      10
+#define MARK_Y      20
+#define MARK_W      30
+#define MARK_H      12
+#define RED565      0xF800
+#define WHITE565    0xFFFF
+
+static lv_obj_t *mark;
+static int64_t mark_pressed;
+static lv_point_t mark_point;
+
+/**
+ * @brief 逻辑坐标在横向观看的面板上的位置（lv_display_rotate_area的约定）
+ */
+static void logical_to_panel(lv_display_rotation_t rotation, int32_t x, int32_t y, int32_t *px, int32_t *py)
+{
+    switch (rotation) {
+    case LV_DISPLAY_ROTATION_90:
+        *px = y;
+        *py = LV_VER_RES_MAX - 1 - x;
+        break;
+    case LV_DISPLAY_ROTATION_180:
+        *px = LV_HOR_RES_MAX - 1 - x;
+        *py = LV_VER_RES_MAX - 1 - y;
+        break;
+    case LV_DISPLAY_ROTATION_270:
+        *px = LV_HOR_RES_MAX - 1 - y;
+        *py = x;
+        break;
+    default:
+        *px = x;
+        *py = y;
+        break;
+    }
+}
+
+static uint16_t panel_at(lv_display_rotation_t rotation, int32_t x, int32_t y)
+{
+    int32_t px, py;
+    logical_to_panel(rotation, x, y, &px, &py);
+    return ili9341_sim_get_pixel(px, py);
+}
+
+static void refresh(ili9341_sim_frame_t *frame)
+{
+    ili9341_sim_frame_begin();
+    lv_refr_now(NULL);
+    disp_wait_for_pending_transactions();
+    ili9341_sim_frame_end(frame);
+}
+
+static void mark_event_cb(lv_event_t *e)
+{
+    lv_indev_get_point(lv_indev_active(), &mark_point);
+    mark_pressed = esp_timer_get_time();
+}
+
+void setUp(void)
+{
+    disp_wait_for_pending_transactions();
+    spi_sim_set_time_scale(0);
+}
+
+void tearDown(void)
+{
+    lv_port_set_shadow_diff(false);
+    lv_display_set_rotation(NULL, LV_DISPLAY_ROTATION_0);
+    lv_refr_now(NULL);
+    disp_wait_for_pending_transactions();
+}
+
+void test_rotation_programs_madctl_and_panel(void)
+{
+    static const uint8_t madctl[] = {0x28, 0x48, 0xE8, 0x88};
+
+    for (int r = LV_DISPLAY_ROTATION_0; r <= LV_DISPLAY_ROTATION_270; r++) {
+        ili9341_sim_frame_t frame;
+        lv_display_set_rotation(NULL, r);
+        refresh(&frame);
+
+        TEST_ASSERT_EQUAL_HEX8(madctl[r], ili9341_sim_get_madctl());
+        TEST_ASSERT_EQUAL_UINT64(LV_HOR_RES_MAX * LV_VER_RES_MAX, frame.pixels_written);
+        // 标记的四角在内，紧邻的外侧不在内：位置、方向和镜像都正确
+        TEST_ASSERT_EQUAL_HEX16(RED565, panel_at(r, MARK_X, MARK_Y));
+        TEST_ASSERT_EQUAL_HEX16(RED565, panel_at(r, MARK_X + MARK_W - 1, MARK_Y));
+        TEST_ASSERT_EQUAL_HEX16(RED565, panel_at(r, MARK_X, MARK_Y + MARK_H - 1));
+        TEST_ASSERT_EQUAL_HEX16(RED565, panel_at(r, MARK_X + MARK_W - 1, MARK_Y + MARK_H - 1));
+        TEST_ASSERT_EQUAL_HEX16(WHITE565, panel_at(r, MARK_X - 1, MARK_Y));
+        TEST_ASSERT_EQUAL_HEX16(WHITE565, panel_at(r, MARK_X + MARK_W, MARK_Y + MARK_H - 1));
+        TEST_ASSERT_EQUAL_HEX16(WHITE565, panel_at(r, MARK_X, MARK_Y - 1));
+        TEST_ASSERT_EQUAL_HEX16(WHITE565, panel_at(r, MARK_X + MARK_W - 1, MARK_Y + MARK_H));
+    }
+}
+
+void test_shadow_diff_follows_rotation(void)
+{
+    ili9341_sim_frame_t frame;
+
+    TEST_ASSERT_TRUE(lv_port_set_shadow_diff(true));
+    refresh(&frame);
+    lv_display_set_rotation(NULL, LV_DISPLAY_ROTATION_90);
+    refresh(&frame);
+    TEST_ASSERT_EQUAL_UINT64(LV_HOR_RES_MAX * LV_VER_RES_MAX, frame.pixels_written);
+    TEST_ASSERT_EQUAL_HEX16(RED565, panel_at(LV_DISPLAY_ROTATION_90, MARK_X + MARK_W - 1, MARK_Y + MARK_H - 1));
+
+    // 副本按旋转后的宽高建立，重绘没有变化
+    lv_obj_invalidate(lv_screen_active());
+    refresh(&frame);
+    TEST_ASSERT_EQUAL_UINT64(0, frame.pixels_written);
+
+    lv_obj_set_x(mark, MARK_X + 1);
+    refresh(&frame);
+    TEST_ASSERT_GREATER_THAN_UINT64(0, frame.pixels_written);
+    TEST_ASSERT_EQUAL_HEX16(WHITE565, panel_at(LV_DISPLAY_ROTATION_90, MARK_X, MARK_Y));
+    TEST_ASSERT_EQUAL_HEX16(RED565, panel_at(LV_DISPLAY_ROTATION_90, MARK_X + MARK_W, MARK_Y));
+    lv_obj_set_x(mark, MARK_X);
+}
+
+void test_touch_follows_rotation(void)
+{
+    // 纵向的下部：面板上的横坐标超过纵向的宽度
+    const int32_t mark_y = 280;
+    spi_sim_set_time_scale(100);
+    lv_display_set_rotation(NULL, LV_DISPLAY_ROTATION_90);
+    lv_obj_set_y(mark, mark_y);
+    lv_refr_now(NULL);
+
+    // 在面板上标记中心的位置按下（触摸屏不随显示旋转）
+    int32_t cx = MARK_X + MARK_W / 2, cy = mark_y + MARK_H / 2, px, py;
+    logical_to_panel(LV_DISPLAY_ROTATION_90, cx, cy, &px, &py);
+    const xpt2046_sim_sample_t sample = {
+        .x = RAW_FOR(px, LV_HOR_RES_MAX, XPT2046_X_MIN, XPT2046_X_MAX),
+        .y = RAW_FOR(py, LV_VER_RES_MAX, XPT2046_Y_MIN, XPT2046_Y_MAX),
+        .z1 = 600,
+        .z2 = 3000,
+    };
+    mark_pressed = 0;
+    xpt2046_sim_press(&sample, 1);
+
+    int64_t end = esp_timer_get_time() + 200000;
+    while (mark_pressed == 0 && esp_timer_get_time() < end) {
+        lv_port_sleep(lv_port_handler());
+    }
+    xpt2046_sim_release();
+    end = esp_timer_get_time() + 3 * XPT2046_SAMPLE_PERIOD_MS * 1000;
+    while (esp_timer_get_time() < end) {
+        lv_port_sleep(lv_port_handler());
+    }
+
+    lv_obj_set_y(mark, MARK_Y);
+    TEST_ASSERT_NOT_EQUAL_INT64(0, mark_pressed);
+    TEST_ASSERT_INT32_WITHIN(1, cx, mark_point.x);
+    TEST_ASSERT_INT32_WITHIN(1, cy, mark_point.y);
+}
+
+int main(void)
+{
+    ili9341_sim_init(LCD_SPI_HOST, LCD_SPI_CS, LCD_SPI_DC, LCD_SPI_RST);
+    lv_port_init();
+    xpt2046_sim_init(TP_SPI_CS, TP_SPI_IRQ);
+
+    lv_obj_t *scr = lv_screen_active();
+    lv_obj_remove_style_all(scr);
+    lv_obj_set_style_bg_opa(scr, LV_OPA_COVER, 0);
+    lv_obj_set_style_bg_color(scr, lv_color_white(), 0);
+
+    mark = lv_obj_create(scr);
+    lv_obj_remove_style_all(mark);
+    lv_obj_set_style_bg_opa(mark, LV_OPA_COVER, 0);
+    lv_obj_set_style_bg_color(mark, lv_color_hex(0xFF0000), 0);
+    lv_obj_set_pos(mark, MARK_X, MARK_Y);
+    lv_obj_set_size(mark, MARK_W, MARK_H);
+    lv_obj_add_flag(mark, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_add_event_cb(mark, mark_event_cb, LV_EVENT_PRESSED, NULL);
+    lv_refr_now(NULL);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_rotation_programs_madctl_and_panel);
+    RUN_TEST(test_shadow_diff_follows_rotation);
+    RUN_TEST(test_touch_follows_rotation);
+    return UNITY_END();
+}
@@ -0,0 +1,345 @@
+#include <string.h>
+#include "unity.h"
+#include "lvgl_port.h"
+#include "blend_ref.h"
+#include "src/draw/sw/blend/lv_draw_sw_blend_to_rgb565.h"
+#include "src/draw/sw/blend/swar/lv_blend_swar.h"
+#include "rgb565_blend.h"
+
+// RGB565混合内核：SWAR实现和PIE内核的C参考模型（rgb565_blend.c）与LVGL参考循环逐位一致。
+// 覆盖各种宽度、起始对齐、行跨距、全部256个不透明度，以及全覆盖/全透明/部分覆盖混合的遮罩
+
+#define MAX_W       150             // 大于PIE调度的暂存块（64像素）加头部
+#define MAX_H       5
+#define STRIDE_PX   (MAX_W + 5)     // 行跨距大于宽度
+#define BUF_PX      (STRIDE_PX * MAX_H + 8)
+
+static uint16_t dest_ref[BUF_PX] __attribute__((aligned(16)));
+static uint16_t dest_swar[BUF_PX] __attribute__((aligned(16)));
+static uint16_t src[BUF_PX] __attribute__((aligned(16)));
+static lv_opa_t mask[BUF_PX + 8] __attribute__((aligned(16)));
+
+static const int32_t widths[] = { 1, 2, 3, 4, 5, 7, 8, 9, 16, 17, 31, 64, 67, 100, MAX_W };
+static const lv_opa_t opas[] = { 0, 1, 3, 4, 5, 64, 127, 128, 200, 251, 252, LV_OPA_MAX, LV_OPA_COVER };
+
+static uint32_t seed = 1;
+
+static uint32_t rnd(void)
+{
+    seed = seed * 1103515245u + 12345u;
+    return seed >> 8;
+}
+
+/**
+ * @brief 目标缓冲区：随机像素中夹着相同颜色的段，用到“上一个字”的结果缓存
+ */
+static void fill_dest(void)
+{
+    for (int i = 0; i < BUF_PX; i++) {
+        dest_ref[i] = (rnd() & 3) == 0 && i > 0 ? dest_ref[i - 1] : (uint16_t)rnd();
+        src[i] = (uint16_t)rnd();
+    }
+    memcpy(dest_swar, dest_ref, sizeof(dest_ref));
+}
+
+/**
+ * @brief 遮罩：全覆盖、全透明和随机值的段
+ */
+static void fill_mask(void)
+{
+    int i = 0;
+    while (i < (int)sizeof(mask)) {
+        int run = 1 + rnd() % 9;
+        int kind = rnd() % 3;
+        for (; run > 0 && i < (int)sizeof(mask); run--, i++) {
+            mask[i] = kind == 0 ? LV_OPA_COVER : kind == 1 ? LV_OPA_TRANSP : (lv_opa_t)rnd();
+        }
+    }
+}
+
+static void init_fill_dsc(lv_draw_sw_blend_fill_dsc_t *dsc, uint16_t *dest, int32_t ofs, int32_t w, int32_t h,
+                          lv_opa_t opa, bool masked, int32_t mask_ofs)
+{
+    memset(dsc, 0, sizeof(*dsc));
+    dsc->dest_buf = dest + ofs;
+    dsc->dest_w = w;
+    dsc->dest_h = h;
+    dsc->dest_stride = STRIDE_PX * 2;
+    dsc->color = lv_color_hex(0x3a7bd5);
+    dsc->opa = opa;
+    dsc->mask_buf = masked ? mask + mask_ofs : NULL;
+    dsc->mask_stride = STRIDE_PX;
+}
+
+static void init_image_dsc(lv_draw_sw_blend_image_dsc_t *dsc, uint16_t *dest, int32_t ofs, int32_t src_ofs,
+                           int32_t w, int32_t h, lv_opa_t opa, bool masked, int32_t mask_ofs)
+{
+    memset(dsc, 0, sizeof(*dsc));
+    dsc->dest_buf = dest + ofs;
+    dsc->dest_w = w;
+    dsc->dest_h = h;
+    dsc->dest_stride = STRIDE_PX * 2;
+    dsc->src_buf = src + src_ofs;
+    dsc->src_stride = STRIDE_PX * 2;
+    dsc->src_color_format = LV_COLOR_FORMAT_RGB565;
+    dsc->blend_mode = LV_BLEND_MODE_NORMAL;
+    dsc->opa = opa;
+    dsc->mask_buf = masked ? mask + mask_ofs : NULL;
+    dsc->mask_stride = STRIDE_PX;
+}
+
+static void assert_same(int32_t w, int32_t ofs, lv_opa_t opa)
+{
+    char msg[64];
+    snprintf(msg, sizeof(msg), "w %d ofs %d opa %d", (int)w, (int)ofs, opa);
+    TEST_ASSERT_EQUAL_HEX16_ARRAY_MESSAGE(dest_ref, dest_swar, BUF_PX, msg);
+}
+
+void setUp(void)
+{
+    seed = 1;
+}
+
+void tearDown(void)
+{
+}
+
+/**
+ * @brief 经LVGL的填充入口（钩子宏）与参考循环比较：四种填充都走SWAR内核，
+ *        自定义汇编模式的构建（LV_PORT_DRAW_SW_ASM_CUSTOM）中走rgb565_blend的调度和C参考模型
+ */
+void test_fill_matches_reference(void)
+{
+    for (int masked = 0; masked < 2; masked++) {
+        for (size_t o = 0; o < sizeof(opas); o++) {
+            for (size_t wi = 0; wi < sizeof(widths) / sizeof(widths[0]); wi++) {
+                for (int32_t ofs = 0; ofs < 4; ofs++) {
+                    lv_draw_sw_blend_fill_dsc_t dsc;
+                    int32_t mask_ofs = (int32_t)(rnd() % 4);
+                    fill_dest();
+                    fill_mask();
+                    init_fill_dsc(&dsc, dest_ref, ofs, widths[wi], MAX_H, opas[o], masked, mask_ofs);
+                    blend_ref_color_to_rgb565(&dsc);
+                    init_fill_dsc(&dsc, dest_swar, ofs, widths[wi], MAX_H, opas[o], masked, mask_ofs);
+                    lv_draw_sw_blend_color_to_rgb565(&dsc);
+                    assert_same(widths[wi], ofs, opas[o]);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief RGB565图像混合：源和目标的对齐互不相同
+ */
+void test_rgb565_image_matches_reference(void)
+{
+    for (int masked = 0; masked < 2; masked++) {
+        for (size_t o = 0; o < sizeof(opas); o++) {
+            for (size_t wi = 0; wi < sizeof(widths) / sizeof(widths[0]); wi++) {
+                for (int32_t ofs = 0; ofs < 4; ofs++) {
+                    lv_draw_sw_blend_image_dsc_t dsc;
+                    int32_t src_ofs = (int32_t)(rnd() % 4);
+                    int32_t mask_ofs = (int32_t)(rnd() % 4);
+                    fill_dest();
+                    fill_mask();
+                    init_image_dsc(&dsc, dest_ref, ofs, src_ofs, widths[wi], MAX_H, opas[o], masked, mask_ofs);
+                    blend_ref_rgb565_to_rgb565(&dsc);
+                    init_image_dsc(&dsc, dest_swar, ofs, src_ofs, widths[wi], MAX_H, opas[o], masked, mask_ofs);
+                    lv_draw_sw_blend_image_to_rgb565(&dsc);
+                    assert_same(widths[wi], ofs, opas[o]);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief 直接调用各个内核，全部256个不透明度（包括入口不会传入的>=LV_OPA_MAX）
+ */
+void test_all_opacities(void)
+{
+    for (int opa = 0; opa <= 255; opa++) {
+        lv_draw_sw_blend_fill_dsc_t fdsc;
+        lv_draw_sw_blend_image_dsc_t idsc;
+
+        fill_dest();
+        fill_mask();
+        init_fill_dsc(&fdsc, dest_ref, 1, MAX_W, MAX_H, (lv_opa_t)opa, false, 0);
+        for (int32_t y = 0; y < MAX_H; y++) {
+            for (int32_t x = 0; x < MAX_W; x++) {
+                uint16_t *p = &dest_ref[1 + y * STRIDE_PX + x];
+                *p = lv_color_16_16_mix(lv_color_to_u16(fdsc.color), *p, (uint8_t)opa);
+            }
+        }
+        init_fill_dsc(&fdsc, dest_swar, 1, MAX_W, MAX_H, (lv_opa_t)opa, false, 0);
+        lv_color_blend_to_rgb565_with_opa_swar(&fdsc);
+        assert_same(MAX_W, 1, (lv_opa_t)opa);
+
+        fill_dest();
+        init_image_dsc(&idsc, dest_ref, 0, 1, MAX_W, MAX_H, (lv_opa_t)opa, false, 0);
+        for (int32_t y = 0; y < MAX_H; y++) {
+            for (int32_t x = 0; x < MAX_W; x++) {
+                uint16_t *p = &dest_ref[y * STRIDE_PX + x];
+                *p = lv_color_16_16_mix(src[1 + y * STRIDE_PX + x], *p, (uint8_t)opa);
+            }
+        }
+        init_image_dsc(&idsc, dest_swar, 0, 1, MAX_W, MAX_H, (lv_opa_t)opa, false, 0);
+        lv_rgb565_blend_normal_to_rgb565_with_opa_swar(&idsc);
+        assert_same(MAX_W, 0, (lv_opa_t)opa);
+
+        // 遮罩加不透明度
+        fill_dest();
+        init_fill_dsc(&fdsc, dest_ref, 2, MAX_W, MAX_H, (lv_opa_t)opa, true, 1);
+        blend_ref_color_to_rgb565(&fdsc);
+        init_fill_dsc(&fdsc, dest_swar, 2, MAX_W, MAX_H, (lv_opa_t)opa, true, 1);
+        if (opa >= LV_OPA_MAX) lv_color_blend_to_rgb565_with_mask_swar(&fdsc);
+        else lv_color_blend_to_rgb565_mix_mask_opa_swar(&fdsc);
+        assert_same(MAX_W, 2, (lv_opa_t)opa);
+    }
+}
+
+/**
+ * @brief 按LVGL选择钩子的条件调用PIE混合的纯色入口
+ */
+static void pie_fill(lv_draw_sw_blend_fill_dsc_t *dsc)
+{
+    if (dsc->mask_buf == NULL && dsc->opa >= LV_OPA_MAX) rgb565_blend_color(dsc);
+    else if (dsc->mask_buf == NULL) rgb565_blend_color_with_opa(dsc);
+    else if (dsc->opa >= LV_OPA_MAX) rgb565_blend_color_with_mask(dsc);
+    else rgb565_blend_color_mix_mask_opa(dsc);
+}
+
+/**
+ * @brief PIE混合的图像入口；没有遮罩且不透明时LVGL直接复制，不经过钩子
+ */
+static void pie_image(lv_draw_sw_blend_image_dsc_t *dsc)
+{
+    if (dsc->mask_buf == NULL) rgb565_blend_image_with_opa(dsc);
+    else if (dsc->opa >= LV_OPA_MAX) rgb565_blend_image_with_mask(dsc);
+    else rgb565_blend_image_mix_mask_opa(dsc);
+}
+
+/**
+ * @brief PIE内核的C参考模型：目标的8种16字节对齐方式，头尾逐像素、中间按8像素块和64像素暂存块调度
+ */
+void test_pie_model_fill_matches_reference(void)
+{
+    TEST_ASSERT_EQUAL_STRING("model", rgb565_blend_impl_name());
+
+    for (int masked = 0; masked < 2; masked++) {
+        for (size_t o = 0; o < sizeof(opas); o++) {
+            for (size_t wi = 0; wi < sizeof(widths) / sizeof(widths[0]); wi++) {
+                for (int32_t ofs = 0; ofs < 8; ofs++) {
+                    lv_draw_sw_blend_fill_dsc_t dsc;
+                    int32_t mask_ofs = (int32_t)(rnd() % 8);
+                    fill_dest();
+                    fill_mask();
+                    init_fill_dsc(&dsc, dest_ref, ofs, widths[wi], MAX_H, opas[o], masked, mask_ofs);
+                    blend_ref_color_to_rgb565(&dsc);
+                    init_fill_dsc(&dsc, dest_swar, ofs, widths[wi], MAX_H, opas[o], masked, mask_ofs);
+                    pie_fill(&dsc);
+                    assert_same(widths[wi], ofs, opas[o]);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief 源与目标对齐相同时直接读源，不同时经暂存块
+ */
+void test_pie_model_image_matches_reference(void)
+{
+    for (int masked = 0; masked < 2; masked++) {
+        for (size_t o = 0; o < sizeof(opas); o++) {
+            if (!masked && opas[o] >= LV_OPA_MAX) continue;
+            for (size_t wi = 0; wi < sizeof(widths) / sizeof(widths[0]); wi++) {
+                for (int32_t ofs = 0; ofs < 8; ofs++) {
+                    lv_draw_sw_blend_image_dsc_t dsc;
+                    int32_t src_ofs = (rnd() & 1) ? ofs : (int32_t)(rnd() % 8);
+                    int32_t mask_ofs = (int32_t)(rnd() % 8);
+                    fill_dest();
+                    fill_mask();
+                    init_image_dsc(&dsc, dest_ref, ofs, src_ofs, widths[wi], MAX_H, opas[o], masked, mask_ofs);
+                    blend_ref_rgb565_to_rgb565(&dsc);
+                    init_image_dsc(&dsc, dest_swar, ofs, src_ofs, widths[wi], MAX_H, opas[o], masked, mask_ofs);
+                    pie_image(&dsc);
+                    assert_same(widths[wi], ofs, opas[o]);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief C参考模型的全部256个不透明度（包括入口不会传入的>=LV_OPA_MAX），有遮罩时按LVGL的条件选择入口
+ */
+void test_pie_model_all_opacities(void)
+{
+    for (int opa = 0; opa <= 255; opa++) {
+        lv_draw_sw_blend_fill_dsc_t fdsc;
+        lv_draw_sw_blend_image_dsc_t idsc;
+
+        fill_dest();
+        fill_mask();
+        init_fill_dsc(&fdsc, dest_ref, 3, MAX_W, MAX_H, (lv_opa_t)opa, true, 5);
+        blend_ref_color_to_rgb565(&fdsc);
+        init_fill_dsc(&fdsc, dest_swar, 3, MAX_W, MAX_H, (lv_opa_t)opa, true, 5);
+        pie_fill(&fdsc);
+        assert_same(MAX_W, 3, (lv_opa_t)opa);
+
+        fill_dest();
+        init_image_dsc(&idsc, dest_ref, 0, 0, MAX_W, MAX_H, (lv_opa_t)opa, false, 0);
+        for (int32_t y = 0; y < MAX_H; y++) {
+            for (int32_t x = 0; x < MAX_W; x++) {
+                uint16_t *p = &dest_ref[y * STRIDE_PX + x];
+                *p = lv_color_16_16_mix(src[y * STRIDE_PX + x], *p, (uint8_t)opa);
+            }
+        }
+        init_image_dsc(&idsc, dest_swar, 0, 0, MAX_W, MAX_H, (lv_opa_t)opa, false, 0);
+        rgb565_blend_image_with_opa(&idsc);
+        assert_same(MAX_W, 0, (lv_opa_t)opa);
+
+        fill_dest();
+        init_image_dsc(&idsc, dest_ref, 1, 6, MAX_W, MAX_H, (lv_opa_t)opa, true, 2);
+        blend_ref_rgb565_to_rgb565(&idsc);
+        init_image_dsc(&idsc, dest_swar, 1, 6, MAX_W, MAX_H, (lv_opa_t)opa, true, 2);
+        pie_image(&idsc);
+        assert_same(MAX_W, 1, (lv_opa_t)opa);
+    }
+}
+
+/**
+ * @brief 宽或高为0时不写任何像素
+ */
+void test_empty_area(void)
+{
+    lv_draw_sw_blend_fill_dsc_t dsc;
+    fill_dest();
+    init_fill_dsc(&dsc, dest_swar, 1, 0, MAX_H, LV_OPA_50, false, 0);
+    lv_color_blend_to_rgb565_swar(&dsc);
+    lv_color_blend_to_rgb565_with_opa_swar(&dsc);
+    init_fill_dsc(&dsc, dest_swar, 1, MAX_W, 0, LV_OPA_50, true, 0);
+    lv_color_blend_to_rgb565_with_mask_swar(&dsc);
+    rgb565_blend_color_with_mask(&dsc);
+    init_fill_dsc(&dsc, dest_swar, 1, 0, MAX_H, LV_OPA_50, false, 0);
+    rgb565_blend_color(&dsc);
+    rgb565_blend_color_with_opa(&dsc);
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(dest_ref, dest_swar, BUF_PX);
+}
+
+int main(void)
+{
+    lv_port_init();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_fill_matches_reference);
+    RUN_TEST(test_rgb565_image_matches_reference);
+    RUN_TEST(test_all_opacities);
+    RUN_TEST(test_pie_model_fill_matches_reference);
+    RUN_TEST(test_pie_model_image_matches_reference);
+    RUN_TEST(test_pie_model_all_opacities);
+    RUN_TEST(test_empty_area);
+    return UNITY_END();
+}
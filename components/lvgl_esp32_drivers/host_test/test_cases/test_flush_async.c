@@ -0,0 +1,161 @@
+#include <stdatomic.h>
+#include "unity.h"
+#include "lvgl_port.h"
+#include "spi_sim.h"
+#include "esp_timer.h"
+
+// 异步刷新：flush_cb排队即返回，只等上一块DMA完成后把其缓冲区交还LVGL
+
+static atomic_int colors_in_flight;       // 已排队但尚未传完的颜色事务数
+static atomic_int flush_finish_count;     // flush_cb返回次数
+static atomic_int dma_after_return_count; // flush_cb返回时DMA仍在传输的次数
+static atomic_int render_overlap_count;   // 渲染下一块时上一块仍在传输的次数
+static atomic_int wait_violation_count;   // 缓冲区交还LVGL时另一块传输尚未结束的次数
+static _Atomic int64_t last_flush_finish_us;
+
+static void color_monitor(spi_host_device_t host, const spi_transaction_t *trans,
+                          int64_t start_us, int64_t end_us, void *user_ctx)
+{
+    if (!((uintptr_t)trans->user & DISP_SPI_SIGNAL_FLUSH)) return;
+
+    if (end_us > atomic_load(&last_flush_finish_us)) {
+        atomic_fetch_add(&dma_after_return_count, 1);
+    }
+    atomic_fetch_sub(&colors_in_flight, 1);
+}
+
+static void display_event_cb(lv_event_t *e)
+{
+    switch (lv_event_get_code(e)) {
+    case LV_EVENT_FLUSH_START:
+        atomic_fetch_add(&colors_in_flight, 1);
+        break;
+    case LV_EVENT_FLUSH_FINISH:
+        // 双缓冲：flush_cb返回后LVGL即渲染到另一块缓冲区，此时只允许刚排队的这一块在途
+        if (atomic_load(&colors_in_flight) > 1) atomic_fetch_add(&wait_violation_count, 1);
+        atomic_store(&last_flush_finish_us, esp_timer_get_time());
+        atomic_fetch_add(&flush_finish_count, 1);
+        break;
+    case LV_EVENT_FLUSH_WAIT_START:
+        if (atomic_load(&colors_in_flight) > 0) atomic_fetch_add(&render_overlap_count, 1);
+        break;
+    default:
+        break;
+    }
+}
+
+static void drain_bus(void)
+{
+    disp_wait_for_pending_transactions();
+    TEST_ASSERT_EQUAL_INT(0, atomic_load(&colors_in_flight));
+}
+
+void setUp(void)
+{
+    drain_bus();
+    spi_sim_set_time_scale(100);
+    spi_sim_reset_stats(LCD_SPI_HOST);
+    atomic_store(&flush_finish_count, 0);
+    atomic_store(&dma_after_return_count, 0);
+    atomic_store(&render_overlap_count, 0);
+    atomic_store(&wait_violation_count, 0);
+}
+
+void tearDown(void)
+{
+}
+
+void test_flush_returns_before_dma_completes(void)
+{
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+    drain_bus();
+
+    int stripes = atomic_load(&flush_finish_count);
+    TEST_ASSERT_EQUAL_INT(LV_VER_RES_MAX / (DISP_BUF_SIZE / LV_HOR_RES_MAX), stripes);
+    TEST_ASSERT_EQUAL_INT(stripes, atomic_load(&dma_after_return_count));
+    TEST_ASSERT_EQUAL_INT(stripes - 1, atomic_load(&render_overlap_count));
+    TEST_ASSERT_EQUAL_INT(0, atomic_load(&wait_violation_count));
+}
+
+void test_no_tearing_under_repeated_updates(void)
+{
+    lv_obj_t *label = lv_label_create(lv_screen_active());
+    lv_obj_center(label);
+
+    for (int i = 0; i < 20; i++) {
+        lv_obj_set_style_bg_color(lv_screen_active(), lv_color_hex(0x010203 * i), LV_PART_MAIN);
+        lv_label_set_text_fmt(label, "frame %d", i);
+        lv_refr_now(NULL);
+    }
+    drain_bus();
+
+    spi_sim_stats_t stats;
+    spi_sim_get_stats(LCD_SPI_HOST, &stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.torn_count);
+    TEST_ASSERT_EQUAL_INT(0, atomic_load(&wait_violation_count));
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT64(20ULL * LV_HOR_RES_MAX * LV_VER_RES_MAX * 2, stats.tx_bytes);
+
+    lv_obj_delete(label);
+}
+
+void test_frame_time_hides_last_transfer(void)
+{
+    lv_obj_invalidate(lv_screen_active());
+    int64_t start = esp_timer_get_time();
+    lv_refr_now(NULL);
+    int64_t frame_us = esp_timer_get_time() - start;
+    drain_bus();
+
+    spi_sim_stats_t stats;
+    spi_sim_get_stats(LCD_SPI_HOST, &stats);
+    int64_t wire_us = (int64_t)(stats.wire_time_ns / 1000);
+
+    TEST_PRINTF("frame %lld us, wire %lld us, %u transactions",
+                (long long)frame_us, (long long)wire_us, (unsigned)stats.trans_count);
+    TEST_ASSERT_LESS_THAN_INT64(wire_us, frame_us);
+}
+
+static atomic_int test_flush_done_count;
+
+static void test_flush_done(void *user_ctx)
+{
+    atomic_fetch_add(&test_flush_done_count, 1);
+}
+
+/**
+ * @brief 长度为0的最后一段：前面的段仍在传输时，完成通知要等它们传完，不能在排队时直接调用
+ *        替换了移植层的完成回调，须最后运行
+ */
+void test_empty_last_chunk_waits_for_queued_chunks(void)
+{
+    static uint8_t chunk[DISP_SPI_COLOR_CHUNK_SIZE];
+
+    spi_sim_set_monitor(LCD_SPI_HOST, NULL, NULL);
+    disp_spi_set_flush_done_cb(test_flush_done, NULL);
+
+    // 总线空闲时没有需要等待的数据，直接通知
+    disp_spi_send_colors_chunk(chunk, 0, true);
+    TEST_ASSERT_EQUAL_INT(1, atomic_load(&test_flush_done_count));
+
+    disp_spi_send_colors_chunk(chunk, sizeof(chunk), false);
+    disp_spi_send_colors_chunk(chunk, 0, true);
+    TEST_ASSERT_EQUAL_INT(1, atomic_load(&test_flush_done_count));
+
+    disp_wait_for_pending_transactions();
+    TEST_ASSERT_EQUAL_INT(2, atomic_load(&test_flush_done_count));
+}
+
+int main(void)
+{
+    lv_port_init();
+    lv_display_add_event_cb(lv_display_get_default(), display_event_cb, LV_EVENT_ALL, NULL);
+    spi_sim_set_monitor(LCD_SPI_HOST, color_monitor, NULL);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_flush_returns_before_dma_completes);
+    RUN_TEST(test_no_tearing_under_repeated_updates);
+    RUN_TEST(test_frame_time_hides_last_transfer);
+    RUN_TEST(test_empty_last_chunk_waits_for_queued_chunks);
+    return UNITY_END();
+}
@@ -0,0 +1,209 @@
+#include <string.h>
+#include "unity.h"
+#include "lvgl_port.h"
+
+// 字体查找表：启用前后每个码点的字形ID、字宽和字距都相同，小字体不建表，表可以释放后重建
+
+#define CP_CNT          0x10000
+#define KERN_FIRST      0x4e00      // 合成字体的码点从这里开始
+#define KERN_GLYPHS     300
+#define KERN_SIDE       24          // 左右字形ID在1..KERN_SIDE之间组合
+
+/**
+ * @brief 一个码点的查找结果
+ */
+typedef struct {
+    bool found;
+    uint16_t gid;
+    uint16_t adv_w;
+} glyph_result_t;
+
+static glyph_result_t off_results[CP_CNT];
+
+static lv_font_fmt_txt_glyph_dsc_t kern_glyph_dsc[KERN_GLYPHS + 1];
+static uint8_t kern_ids_8[KERN_SIDE * KERN_SIDE * 2];
+static uint16_t kern_ids_16[KERN_SIDE * KERN_SIDE * 2];
+static int8_t kern_values[KERN_SIDE * KERN_SIDE];
+static lv_font_fmt_txt_cmap_t kern_cmap;
+static lv_font_fmt_txt_kern_pair_t kern_pairs_8, kern_pairs_16;
+static lv_font_fmt_txt_dsc_t kern_dsc_8, kern_dsc_16;
+static lv_font_t kern_font_8, kern_font_16;
+
+static void lookup(const lv_font_t *font, uint32_t letter, uint32_t letter_next, glyph_result_t *res)
+{
+    lv_font_glyph_dsc_t dsc;
+    memset(&dsc, 0, sizeof(dsc));
+    res->found = lv_font_get_glyph_dsc(font, &dsc, letter, letter_next) && !dsc.is_placeholder;
+    res->gid = res->found ? (uint16_t)dsc.gid.index : 0;
+    res->adv_w = res->found ? dsc.adv_w : 0;
+}
+
+/**
+ * @brief 按lv_font_conv的字距对格式搭建合成字体：KERN_GLYPHS个字形，左右ID按顺序排列的字距对
+ */
+static void init_kern_font(lv_font_t *font, lv_font_fmt_txt_dsc_t *fdsc, lv_font_fmt_txt_kern_pair_t *pairs,
+                           uint8_t ids_size)
+{
+    pairs->glyph_ids = ids_size == 0 ? (const void *)kern_ids_8 : (const void *)kern_ids_16;
+    pairs->values = kern_values;
+    pairs->glyph_ids_size = ids_size;
+
+    fdsc->glyph_dsc = kern_glyph_dsc;
+    fdsc->cmaps = &kern_cmap;
+    fdsc->cmap_num = 1;
+    fdsc->kern_dsc = pairs;
+    fdsc->kern_scale = 16;
+    fdsc->kern_classes = 0;
+    fdsc->bpp = 4;
+
+    font->get_glyph_dsc = lv_font_get_glyph_dsc_fmt_txt;
+    font->get_glyph_bitmap = lv_font_get_bitmap_fmt_txt;
+    font->line_height = 16;
+    font->dsc = fdsc;
+}
+
+static void init_kern_fonts(void)
+{
+    for (int i = 1; i <= KERN_GLYPHS; i++) {
+        kern_glyph_dsc[i].adv_w = 8 * 16;
+    }
+    kern_cmap.range_start = KERN_FIRST;
+    kern_cmap.range_length = KERN_GLYPHS;
+    kern_cmap.glyph_id_start = 1;
+    kern_cmap.type = LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY;
+
+    // 跳过每三对中的一对，未列出的对字距为0
+    uint32_t n = 0;
+    for (int l = 1; l <= KERN_SIDE; l++) {
+        for (int r = 1; r <= KERN_SIDE; r++) {
+            if ((l + r) % 3 == 0) continue;
+            kern_ids_8[n * 2] = kern_ids_16[n * 2] = (uint16_t)l;
+            kern_ids_8[n * 2 + 1] = kern_ids_16[n * 2 + 1] = (uint16_t)r;
+            kern_values[n] = (int8_t)((l * 7 + r * 3) % 15 - 7);
+            n++;
+        }
+    }
+    kern_pairs_8.pair_cnt = n;
+    kern_pairs_16.pair_cnt = n;
+    init_kern_font(&kern_font_8, &kern_dsc_8, &kern_pairs_8, 0);
+    init_kern_font(&kern_font_16, &kern_dsc_16, &kern_pairs_16, 1);
+}
+
+static void assert_kerning_matches(const lv_font_t *font)
+{
+    static glyph_result_t off[KERN_SIDE + 1][KERN_SIDE + 1];
+    glyph_result_t on;
+
+    lv_font_fmt_txt_lut_set_enabled(false);
+    for (int l = 1; l <= KERN_SIDE; l++) {
+        for (int r = 1; r <= KERN_SIDE; r++) {
+            lookup(font, KERN_FIRST + l - 1, KERN_FIRST + r - 1, &off[l][r]);
+        }
+    }
+
+    lv_font_fmt_txt_lut_set_enabled(true);
+    for (int l = 1; l <= KERN_SIDE; l++) {
+        for (int r = 1; r <= KERN_SIDE; r++) {
+            lookup(font, KERN_FIRST + l - 1, KERN_FIRST + r - 1, &on);
+            TEST_ASSERT_TRUE(on.found);
+            TEST_ASSERT_EQUAL_UINT16(off[l][r].gid, on.gid);
+            TEST_ASSERT_EQUAL_UINT16(off[l][r].adv_w, on.adv_w);
+        }
+    }
+    TEST_ASSERT_GREATER_THAN_UINT32(0, lv_font_fmt_txt_lut_get_size());
+}
+
+void setUp(void)
+{
+    lv_font_fmt_txt_lut_set_enabled(true);
+}
+
+void tearDown(void)
+{
+    // 释放全部表，下一个用例从空表开始
+    lv_font_fmt_txt_lut_set_enabled(false);
+}
+
+void test_small_font_has_no_table(void)
+{
+    glyph_result_t res;
+    lookup(&lv_font_montserrat_14, 'A', 'V', &res);
+    TEST_ASSERT_TRUE(res.found);
+    TEST_ASSERT_EQUAL_UINT32(0, lv_font_fmt_txt_lut_get_size());
+}
+
+void test_cjk_glyph_ids_match(void)
+{
+    const lv_font_t *font = &lv_font_simsun_16_cjk;
+    glyph_result_t on;
+    uint32_t found = 0;
+
+    lv_font_fmt_txt_lut_set_enabled(false);
+    for (uint32_t cp = 0; cp < CP_CNT; cp++) {
+        lookup(font, cp, 0, &off_results[cp]);
+    }
+
+    lv_font_fmt_txt_lut_set_enabled(true);
+    for (uint32_t cp = 0; cp < CP_CNT; cp++) {
+        lookup(font, cp, 0, &on);
+        TEST_ASSERT_EQUAL(off_results[cp].found, on.found);
+        TEST_ASSERT_EQUAL_UINT16(off_results[cp].gid, on.gid);
+        TEST_ASSERT_EQUAL_UINT16(off_results[cp].adv_w, on.adv_w);
+        found += on.found;
+    }
+
+    uint32_t size = lv_font_fmt_txt_lut_get_size();
+    TEST_PRINTF("%u glyphs, table %u bytes", (unsigned)found, (unsigned)size);
+    TEST_ASSERT_GREATER_THAN_UINT32(1000, found);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(found * 8, size);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(found * 16, size);
+}
+
+void test_kern_pairs_8_match(void)
+{
+    assert_kerning_matches(&kern_font_8);
+}
+
+void test_kern_pairs_16_match(void)
+{
+    assert_kerning_matches(&kern_font_16);
+}
+
+void test_drop_frees_and_rebuilds(void)
+{
+    glyph_result_t res;
+
+    lookup(&lv_font_simsun_16_cjk, 0x4e2d, 0, &res);  // 中
+    TEST_ASSERT_TRUE(res.found);
+    uint32_t size = lv_font_fmt_txt_lut_get_size();
+    TEST_ASSERT_GREATER_THAN_UINT32(0, size);
+
+    lv_font_fmt_txt_lut_drop(&lv_font_simsun_16_cjk);
+    TEST_ASSERT_EQUAL_UINT32(0, lv_font_fmt_txt_lut_get_size());
+
+    glyph_result_t again;
+    lookup(&lv_font_simsun_16_cjk, 0x4e2d, 0, &again);
+    TEST_ASSERT_EQUAL_UINT16(res.gid, again.gid);
+    TEST_ASSERT_EQUAL_UINT32(size, lv_font_fmt_txt_lut_get_size());
+
+    // 停用后释放，查找仍然正确
+    lv_font_fmt_txt_lut_set_enabled(false);
+    TEST_ASSERT_EQUAL_UINT32(0, lv_font_fmt_txt_lut_get_size());
+    lookup(&lv_font_simsun_16_cjk, 0x4e2d, 0, &again);
+    TEST_ASSERT_EQUAL_UINT16(res.gid, again.gid);
+    TEST_ASSERT_EQUAL_UINT32(0, lv_font_fmt_txt_lut_get_size());
+}
+
+int main(void)
+{
+    lv_port_init();
+    init_kern_fonts();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_small_font_has_no_table);
+    RUN_TEST(test_cjk_glyph_ids_match);
+    RUN_TEST(test_kern_pairs_8_match);
+    RUN_TEST(test_kern_pairs_16_match);
+    RUN_TEST(test_drop_frees_and_rebuilds);
+    return UNITY_END();
+}
@@ -0,0 +1,210 @@
+#include <string.h>
+#include <pthread.h>
+#include "unity.h"
+#include "lvgl_port.h"
+#include "spi_sim.h"
+
+// 字形缓存：启用前后渲染的像素相同，重复绘制相同的字符全部命中，占用不超过预算，预算为0时关闭
+
+static lv_obj_t *label;
+
+/**
+ * @brief 刷新并截取整屏快照
+ */
+static lv_draw_buf_t *render(void)
+{
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+    disp_wait_for_pending_transactions();
+    lv_draw_buf_t *snapshot = lv_snapshot_take(lv_screen_active(), LV_COLOR_FORMAT_RGB565);
+    TEST_ASSERT_NOT_NULL(snapshot);
+    return snapshot;
+}
+
+static void assert_same_pixels(const lv_draw_buf_t *a, const lv_draw_buf_t *b)
+{
+    TEST_ASSERT_EQUAL_UINT32(a->data_size, b->data_size);
+    TEST_ASSERT_EQUAL_MEMORY(a->data, b->data, a->data_size);
+}
+
+void setUp(void)
+{
+    lv_font_glyph_cache_resize(LV_PORT_GLYPH_CACHE_SIZE, true);
+    lv_font_glyph_cache_drop();
+    lv_font_glyph_cache_reset_stats();
+    lv_obj_set_style_text_font(label, &lv_font_montserrat_14, 0);
+    lv_label_set_text(label, "ALT 1234.5 m\nSPD 56.7 m/s\nVOLT 11.8 V");
+}
+
+void tearDown(void)
+{
+}
+
+void test_port_enables_cache(void)
+{
+    TEST_ASSERT_TRUE(lv_font_glyph_cache_is_enabled());
+    lv_font_glyph_cache_stats_t stats;
+    lv_font_glyph_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(LV_PORT_GLYPH_CACHE_SIZE, stats.max_size);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.size);
+}
+
+void test_same_pixels_with_and_without_cache(void)
+{
+    const lv_font_t *fonts[] = { &lv_font_montserrat_14, &lv_font_montserrat_28_compressed };
+
+    for (size_t i = 0; i < sizeof(fonts) / sizeof(fonts[0]); i++) {
+        lv_obj_set_style_text_font(label, fonts[i], 0);
+        lv_font_glyph_cache_resize(0, true);
+        lv_draw_buf_t *off = render();
+        lv_font_glyph_cache_resize(LV_PORT_GLYPH_CACHE_SIZE, true);
+        lv_draw_buf_t *miss = render();
+        lv_draw_buf_t *hit = render();
+
+        assert_same_pixels(off, miss);
+        assert_same_pixels(off, hit);
+        lv_draw_buf_destroy(off);
+        lv_draw_buf_destroy(miss);
+        lv_draw_buf_destroy(hit);
+    }
+}
+
+void test_redraw_hits(void)
+{
+    lv_font_glyph_cache_stats_t stats;
+
+    lv_draw_buf_destroy(render());
+    lv_font_glyph_cache_get_stats(&stats);
+    uint32_t misses = stats.misses;
+    TEST_ASSERT_GREATER_THAN_UINT32(0, misses);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, stats.size);
+
+    // 第二次绘制不再解码
+    lv_font_glyph_cache_reset_stats();
+    lv_draw_buf_destroy(render());
+    lv_font_glyph_cache_get_stats(&stats);
+    TEST_PRINTF("%u glyphs, %u bytes", (unsigned)misses, (unsigned)stats.size);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.misses);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(misses, stats.hits);
+}
+
+void test_budget_is_respected(void)
+{
+    lv_font_glyph_cache_stats_t stats;
+
+    lv_font_glyph_cache_resize(512, true);
+    lv_obj_set_style_text_font(label, &lv_font_montserrat_28_compressed, 0);
+    lv_draw_buf_destroy(render());
+    lv_font_glyph_cache_get_stats(&stats);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, stats.misses);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(512, stats.size);
+
+    // 缩小预算时立即淘汰
+    lv_font_glyph_cache_resize(LV_PORT_GLYPH_CACHE_SIZE, true);
+    lv_draw_buf_destroy(render());
+    lv_font_glyph_cache_resize(256, true);
+    lv_font_glyph_cache_get_stats(&stats);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(256, stats.size);
+}
+
+void test_zero_budget_disables(void)
+{
+    lv_font_glyph_cache_stats_t stats;
+
+    lv_draw_buf_destroy(render());
+    lv_font_glyph_cache_resize(0, true);
+    TEST_ASSERT_FALSE(lv_font_glyph_cache_is_enabled());
+    lv_font_glyph_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.size);
+
+    lv_font_glyph_cache_reset_stats();
+    lv_draw_buf_destroy(render());
+    lv_font_glyph_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.hits);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.misses);
+}
+
+void test_drop_empties_cache(void)
+{
+    lv_font_glyph_cache_stats_t stats;
+
+    lv_draw_buf_destroy(render());
+    lv_font_glyph_cache_drop();
+    lv_font_glyph_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.size);
+    TEST_ASSERT_TRUE(lv_font_glyph_cache_is_enabled());
+}
+
+#define ACQUIRE_THREADS     4
+#define ACQUIRE_ROUNDS      500
+
+/**
+ * @brief 取一个字形并立即释放
+ * @return 取到位图返回true
+ */
+static bool acquire_letter(uint32_t letter)
+{
+    lv_font_glyph_dsc_t g;
+    lv_cache_entry_t *entry;
+    if (!lv_font_get_glyph_dsc(&lv_font_montserrat_14, &g, letter, 0)) return false;
+    lv_draw_buf_t *bitmap = lv_font_glyph_cache_acquire(&g, &entry);
+    lv_font_glyph_cache_release(entry);
+    return bitmap != NULL;
+}
+
+static void *acquire_thread(void *arg)
+{
+    int *failed = arg;
+    for (int i = 0; i < ACQUIRE_ROUNDS; i++) {
+        if (!acquire_letter('0' + i % 10)) (*failed)++;
+    }
+    return NULL;
+}
+
+void test_each_acquire_counts_once(void)
+{
+    lv_font_glyph_cache_stats_t stats;
+
+    TEST_ASSERT_TRUE(acquire_letter('A'));
+    TEST_ASSERT_TRUE(acquire_letter('A'));
+    TEST_ASSERT_TRUE(acquire_letter('B'));
+    lv_font_glyph_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.misses);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.hits);
+
+    // 多个线程（多个绘制单元）同时取字形：每次恰好计一次命中或未命中，每个字形只解码一次
+    lv_font_glyph_cache_reset_stats();
+    pthread_t threads[ACQUIRE_THREADS];
+    int failed[ACQUIRE_THREADS] = {0};
+    for (int i = 0; i < ACQUIRE_THREADS; i++) {
+        pthread_create(&threads[i], NULL, acquire_thread, &failed[i]);
+#if LV_USE_OS == LV_OS_NONE
+        pthread_join(threads[i], NULL);     // 没有锁时逐个运行
+#endif
+    }
+#if LV_USE_OS != LV_OS_NONE
+    for (int i = 0; i < ACQUIRE_THREADS; i++) pthread_join(threads[i], NULL);
+#endif
+    lv_font_glyph_cache_get_stats(&stats);
+    for (int i = 0; i < ACQUIRE_THREADS; i++) TEST_ASSERT_EQUAL_INT(0, failed[i]);
+    TEST_ASSERT_EQUAL_UINT32(10, stats.misses);
+    TEST_ASSERT_EQUAL_UINT32(ACQUIRE_THREADS * ACQUIRE_ROUNDS - 10, stats.hits);
+}
+
+int main(void)
+{
+    lv_port_init();
+    spi_sim_set_time_scale(0);
+    label = lv_label_create(lv_screen_active());
+    lv_obj_center(label);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_port_enables_cache);
+    RUN_TEST(test_same_pixels_with_and_without_cache);
+    RUN_TEST(test_redraw_hits);
+    RUN_TEST(test_budget_is_respected);
+    RUN_TEST(test_zero_budget_disables);
+    RUN_TEST(test_drop_empties_cache);
+    RUN_TEST(test_each_acquire_counts_once);
+    return UNITY_END();
+}
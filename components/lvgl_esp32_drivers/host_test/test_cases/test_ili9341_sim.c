@@ -0,0 +1,149 @@
+#include "unity.h"
+#include "lvgl_port.h"
+#include "spi_sim.h"
+#include "ili9341_sim.h"
+#include "esp_timer.h"
+
+// 面板模型：初始化序列、逐帧总线统计、与LVGL渲染结果逐像素比对
+
+#define STRIPE_LINES    (DISP_BUF_SIZE / LV_HOR_RES_MAX)
+#define FLUSH_CMD_BYTES (3 + 4 + 4)     // CASET/PASET/RAMWR命令及参数
+
+static ili9341_sim_frame_t refresh(void)
+{
+    ili9341_sim_frame_t frame;
+
+    ili9341_sim_frame_begin();
+    lv_refr_now(NULL);
+    disp_wait_for_pending_transactions();
+    ili9341_sim_frame_end(&frame);
+    return frame;
+}
+
+/**
+ * @brief 对当前屏幕做快照，与面板GRAM逐像素比较
+ * @return 不一致的像素数
+ */
+static uint32_t compare_with_snapshot(void)
+{
+    lv_draw_buf_t *snapshot = lv_snapshot_take(lv_screen_active(), LV_COLOR_FORMAT_RGB565);
+    TEST_ASSERT_NOT_NULL(snapshot);
+
+    uint32_t mismatches = 0;
+    for (int y = 0; y < LV_VER_RES_MAX; y++) {
+        const uint16_t *row = (const uint16_t *)(snapshot->data + y * snapshot->header.stride);
+        for (int x = 0; x < LV_HOR_RES_MAX; x++) {
+            if (ili9341_sim_get_pixel(x, y) != row[x]) mismatches++;
+        }
+    }
+    lv_draw_buf_destroy(snapshot);
+    return mismatches;
+}
+
+void setUp(void)
+{
+    spi_sim_set_time_scale(0);
+}
+
+void tearDown(void)
+{
+}
+
+void test_boot_sequence_turns_display_on(void)
+{
+    // 与app_main相同：初始化后立即渲染第一帧，开显示由LVGL任务中的定时器完成
+    lv_refr_now(NULL);
+    int64_t end = esp_timer_get_time() + 1000000;
+    while (!ili9341_sim_is_display_on() && esp_timer_get_time() < end) {
+        lv_port_sleep(lv_port_handler());
+    }
+
+    ili9341_sim_boot_t boot;
+    lv_port_boot_stats_t stats;
+    ili9341_sim_get_boot(&boot);
+    lv_port_get_boot_stats(&stats);
+    TEST_PRINTF("reset -> first pixel %lld us, slpout %lld us, display on %lld us",
+                (long long)(boot.first_pixel_us - boot.reset_release_us),
+                (long long)(boot.slpout_us - boot.reset_release_us),
+                (long long)(boot.display_on_us - boot.reset_release_us));
+
+    TEST_ASSERT_TRUE(ili9341_sim_is_display_on());
+    TEST_ASSERT_EQUAL_HEX8(0x28, ili9341_sim_get_madctl());
+    TEST_ASSERT_EQUAL_UINT32(0, boot.timing_violations);
+    // 第一帧在睡眠中写入，开显示时已整屏写完
+    TEST_ASSERT_LESS_THAN_INT64(boot.slpout_us, boot.first_pixel_us);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT64(LV_HOR_RES_MAX * LV_VER_RES_MAX, boot.pixels_before_on);
+    TEST_ASSERT_LESS_THAN_INT64(boot.reset_release_us + 200000, boot.display_on_us);
+    TEST_ASSERT_LESS_OR_EQUAL_INT64(stats.first_flush_us, stats.init_done_us);
+    TEST_ASSERT_LESS_OR_EQUAL_INT64(stats.first_frame_us, stats.first_flush_us);
+    TEST_ASSERT_LESS_OR_EQUAL_INT64(stats.display_on_us, stats.first_frame_us);
+}
+
+void test_full_frame_bus_report(void)
+{
+    lv_obj_invalidate(lv_screen_active());
+    ili9341_sim_frame_t frame = refresh();
+    ili9341_sim_print_frame("full screen", &frame);
+
+    uint32_t stripes = LV_VER_RES_MAX / STRIPE_LINES;
+    uint64_t pixels = LV_HOR_RES_MAX * LV_VER_RES_MAX;
+    TEST_ASSERT_EQUAL_UINT64(pixels, frame.pixels_written);
+    TEST_ASSERT_EQUAL_UINT32(stripes, frame.window_count);
+    TEST_ASSERT_EQUAL_UINT32(stripes, frame.ramwr_count);
+    TEST_ASSERT_EQUAL_UINT64(pixels * 2 + stripes * FLUSH_CMD_BYTES, frame.bus_bytes);
+    TEST_ASSERT_EQUAL_UINT64(frame.bus_bytes * 8 * 1000 / 40, frame.wire_time_ns);
+}
+
+void test_panel_matches_lvgl_rendering(void)
+{
+    lv_obj_t *scr = lv_screen_active();
+    lv_obj_set_style_bg_color(scr, lv_color_hex(0x003a57), LV_PART_MAIN);
+
+    lv_obj_t *label = lv_label_create(scr);
+    lv_label_set_text(label, "Hello world");
+    lv_obj_set_style_text_color(label, lv_color_hex(0xffffff), LV_PART_MAIN);
+    lv_obj_align(label, LV_ALIGN_CENTER, 0, 0);
+
+    lv_obj_t *bar = lv_bar_create(scr);
+    lv_obj_set_size(bar, 200, 16);
+    lv_obj_align(bar, LV_ALIGN_BOTTOM_MID, 0, -20);
+    lv_bar_set_value(bar, 70, LV_ANIM_OFF);
+
+    refresh();
+    TEST_ASSERT_EQUAL_UINT32(0, compare_with_snapshot());
+
+    lv_obj_delete(bar);
+    lv_obj_delete(label);
+}
+
+void test_partial_update_sends_dirty_area_only(void)
+{
+    lv_obj_t *label = lv_label_create(lv_screen_active());
+    lv_label_set_text(label, "12");
+    lv_obj_set_pos(label, 10, 10);
+    refresh();
+
+    lv_label_set_text(label, "13");
+    ili9341_sim_frame_t frame = refresh();
+    ili9341_sim_print_frame("label update", &frame);
+
+    TEST_ASSERT_EQUAL_UINT32(1, frame.window_count);
+    TEST_ASSERT_LESS_THAN_UINT64(LV_HOR_RES_MAX * STRIPE_LINES, frame.pixels_written);
+    TEST_ASSERT_EQUAL_UINT32(0, compare_with_snapshot());
+
+    lv_obj_delete(label);
+    refresh();
+}
+
+int main(void)
+{
+    ili9341_sim_init(LCD_SPI_HOST, LCD_SPI_CS, LCD_SPI_DC, LCD_SPI_RST);
+    lv_port_init();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_boot_sequence_turns_display_on);
+    RUN_TEST(test_full_frame_bus_report);
+    RUN_TEST(test_panel_matches_lvgl_rendering);
+    RUN_TEST(test_partial_update_sends_dirty_area_only);
+    return UNITY_END();
+}
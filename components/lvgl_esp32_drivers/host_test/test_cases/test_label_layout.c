@@ -0,0 +1,235 @@
+#include <string.h>
+#include "unity.h"
+#include "lvgl_port.h"
+#include "spi_sim.h"
+#include "src/widgets/label/lv_label_private.h"
+
+// 标签布局缓存：使用缓存绘制的像素与逐字测量的相同，尺寸与lv_text_get_size相同，
+// 文本、字体、宽度和字间距改变时重建，只改颜色时不重建
+
+#define MARK_WIDTH  12345   // 写进缓存的标记宽度，重建后消失
+
+static const char *long_text =
+    "The telemetry link reports altitude, speed and battery voltage every 100 ms. "
+    "Long lines are wrapped at spaces.\nA new paragraph starts here and keeps going until it wraps "
+    "several times on the narrow screen.\n\nEmpty line above; kerning pairs: AV To WA LT Yo.\n"
+    "高度 速度 電壓 電流 設定";
+
+static lv_obj_t *label;
+static bool layout_off;     // 为真时绘制任务不使用缓存
+static lv_draw_buf_t *snap_off, *snap_on;   // 断言失败时由tearDown释放
+
+static void draw_task_cb(lv_event_t *e)
+{
+    lv_draw_task_t *task = lv_event_get_draw_task(e);
+    lv_draw_label_dsc_t *dsc = lv_draw_task_get_label_dsc(task);
+    if (dsc && layout_off) dsc->layout = NULL;
+}
+
+/**
+ * @brief 刷新并截取整屏快照。先停掉滚动模式的动画，两次快照的滚动位置相同
+ */
+static lv_draw_buf_t *render(bool off)
+{
+    lv_anim_delete(label, NULL);
+    layout_off = off;
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+    disp_wait_for_pending_transactions();
+    lv_draw_buf_t *snapshot = lv_snapshot_take(lv_screen_active(), LV_COLOR_FORMAT_RGB565);
+    TEST_ASSERT_NOT_NULL(snapshot);
+    return snapshot;
+}
+
+static void free_snapshots(void)
+{
+    if (snap_off) lv_draw_buf_destroy(snap_off);
+    if (snap_on) lv_draw_buf_destroy(snap_on);
+    snap_off = snap_on = NULL;
+}
+
+static void assert_same_with_and_without_layout(void)
+{
+    snap_off = render(true);
+    snap_on = render(false);
+    TEST_ASSERT_TRUE(lv_draw_label_layout_is_valid(&((lv_label_t *)label)->layout, lv_label_get_text(label),
+                                                   lv_obj_get_style_text_font(label, 0),
+                                                   lv_obj_get_style_text_letter_space(label, 0),
+                                                   lv_obj_get_content_width(label),
+                                                   ((lv_label_t *)label)->layout.flag));
+    TEST_ASSERT_EQUAL_UINT32(snap_off->data_size, snap_on->data_size);
+    TEST_ASSERT_EQUAL_MEMORY(snap_off->data, snap_on->data, snap_off->data_size);
+    free_snapshots();
+}
+
+static lv_draw_label_layout_t *layout(void)
+{
+    return &((lv_label_t *)label)->layout;
+}
+
+void setUp(void)
+{
+    lv_obj_set_style_text_font(label, &lv_font_simsun_16_cjk, 0);
+    lv_obj_set_style_text_align(label, LV_TEXT_ALIGN_LEFT, 0);
+    lv_obj_set_style_text_letter_space(label, 0, 0);
+    lv_obj_set_style_text_line_space(label, 0, 0);
+    lv_obj_set_style_text_color(label, lv_color_black(), 0);
+    lv_label_set_long_mode(label, LV_LABEL_LONG_WRAP);
+    lv_obj_set_size(label, 200, LV_SIZE_CONTENT);
+    lv_obj_set_pos(label, 10, 10);
+    lv_obj_scroll_to_y(label, 0, LV_ANIM_OFF);
+    lv_label_set_text(label, long_text);
+    lv_refr_now(NULL);
+}
+
+void tearDown(void)
+{
+    // 断言失败时测试中途返回：释放快照，丢弃写了标记的缓存，停掉滚动动画，恢复换行模式和背景
+    free_snapshots();
+    lv_draw_label_layout_invalidate(layout());
+    layout_off = false;
+    lv_anim_delete(label, NULL);
+    lv_label_set_long_mode(label, LV_LABEL_LONG_WRAP);
+    lv_obj_set_style_bg_opa(label, LV_OPA_TRANSP, 0);
+    lv_obj_scroll_to_y(label, 0, LV_ANIM_OFF);
+    lv_label_set_text(label, long_text);
+}
+
+void test_same_pixels_all_aligns(void)
+{
+    const lv_text_align_t aligns[] = { LV_TEXT_ALIGN_LEFT, LV_TEXT_ALIGN_CENTER, LV_TEXT_ALIGN_RIGHT };
+    const lv_font_t *fonts[] = { &lv_font_montserrat_14, &lv_font_simsun_16_cjk };
+
+    for (size_t f = 0; f < sizeof(fonts) / sizeof(fonts[0]); f++) {
+        lv_obj_set_style_text_font(label, fonts[f], 0);
+        for (size_t a = 0; a < sizeof(aligns) / sizeof(aligns[0]); a++) {
+            lv_obj_set_style_text_align(label, aligns[a], 0);
+            lv_obj_set_style_text_letter_space(label, (int32_t)a, 0);
+            assert_same_with_and_without_layout();
+        }
+    }
+}
+
+void test_same_pixels_scrolled(void)
+{
+    // 固定高度的换行标签可以滚动，滚动后跳过上方不可见的行
+    lv_obj_set_height(label, 80);
+    lv_obj_set_style_text_line_space(label, 3, 0);
+    lv_obj_set_style_text_align(label, LV_TEXT_ALIGN_CENTER, 0);
+    for (int32_t y = 0; y < 200; y += 37) {
+        lv_obj_scroll_to_y(label, y, LV_ANIM_OFF);
+        assert_same_with_and_without_layout();
+    }
+}
+
+void test_same_pixels_dot_and_scroll_modes(void)
+{
+    lv_obj_set_height(label, 60);
+    lv_label_set_long_mode(label, LV_LABEL_LONG_DOT);
+    assert_same_with_and_without_layout();
+
+    // 滚动模式不换行，宽度按LV_COORD_MAX
+    lv_obj_set_height(label, LV_SIZE_CONTENT);
+    lv_label_set_long_mode(label, LV_LABEL_LONG_SCROLL_CIRCULAR);
+    assert_same_with_and_without_layout();
+}
+
+void test_size_matches_text_get_size(void)
+{
+    static const char *texts[] = { "", "A", "one line", "two\nlines", "ends with newline\n", "\r\n\n" };
+    const int32_t widths[] = { LV_COORD_MAX, 200, 60, 1 };
+    lv_draw_label_layout_t lay;
+    memset(&lay, 0, sizeof(lay));
+
+    for (size_t t = 0; t < sizeof(texts) / sizeof(texts[0]) + 1; t++) {
+        const char *text = t < sizeof(texts) / sizeof(texts[0]) ? texts[t] : long_text;
+        for (size_t w = 0; w < sizeof(widths) / sizeof(widths[0]); w++) {
+            for (int expand = 0; expand < 2; expand++) {
+                lv_text_flag_t flag = expand ? LV_TEXT_FLAG_EXPAND : LV_TEXT_FLAG_NONE;
+                lv_point_t expected, size;
+                lv_text_get_size(&expected, text, &lv_font_simsun_16_cjk, 2, 4, widths[w], flag);
+                lv_draw_label_layout_update(&lay, text, &lv_font_simsun_16_cjk, 2, widths[w], flag);
+                TEST_ASSERT_TRUE(lv_draw_label_layout_is_valid(&lay, text, &lv_font_simsun_16_cjk, 2, widths[w], flag));
+                lv_draw_label_layout_get_size(&lay, 4, &size);
+                TEST_ASSERT_EQUAL_INT32(expected.x, size.x);
+                TEST_ASSERT_EQUAL_INT32(expected.y, size.y);
+            }
+        }
+    }
+    lv_draw_label_layout_reset(&lay);
+    TEST_ASSERT_NULL(lay.lines);
+    TEST_ASSERT_NULL(lay.letter_w);
+}
+
+void test_self_size_matches(void)
+{
+    lv_point_t expected;
+    lv_text_get_size(&expected, long_text, &lv_font_simsun_16_cjk, 0, 0, 200, LV_TEXT_FLAG_NONE);
+    TEST_ASSERT_EQUAL_INT32(expected.y, lv_obj_get_height(label));
+}
+
+void test_color_change_keeps_layout(void)
+{
+    lv_draw_buf_destroy(render(false));
+    layout()->lines[0].width = MARK_WIDTH;
+
+    lv_obj_set_style_text_color(label, lv_color_hex(0xff0000), 0);
+    lv_obj_set_style_bg_opa(label, LV_OPA_COVER, 0);
+    lv_draw_buf_destroy(render(false));
+    TEST_ASSERT_EQUAL_INT32(MARK_WIDTH, layout()->lines[0].width);
+}
+
+void test_rebuilt_on_text_font_width_and_letter_space(void)
+{
+    static char buf[64];
+
+    // 新文本
+    layout()->lines[0].width = MARK_WIDTH;
+    lv_label_set_text(label, "Short text");
+    TEST_ASSERT_EQUAL_STRING("Short text", layout()->text);
+    TEST_ASSERT_EQUAL_UINT32(1, layout()->line_cnt);
+    TEST_ASSERT_NOT_EQUAL(MARK_WIDTH, layout()->lines[0].width);
+
+    // 原地修改的静态文本
+    strcpy(buf, "AAAA");
+    lv_label_set_text_static(label, buf);
+    int32_t w4 = layout()->lines[0].width;
+    strcpy(buf, "AAAAAAAA");
+    lv_label_set_text_static(label, buf);
+    TEST_ASSERT_GREATER_THAN_INT32(w4, layout()->lines[0].width);
+
+    // 字体、宽度和字间距
+    layout()->lines[0].width = MARK_WIDTH;
+    lv_obj_set_style_text_font(label, &lv_font_montserrat_14, 0);
+    TEST_ASSERT_EQUAL_PTR(&lv_font_montserrat_14, layout()->font);
+    TEST_ASSERT_NOT_EQUAL(MARK_WIDTH, layout()->lines[0].width);
+
+    lv_obj_set_width(label, 150);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_INT32(150, layout()->max_width);
+
+    lv_obj_set_style_text_letter_space(label, 5, 0);
+    TEST_ASSERT_EQUAL_INT32(5, layout()->letter_space);
+    lv_draw_buf_destroy(render(false));
+    TEST_ASSERT_TRUE(lv_draw_label_layout_is_valid(layout(), buf, &lv_font_montserrat_14, 5, 150,
+                                                   LV_TEXT_FLAG_NONE));
+}
+
+int main(void)
+{
+    lv_port_init();
+    spi_sim_set_time_scale(0);
+    label = lv_label_create(lv_screen_active());
+    lv_obj_add_flag(label, LV_OBJ_FLAG_SEND_DRAW_TASK_EVENTS);
+    lv_obj_add_event_cb(label, draw_task_cb, LV_EVENT_DRAW_TASK_ADDED, NULL);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_same_pixels_all_aligns);
+    RUN_TEST(test_same_pixels_scrolled);
+    RUN_TEST(test_same_pixels_dot_and_scroll_modes);
+    RUN_TEST(test_size_matches_text_get_size);
+    RUN_TEST(test_self_size_matches);
+    RUN_TEST(test_color_change_keeps_layout);
+    RUN_TEST(test_rebuilt_on_text_font_width_and_letter_space);
+    return UNITY_END();
+}
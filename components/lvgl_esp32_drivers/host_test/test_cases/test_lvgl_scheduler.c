@@ -0,0 +1,171 @@
+#include <stdatomic.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "unity.h"
+#include "lvgl_port.h"
+#include "spi_sim.h"
+#include "esp_timer.h"
+
+// LVGL任务调度：按下一个定时器到期时间睡眠，外部唤醒和失效区域立即处理
+
+#define TIMER_PERIOD_MS     37
+#define TIMER_FIRES         8
+
+static atomic_bool external_data;       // 外部数据源写入的标志
+static atomic_llong external_us;        // 外部数据源唤醒LVGL的时刻
+static uint32_t fire_ms[TIMER_FIRES];
+static int fire_count;
+static uint32_t virtual_ms;             // 虚拟时基，主循环的睡眠只推进它
+
+/**
+ * @brief 按lv_port_task的方式运行主循环（本线程即LVGL任务）
+ * @param timeout_ms 运行时长
+ * @param stop 结束条件，NULL表示运行满timeout_ms
+ * @return lv_port_handler的调用次数，即唤醒次数
+ */
+static int run_loop(int timeout_ms, bool (*stop)(void))
+{
+    int64_t end = esp_timer_get_time() + timeout_ms * 1000LL;
+    int64_t now;
+    int iterations = 0;
+
+    while ((now = esp_timer_get_time()) < end) {
+        uint32_t next_ms = lv_port_handler();
+        iterations++;
+        if (stop && stop()) break;
+        uint32_t left_ms = (uint32_t)((end - now + 999) / 1000);
+        lv_port_sleep(next_ms < left_ms ? next_ms : left_ms);
+    }
+    return iterations;
+}
+
+static uint32_t virtual_tick_cb(void)
+{
+    return virtual_ms;
+}
+
+// 与移植层tick_get_cb相同的实际时基，用例结束后恢复
+static uint32_t real_tick_cb(void)
+{
+    return (uint32_t)(esp_timer_get_time() / 1000);
+}
+
+static bool external_data_seen(void)
+{
+    return atomic_load(&external_data);
+}
+
+static bool timer_done(void)
+{
+    return fire_count >= TIMER_FIRES;
+}
+
+static void periodic_cb(lv_timer_t *timer)
+{
+    if (fire_count < TIMER_FIRES) fire_ms[fire_count++] = lv_tick_get();
+}
+
+static void *external_source(void *arg)
+{
+    usleep(30 * 1000);
+    atomic_store(&external_us, esp_timer_get_time());
+    atomic_store(&external_data, true);
+    lv_port_wake();
+    return NULL;
+}
+
+void setUp(void)
+{
+    spi_sim_set_time_scale(0);
+    run_loop(50, NULL);         // 处理完上一个用例留下的定时器
+}
+
+void tearDown(void)
+{
+    lv_tick_set_cb(real_tick_cb);
+}
+
+void test_idle_loop_sleeps(void)
+{
+    const int window_ms = 500;
+    int iterations = run_loop(window_ms, NULL);
+
+    TEST_PRINTF("idle: %d wakeups in %d ms (fixed 10 ms loop: %d)", iterations, window_ms, window_ms / 10);
+    TEST_ASSERT_LESS_OR_EQUAL_INT(window_ms / LV_PORT_IDLE_SLEEP_MS + 2, iterations);
+}
+
+void test_sleeps_until_next_timer(void)
+{
+    // 虚拟时基下每次睡眠恰好推进lv_port_handler返回的时间（与lv_port_sleep一样封顶），
+    // 唤醒次数和到期时刻不受主机负载影响
+    virtual_ms = real_tick_cb();
+    lv_tick_set_cb(virtual_tick_cb);
+    fire_count = 0;
+    lv_timer_t *timer = lv_timer_create(periodic_cb, TIMER_PERIOD_MS, NULL);
+    uint32_t start = virtual_ms;
+    int iterations = 0;
+    while (!timer_done() && iterations < 10 * TIMER_FIRES) {
+        uint32_t next_ms = lv_port_handler();
+        iterations++;
+        virtual_ms += next_ms < LV_PORT_IDLE_SLEEP_MS ? next_ms : LV_PORT_IDLE_SLEEP_MS;
+    }
+    lv_timer_delete(timer);
+
+    TEST_PRINTF("%d ms timer: %d fires in %d wakeups (fixed 10 ms loop: %d)",
+                TIMER_PERIOD_MS, fire_count, iterations, TIMER_PERIOD_MS * TIMER_FIRES / 10);
+    TEST_ASSERT_EQUAL_INT(TIMER_FIRES, fire_count);
+    // 每个到期只唤醒一次左右，不按固定周期轮询
+    TEST_ASSERT_LESS_OR_EQUAL_INT(2 * TIMER_FIRES, iterations);
+    // 睡眠不会越过到期时刻，定时器也不会提前触发
+    for (int i = 0; i < TIMER_FIRES; i++) {
+        TEST_ASSERT_GREATER_OR_EQUAL_UINT32(start + (uint32_t)(i + 1) * TIMER_PERIOD_MS, fire_ms[i]);
+    }
+}
+
+void test_external_wake_is_immediate(void)
+{
+    pthread_t thread;
+    atomic_store(&external_data, false);
+    pthread_create(&thread, NULL, external_source, NULL);
+
+    run_loop(500, external_data_seen);
+    int64_t latency = esp_timer_get_time() - atomic_load(&external_us);
+    pthread_join(thread, NULL);
+
+    TEST_PRINTF("external wake latency %lld us", (long long)latency);
+    TEST_ASSERT_TRUE(atomic_load(&external_data));
+    TEST_ASSERT_LESS_THAN_INT64(2000, latency);
+}
+
+void test_invalidation_between_handlers_wakes(void)
+{
+    // 主循环空闲后在睡眠前使区域失效（例如上一轮事件回调之后），不能等到兜底超时
+    TEST_ASSERT_EQUAL_UINT32(LV_NO_TIMER_READY, lv_port_handler());
+    lv_obj_invalidate(lv_screen_active());
+
+    int64_t start = esp_timer_get_time();
+    lv_port_sleep(LV_PORT_IDLE_SLEEP_MS);
+    int64_t elapsed = esp_timer_get_time() - start;
+    lv_port_handler();
+
+    TEST_PRINTF("invalidate -> wake %lld us", (long long)elapsed);
+    TEST_ASSERT_LESS_THAN_INT64(LV_PORT_IDLE_SLEEP_MS * 1000 / 2, elapsed);
+}
+
+int main(void)
+{
+    lv_port_init();
+    // 等上电时序的定时器结束，用例中只有空闲和用例自己的定时器
+    lv_port_boot_stats_t boot = {0};
+    for (int i = 0; i < 20 && boot.display_on_us == 0; i++) {
+        run_loop(50, NULL);
+        lv_port_get_boot_stats(&boot);
+    }
+
+    UNITY_BEGIN();
+    RUN_TEST(test_idle_loop_sleeps);
+    RUN_TEST(test_sleeps_until_next_timer);
+    RUN_TEST(test_external_wake_is_immediate);
+    RUN_TEST(test_invalidation_between_handlers_wakes);
+    return UNITY_END();
+}
@@ -0,0 +1,181 @@
+#include <string.h>
+#include "unity.h"
+#include "lvgl_port.h"
+#include "spi_sim.h"
+#include "xpt2046_sim.h"
+#include "esp_timer.h"
+#include "esp_rom_sys.h"
+
+// 移植层性能计数器：与仿真总线自己的统计对照，并检查sysmon叠加层每个周期给出文本
+
+#define RAW_FOR(px, res, min, max)  ((uint16_t)(2 * ((min) + ((px) * ((max) - (min)) + (res) - 1) / (res))))
+#define SCREEN_PX                   (LV_HOR_RES_MAX * LV_VER_RES_MAX)
+
+static void run_loop(int timeout_ms)
+{
+    int64_t end = esp_timer_get_time() + timeout_ms * 1000LL;
+    while (esp_timer_get_time() < end) {
+        uint32_t next_ms = lv_port_handler();
+        lv_port_sleep(next_ms < 5 ? next_ms : 5);
+    }
+}
+
+/**
+ * @brief 全屏刷新一帧，等最后一块传完
+ */
+static void refresh_full_screen(void)
+{
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+    disp_wait_for_pending_transactions();
+}
+
+void setUp(void)
+{
+    disp_wait_for_pending_transactions();
+    spi_sim_set_time_scale(100);
+}
+
+void tearDown(void)
+{
+    lv_port_hide_perf_stats();
+}
+
+void test_spi_counters_match_bus(void)
+{
+    port_stats_mark_t mark;
+    spi_sim_stats_t bus;
+
+    spi_sim_reset_stats(LCD_SPI_HOST);
+    port_stats_mark(&mark);
+    uint32_t busy_cycles = atomic_load(&port_stats.spi_busy_cycles);
+    refresh_full_screen();
+    refresh_full_screen();
+    port_stats_period_t stats;
+    port_stats_read(&mark, &stats);
+    busy_cycles = atomic_load(&port_stats.spi_busy_cycles) - busy_cycles;
+    spi_sim_get_stats(LCD_SPI_HOST, &bus);
+
+    TEST_PRINTF("%u trans, %u bytes, busy %u us (%u%%), wait %u us in %u, queue %u/10 max %u, swap %u us, "
+                "flush %u us", (unsigned)stats.spi_trans, (unsigned)stats.spi_bytes, (unsigned)stats.spi_busy_us,
+                (unsigned)stats.spi_busy_pct, (unsigned)stats.spi_wait_us, (unsigned)stats.spi_waits,
+                (unsigned)(stats.queue_depth_avg * 10), (unsigned)stats.queue_depth_max, (unsigned)stats.swap_us,
+                (unsigned)stats.flush_latency_avg_us);
+
+    // 每个事务、每个字节都与总线一致
+    TEST_ASSERT_EQUAL_UINT32(bus.trans_count, stats.spi_trans);
+    TEST_ASSERT_EQUAL_UINT32((uint32_t)(bus.tx_bytes + bus.rx_bytes), stats.spi_bytes);
+    TEST_ASSERT_EQUAL_UINT32(2 * SCREEN_PX, stats.pixels);
+    TEST_ASSERT_EQUAL_UINT32(2 * LV_VER_RES_MAX / (DISP_BUF_SIZE / LV_HOR_RES_MAX), stats.windows);
+
+    // 总线忙的周期数在pre_cb和post_cb中读取，落在仿真总线在两个回调前后读取的周期数之间，
+    // 不经过周期数与微秒的换算；周期内的利用率在0~100%之间
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT64(bus.cb_cycles_min, busy_cycles);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT64(bus.cb_cycles_max, busy_cycles);
+    TEST_ASSERT_EQUAL_UINT32(busy_cycles / esp_rom_get_cpu_ticks_per_us(), stats.spi_busy_us);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(stats.period_us, stats.spi_busy_us);
+    TEST_ASSERT_GREATER_THAN_UINT8(0, stats.spi_busy_pct);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT8(100, stats.spi_busy_pct);
+
+    // 每帧末尾等最后一块传完；渲染比传输快，排队时前面总有事务
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(2, stats.spi_waits);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, stats.spi_wait_us);
+    TEST_ASSERT_GREATER_THAN_FLOAT(0.0f, stats.queue_depth_avg);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(DISP_SPI_TRANS_RING_SIZE, stats.queue_depth_max);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, stats.swap_us);
+
+    // 下一帧的第一块确认上一帧最后一块传完，第二帧的最后一块尚未计入
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(stats.windows - 1, stats.flushes);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, stats.flush_latency_avg_us);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(stats.flush_latency_avg_us, stats.flush_latency_max_us);
+}
+
+void test_marks_are_independent(void)
+{
+    port_stats_mark_t a, b;
+    port_stats_period_t stats_a, stats_b;
+
+    port_stats_mark(&a);
+    port_stats_mark(&b);
+    refresh_full_screen();
+    port_stats_read(&a, &stats_a);
+    port_stats_read(&b, &stats_b);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, stats_a.spi_trans);
+    TEST_ASSERT_EQUAL_UINT32(stats_a.spi_trans, stats_b.spi_trans);
+    TEST_ASSERT_EQUAL_UINT32(stats_a.pixels, stats_b.pixels);
+
+    // 读取后起点前移，没有新传输时为0；最大值也是本周期的
+    port_stats_read(&a, &stats_a);
+    TEST_ASSERT_EQUAL_UINT32(0, stats_a.spi_trans);
+    TEST_ASSERT_EQUAL_UINT32(0, stats_a.spi_busy_us);
+    TEST_ASSERT_EQUAL_UINT32(0, stats_a.queue_depth_max);
+    TEST_ASSERT_EQUAL_UINT32(0, stats_a.flush_latency_max_us);
+}
+
+void test_touch_latency(void)
+{
+    const xpt2046_sim_sample_t sample = {
+        .x = RAW_FOR(160, LV_HOR_RES_MAX, XPT2046_X_MIN, XPT2046_X_MAX),
+        .y = RAW_FOR(120, LV_VER_RES_MAX, XPT2046_Y_MIN, XPT2046_Y_MAX),
+        .z1 = 600,
+        .z2 = 3000,
+    };
+    port_stats_mark_t mark;
+    port_stats_period_t stats;
+
+    port_stats_mark(&mark);
+    xpt2046_sim_press(&sample, 1);
+    run_loop(100);
+    xpt2046_sim_release();
+    run_loop(100);
+    port_stats_read(&mark, &stats);
+
+    TEST_PRINTF("%u samples, %u reads, latency %u us (max %u)", (unsigned)stats.touch_samples,
+                (unsigned)stats.touch_reads, (unsigned)stats.touch_latency_avg_us,
+                (unsigned)stats.touch_latency_max_us);
+    TEST_ASSERT_GREATER_THAN_UINT32(1, stats.touch_reads);
+    TEST_ASSERT_EQUAL_UINT32(stats.touch_samples, stats.touch_reads);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, stats.touch_latency_avg_us);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(stats.touch_latency_avg_us, stats.touch_latency_max_us);
+    // LVGL任务空闲时被采样任务唤醒，延迟远小于一个采样周期
+    TEST_ASSERT_LESS_THAN_UINT32(XPT2046_SAMPLE_PERIOD_MS * 1000, stats.touch_latency_avg_us);
+}
+
+void test_sysmon_overlay_shows_counters(void)
+{
+    lv_obj_t *label = lv_port_show_perf_stats(false);
+    TEST_ASSERT_NOT_NULL(label);
+    TEST_ASSERT_FALSE(lv_obj_has_flag(label, LV_OBJ_FLAG_HIDDEN));
+
+    lv_obj_invalidate(lv_screen_active());
+    run_loop(400);
+    const char *text = lv_label_get_text(label);
+    TEST_PRINTF("%s", text);
+    TEST_ASSERT_EQUAL_STRING_LEN("SPI ", text, 4);
+    TEST_ASSERT_NOT_NULL(strstr(text, "queue "));
+    TEST_ASSERT_NOT_NULL(strstr(text, "touch "));
+
+    // 日志模式不显示标签；隐藏后不再更新
+    TEST_ASSERT_EQUAL_PTR(label, lv_port_show_perf_stats(true));
+    TEST_ASSERT_TRUE(lv_obj_has_flag(label, LV_OBJ_FLAG_HIDDEN));
+    lv_port_hide_perf_stats();
+    lv_label_set_text(label, "hidden");
+    run_loop(400);
+    TEST_ASSERT_EQUAL_STRING("hidden", lv_label_get_text(label));
+}
+
+int main(void)
+{
+    lv_port_init();
+    xpt2046_sim_init(TP_SPI_CS, TP_SPI_IRQ);
+    lv_obj_t *label = lv_label_create(lv_screen_active());
+    lv_label_set_text(label, "port stats");
+    run_loop(200);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_spi_counters_match_bus);
+    RUN_TEST(test_marks_are_independent);
+    RUN_TEST(test_touch_latency);
+    RUN_TEST(test_sysmon_overlay_shows_counters);
+    return UNITY_END();
+}
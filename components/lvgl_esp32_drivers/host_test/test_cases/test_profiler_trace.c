@@ -0,0 +1,292 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "unity.h"
+#include "lvgl_port.h"
+#include "spi_sim.h"
+#include "xpt2046_sim.h"
+#include "esp_timer.h"
+
+// 性能跟踪：移植层的跟踪点出现在二进制流中，各线程的开始/结束成对嵌套，多线程并发记录时事件不丢不乱
+// 并发用例的跟踪流写入profiler_trace.bin，由lv_trace2json测试转换
+
+#define RAW_FOR(px, res, min, max)  ((uint16_t)(2 * ((min) + ((px) * ((max) - (min)) + (res) - 1) / (res))))
+#define TRACE_BUF_SIZE  (4 * 1024 * 1024)
+#define NAMES_MAX       256
+#define DEPTH_MAX       64
+#define THREADS_MAX     LV_PROFILER_BUILTIN_THREAD_MAX
+#define PRODUCERS       3
+#define PRODUCER_PAIRS  20000
+#define PRODUCER_BURST  32          // 每写这么多对事件让出一次，模拟绘制线程的节奏
+
+/**
+ * @brief 一个线程在跟踪流中的统计
+ */
+typedef struct {
+    bool seen;
+    uint32_t begins;
+    uint32_t ends;
+    uint32_t dropped;
+    uint32_t nesting_errors;    // 结束与栈顶的开始不匹配
+    uint32_t tick_errors;       // 时间戳倒退
+    uint32_t last_tick;
+    uint32_t depth;
+    uint16_t stack[DEPTH_MAX];
+    uint32_t name_begins[NAMES_MAX];
+} trace_thread_t;
+
+static uint8_t trace_buf[TRACE_BUF_SIZE];
+static uint32_t trace_len;
+static char names[NAMES_MAX][64];
+static trace_thread_t threads[THREADS_MAX];
+static atomic_int producers_running;
+
+static void trace_write(const void *buf, uint32_t size)
+{
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(sizeof(trace_buf), trace_len + size);
+    memcpy(&trace_buf[trace_len], buf, size);
+    trace_len += size;
+}
+
+static uint32_t get_u32(const uint8_t *p)
+{
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/**
+ * @brief 解析trace_buf中的跟踪流，统计写入threads
+ */
+static void parse_trace(void)
+{
+    memset(threads, 0, sizeof(threads));
+    memset(names, 0, sizeof(names));
+
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(LV_PROFILER_BUILTIN_BIN_HEADER_SIZE, trace_len);
+    TEST_ASSERT_EQUAL_MEMORY(LV_PROFILER_BUILTIN_BIN_MAGIC, trace_buf, 4);
+    TEST_ASSERT_EQUAL_UINT8(LV_PROFILER_BUILTIN_BIN_VERSION, trace_buf[4]);
+    TEST_ASSERT_EQUAL_UINT32(1000000, get_u32(&trace_buf[8]));
+
+    trace_thread_t *thread = NULL;
+    uint32_t pos = LV_PROFILER_BUILTIN_BIN_HEADER_SIZE;
+    while (pos < trace_len) {
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(trace_len, pos + LV_PROFILER_BUILTIN_BIN_RECORD_SIZE);
+        const uint8_t *rec = &trace_buf[pos];
+        uint16_t id = rec[2] | (rec[3] << 8);
+        uint32_t val = get_u32(&rec[4]);
+        pos += LV_PROFILER_BUILTIN_BIN_RECORD_SIZE;
+
+        switch (rec[0]) {
+        case 'N':
+            TEST_ASSERT_LESS_THAN_UINT16(NAMES_MAX, id);
+            memcpy(names[id], &trace_buf[pos], LV_MIN(rec[1], sizeof(names[id]) - 1));
+            pos += rec[1];
+            break;
+        case 'T':
+            TEST_ASSERT_LESS_THAN_UINT8(THREADS_MAX, rec[1]);
+            thread = &threads[rec[1]];
+            thread->seen = true;
+            break;
+        case 'B':
+        case 'E':
+            TEST_ASSERT_NOT_NULL(thread);
+            TEST_ASSERT_LESS_THAN_UINT16(NAMES_MAX, id);
+            TEST_ASSERT_NOT_EQUAL_CHAR(0, names[id][0]);
+            if (thread->begins + thread->ends > 0 && (int32_t)(val - thread->last_tick) < 0) thread->tick_errors++;
+            thread->last_tick = val;
+            if (rec[0] == 'B') {
+                thread->begins++;
+                thread->name_begins[id]++;
+                if (thread->depth < DEPTH_MAX) thread->stack[thread->depth] = id;
+                thread->depth++;
+            } else {
+                thread->ends++;
+                if (thread->depth == 0 || (thread->depth <= DEPTH_MAX && thread->stack[thread->depth - 1] != id)) {
+                    thread->nesting_errors++;
+                }
+                if (thread->depth > 0) thread->depth--;
+            }
+            break;
+        case 'D':
+            if (rec[1] < THREADS_MAX) threads[rec[1]].dropped += val;
+            break;
+        default:
+            TEST_FAIL_MESSAGE("未知记录类型");
+        }
+    }
+}
+
+/**
+ * @brief 所有线程中名为name的跟踪点开始的次数
+ */
+static uint32_t begins_of(const char *name)
+{
+    uint32_t count = 0;
+    for (int id = 0; id < NAMES_MAX; id++) {
+        if (strcmp(names[id], name) != 0) continue;
+        for (int t = 0; t < THREADS_MAX; t++) count += threads[t].name_begins[id];
+    }
+    return count;
+}
+
+static void run_loop(int timeout_ms)
+{
+    int64_t end = esp_timer_get_time() + timeout_ms * 1000LL;
+    while (esp_timer_get_time() < end) {
+        uint32_t next_ms = lv_port_handler();
+        lv_port_sleep(next_ms < 5 ? next_ms : 5);
+    }
+}
+
+static void *producer(void *arg)
+{
+    const char *tag = arg;
+    for (int i = 0; i < PRODUCER_PAIRS; i++) {
+        LV_PROFILER_BEGIN_TAG(tag);
+        LV_PROFILER_BEGIN_TAG("inner");
+        LV_PROFILER_END_TAG("inner");
+        LV_PROFILER_END_TAG(tag);
+        if (i % PRODUCER_BURST == PRODUCER_BURST - 1) usleep(20);
+    }
+    atomic_fetch_sub(&producers_running, 1);
+    return NULL;
+}
+
+void setUp(void)
+{
+    spi_sim_set_time_scale(100);
+    trace_len = 0;
+    TEST_ASSERT_TRUE(lv_port_set_trace_output(trace_write));
+}
+
+void tearDown(void)
+{
+    lv_port_set_trace_output(NULL);
+}
+
+void test_frame_and_touch_trace_points(void)
+{
+    lv_obj_invalidate(lv_screen_active());
+    const xpt2046_sim_sample_t sample = {
+        .x = RAW_FOR(160, LV_HOR_RES_MAX, XPT2046_X_MIN, XPT2046_X_MAX),
+        .y = RAW_FOR(120, LV_VER_RES_MAX, XPT2046_Y_MIN, XPT2046_Y_MAX),
+        .z1 = 600,
+        .z2 = 3000,
+    };
+    xpt2046_sim_press(&sample, 1);
+    run_loop(100);
+    xpt2046_sim_release();
+    run_loop(100);
+    parse_trace();
+
+    TEST_PRINTF("%u bytes: disp_flush %u, disp_flush_wait %u, disp_spi_wait %u, xpt2046_read %u, burst %u",
+                (unsigned)trace_len, (unsigned)begins_of("disp_flush"), (unsigned)begins_of("disp_flush_wait"),
+                (unsigned)begins_of("disp_spi_wait"), (unsigned)begins_of("xpt2046_read"),
+                (unsigned)begins_of("xpt2046_burst_read"));
+    TEST_ASSERT_GREATER_THAN_UINT32(0, begins_of("lv_display_refr_timer"));
+    TEST_ASSERT_GREATER_THAN_UINT32(0, begins_of("disp_flush"));
+    TEST_ASSERT_GREATER_THAN_UINT32(0, begins_of("disp_flush_wait"));
+    TEST_ASSERT_GREATER_THAN_UINT32(0, begins_of("xpt2046_read"));
+    TEST_ASSERT_GREATER_THAN_UINT32(0, begins_of("xpt2046_burst_read"));
+
+    // LVGL任务和触摸采样任务各用一个环，每个线程的开始/结束成对嵌套
+    uint32_t seen = 0;
+    for (int t = 0; t < THREADS_MAX; t++) {
+        if (!threads[t].seen) continue;
+        seen++;
+        TEST_ASSERT_EQUAL_UINT32(0, threads[t].dropped);
+        TEST_ASSERT_EQUAL_UINT32(0, threads[t].nesting_errors);
+        TEST_ASSERT_EQUAL_UINT32(0, threads[t].tick_errors);
+    }
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(2, seen);
+}
+
+void test_concurrent_threads_record_lock_free(void)
+{
+    static const char *tags[PRODUCERS] = { "producer0", "producer1", "producer2" };
+    pthread_t ids[PRODUCERS];
+    atomic_store(&producers_running, PRODUCERS);
+    for (int i = 0; i < PRODUCERS; i++) pthread_create(&ids[i], NULL, producer, (void *)tags[i]);
+    // 生产者记录的同时输出；环满时生产者不等待，丢弃并计数
+    while (atomic_load(&producers_running) > 0) {
+        lv_profiler_builtin_flush();
+        usleep(100);
+    }
+    for (int i = 0; i < PRODUCERS; i++) pthread_join(ids[i], NULL);
+    lv_profiler_builtin_flush();
+    parse_trace();
+
+    FILE *f = fopen("profiler_trace.bin", "wb");
+    TEST_ASSERT_NOT_NULL(f);
+    fwrite(trace_buf, 1, trace_len, f);
+    fclose(f);
+
+    uint32_t producers_seen = 0;
+    for (int t = 0; t < THREADS_MAX; t++) {
+        if (!threads[t].seen || threads[t].begins + threads[t].ends + threads[t].dropped == 0) continue;
+        trace_thread_t *thread = &threads[t];
+        TEST_PRINTF("thread %d: %u begins, %u ends, %u dropped", t, (unsigned)thread->begins,
+                    (unsigned)thread->ends, (unsigned)thread->dropped);
+        // 每个生产者独占一个环：记录的和丢弃的合计恰好是它写入的事件数
+        TEST_ASSERT_EQUAL_UINT32(PRODUCER_PAIRS * 4, thread->begins + thread->ends + thread->dropped);
+        TEST_ASSERT_EQUAL_UINT32(0, thread->tick_errors);
+        if (thread->dropped == 0) TEST_ASSERT_EQUAL_UINT32(0, thread->nesting_errors);
+        producers_seen++;
+    }
+    TEST_ASSERT_EQUAL_UINT32(PRODUCERS, producers_seen);
+    for (int i = 0; i < PRODUCERS; i++) TEST_ASSERT_GREATER_THAN_UINT32(0, begins_of(tags[i]));
+}
+
+void test_restart_while_recording(void)
+{
+    static const char *tags[PRODUCERS] = { "producer0", "producer1", "producer2" };
+    pthread_t ids[PRODUCERS];
+    atomic_store(&producers_running, PRODUCERS);
+    for (int i = 0; i < PRODUCERS; i++) pthread_create(&ids[i], NULL, producer, (void *)tags[i]);
+    // 生产者记录的同时反复重新设置输出：缓冲区不释放，每次输出流从头部开始
+    while (atomic_load(&producers_running) > 0) {
+        trace_len = 0;
+        TEST_ASSERT_TRUE(lv_port_set_trace_output(trace_write));
+        lv_profiler_builtin_flush();
+        usleep(100);
+    }
+    for (int i = 0; i < PRODUCERS; i++) pthread_join(ids[i], NULL);
+
+    // 最后一次重新开始之后的流完整可解析，生产者退出后空出的环可以再分给新线程
+    trace_len = 0;
+    TEST_ASSERT_TRUE(lv_port_set_trace_output(trace_write));
+    pthread_t id;
+    atomic_store(&producers_running, 1);
+    pthread_create(&id, NULL, producer, (void *)tags[0]);
+    pthread_join(id, NULL);
+    lv_profiler_builtin_flush();
+    parse_trace();
+    TEST_ASSERT_GREATER_THAN_UINT32(0, begins_of(tags[0]));
+}
+
+void test_no_output_records_nothing(void)
+{
+    lv_port_set_trace_output(NULL);
+    trace_len = 0;
+    lv_obj_invalidate(lv_screen_active());
+    run_loop(100);
+    lv_profiler_builtin_flush();
+    TEST_ASSERT_EQUAL_UINT32(0, trace_len);
+}
+
+int main(void)
+{
+    lv_port_init();
+    xpt2046_sim_init(TP_SPI_CS, TP_SPI_IRQ);
+    lv_obj_t *label = lv_label_create(lv_screen_active());
+    lv_label_set_text(label, "trace");
+    run_loop(200);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_frame_and_touch_trace_points);
+    RUN_TEST(test_concurrent_threads_record_lock_free);
+    RUN_TEST(test_restart_while_recording);
+    RUN_TEST(test_no_output_records_nothing);
+    return UNITY_END();
+}
@@ -0,0 +1,178 @@
+#include <string.h>
+#include "unity.h"
+#include "lvgl_port.h"
+#include "spi_sim.h"
+#include "ili9341_sim.h"
+
+// 影子帧缓冲比较：没有变化的刷新不发送，小的变化只发送变化的部分，面板内容与整屏发送时一致
+
+static lv_obj_t *label;
+static uint16_t panel[LV_VER_RES_MAX][LV_HOR_RES_MAX];
+
+/**
+ * @brief 刷新一帧并等传完
+ */
+static void refresh(ili9341_sim_frame_t *frame)
+{
+    ili9341_sim_frame_begin();
+    lv_refr_now(NULL);
+    disp_wait_for_pending_transactions();
+    ili9341_sim_frame_end(frame);
+}
+
+static void save_panel(void)
+{
+    for (int y = 0; y < LV_VER_RES_MAX; y++) {
+        for (int x = 0; x < LV_HOR_RES_MAX; x++) {
+            panel[y][x] = ili9341_sim_get_pixel(x, y);
+        }
+    }
+}
+
+/**
+ * @brief 关闭比较后整屏重新发送，与之前的面板内容比较
+ */
+static void assert_panel_matches_full_redraw(void)
+{
+    ili9341_sim_frame_t frame;
+    save_panel();
+    lv_port_set_shadow_diff(false);
+    lv_obj_invalidate(lv_screen_active());
+    refresh(&frame);
+    for (int y = 0; y < LV_VER_RES_MAX; y++) {
+        for (int x = 0; x < LV_HOR_RES_MAX; x++) {
+            if (panel[y][x] != ili9341_sim_get_pixel(x, y)) {
+                TEST_PRINTF("pixel (%d, %d): 0x%04x, full redraw 0x%04x", x, y, panel[y][x],
+                            ili9341_sim_get_pixel(x, y));
+                TEST_FAIL_MESSAGE("panel differs from full redraw");
+            }
+        }
+    }
+}
+
+void setUp(void)
+{
+    disp_wait_for_pending_transactions();
+    spi_sim_set_time_scale(0);
+    lv_label_set_text(label, "12345");
+    TEST_ASSERT_TRUE(lv_port_set_shadow_diff(true));
+    // 启用时整屏失效，这一帧把副本填满
+    ili9341_sim_frame_t frame;
+    refresh(&frame);
+    TEST_ASSERT_EQUAL_UINT64(LV_HOR_RES_MAX * LV_VER_RES_MAX, frame.pixels_written);
+}
+
+void tearDown(void)
+{
+    lv_port_set_shadow_diff(false);
+}
+
+void test_unchanged_refresh_sends_nothing(void)
+{
+    lv_port_stripe_stats_t stats;
+    ili9341_sim_frame_t frame;
+
+    lv_port_reset_stripe_stats();
+    lv_obj_invalidate(lv_screen_active());
+    refresh(&frame);
+    lv_port_get_stripe_stats(&stats);
+
+    TEST_ASSERT_EQUAL_UINT64(0, frame.pixels_written);
+    TEST_ASSERT_EQUAL_UINT32(0, frame.window_count);
+    TEST_ASSERT_EQUAL_UINT64(0, stats.bytes_sent);
+    TEST_ASSERT_EQUAL_UINT64(LV_HOR_RES_MAX * LV_VER_RES_MAX * 2, stats.bytes_skipped);
+}
+
+void test_small_change_sends_changed_span(void)
+{
+    ili9341_sim_frame_t frame;
+
+    lv_obj_update_layout(label);
+    lv_area_t coords;
+    lv_obj_get_coords(label, &coords);
+
+    // 只改最后一位，宽度不变
+    lv_label_set_text(label, "12346");
+    refresh(&frame);
+    TEST_PRINTF("label %dx%d: %u px in %u windows", (int)lv_area_get_width(&coords),
+                (int)lv_area_get_height(&coords), (unsigned)frame.pixels_written, (unsigned)frame.window_count);
+    TEST_ASSERT_GREATER_THAN_UINT64(0, frame.pixels_written);
+    TEST_ASSERT_LESS_THAN_UINT64(lv_area_get_size(&coords) / 2, frame.pixels_written);
+
+    assert_panel_matches_full_redraw();
+}
+
+void test_scattered_changes_keep_panel_correct(void)
+{
+    ili9341_sim_frame_t frame;
+
+    // 两处相隔较远的变化，以及奇数起始列的窄区域
+    lv_obj_t *box = lv_obj_create(lv_screen_active());
+    lv_obj_remove_style_all(box);
+    lv_obj_set_style_bg_opa(box, LV_OPA_COVER, 0);
+    lv_obj_set_style_bg_color(box, lv_color_hex(0x3366cc), 0);
+    lv_obj_set_pos(box, 201, 181);
+    lv_obj_set_size(box, 7, 5);
+    lv_label_set_text(label, "92345");
+    lv_obj_invalidate(lv_screen_active());
+    refresh(&frame);
+    TEST_PRINTF("%u px in %u windows", (unsigned)frame.pixels_written, (unsigned)frame.window_count);
+    TEST_ASSERT_GREATER_THAN_UINT32(1, frame.window_count);
+    TEST_ASSERT_LESS_THAN_UINT64(LV_HOR_RES_MAX * LV_VER_RES_MAX / 20, frame.pixels_written);
+
+    assert_panel_matches_full_redraw();
+    lv_obj_delete(box);
+}
+
+void test_max_windows_fit_spi_ring(void)
+{
+    // 相邻两块各有LV_PORT_SHADOW_RECTS_MAX处相隔较远的小变化，每块拆出最多的窗口，
+    // 总线按实际速度传输，两块同时在途时事务环也不能满
+    lv_obj_t *dots[2 * LV_PORT_SHADOW_RECTS_MAX];
+    const int32_t band = DISP_BUF_SIZE / LV_HOR_RES_MAX;
+    for (int i = 0; i < 2 * LV_PORT_SHADOW_RECTS_MAX; i++) {
+        int k = i % LV_PORT_SHADOW_RECTS_MAX;
+        dots[i] = lv_obj_create(lv_screen_active());
+        lv_obj_remove_style_all(dots[i]);
+        lv_obj_set_style_bg_opa(dots[i], LV_OPA_COVER, 0);
+        lv_obj_set_style_bg_color(dots[i], lv_color_hex(0xcc3366), 0);
+        lv_obj_set_pos(dots[i], 4 + k * (LV_HOR_RES_MAX / LV_PORT_SHADOW_RECTS_MAX),
+                       (i / LV_PORT_SHADOW_RECTS_MAX) * band + k * (band / LV_PORT_SHADOW_RECTS_MAX));
+        lv_obj_set_size(dots[i], 2, 2);
+    }
+    ili9341_sim_frame_t frame;
+    lv_obj_invalidate(lv_screen_active());
+    refresh(&frame);
+
+    spi_sim_set_time_scale(100);
+    uint32_t ring_full = atomic_load(&port_stats.spi_ring_full);
+    for (int i = 0; i < 2 * LV_PORT_SHADOW_RECTS_MAX; i++) {
+        lv_obj_set_style_bg_color(dots[i], lv_color_hex(0x33cc66), 0);
+    }
+    lv_obj_invalidate(lv_screen_active());
+    refresh(&frame);
+    TEST_PRINTF("%u px in %u windows", (unsigned)frame.pixels_written, (unsigned)frame.window_count);
+    TEST_ASSERT_EQUAL_UINT32(2 * LV_PORT_SHADOW_RECTS_MAX, frame.window_count);
+    TEST_ASSERT_EQUAL_UINT32(ring_full, atomic_load(&port_stats.spi_ring_full));
+
+    assert_panel_matches_full_redraw();
+    for (int i = 0; i < 2 * LV_PORT_SHADOW_RECTS_MAX; i++) {
+        lv_obj_delete(dots[i]);
+    }
+}
+
+int main(void)
+{
+    ili9341_sim_init(LCD_SPI_HOST, LCD_SPI_CS, LCD_SPI_DC, LCD_SPI_RST);
+    lv_port_init();
+
+    label = lv_label_create(lv_screen_active());
+    lv_obj_set_pos(label, 40, 30);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_unchanged_refresh_sends_nothing);
+    RUN_TEST(test_small_change_sends_changed_span);
+    RUN_TEST(test_scattered_changes_keep_panel_correct);
+    RUN_TEST(test_max_windows_fit_spi_ring);
+    return UNITY_END();
+}
@@ -0,0 +1,180 @@
+#include "unity.h"
+#include "lvgl_port.h"
+#include "stripe_tuner.h"
+#include "spi_sim.h"
+#include "ili9341_sim.h"
+
+// 条带高度自适应：在仿真总线上检查条带切分是否完整；高度的选择用合成的耗时样本驱动选择器，
+// 结果只取决于注入的耗时模型，不受主机负载影响
+
+#define BUF_LINES       (DISP_BUF_SIZE / LV_HOR_RES_MAX)
+#define MODEL_SAMPLES   40
+
+/**
+ * @brief 注入的耗时模型：每块固定开销 + 每行开销（微秒）
+ */
+typedef struct {
+    uint32_t render_fixed_us;
+    uint32_t render_line_us;
+    uint32_t xfer_fixed_us;
+    uint32_t xfer_line_us;
+} cost_model_t;
+
+static const lv_area_t full_screen = {0, 0, LV_HOR_RES_MAX - 1, LV_VER_RES_MAX - 1};
+
+/**
+ * @brief 按模型生成样本，行数在缓冲区上限和一半之间交替（与选择器建模时的试探相同）
+ */
+static void feed_model(stripe_tuner_t *t, const cost_model_t *m)
+{
+    stripe_tuner_init(t, LV_HOR_RES_MAX, LV_PORT_STRIPE_MIN_LINES, BUF_LINES);
+    for (int i = 0; i < MODEL_SAMPLES; i++) {
+        uint32_t lines = i % 2 ? BUF_LINES / 2 : BUF_LINES;
+        uint32_t px = lines * LV_HOR_RES_MAX;
+        stripe_tuner_add_render(t, px, m->render_fixed_us + m->render_line_us * lines);
+        stripe_tuner_add_xfer(t, px, m->xfer_fixed_us + m->xfer_line_us * lines);
+    }
+}
+
+/**
+ * @brief 拟合应还原注入的模型
+ */
+static void assert_fit(const stripe_tuner_t *t, const cost_model_t *m)
+{
+    TEST_ASSERT_TRUE(t->render.valid);
+    TEST_ASSERT_TRUE(t->xfer.valid);
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, m->render_fixed_us, t->render.fixed_us);
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, m->render_line_us, t->render.line_us);
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, m->xfer_fixed_us, t->xfer.fixed_us);
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, m->xfer_line_us, t->xfer.line_us);
+}
+
+/**
+ * @brief 全屏刷新一帧，等最后一块传完
+ */
+static void refresh_full_screen(void)
+{
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+    disp_wait_for_pending_transactions();
+}
+
+/**
+ * @brief 连续刷新若干帧，返回平均帧时间
+ */
+static uint32_t run_frames(uint32_t frames, lv_port_stripe_stats_t *stats)
+{
+    lv_port_reset_stripe_stats();
+    for (uint32_t i = 0; i < frames; i++) {
+        refresh_full_screen();
+    }
+    lv_port_get_stripe_stats(stats);
+    TEST_ASSERT_EQUAL_UINT32(frames, stats->frames);
+    return (uint32_t)(stats->frame_us_total / stats->frames);
+}
+
+void setUp(void)
+{
+    disp_wait_for_pending_transactions();
+    spi_sim_set_time_scale(100);
+    lv_port_set_adaptive_stripe(false);
+}
+
+void tearDown(void)
+{
+    lv_port_set_adaptive_stripe(false);
+}
+
+void test_fixed_mode_reports_full_buffer_stripes(void)
+{
+    lv_port_stripe_stats_t stats;
+    run_frames(1, &stats);
+
+    TEST_ASSERT_FALSE(stats.adaptive);
+    TEST_ASSERT_EQUAL_UINT16(BUF_LINES, stats.stripe_lines);
+    TEST_ASSERT_EQUAL_UINT32(LV_VER_RES_MAX / BUF_LINES, stats.stripes);
+    // 40MHz总线上整屏像素至少需要 320*240*16/40 微秒
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(LV_HOR_RES_MAX * LV_VER_RES_MAX * 16 / 40, stats.frame_us);
+    TEST_ASSERT_EQUAL_UINT32(stats.frame_us, stats.frame_us_max);
+}
+
+void test_adaptive_frames_are_complete(void)
+{
+    lv_port_set_adaptive_stripe(true);
+    lv_port_stripe_stats_t stats;
+
+    for (int i = 0; i < 4; i++) {
+        ili9341_sim_frame_begin();
+        refresh_full_screen();
+        ili9341_sim_frame_t frame;
+        ili9341_sim_frame_end(&frame);
+        lv_port_get_stripe_stats(&stats);
+
+        TEST_ASSERT_EQUAL_UINT64(LV_HOR_RES_MAX * LV_VER_RES_MAX, frame.pixels_written);
+        TEST_ASSERT_EQUAL_UINT32(stats.stripes, frame.window_count);
+        TEST_ASSERT_LESS_OR_EQUAL_UINT16(BUF_LINES, stats.stripe_lines);
+        TEST_ASSERT_GREATER_OR_EQUAL_UINT16(LV_PORT_STRIPE_MIN_LINES, stats.stripe_lines);
+    }
+
+    // 小区域只有一块
+    lv_area_t area = {10, 10, 49, 29};
+    lv_obj_invalidate_area(lv_screen_active(), &area);
+    lv_refr_now(NULL);
+    disp_wait_for_pending_transactions();
+    lv_port_get_stripe_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.stripes);
+}
+
+void test_render_bound_uses_full_buffer(void)
+{
+    // 总线不占时间，每块渲染固定开销大：块越少越好
+    const cost_model_t model = { .render_fixed_us = 1500, .render_line_us = 10 };
+    stripe_tuner_t t;
+    feed_model(&t, &model);
+    assert_fit(&t, &model);
+
+    uint16_t lines = stripe_tuner_choose(&t, &full_screen, 1);
+    uint32_t stripes;
+    float predicted = stripe_tuner_predict(&t, &full_screen, 1, lines, &stripes);
+    TEST_PRINTF("render bound: %u lines x %u stripes, predicted %u us", lines, (unsigned)stripes, (unsigned)predicted);
+    TEST_ASSERT_EQUAL_UINT16(BUF_LINES, lines);
+    TEST_ASSERT_EQUAL_UINT32(LV_VER_RES_MAX / BUF_LINES, stripes);
+    // 1500*6 + 10*240
+    TEST_ASSERT_FLOAT_WITHIN(10.0f, 11400.0f, predicted);
+}
+
+void test_balanced_pipeline_uses_smaller_stripes(void)
+{
+    // 渲染和传输每行开销相近（40MHz下每行128us）、固定开销小：小条带缩短流水的首尾
+    const cost_model_t model = {
+        .render_fixed_us = 100, .render_line_us = 110, .xfer_fixed_us = 40, .xfer_line_us = 128,
+    };
+    stripe_tuner_t t;
+    feed_model(&t, &model);
+    assert_fit(&t, &model);
+
+    uint16_t lines = stripe_tuner_choose(&t, &full_screen, 1);
+    uint32_t stripes, fixed_stripes;
+    float predicted = stripe_tuner_predict(&t, &full_screen, 1, lines, &stripes);
+    float fixed = stripe_tuner_predict(&t, &full_screen, 1, BUF_LINES, &fixed_stripes);
+    TEST_PRINTF("fixed %u lines x %u: predicted %u us; adaptive %u lines x %u: predicted %u us",
+                BUF_LINES, (unsigned)fixed_stripes, (unsigned)fixed, lines, (unsigned)stripes, (unsigned)predicted);
+    TEST_ASSERT_LESS_THAN_UINT16(BUF_LINES, lines);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT16(LV_PORT_STRIPE_MIN_LINES, lines);
+    TEST_ASSERT_LESS_THAN_FLOAT(fixed, predicted);
+    // 下界：所有块的传输时间之和
+    TEST_ASSERT_GREATER_OR_EQUAL_FLOAT(model.xfer_fixed_us * stripes + model.xfer_line_us * LV_VER_RES_MAX, predicted);
+}
+
+int main(void)
+{
+    ili9341_sim_init(LCD_SPI_HOST, LCD_SPI_CS, LCD_SPI_DC, LCD_SPI_RST);
+    lv_port_init();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_fixed_mode_reports_full_buffer_stripes);
+    RUN_TEST(test_adaptive_frames_are_complete);
+    RUN_TEST(test_render_bound_uses_full_buffer);
+    RUN_TEST(test_balanced_pipeline_uses_smaller_stripes);
+    return UNITY_END();
+}
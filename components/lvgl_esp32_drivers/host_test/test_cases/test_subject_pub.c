@@ -0,0 +1,186 @@
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "unity.h"
+#include "lvgl_port.h"
+#include "subject_pub.h"
+#include "spi_sim.h"
+#include "esp_timer.h"
+
+// 跨任务发布主题：多个生产者线程不加锁高频发布，观察者只在LVGL线程运行、每帧最多一次，最终值是最后发布的值
+
+#define PRODUCERS       4
+#define PUBLISHES       2000        // 每个生产者发布的次数
+#define PUBLISH_GAP_US  100         // 发布间隔，约5kHz，远高于刷新率
+
+static lv_subject_t own_subjects[PRODUCERS];    // 每个生产者独占的主题
+static subject_pub_t own_pubs[PRODUCERS];
+static lv_subject_t shared_subject;             // 所有生产者都发布的主题
+static subject_pub_t shared_pub;
+static lv_subject_t color_subject;
+static subject_pub_t color_pub;
+
+static uint32_t notify_count[PRODUCERS + 2];    // 按观察者的user_data计数，最后两个是共享主题和颜色主题
+static bool foreign_thread;                     // 观察者是否在LVGL线程以外运行过
+static pthread_t lvgl_thread;
+static uint32_t frames;                         // 刷新开始的次数
+static atomic_int producers_running;
+
+static void observer_cb(lv_observer_t *observer, lv_subject_t *subject)
+{
+    notify_count[(uintptr_t)lv_observer_get_user_data(observer)]++;
+    if (!pthread_equal(pthread_self(), lvgl_thread)) foreign_thread = true;
+}
+
+static void refr_start_cb(lv_event_t *e)
+{
+    frames++;
+}
+
+static void *producer(void *arg)
+{
+    uintptr_t id = (uintptr_t)arg;
+    for (int32_t i = 1; i <= PUBLISHES; i++) {
+        subject_pub_int(&own_pubs[id], i);
+        subject_pub_int(&shared_pub, (int32_t)(id * PUBLISHES + i));
+        if (id == 0) subject_pub_color(&color_pub, lv_color_hex(i % 2 ? 0xFF0000 : 0x0000FF));
+        usleep(PUBLISH_GAP_US);
+    }
+    atomic_fetch_sub(&producers_running, 1);
+    return NULL;
+}
+
+/**
+ * @brief 按lv_port_task的方式运行主循环，直到生产者结束且所有值都已应用
+ */
+static void run_until_applied(int timeout_ms)
+{
+    int64_t end = esp_timer_get_time() + timeout_ms * 1000LL;
+    while (esp_timer_get_time() < end) {
+        uint32_t next_ms = lv_port_handler();
+        if (atomic_load(&producers_running) == 0 && !subject_pub_pending()) break;
+        lv_port_sleep(next_ms < 10 ? next_ms : 10);
+    }
+}
+
+static void reset_counts(void)
+{
+    memset(notify_count, 0, sizeof(notify_count));
+    frames = 0;
+    foreign_thread = false;
+}
+
+void setUp(void)
+{
+    spi_sim_set_time_scale(0);
+    reset_counts();
+}
+
+void tearDown(void)
+{
+}
+
+void test_producers_coalesce_to_one_notify_per_frame(void)
+{
+    pthread_t threads[PRODUCERS];
+    atomic_store(&producers_running, PRODUCERS);
+    int64_t start = esp_timer_get_time();
+    for (uintptr_t i = 0; i < PRODUCERS; i++) {
+        pthread_create(&threads[i], NULL, producer, (void *)i);
+    }
+    run_until_applied(5000);
+    int64_t elapsed = esp_timer_get_time() - start;
+    for (int i = 0; i < PRODUCERS; i++) pthread_join(threads[i], NULL);
+
+    TEST_PRINTF("%d producers x %d publishes in %lld ms: %u frames, shared subject notified %u times",
+                PRODUCERS, PUBLISHES, (long long)elapsed / 1000, (unsigned)frames,
+                (unsigned)notify_count[PRODUCERS]);
+    TEST_ASSERT_FALSE(foreign_thread);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, frames);
+    for (int i = 0; i < PRODUCERS + 2; i++) {
+        TEST_ASSERT_GREATER_THAN_UINT32(0, notify_count[i]);
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(frames, notify_count[i]);
+    }
+
+    // 每个生产者最后发布的值都已应用
+    for (int i = 0; i < PRODUCERS; i++) {
+        TEST_ASSERT_EQUAL_INT32(PUBLISHES, lv_subject_get_int(&own_subjects[i]));
+    }
+    int32_t shared = lv_subject_get_int(&shared_subject);
+    TEST_ASSERT_EQUAL_INT32(0, shared % PUBLISHES);
+    TEST_ASSERT_TRUE(lv_color_eq(lv_color_hex(0x0000FF), lv_subject_get_color(&color_subject)));
+}
+
+void test_unchanged_value_does_not_notify(void)
+{
+    subject_pub_int(&own_pubs[0], lv_subject_get_int(&own_subjects[0]));
+    subject_pub_color(&color_pub, lv_subject_get_color(&color_subject));
+    TEST_ASSERT_TRUE(subject_pub_pending());
+    TEST_ASSERT_EQUAL_UINT32(0, subject_pub_apply());
+    TEST_ASSERT_FALSE(subject_pub_pending());
+
+    // 同一帧内先改后改回，也不通知
+    subject_pub_int(&own_pubs[1], 12345);
+    subject_pub_int(&own_pubs[1], lv_subject_get_int(&own_subjects[1]));
+    TEST_ASSERT_EQUAL_UINT32(0, subject_pub_apply());
+
+    TEST_ASSERT_EQUAL_UINT32(0, notify_count[0]);
+    TEST_ASSERT_EQUAL_UINT32(0, notify_count[1]);
+    TEST_ASSERT_EQUAL_UINT32(0, notify_count[PRODUCERS + 1]);
+}
+
+void test_pointer_subject(void)
+{
+    static const char first[] = "first";
+    static const char second[] = "second";
+    lv_subject_t subject;
+    subject_pub_t pub;
+    lv_subject_init_pointer(&subject, (void *)first);
+    lv_subject_add_observer(&subject, observer_cb, (void *)(uintptr_t)0);
+    subject_pub_init(&pub, &subject);
+    reset_counts();
+
+    subject_pub_pointer(&pub, (void *)second);
+    TEST_ASSERT_EQUAL_UINT32(1, subject_pub_apply());
+    TEST_ASSERT_EQUAL_PTR(second, lv_subject_get_pointer(&subject));
+    subject_pub_pointer(&pub, (void *)second);
+    TEST_ASSERT_EQUAL_UINT32(0, subject_pub_apply());
+    TEST_ASSERT_EQUAL_UINT32(1, notify_count[0]);
+
+    // 取消登记后未应用的值丢弃
+    subject_pub_pointer(&pub, (void *)first);
+    subject_pub_deinit(&pub);
+    TEST_ASSERT_EQUAL_UINT32(0, subject_pub_apply());
+    TEST_ASSERT_EQUAL_PTR(second, lv_subject_get_pointer(&subject));
+    lv_subject_deinit(&subject);
+}
+
+int main(void)
+{
+    lv_port_init();
+    lvgl_thread = pthread_self();
+
+    for (uintptr_t i = 0; i < PRODUCERS; i++) {
+        lv_subject_init_int(&own_subjects[i], 0);
+        lv_subject_add_observer(&own_subjects[i], observer_cb, (void *)i);
+        subject_pub_init(&own_pubs[i], &own_subjects[i]);
+    }
+    lv_subject_init_int(&shared_subject, 0);
+    lv_subject_add_observer(&shared_subject, observer_cb, (void *)(uintptr_t)PRODUCERS);
+    subject_pub_init(&shared_pub, &shared_subject);
+    lv_subject_init_color(&color_subject, lv_color_black());
+    lv_subject_add_observer(&color_subject, observer_cb, (void *)(uintptr_t)(PRODUCERS + 1));
+    subject_pub_init(&color_pub, &color_subject);
+
+    // 观察者绑定的标签：应用的值在同一帧内重绘
+    lv_obj_t *label = lv_label_create(lv_screen_active());
+    lv_label_bind_text(label, &shared_subject, "%d");
+    lv_display_add_event_cb(lv_display_get_default(), refr_start_cb, LV_EVENT_REFR_START, NULL);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_producers_coalesce_to_one_notify_per_frame);
+    RUN_TEST(test_unchanged_value_does_not_notify);
+    RUN_TEST(test_pointer_subject);
+    return UNITY_END();
+}
@@ -0,0 +1,240 @@
+#include <stdlib.h>
+#include <unistd.h>
+#include "unity.h"
+#include "lvgl_port.h"
+#include "spi_sim.h"
+#include "xpt2046_sim.h"
+#include "touch_traces.h"
+
+// 触摸滤波管线：用录制的噪声轨迹回放，检查稳定所需的点数、拖动滞后、跳变和轻压剔除、三点校准
+
+#define RAW_FOR(px, res, min, max)  ((uint16_t)(2 * ((min) + ((px) * ((max) - (min)) + (res) - 1) / (res))))
+#define ROWS(trace)                 (sizeof(trace) / sizeof((trace)[0]))
+#define MAX_POINTS                  64
+#define STABLE_PX                   2       // 与真实位置相差不超过该值视为稳定
+
+static lv_indev_t *indev;
+
+/**
+ * @brief 回放一段轨迹，收集松开前产生的全部按下点
+ * @return 点数
+ */
+static int play(const xpt2046_sim_sample_t *trace, size_t rows, lv_point_t *points)
+{
+    uint32_t conversions = xpt2046_sim_get_conversion_count();
+    int count = 0;
+
+    // 每行对应一组4个通道的转换，全部回放完再松开
+    xpt2046_sim_press(trace, rows);
+    for (int i = 0; i < 2000 && xpt2046_sim_get_conversion_count() - conversions < rows * 4; i++) {
+        usleep(1000);
+    }
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(rows * 4, xpt2046_sim_get_conversion_count() - conversions);
+    xpt2046_sim_release();
+
+    for (int i = 0; i < 1000; i++) {
+        if (xpt2046_pending() == 0) {
+            usleep(1000);
+            continue;
+        }
+        lv_indev_read(indev);
+        if (lv_indev_get_state(indev) == LV_INDEV_STATE_RELEASED) return count;
+        TEST_ASSERT_LESS_THAN_INT(MAX_POINTS, count);
+        lv_indev_get_point(indev, &points[count++]);
+    }
+    TEST_FAIL_MESSAGE("松开点未到达");
+    return count;
+}
+
+/**
+ * @brief 原先的读取方式作为对照：每个周期单次转换，线性映射后做4点滑动平均
+ * @param row 该周期转换到的轨迹行
+ * @param buf 滑动平均缓冲区（4个点）
+ * @param n 缓冲区中的有效点数
+ */
+static lv_point_t boxcar_reference(const xpt2046_sim_sample_t *row, lv_point_t *buf, int *n)
+{
+    int32_t x = ((row->x << 3) >> 4) - XPT2046_X_MIN;
+    int32_t y = ((row->y << 3) >> 4) - XPT2046_Y_MIN;
+    x = (x > 0 ? x : 0) * LV_HOR_RES_MAX / (XPT2046_X_MAX - XPT2046_X_MIN);
+    y = (y > 0 ? y : 0) * LV_VER_RES_MAX / (XPT2046_Y_MAX - XPT2046_Y_MIN);
+
+    for (int i = 3; i > 0; i--) buf[i] = buf[i - 1];
+    buf[0].x = x;
+    buf[0].y = y;
+    if (*n < 4) (*n)++;
+
+    lv_point_t avg = {0, 0};
+    for (int i = 0; i < *n; i++) {
+        avg.x += buf[i].x;
+        avg.y += buf[i].y;
+    }
+    avg.x /= *n;
+    avg.y /= *n;
+    return avg;
+}
+
+/**
+ * @brief 从第几个点起与目标的偏差始终不超过STABLE_PX
+ * @return 点的序号，始终不稳定时返回count
+ */
+static int samples_to_stable(const lv_point_t *points, int count, int32_t x, int32_t y)
+{
+    int stable_from = count;
+    for (int i = count - 1; i >= 0; i--) {
+        if (abs(points[i].x - x) > STABLE_PX || abs(points[i].y - y) > STABLE_PX) break;
+        stable_from = i;
+    }
+    return stable_from;
+}
+
+/**
+ * @brief 生成一段按压稳定、无噪声的轨迹
+ */
+static void fill_hold(xpt2046_sim_sample_t *rows, size_t count, int32_t px, int32_t py)
+{
+    for (size_t i = 0; i < count; i++) {
+        rows[i].x = RAW_FOR(px, LV_HOR_RES_MAX, XPT2046_X_MIN, XPT2046_X_MAX);
+        rows[i].y = RAW_FOR(py, LV_VER_RES_MAX, XPT2046_Y_MIN, XPT2046_Y_MAX);
+        rows[i].z1 = 600;
+        rows[i].z2 = 3000;
+    }
+}
+
+void setUp(void)
+{
+    spi_sim_set_time_scale(0);
+}
+
+void tearDown(void)
+{
+    xpt2046_set_calib(NULL);
+}
+
+void test_noisy_hold_is_stable_from_first_point(void)
+{
+    lv_point_t points[MAX_POINTS];
+    int count = play(trace_hold, ROWS(trace_hold), points);
+
+    // 轻压过渡全部剔除，每次突发产生一个点
+    TEST_ASSERT_EQUAL_INT(TRACE_HOLD_ROWS / XPT2046_OVERSAMPLE, count);
+    int stable = samples_to_stable(points, count, TRACE_HOLD_X, TRACE_HOLD_Y);
+
+    // 对照：每10ms单次转换一行，包括轻压阶段
+    lv_point_t buf[4], ref[MAX_POINTS];
+    int n = 0, ref_count = 0;
+    for (size_t r = 0; r < ROWS(trace_hold) && ref_count < MAX_POINTS; r += XPT2046_OVERSAMPLE) {
+        ref[ref_count++] = boxcar_reference(&trace_hold[r], buf, &n);
+    }
+    int ref_stable = samples_to_stable(ref, ref_count, TRACE_HOLD_X, TRACE_HOLD_Y);
+
+    TEST_PRINTF("hold: pipeline stable from point %d of %d, boxcar stable from point %d of %d",
+                stable, count, ref_stable, ref_count);
+    TEST_ASSERT_EQUAL_INT(0, stable);
+}
+
+void test_noisy_swipe_follows_with_small_lag(void)
+{
+    lv_point_t points[MAX_POINTS];
+    int count = play(trace_swipe, ROWS(trace_swipe), points);
+    TEST_ASSERT_EQUAL_INT(TRACE_SWIPE_ROWS / XPT2046_OVERSAMPLE, count);
+
+    int32_t max_lag = 0, ref_max_lag = 0;
+    lv_point_t buf[4];
+    int n = 0;
+    for (int k = 0; k < count; k++) {
+        // 第k个点来自第k次突发，中值对应该次突发中间一行的位置
+        int row = k * XPT2046_OVERSAMPLE + XPT2046_OVERSAMPLE / 2;
+        int32_t truth = TRACE_SWIPE_X0 + (TRACE_SWIPE_X1 - TRACE_SWIPE_X0) * row / (TRACE_SWIPE_ROWS - 1);
+        int32_t lag = abs(points[k].x - truth);
+        if (lag > max_lag) max_lag = lag;
+        TEST_ASSERT_INT_WITHIN(STABLE_PX, TRACE_SWIPE_Y, points[k].y);
+        if (k > 0) TEST_ASSERT_GREATER_OR_EQUAL_INT32(points[k - 1].x, points[k].x);
+
+        lv_point_t ref = boxcar_reference(&trace_swipe[TRACE_EDGE_ROWS + k * XPT2046_OVERSAMPLE], buf, &n);
+        if (abs(ref.x - truth) > ref_max_lag) ref_max_lag = abs(ref.x - truth);
+    }
+
+    TEST_PRINTF("swipe: pipeline max lag %d px, boxcar max lag %d px", (int)max_lag, (int)ref_max_lag);
+    TEST_ASSERT_LESS_OR_EQUAL_INT32(4, max_lag);
+}
+
+void test_isolated_jump_is_rejected(void)
+{
+    xpt2046_sim_sample_t rows[13 * XPT2046_OVERSAMPLE];
+    fill_hold(rows, 6 * XPT2046_OVERSAMPLE, 100, 100);
+    fill_hold(&rows[6 * XPT2046_OVERSAMPLE], XPT2046_OVERSAMPLE, 300, 200);      // 一整次突发都跳开
+    fill_hold(&rows[7 * XPT2046_OVERSAMPLE], 6 * XPT2046_OVERSAMPLE, 100, 100);
+
+    lv_point_t points[MAX_POINTS];
+    int count = play(rows, ROWS(rows), points);
+
+    TEST_ASSERT_GREATER_OR_EQUAL_INT(12, count);
+    for (int i = 0; i < count; i++) {
+        TEST_ASSERT_INT_WITHIN(1, 100, points[i].x);
+        TEST_ASSERT_INT_WITHIN(1, 100, points[i].y);
+    }
+}
+
+void test_sustained_jump_is_followed_after_one_sample(void)
+{
+    xpt2046_sim_sample_t rows[10 * XPT2046_OVERSAMPLE];
+    fill_hold(rows, 4 * XPT2046_OVERSAMPLE, 100, 100);
+    fill_hold(&rows[4 * XPT2046_OVERSAMPLE], 6 * XPT2046_OVERSAMPLE, 250, 100);
+
+    lv_point_t points[MAX_POINTS];
+    int count = play(rows, ROWS(rows), points);
+
+    // 第一次跳开的突发待确认，第二次起直接到位，没有IIR的建立过程
+    TEST_ASSERT_GREATER_OR_EQUAL_INT(9, count);
+    TEST_ASSERT_INT_WITHIN(1, 100, points[3].x);
+    TEST_ASSERT_INT_WITHIN(1, 250, points[4].x);
+    TEST_ASSERT_INT_WITHIN(1, 250, points[count - 1].x);
+}
+
+void test_three_point_calibration_maps_swapped_axes(void)
+{
+    // 面板XY与屏幕交换：原始x对应屏幕y，原始y对应屏幕x
+    const lv_point_t raw[3] = {{400, 300}, {1600, 300}, {400, 1500}};
+    const lv_point_t screen[3] = {{20, 20}, {20, 220}, {300, 20}};
+    xpt2046_calib_t calib;
+    TEST_ASSERT_TRUE(xpt2046_calib_compute(raw, screen, &calib));
+    xpt2046_set_calib(&calib);
+
+    // 原始(1000, 900)位于三点中间
+    xpt2046_sim_sample_t rows[2 * XPT2046_OVERSAMPLE];
+    for (size_t i = 0; i < ROWS(rows); i++) {
+        rows[i] = (xpt2046_sim_sample_t){.x = 2 * 1000, .y = 2 * 900, .z1 = 600, .z2 = 3000};
+    }
+    lv_point_t points[MAX_POINTS];
+    int count = play(rows, ROWS(rows), points);
+
+    TEST_ASSERT_GREATER_OR_EQUAL_INT(1, count);
+    TEST_ASSERT_INT_WITHIN(1, 160, points[0].x);
+    TEST_ASSERT_INT_WITHIN(1, 120, points[0].y);
+}
+
+void test_collinear_calibration_points_are_rejected(void)
+{
+    const lv_point_t raw[3] = {{100, 100}, {200, 200}, {300, 300}};
+    const lv_point_t screen[3] = {{0, 0}, {100, 100}, {200, 200}};
+    xpt2046_calib_t calib;
+
+    TEST_ASSERT_FALSE(xpt2046_calib_compute(raw, screen, &calib));
+}
+
+int main(void)
+{
+    lv_port_init();
+    xpt2046_sim_init(TP_SPI_CS, TP_SPI_IRQ);
+    indev = lv_indev_get_next(NULL);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_noisy_hold_is_stable_from_first_point);
+    RUN_TEST(test_noisy_swipe_follows_with_small_lag);
+    RUN_TEST(test_isolated_jump_is_rejected);
+    RUN_TEST(test_sustained_jump_is_followed_after_one_sample);
+    RUN_TEST(test_three_point_calibration_maps_swapped_axes);
+    RUN_TEST(test_collinear_calibration_points_are_rejected);
+    return UNITY_END();
+}
@@ -0,0 +1,142 @@
+#include <unistd.h>
+#include "unity.h"
+#include "lvgl_port.h"
+#include "spi_sim.h"
+#include "xpt2046_sim.h"
+#include "esp_timer.h"
+
+// 触摸延迟：PENIRQ下降沿到采样、到LVGL事件的时间，以及界面阻塞时采样不中断
+
+#define RAW_FOR(px, res, min, max)  ((uint16_t)(2 * ((min) + ((px) * ((max) - (min)) + (res) - 1) / (res))))
+#define PERIOD_US                   (XPT2046_SAMPLE_PERIOD_MS * 1000)
+
+static lv_indev_t *indev;
+static int64_t pressed_event_us;        // 收到LV_EVENT_PRESSED的时刻
+static int64_t pressed_sample_us;       // 触发LV_EVENT_PRESSED的采样点时刻
+static int64_t released_event_us;       // 收到LV_EVENT_RELEASED的时刻
+
+static void screen_event_cb(lv_event_t *e)
+{
+    switch (lv_event_get_code(e)) {
+    case LV_EVENT_PRESSED:
+        pressed_event_us = esp_timer_get_time();
+        pressed_sample_us = xpt2046_get_last_timestamp();
+        break;
+    case LV_EVENT_RELEASED:
+        released_event_us = esp_timer_get_time();
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief 按lv_port_task的方式运行LVGL主循环（本线程即LVGL任务），直到*done非0或超时
+ * @param done 结束条件，NULL表示运行满timeout_ms
+ */
+static void run_ui_until(const int64_t *done, int timeout_ms)
+{
+    int64_t end = esp_timer_get_time() + timeout_ms * 1000LL;
+    int64_t now;
+    while ((done == NULL || *done == 0) && (now = esp_timer_get_time()) < end) {
+        uint32_t next_ms = lv_port_handler();
+        uint32_t left_ms = (uint32_t)((end - now + 999) / 1000);
+        lv_port_sleep(next_ms < left_ms ? next_ms : left_ms);
+    }
+}
+
+static void press_center(void)
+{
+    const xpt2046_sim_sample_t sample = {
+        .x = RAW_FOR(160, LV_HOR_RES_MAX, XPT2046_X_MIN, XPT2046_X_MAX),
+        .y = RAW_FOR(120, LV_VER_RES_MAX, XPT2046_Y_MIN, XPT2046_Y_MAX),
+        .z1 = 600,
+        .z2 = 3000,
+    };
+    xpt2046_sim_press(&sample, 1);
+}
+
+void setUp(void)
+{
+    spi_sim_set_time_scale(100);
+    pressed_event_us = 0;
+    pressed_sample_us = 0;
+    released_event_us = 0;
+}
+
+void tearDown(void)
+{
+    xpt2046_sim_release();
+    run_ui_until(&released_event_us, 200);
+    run_ui_until(NULL, 3 * XPT2046_SAMPLE_PERIOD_MS);     // 排空剩余采样点
+    TEST_ASSERT_EQUAL_UINT32(0, xpt2046_pending());
+}
+
+void test_press_and_release_latency(void)
+{
+    int64_t t0 = esp_timer_get_time();
+    press_center();
+    run_ui_until(&pressed_event_us, 200);
+    TEST_ASSERT_NOT_EQUAL_INT64(0, pressed_event_us);
+
+    int64_t sample_latency = pressed_sample_us - t0;
+    int64_t press_latency = pressed_event_us - t0;
+
+    run_ui_until(&released_event_us, 20);                   // 按住一段时间
+    TEST_ASSERT_EQUAL_INT64(0, released_event_us);
+
+    int64_t t1 = esp_timer_get_time();
+    xpt2046_sim_release();
+    run_ui_until(&released_event_us, 200);
+    TEST_ASSERT_NOT_EQUAL_INT64(0, released_event_us);
+    int64_t release_latency = released_event_us - t1;
+
+    TEST_PRINTF("irq->sample %lld us, irq->PRESSED %lld us, release->RELEASED %lld us",
+                (long long)sample_latency, (long long)press_latency, (long long)release_latency);
+
+    // 下降沿立即唤醒采样任务，采样点写入后立即唤醒LVGL任务
+    TEST_ASSERT_LESS_THAN_INT64(PERIOD_US / 2, sample_latency);
+    TEST_ASSERT_LESS_THAN_INT64(PERIOD_US / 2, press_latency);
+    // 松开由下一次周期采样检测
+    TEST_ASSERT_LESS_THAN_INT64(PERIOD_US + PERIOD_US / 2, release_latency);
+}
+
+void test_sampling_continues_while_ui_blocked(void)
+{
+    const int blocked_ms = 100;
+
+    press_center();
+    usleep(blocked_ms * 1000);                              // 模拟一次耗时的界面刷新
+
+    uint32_t pending = xpt2046_pending();
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(blocked_ms / XPT2046_SAMPLE_PERIOD_MS - 1, pending);
+
+    // 逐点取出，检查采样间隔没有因LVGL线程阻塞而变大
+    int64_t prev = 0, max_gap = 0;
+    for (uint32_t i = 0; i < pending; i++) {
+        lv_indev_read(indev);
+        int64_t ts = xpt2046_get_last_timestamp();
+        if (prev != 0 && ts - prev > max_gap) max_gap = ts - prev;
+        prev = ts;
+    }
+
+    TEST_PRINTF("%lu points buffered during %d ms block, max sample gap %lld us",
+                (unsigned long)pending, blocked_ms, (long long)max_gap);
+    TEST_ASSERT_EQUAL(LV_INDEV_STATE_PRESSED, lv_indev_get_state(indev));
+    TEST_ASSERT_LESS_THAN_INT64(2 * PERIOD_US, max_gap);
+}
+
+int main(void)
+{
+    lv_port_init();
+    xpt2046_sim_init(TP_SPI_CS, TP_SPI_IRQ);
+    indev = lv_indev_get_next(NULL);
+    lv_obj_add_event_cb(lv_screen_active(), screen_event_cb, LV_EVENT_ALL, NULL);
+    lv_refr_now(NULL);
+    run_ui_until(NULL, 50);     // 处理完初始化后的定时器
+
+    UNITY_BEGIN();
+    RUN_TEST(test_press_and_release_latency);
+    RUN_TEST(test_sampling_continues_while_ui_blocked);
+    return UNITY_END();
+}
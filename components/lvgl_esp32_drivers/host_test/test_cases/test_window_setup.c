@@ -0,0 +1,113 @@
+#include <stdatomic.h>
+#include "unity.h"
+#include "lvgl_port.h"
+#include "spi_sim.h"
+#include "ili9341_sim.h"
+#include "esp_timer.h"
+
+// 窗口设置：CASET/PASET/RAMWR随颜色数据一起排队，在上一块DMA之后流水发送
+
+#define STRIPES     (LV_VER_RES_MAX / (DISP_BUF_SIZE / LV_HOR_RES_MAX))
+
+static atomic_int flush_started;          // flush_cb被调用次数
+static atomic_int colors_done;            // 已传完的颜色事务数
+static atomic_int polling_count;          // 轮询方式发送的事务数
+static atomic_int pipelined_count;        // 某块颜色传完时下一块已开始排队的次数
+static int64_t color_start_us[STRIPES];  // 每块第一段颜色数据开始传输的时刻
+static int64_t color_end_us[STRIPES];    // 每块最后一段颜色数据传完的时刻
+static int64_t first_chunk_us;           // 当前块第一段颜色数据的开始时刻，0表示尚未开始
+
+static void bus_monitor(spi_host_device_t host, const spi_transaction_t *trans,
+                        int64_t start_us, int64_t end_us, void *user_ctx)
+{
+    disp_spi_send_flag_t flags = (disp_spi_send_flag_t)(uintptr_t)trans->user;
+
+    if (flags & DISP_SPI_SEND_POLLING) atomic_fetch_add(&polling_count, 1);
+    // 颜色数据分段发送，参数事务不超过4字节
+    if ((flags & DISP_SPI_DC_DATA) && trans->length > 32 && first_chunk_us == 0) first_chunk_us = start_us;
+    if (!(flags & DISP_SPI_SIGNAL_FLUSH)) return;
+
+    int i = atomic_fetch_add(&colors_done, 1);
+    if (i < STRIPES) {
+        color_start_us[i] = first_chunk_us;
+        color_end_us[i] = end_us;
+    }
+    first_chunk_us = 0;
+    if (atomic_load(&flush_started) > i + 1) atomic_fetch_add(&pipelined_count, 1);
+}
+
+static void display_event_cb(lv_event_t *e)
+{
+    if (lv_event_get_code(e) == LV_EVENT_FLUSH_START) atomic_fetch_add(&flush_started, 1);
+}
+
+void setUp(void)
+{
+    disp_wait_for_pending_transactions();
+    spi_sim_set_time_scale(100);
+    atomic_store(&flush_started, 0);
+    atomic_store(&colors_done, 0);
+    atomic_store(&polling_count, 0);
+    atomic_store(&pipelined_count, 0);
+    first_chunk_us = 0;
+}
+
+void tearDown(void)
+{
+}
+
+void test_window_setup_is_queued_behind_pixels(void)
+{
+    lv_obj_invalidate(lv_screen_active());
+    ili9341_sim_frame_begin();
+    lv_refr_now(NULL);
+    disp_wait_for_pending_transactions();
+
+    ili9341_sim_frame_t frame;
+    ili9341_sim_frame_end(&frame);
+
+    TEST_ASSERT_EQUAL_INT(STRIPES, atomic_load(&colors_done));
+    TEST_ASSERT_EQUAL_UINT32(STRIPES, frame.window_count);
+    TEST_ASSERT_EQUAL_UINT64(LV_HOR_RES_MAX * LV_VER_RES_MAX, frame.pixels_written);
+    TEST_ASSERT_EQUAL_INT(0, atomic_load(&polling_count));
+    TEST_ASSERT_EQUAL_INT(STRIPES - 1, atomic_load(&pipelined_count));
+}
+
+void test_setup_latency_per_stripe(void)
+{
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+    disp_wait_for_pending_transactions();
+    TEST_ASSERT_EQUAL_INT(STRIPES, atomic_load(&colors_done));
+
+    // 相邻两块颜色数据之间的总线空闲时间，即每块窗口设置的实际代价
+    int64_t total_gap = 0, max_gap = 0;
+    for (int i = 1; i < STRIPES; i++) {
+        int64_t gap = color_start_us[i] - color_end_us[i - 1];
+        total_gap += gap;
+        if (gap > max_gap) max_gap = gap;
+    }
+    int64_t avg_gap = total_gap / (STRIPES - 1);
+    int64_t stripe_wire_us = (int64_t)DISP_BUF_SIZE * 2 * 8 / 40;
+
+    TEST_PRINTF("setup gap per stripe: avg %lld us, max %lld us (stripe wire %lld us), %d polling",
+                (long long)avg_gap, (long long)max_gap, (long long)stripe_wire_us,
+                atomic_load(&polling_count));
+    TEST_ASSERT_LESS_THAN_INT64(stripe_wire_us / 100, avg_gap);
+}
+
+int main(void)
+{
+    ili9341_sim_init(LCD_SPI_HOST, LCD_SPI_CS, LCD_SPI_DC, LCD_SPI_RST);
+    lv_port_init();
+    // 面板配置推迟到第一帧，先渲染一帧，用例中只有窗口设置和颜色数据
+    lv_refr_now(NULL);
+    disp_wait_for_pending_transactions();
+    lv_display_add_event_cb(lv_display_get_default(), display_event_cb, LV_EVENT_FLUSH_START, NULL);
+    spi_sim_set_monitor(LCD_SPI_HOST, bus_monitor, NULL);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_window_setup_is_queued_behind_pixels);
+    RUN_TEST(test_setup_latency_per_stripe);
+    return UNITY_END();
+}
@@ -0,0 +1,156 @@
+#include <unistd.h>
+#include "unity.h"
+#include "lvgl_port.h"
+#include "spi_sim.h"
+#include "xpt2046_sim.h"
+
+// 触摸模型：脚本采样经xpt2046采样任务和校正后到达LVGL输入设备
+
+// 原始12位采样：驱动先右移4位（即12位值的一半），再按X/Y_MIN~MAX线性映射到分辨率
+#define RAW_FOR(px, res, min, max)  ((uint16_t)(2 * ((min) + ((px) * ((max) - (min)) + (res) - 1) / (res))))
+
+static lv_indev_t *indev;
+
+static lv_indev_state_t read_touch(lv_point_t *point)
+{
+    lv_indev_read(indev);
+    lv_indev_get_point(indev, point);
+    return lv_indev_get_state(indev);
+}
+
+/**
+ * @brief 等待采样任务写入至少count个点，超时则测试失败
+ */
+static void wait_pending(uint32_t count)
+{
+    for (int i = 0; i < 1000 && xpt2046_pending() < count; i++) usleep(1000);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(count, xpt2046_pending());
+}
+
+/**
+ * @brief 逐点读取直到读到松开点，超时则测试失败
+ * @param point 输出松开时的坐标
+ * @param last_pressed_x 输出松开前最后一个按下点的X坐标，可为NULL
+ */
+static void read_until_released(lv_point_t *point, int32_t *last_pressed_x)
+{
+    for (int i = 0; i < 1000; i++) {
+        if (xpt2046_pending() == 0) {
+            usleep(1000);
+            continue;
+        }
+        if (read_touch(point) == LV_INDEV_STATE_RELEASED) return;
+        if (last_pressed_x) *last_pressed_x = point->x;
+    }
+    TEST_FAIL_MESSAGE("松开点未到达");
+}
+
+void setUp(void)
+{
+    spi_sim_set_time_scale(0);
+}
+
+void tearDown(void)
+{
+    lv_point_t point;
+    if (lv_indev_get_state(indev) == LV_INDEV_STATE_PRESSED || xpt2046_pending() > 0) {
+        xpt2046_sim_release();
+        read_until_released(&point, NULL);
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, xpt2046_pending());
+}
+
+void test_released_without_touch(void)
+{
+    lv_point_t point;
+    uint32_t conversions = xpt2046_sim_get_conversion_count();
+
+    usleep(3 * XPT2046_SAMPLE_PERIOD_MS * 1000);
+    TEST_ASSERT_EQUAL_UINT32(0, xpt2046_pending());
+    TEST_ASSERT_EQUAL(LV_INDEV_STATE_RELEASED, read_touch(&point));
+    TEST_ASSERT_EQUAL_UINT32(conversions, xpt2046_sim_get_conversion_count());
+}
+
+void test_scripted_press_maps_to_screen(void)
+{
+    const xpt2046_sim_sample_t sample = {
+        .x = RAW_FOR(160, LV_HOR_RES_MAX, XPT2046_X_MIN, XPT2046_X_MAX),
+        .y = RAW_FOR(120, LV_VER_RES_MAX, XPT2046_Y_MIN, XPT2046_Y_MAX),
+        .z1 = 600,
+        .z2 = 3000,
+    };
+    xpt2046_sim_press(&sample, 1);
+    wait_pending(1);
+
+    lv_point_t point;
+    TEST_ASSERT_EQUAL(LV_INDEV_STATE_PRESSED, read_touch(&point));
+    TEST_ASSERT_INT_WITHIN(1, 160, point.x);
+    TEST_ASSERT_INT_WITHIN(1, 120, point.y);
+}
+
+void test_script_replays_in_order(void)
+{
+    // 每次突发读取消耗XPT2046_OVERSAMPLE个脚本采样，每个位置重复相同次数即对应一个采样点
+    xpt2046_sim_sample_t samples[3 * XPT2046_OVERSAMPLE];
+    for (int i = 0; i < 3 * XPT2046_OVERSAMPLE; i++) {
+        samples[i].x = RAW_FOR(40 + 20 * (i / XPT2046_OVERSAMPLE), LV_HOR_RES_MAX, XPT2046_X_MIN, XPT2046_X_MAX);
+        samples[i].y = RAW_FOR(200, LV_VER_RES_MAX, XPT2046_Y_MIN, XPT2046_Y_MAX);
+        samples[i].z1 = 600;
+        samples[i].z2 = 3000;
+    }
+    xpt2046_sim_press(samples, 3 * XPT2046_OVERSAMPLE);
+    wait_pending(3);
+
+    lv_point_t point;
+    int32_t last_x = -1;
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL(LV_INDEV_STATE_PRESSED, read_touch(&point));
+        TEST_ASSERT_GREATER_THAN_INT32(last_x, point.x);   // 滤波后单调右移
+        last_x = point.x;
+    }
+
+    // 脚本末尾保持最后一个采样，松开前可能还有更多按下点
+    xpt2046_sim_release();
+    read_until_released(&point, &last_x);
+    TEST_ASSERT_EQUAL_INT32(last_x, point.x);                // 松开时保持最后位置
+}
+
+void test_burst_converts_all_channels_in_one_transaction(void)
+{
+    const xpt2046_sim_sample_t sample = {
+        .x = RAW_FOR(100, LV_HOR_RES_MAX, XPT2046_X_MIN, XPT2046_X_MAX),
+        .y = RAW_FOR(100, LV_VER_RES_MAX, XPT2046_Y_MIN, XPT2046_Y_MAX),
+        .z1 = 600,
+        .z2 = 3000,
+    };
+    spi_sim_stats_t before, after;
+
+    spi_sim_get_stats(TP_SPI_HOST, &before);
+    uint32_t conversions = xpt2046_sim_get_conversion_count();
+    lv_point_t point;
+    xpt2046_sim_press(&sample, 1);
+    wait_pending(3);
+    xpt2046_sim_release();
+    read_until_released(&point, NULL);      // 采样任务回到空闲后再统计
+    spi_sim_get_stats(TP_SPI_HOST, &after);
+
+    uint32_t trans = after.trans_count - before.trans_count;
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(3, trans);
+    TEST_ASSERT_EQUAL_UINT32(trans * 4 * XPT2046_OVERSAMPLE, xpt2046_sim_get_conversion_count() - conversions);
+    // 每次转换15个时钟（重叠流水），另加末尾1字节
+    TEST_ASSERT_EQUAL_UINT64((uint64_t)trans * (4 * XPT2046_OVERSAMPLE * 2 + 1), after.tx_bytes - before.tx_bytes);
+}
+
+int main(void)
+{
+    lv_port_init();
+    xpt2046_sim_init(TP_SPI_CS, TP_SPI_IRQ);
+    indev = lv_indev_get_next(NULL);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_released_without_touch);
+    RUN_TEST(test_scripted_press_maps_to_screen);
+    RUN_TEST(test_script_replays_in_order);
+    RUN_TEST(test_burst_converts_all_channels_in_one_transaction);
+    return UNITY_END();
+}
@@ -0,0 +1,85 @@
+#ifndef __TOUCH_TRACES_H
+#define __TOUCH_TRACES_H
+
+#include "xpt2046_sim.h"
+
+// 录制的噪声触摸轨迹：每行一组X/Y/Z1/Z2的12位转换值，按转换顺序回放
+// 坐标噪声约12 LSB，约5%的单次转换带有300~600 LSB的毛刺；
+// 按下和抬起时的轻压阶段（Z1小、Z2大）位置向一侧漂移
+
+#define TRACE_EDGE_ROWS     15      // 轨迹首尾的轻压过渡行数
+
+#define TRACE_HOLD_X        160
+#define TRACE_HOLD_Y        120
+#define TRACE_HOLD_ROWS     100     // 中间稳定按压的行数
+
+#define TRACE_SWIPE_X0      40
+#define TRACE_SWIPE_X1      280
+#define TRACE_SWIPE_Y       200
+#define TRACE_SWIPE_ROWS    120     // 中间匀速移动的行数
+
+// 按住(160, 120)：前后各15组轻压过渡（位置漂移），中间100组
+static const xpt2046_sim_sample_t trace_hold[] = {
+    {2340, 2238,  115, 3913}, {2349, 2249,  138, 3872}, {2334, 2216,  200, 3916}, {2327, 1606,  175, 3864}, {2261, 2191,  107, 3913},
+    {2257, 2177,  180, 3876}, {2237, 2157,  126, 3927}, {2225, 2151,  171, 3929}, {2212, 2133,  163, 3859}, {2198, 2094,  110, 3901},
+    {2198, 2089,  103, 3852}, {2154, 2060,  194, 3875}, {2157, 2045,  183, 3903}, {2130, 2039,  171, 3876}, {2127, 2016,  145, 3918},
+    {2100, 2020,  595, 3009}, {2100, 2015,  605, 3004}, {2087, 2021,  576, 3027}, {2113, 2045,  603, 3017}, {2117, 2005,  588, 3018},
+    {2101, 2045,  566, 3006}, {2091, 2018,  623, 2980}, {2084, 1538,  580, 3024}, {2093, 2013,  581, 3016}, {2116, 2036,  599, 2994},
+    {2095, 2022,  591, 2979}, {2097, 2004,  576, 2998}, {2112, 2022,  591, 2985}, {2107, 2018,  573, 2985}, {2103, 2004,  607, 3050},
+    {2105, 1995,  616, 2998}, {2090, 2007,  580, 2985}, {2108, 2015,  619, 3001}, {2092, 2016,  600, 2986}, {2101, 2035,  563, 2990},
+    {2099, 2023,  596, 2996}, {2110, 2037,  611, 3002}, {2095, 2010,  573, 3037}, {2109, 1521,  609, 3000}, {2094, 2025,  576, 3012},
+    {2089, 2036,  590, 2989}, {2081, 2029,  595, 3020}, {2099, 2031,  591, 3008}, {2100, 2014,  571, 2991}, {2077, 2033,  583, 2983},
+    {2096, 2035,  620, 3011}, {2122, 2017,  603, 2971}, {2098, 1563,  599, 2994}, {2127, 2010,  616, 3025}, {2102, 2022,  613, 2995},
+    {2091, 2046,  612, 2967}, {2108, 2026,  587, 2974}, {2112, 2033,  603, 2972}, {2102, 2023,  601, 3019}, {2108, 2324,  595, 3016},
+    {2100, 2017,  585, 3032}, {2081, 2034,  600, 2998}, {2102, 2038,  583, 3005}, {2093, 2007,  589, 3022}, {2107, 2040,  590, 3000},
+    {2091, 2018,  601, 3009}, {2094, 2017,  591, 3014}, {2104, 2021,  602, 2975}, {2117, 2012,  580, 3020}, {2133, 2005,  604, 2974},
+    {2094, 2018,  601, 3030}, {2104, 2031,  612, 3005}, {2093, 2018,  616, 2971}, {1645, 2024,  607, 3010}, {2115, 2044,  594, 2976},
+    {2103, 2027,  625, 3018}, {2090, 2014,  594, 2983}, {2099, 2009,  590, 2970}, {2097, 2361,  543, 3009}, {2115, 2021,  610, 3001},
+    {2087, 2009,  602, 2966}, {2103, 1998,  615, 3004}, {2096, 2007,  612, 3001}, {2088, 2013,  587, 3038}, {2095, 2034,  593, 2978},
+    {2075, 2010,  588, 3011}, {2560, 2019,  572, 2983}, {2091, 2027,  627, 3000}, {2117, 2010,  610, 3001}, {2101, 2011,  599, 2979},
+    {2086, 2001,  605, 2991}, {2101, 2036,  592, 3006}, {2115, 2004,  588, 3023}, {2096, 2017,  591, 3018}, {2110, 2336,  594, 3024},
+    {2089, 2015,  594, 3007}, {2095, 2013,  608, 3025}, {2100, 2032,  609, 3001}, {2095, 2025,  584, 2981}, {2069, 2017,  613, 2989},
+    {2109, 2001,  608, 2985}, {2115, 2024,  575, 3009}, {2097, 2015,  596, 3001}, {2118, 2032,  606, 2984}, {2444, 2017,  569, 3003},
+    {2100, 2585,  600, 2977}, {2093, 2030,  579, 3014}, {2085, 2021,  588, 3009}, {2097, 2032,  609, 2984}, {2093, 2030,  602, 3016},
+    {2494, 2008,  596, 3006}, {2094, 2019,  602, 3008}, {2105, 1989,  633, 2987}, {2115, 2038,  602, 2971}, {2134, 2001,  620, 2999},
+    {2094, 2025,  603, 2998}, {2092, 2007,  597, 2984}, {2102, 2026,  608, 3034}, {2087, 2003,  608, 3021}, {2091, 2025,  619, 3013},
+    {2103, 2007,  165, 3949}, {2133, 2053,  145, 3950}, {2158, 2101,  120, 3851}, {2201, 2115,  183, 3881}, {2225, 2134,  193, 3878},
+    {2272, 2168,  192, 3927}, {2308, 2172,  110, 3896}, {2327, 2230,  169, 3936}, {2874, 2248,  153, 3917}, {2386, 2289,  162, 3935},
+    {2749, 2324,  175, 3923}, {2464, 2349,  176, 3855}, {2471, 2362,  162, 3868}, {2515, 2400,  114, 3904}, {2557, 2430,  120, 3912},
+};
+
+// 从(40, 200)水平滑到(280, 200)：前后各15组轻压过渡，中间120组匀速移动
+static const xpt2046_sim_sample_t trace_swipe[] = {
+    { 670, 3220,  196, 3890}, {1089, 3198,  192, 3936}, { 708, 3210,  196, 3911}, { 677, 3203,  103, 3867}, { 722, 3218,  171, 3879},
+    { 706, 3218,  199, 3881}, { 734, 3205,  154, 3927}, { 748, 3216,  116, 3950}, { 755, 3215,  146, 3929}, { 741, 3215,  101, 3907},
+    { 771, 3180,  153, 3891}, { 759, 3653,  160, 3870}, { 801, 3196,  171, 3863}, { 793, 3222,  147, 3918}, {1277, 3210,  169, 3939},
+    { 822, 3191,  579, 3031}, { 864, 3188,  599, 3031}, { 875, 3221,  603, 2989}, { 880, 2775,  593, 3012}, { 902, 3212,  606, 2995},
+    { 923, 3207,  571, 2979}, { 956, 3213,  607, 2972}, { 983, 3229,  612, 3006}, { 995, 3224,  601, 2999}, {1038, 3208,  573, 2998},
+    {1035, 3218,  607, 3007}, {1363, 3203,  578, 2994}, {1088, 3208,  611, 2993}, {1104, 3211,  615, 3016}, {1128, 3216,  572, 2968},
+    {1153, 3704,  619, 2971}, {1147, 3186,  601, 3009}, {1183, 3201,  630, 3002}, {1208, 3225,  579, 3015}, {1224, 3205,  592, 2967},
+    {1269, 3193,  606, 3000}, {1261, 3226,  597, 2984}, {1260, 3207,  618, 3012}, {1310, 3218,  616, 3003}, {1342, 3207,  587, 2987},
+    {1348, 3188,  576, 3029}, {1362, 3205,  604, 2985}, {1413, 3210,  617, 2999}, {1434, 3198,  605, 3018}, {1467, 3214,  578, 3010},
+    {1470, 3202,  606, 2966}, {1504, 3207,  602, 3036}, {1527, 3212,  601, 3036}, {1524, 3211,  577, 2998}, {1567, 3227,  554, 2988},
+    {1578, 3216,  586, 3005}, {1599, 3220,  584, 2985}, {1622, 3208,  610, 2992}, {1624, 3213,  575, 2998}, {1661, 3208,  603, 3020},
+    {1668, 3214,  600, 2987}, {1709, 2862,  604, 3011}, {1737, 3205,  586, 3008}, {1744, 3195,  610, 2963}, {1760, 3208,  609, 2993},
+    {2156, 3219,  627, 2999}, {1825, 3208,  580, 2961}, {1837, 3204,  589, 3011}, {1855, 3211,  614, 3008}, {1883, 3222,  594, 2998},
+    {1924, 3199,  586, 2997}, {1919, 3217,  616, 3000}, {1940, 3214,  603, 2976}, {1979, 3192,  600, 3004}, {1975, 3205,  602, 2967},
+    {1985, 3205,  604, 2977}, {2023, 3224,  590, 2983}, {2055, 3211,  595, 2977}, {2045, 3225,  628, 3013}, {2072, 3223,  608, 3009},
+    {2118, 3198,  611, 3006}, {1701, 3193,  611, 3024}, {2164, 3193,  596, 2970}, {2180, 3221,  588, 3008}, {2246, 3203,  593, 3002},
+    {2229, 3199,  574, 2981}, {2234, 3219,  593, 2993}, {2272, 3211,  599, 3001}, {2288, 3218,  595, 3000}, {2303, 3193,  574, 2976},
+    {2336, 3210,  576, 3009}, {2353, 3215,  596, 2996}, {2362, 3214,  602, 3006}, {2367, 3189,  589, 3002}, {2390, 3227,  602, 3009},
+    {2465, 3205,  602, 3030}, {2462, 3207,  613, 3002}, {2487, 3194,  584, 2993}, {2504, 3195,  587, 2991}, {2523, 3199,  589, 3002},
+    {2540, 3196,  590, 2992}, {2584, 3194,  628, 3012}, {2590, 3202,  577, 3002}, {2593, 3211,  584, 3014}, {2617, 3211,  585, 3006},
+    {2650, 3193,  573, 2988}, {2652, 3221,  590, 2985}, {2685, 3194,  630, 3008}, {2733, 3203,  617, 3031}, {2735, 3207,  612, 3024},
+    {2749, 3187,  597, 2990}, {2774, 3195,  597, 3023}, {2790, 3201,  605, 2999}, {2820, 3197,  596, 3016}, {2847, 3203,  596, 3002},
+    {2877, 3205,  624, 2998}, {2882, 3193,  610, 2989}, {2900, 3214,  598, 2979}, {2929, 3227,  601, 2973}, {2953, 3658,  603, 3007},
+    {2971, 3197,  594, 2997}, {2989, 3196,  627, 2995}, {3012, 3204,  587, 2994}, {3033, 3202,  615, 3002}, {3056, 3214,  601, 3022},
+    {3079, 3214,  586, 3034}, {3082, 3192,  612, 2988}, {3101, 3210,  617, 2987}, {3128, 3209,  594, 3016}, {3159, 3190,  576, 3008},
+    {3207, 3185,  619, 3006}, {3208, 3221,  635, 2995}, {3220, 3203,  606, 2956}, {3238, 3219,  602, 2970}, {3281, 3205,  608, 3034},
+    {3293, 3225,  574, 3013}, {3320, 3209,  611, 2977}, {3319, 3210,  595, 3006}, {3332, 3204,  605, 2985}, {3364, 3213,  579, 2990},
+    {3356, 3206,  159, 3942}, {3401, 3206,  101, 3903}, {3898, 3184,  179, 3884}, {3408, 3200,  186, 3889}, {3415, 3206,  107, 3861},
+    {3434, 3218,  183, 3904}, {3457, 3215,  178, 3915}, {3457, 3214,  134, 3927}, {3454, 3226,  155, 3863}, {3467, 3210,  155, 3943},
+    {3475, 3205,  152, 3916}, {3491, 3213,  120, 3891}, {3506, 3242,  170, 3885}, {3530, 3217,  171, 3926}, {3502, 3205,  131, 3931},
+};
+
+#endif /* __TOUCH_TRACES_H */
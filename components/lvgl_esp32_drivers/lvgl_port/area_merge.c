@@ -0,0 +1,236 @@
+#include "area_merge.h"
+#include <stdlib.h>
+#include <string.h>
+#include "src/misc/lv_area_private.h"
+
+#define AREA_MERGE_ACTIVE_MAX   32  // 扫描线附近同时比较的区域数上限，超过时放弃下边缘最靠上的一个
+#define AREA_MERGE_NEAR         8   // 强制合并时每个区域在y1顺序中向后比较的区域数
+
+/**
+ * @brief 按y1（相同时按x1）排序
+ */
+static int cmp_y1(const void *a, const void *b)
+{
+    const lv_area_t *p = a, *q = b;
+    if (p->y1 != q->y1) return p->y1 < q->y1 ? -1 : 1;
+    return (p->x1 > q->x1) - (p->x1 < q->x1);
+}
+
+/**
+ * @brief 对基本有序的区域按y1插入排序：扫描结果只有合并后变大的区域y1提前，移动很少
+ */
+static void resort_y1(lv_area_t *areas, uint32_t cnt)
+{
+    for (uint32_t i = 1; i < cnt; i++) {
+        lv_area_t a = areas[i];
+        uint32_t j = i;
+        for (; j > 0 && cmp_y1(&areas[j - 1], &a) > 0; j--) {
+            areas[j] = areas[j - 1];
+        }
+        areas[j] = a;
+    }
+}
+
+/**
+ * @brief 合并两个区域省下的开销：一次固定开销，减去外接矩形多出的像素（重叠时为负，即省下重复的像素）
+ */
+static int64_t merge_saving(const lv_area_t *a, const lv_area_t *b, const area_merge_cost_t *cost)
+{
+    int64_t w = (int64_t)LV_MAX(a->x2, b->x2) - LV_MIN(a->x1, b->x1) + 1;
+    int64_t h = (int64_t)LV_MAX(a->y2, b->y2) - LV_MIN(a->y1, b->y1) + 1;
+    int64_t size_a = (int64_t)(a->x2 - a->x1 + 1) * (a->y2 - a->y1 + 1);
+    int64_t size_b = (int64_t)(b->x2 - b->x1 + 1) * (b->y2 - b->y1 + 1);
+    int64_t extra_px = w * h - size_a - size_b;
+    return (int64_t)cost->window_ns - extra_px * cost->px_ns;
+}
+
+/**
+ * @brief 区域o的下边缘离扫描线已足够远：之后的区域都在扫描线以下，
+ *        与o合并至少多画 间隔行数×o的宽度 个像素，已超过一次固定开销
+ */
+static bool out_of_reach(const lv_area_t *o, int32_t sweep_y, const area_merge_cost_t *cost)
+{
+    int64_t gap = (int64_t)sweep_y - o->y2 - 1;
+    return gap > 0 && gap * (o->x2 - o->x1 + 1) * cost->px_ns >= cost->window_ns;
+}
+
+/**
+ * @brief 按y1扫描一遍：每个区域与仍在扫描线附近的结果区域中合并最划算的一个合并，
+ *        合并后的外接矩形变大，可能又值得与其他区域合并，继续直到不再划算，再作为结果区域加入
+ * @return 结果区域数，结果写回数组开头
+ */
+static uint32_t sweep(lv_area_t *areas, uint32_t cnt, const area_merge_cost_t *cost)
+{
+    uint32_t active[AREA_MERGE_ACTIVE_MAX];  // 扫描线附近的结果区域下标
+    uint32_t active_cnt = 0;
+
+    // 第i个输入处理完后写回areas[i]，被合并掉的结果区域标记为空（x1 > x2），最后压缩
+    for (uint32_t i = 0; i < cnt; i++) {
+        lv_area_t r = areas[i];
+
+        for (uint32_t k = 0; k < active_cnt;) {
+            if (out_of_reach(&areas[active[k]], r.y1, cost)) {
+                active[k] = active[--active_cnt];
+            } else {
+                k++;
+            }
+        }
+
+        for (;;) {
+            int64_t best = 0;
+            uint32_t best_k = active_cnt;
+            for (uint32_t k = 0; k < active_cnt; k++) {
+                int64_t saving = merge_saving(&areas[active[k]], &r, cost);
+                if (saving > best) {
+                    best = saving;
+                    best_k = k;
+                }
+            }
+            if (best_k == active_cnt) break;
+
+            lv_area_join(&r, &r, &areas[active[best_k]]);
+            lv_area_set(&areas[active[best_k]], 0, 0, -1, -1);
+            active[best_k] = active[--active_cnt];
+        }
+
+        if (active_cnt == AREA_MERGE_ACTIVE_MAX) {
+            uint32_t top = 0;
+            for (uint32_t k = 1; k < active_cnt; k++) {
+                if (areas[active[k]].y2 < areas[active[top]].y2) top = k;
+            }
+            active[top] = active[--active_cnt];
+        }
+        areas[i] = r;
+        active[active_cnt++] = i;
+    }
+
+    uint32_t out = 0;
+    for (uint32_t i = 0; i < cnt; i++) {
+        if (areas[i].x1 <= areas[i].x2) areas[out++] = areas[i];
+    }
+    return out;
+}
+
+/**
+ * @brief 候选合并：两个区域的下标和省下的开销
+ */
+typedef struct {
+    int64_t saving;
+    uint32_t a;
+    uint32_t b;
+} merge_pair_t;
+
+/**
+ * @brief 按省下的开销从大到小排序
+ */
+static int cmp_saving(const void *a, const void *b)
+{
+    const merge_pair_t *p = a, *q = b;
+    return (p->saving < q->saving) - (p->saving > q->saving);
+}
+
+/**
+ * @brief 强制合并到max_cnt个以内：每轮为每个区域在y1顺序中之后的AREA_MERGE_NEAR个区域里找代价增加最少的伙伴，
+ *        按代价从小到大合并互不相交的候选，每轮O(n log n)；每轮只合并超出部分的一半，
+ *        其余留到下一轮按合并后的外接矩形重新比较
+ * @param areas 按y1排序的区域
+ * @return 结果区域数
+ */
+static uint32_t force_merge(lv_area_t *areas, uint32_t cnt, uint32_t max_cnt, const area_merge_cost_t *cost)
+{
+    // 候选和每个区域本轮是否已参与合并（外接矩形已变，不再作为候选）
+    merge_pair_t *pairs = lv_malloc(cnt * (sizeof(merge_pair_t) + 1));
+    if (pairs == NULL) {
+        // 没有暂存空间时退化为整体的外接矩形，仍覆盖全部区域
+        for (uint32_t i = 1; i < cnt; i++) {
+            lv_area_join(&areas[0], &areas[0], &areas[i]);
+        }
+        return 1;
+    }
+    uint8_t *used = (uint8_t *)(pairs + cnt);
+
+    while (cnt > max_cnt) {
+        uint32_t pair_cnt = 0;
+        for (uint32_t a = 0; a + 1 < cnt; a++) {
+            merge_pair_t best = {.saving = INT64_MIN, .a = a, .b = a + 1};
+            for (uint32_t b = a + 1; b < cnt && b <= a + AREA_MERGE_NEAR; b++) {
+                int64_t saving = merge_saving(&areas[a], &areas[b], cost);
+                if (saving > best.saving) {
+                    best.saving = saving;
+                    best.b = b;
+                }
+            }
+            pairs[pair_cnt++] = best;
+        }
+        qsort(pairs, pair_cnt, sizeof(pairs[0]), cmp_saving);
+
+        // 被合并掉的区域标记为空（x1 > x2），合并结果留在y1较小的a处，顺序不变
+        memset(used, 0, cnt);
+        uint32_t need = (cnt - max_cnt + 1) / 2;
+        for (uint32_t p = 0; p < pair_cnt && need > 0; p++) {
+            if (used[pairs[p].a] || used[pairs[p].b]) continue;
+            used[pairs[p].a] = used[pairs[p].b] = 1;
+            lv_area_join(&areas[pairs[p].a], &areas[pairs[p].a], &areas[pairs[p].b]);
+            lv_area_set(&areas[pairs[p].b], 0, 0, -1, -1);
+            need--;
+        }
+
+        uint32_t out = 0;
+        for (uint32_t i = 0; i < cnt; i++) {
+            if (areas[i].x1 <= areas[i].x2) areas[out++] = areas[i];
+        }
+        cnt = out;
+    }
+
+    lv_free(pairs);
+    return cnt;
+}
+
+/**
+ * @brief 原地合并区域
+ *
+ * 先按y1扫描（见sweep），只和扫描线附近的区域比较。扫描中已远离扫描线的区域不再比较，
+ * 之后变大的区域可能与它们重叠：有合并时再扫描一遍，直到没有划算的合并；第一遍没有合并时不再扫描。
+ * 结果超过max_cnt时，在y1顺序中相邻的区域里合并代价增加最少的（见force_merge）。
+ */
+uint32_t area_merge(lv_area_t *areas, uint32_t cnt, uint32_t max_cnt, const area_merge_cost_t *cost)
+{
+    if (cnt == 0) return 0;
+
+    qsort(areas, cnt, sizeof(areas[0]), cmp_y1);
+    uint32_t out = sweep(areas, cnt, cost);
+    while (out < cnt && out > 1) {
+        cnt = out;
+        resort_y1(areas, cnt);
+        out = sweep(areas, cnt, cost);
+    }
+
+    if (max_cnt == 0) max_cnt = 1;
+    if (out > max_cnt) {
+        resort_y1(areas, out);
+        out = force_merge(areas, out, max_cnt, cost);
+    }
+
+    // 结果之间重叠较多时，不如整体的外接矩形
+    lv_area_t all = areas[0];
+    for (uint32_t i = 1; i < out; i++) {
+        lv_area_join(&all, &all, &areas[i]);
+    }
+    if (area_merge_total_cost(&all, 1, cost) <= area_merge_total_cost(areas, out, cost)) {
+        areas[0] = all;
+        out = 1;
+    }
+    return out;
+}
+
+/**
+ * @brief 按代价模型计算一组区域的总开销
+ */
+uint64_t area_merge_total_cost(const lv_area_t *areas, uint32_t cnt, const area_merge_cost_t *cost)
+{
+    uint64_t total = 0;
+    for (uint32_t i = 0; i < cnt; i++) {
+        total += cost->window_ns + (uint64_t)lv_area_get_size(&areas[i]) * cost->px_ns;
+    }
+    return total;
+}
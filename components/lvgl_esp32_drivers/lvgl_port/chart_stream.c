@@ -0,0 +1,365 @@
+#include "chart_stream.h"
+#include <string.h>
+#include "esp_log.h"
+#include "esp_heap_caps.h"
+#include "src/core/lv_obj_private.h"
+#include "src/misc/lv_area_private.h"
+#include "src/widgets/chart/lv_chart_private.h"
+
+#define TAG "CHART_STREAM" // 日志标签
+
+// column_add的结果
+typedef enum {
+    COL_UNCHANGED,  // 显示不变（只改了最后一个值，或样本为空）
+    COL_CHANGED,    // 最新一列的范围扩大
+    COL_NEW,        // 开始了新的一列
+} col_update_t;
+
+static void stream_event_cb(lv_event_t *e);
+
+static inline void column_reset(chart_stream_col_t *col)
+{
+    col->min = INT32_MAX;
+    col->max = INT32_MIN;
+    col->last = LV_CHART_POINT_NONE;
+}
+
+static inline bool column_empty(const chart_stream_col_t *col)
+{
+    return col->min > col->max;
+}
+
+static inline bool stream_shift(const chart_stream_t *s)
+{
+    return ((const lv_chart_t *)s->chart)->update_mode == LV_CHART_UPDATE_MODE_SHIFT;
+}
+
+/**
+ * @brief 把一个样本计入最新一列，最新一列已满时开始新的一列
+ */
+static col_update_t column_add(chart_stream_t *s, int32_t value)
+{
+    col_update_t res = COL_UNCHANGED;
+    if (s->cols_started == 0 || s->col_fill == s->per_col) {
+        column_reset(&s->cols[s->cols_started % s->col_cnt]);
+        s->cols_started++;
+        s->col_fill = 0;
+        res = COL_NEW;
+    }
+
+    chart_stream_col_t *col = &s->cols[(s->cols_started - 1) % s->col_cnt];
+    s->col_fill++;
+    if (value == LV_CHART_POINT_NONE) return res;
+
+    if (value < col->min) {
+        col->min = value;
+        if (res == COL_UNCHANGED) res = COL_CHANGED;
+    }
+    if (value > col->max) {
+        col->max = value;
+        if (res == COL_UNCHANGED) res = COL_CHANGED;
+    }
+    col->last = value;
+    return res;
+}
+
+/**
+ * @brief 某一显示位置上的列序号
+ * @return 该位置还没有列时返回false
+ */
+static bool column_seq_at(const chart_stream_t *s, uint32_t pos, uint32_t *seq)
+{
+    if (s->cols_started == 0 || pos >= s->col_cnt) return false;
+
+    uint32_t newest = s->cols_started - 1;
+    uint32_t age = stream_shift(s) ? s->col_cnt - 1 - pos :
+                   (newest % s->col_cnt + s->col_cnt - pos) % s->col_cnt;
+    if (age > newest) return false;
+    *seq = newest - age;
+    return true;
+}
+
+/**
+ * @brief 最新一列的显示位置
+ */
+static uint32_t newest_pos(const chart_stream_t *s)
+{
+    return stream_shift(s) ? s->col_cnt - 1 : (s->cols_started - 1) % s->col_cnt;
+}
+
+/**
+ * @brief 图表内容区域的屏幕坐标（已减去滚动偏移），与lv_chart绘制折线时相同
+ */
+static void stream_content(const chart_stream_t *s, lv_area_t *content)
+{
+    lv_obj_get_content_coords(s->chart, content);
+    lv_area_move(content, -lv_obj_get_scroll_left(s->chart), -lv_obj_get_scroll_top(s->chart));
+}
+
+/**
+ * @brief 列的横坐标：每列一个样本时与lv_chart的点间距相同，否则每列一个像素
+ */
+static int32_t column_x(const chart_stream_t *s, const lv_area_t *content, int32_t pos)
+{
+    return content->x1 + pos * (lv_area_get_width(content) - 1) / (int32_t)(s->col_cnt - 1);
+}
+
+/**
+ * @brief 值的纵坐标，与lv_chart相同
+ */
+static int32_t value_y(const chart_stream_t *s, const lv_area_t *content, int32_t value)
+{
+    const lv_chart_t *chart = (const lv_chart_t *)s->chart;
+    int axis = s->axis == LV_CHART_AXIS_SECONDARY_Y ? 1 : 0;
+    int32_t range = chart->ymax[axis] - chart->ymin[axis];
+    if (range == 0) range = 1;
+
+    int64_t dy = (int64_t)(value - chart->ymin[axis]) * lv_area_get_height(content) / range;
+    return content->y2 + 1 - (int32_t)dy;
+}
+
+/**
+ * @brief 使位置p1~p2的列及其与左侧一列的连线失效
+ */
+static void invalidate_columns(chart_stream_t *s, uint32_t p1, uint32_t p2)
+{
+    lv_area_t content, area;
+    int32_t line_w = lv_obj_get_style_line_width(s->chart, LV_PART_ITEMS);
+
+    stream_content(s, &content);
+    area.x1 = column_x(s, &content, p1 > 0 ? p1 - 1 : 0) - line_w;
+    area.x2 = column_x(s, &content, p2) + line_w;
+    area.y1 = content.y1 - line_w;
+    area.y2 = content.y2 + line_w;
+    lv_obj_invalidate_area(s->chart, &area);
+}
+
+/**
+ * @brief 按内容宽度分列，并由环形缓冲区中的样本重建列聚合
+ * @return 列缓冲区分配失败返回false，原有的列保持不变
+ */
+static bool stream_layout(chart_stream_t *s)
+{
+    int32_t w = lv_obj_get_content_width(s->chart);
+    if (w < 2) w = 2;
+    uint32_t per_col = (s->capacity + w - 1) / w;
+    uint32_t col_cnt = per_col > 1 ? (uint32_t)w : s->capacity;
+
+    if (s->cols == NULL || col_cnt != s->col_cnt) {
+        // 列聚合每次绘制都要遍历，放在内部RAM
+        chart_stream_col_t *cols = heap_caps_malloc(col_cnt * sizeof(chart_stream_col_t),
+                                                    MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+        if (cols == NULL) {
+            ESP_LOGE(TAG, "列缓冲区分配失败（%u列）", (unsigned)col_cnt);
+            return false;
+        }
+        heap_caps_free(s->cols);
+        s->cols = cols;
+    }
+    s->width = w;
+    s->per_col = per_col;
+    s->col_cnt = col_cnt;
+    s->cols_started = 0;
+    s->col_fill = 0;
+
+    uint32_t idx = (s->head + s->capacity - s->count) % s->capacity;
+    for (uint32_t i = 0; i < s->count; i++) {
+        column_add(s, s->samples[idx]);
+        idx = idx + 1 == s->capacity ? 0 : idx + 1;
+    }
+    return true;
+}
+
+/**
+ * @brief 绘制：只遍历与裁剪区域相交的列，每列一条线
+ */
+static void stream_draw(chart_stream_t *s, lv_layer_t *layer)
+{
+    lv_area_t clip;
+    if (s->cols_started == 0 || !lv_area_intersect(&clip, &s->chart->coords, &layer->_clip_area)) return;
+
+    lv_area_t content;
+    stream_content(s, &content);
+    // 内容区不足两个像素宽（例如内边距大于图表宽度）时没有可连的线，span也不能作除数
+    int32_t span = lv_area_get_width(&content) - 1;
+    if (span <= 0) return;
+
+    lv_draw_line_dsc_t line_dsc;
+    lv_draw_line_dsc_init(&line_dsc);
+    lv_obj_init_draw_line_dsc(s->chart, LV_PART_ITEMS, &line_dsc);
+    line_dsc.color = s->color;
+    if (line_dsc.width <= 1) line_dsc.raw_end = 1;
+
+    const lv_area_t clip_area_ori = layer->_clip_area;
+    layer->_clip_area = clip;
+
+    int32_t last_pos = (int32_t)s->col_cnt - 1;
+    int32_t p_lo = LV_MAX((clip.x1 - line_dsc.width - content.x1) * last_pos / span - 1, 0);
+    int32_t p_hi = LV_MIN((clip.x2 + line_dsc.width - content.x1) * last_pos / span + 2, last_pos);
+
+    for (int32_t p = p_lo; p <= p_hi; p++) {
+        uint32_t seq, prev_seq;
+        if (!column_seq_at(s, p, &seq)) continue;
+        const chart_stream_col_t *col = &s->cols[seq % s->col_cnt];
+        if (column_empty(col)) continue;
+
+        // 左侧相邻的列序号相连时才连线（循环模式下最新一列的右侧是缺口）
+        const chart_stream_col_t *prev = NULL;
+        if (p > 0 && column_seq_at(s, p - 1, &prev_seq) && prev_seq + 1 == seq) {
+            prev = &s->cols[prev_seq % s->col_cnt];
+            if (column_empty(prev)) prev = NULL;
+        }
+
+        int32_t x = column_x(s, &content, p);
+        if (s->per_col == 1 && prev != NULL) {
+            line_dsc.p1.x = column_x(s, &content, p - 1);
+            line_dsc.p1.y = value_y(s, &content, prev->last);
+            line_dsc.p2.x = x;
+            line_dsc.p2.y = value_y(s, &content, col->last);
+        } else {
+            // 一列画一条竖线，包含上一列的最后一个值，与之相连
+            int32_t lo = col->min, hi = col->max;
+            if (prev != NULL) {
+                lo = LV_MIN(lo, prev->last);
+                hi = LV_MAX(hi, prev->last);
+            }
+            line_dsc.p1.x = x;
+            line_dsc.p2.x = x;
+            line_dsc.p1.y = value_y(s, &content, hi);
+            line_dsc.p2.y = value_y(s, &content, lo);
+            if (line_dsc.p1.y == line_dsc.p2.y) line_dsc.p2.y++;    // 长度为0时不会画出
+        }
+        lv_draw_line(layer, &line_dsc);
+    }
+
+    layer->_clip_area = clip_area_ori;
+}
+
+/**
+ * @brief 图表事件：绘制、尺寸或样式变化、删除
+ */
+static void stream_event_cb(lv_event_t *e)
+{
+    chart_stream_t *s = lv_event_get_user_data(e);
+
+    switch (lv_event_get_code(e)) {
+    case LV_EVENT_DRAW_MAIN:
+        stream_draw(s, lv_event_get_layer(e));
+        break;
+    case LV_EVENT_SIZE_CHANGED:
+    case LV_EVENT_STYLE_CHANGED:
+        if (lv_obj_get_content_width(s->chart) != s->width && stream_layout(s)) {
+            lv_obj_invalidate(s->chart);
+        }
+        break;
+    case LV_EVENT_DELETE:
+        s->chart = NULL;
+        chart_stream_deinit(s);
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief 在图表上建立一条数据流曲线
+ */
+bool chart_stream_init(chart_stream_t *stream, lv_obj_t *chart, lv_color_t color, lv_chart_axis_t axis,
+                       uint32_t capacity)
+{
+    memset(stream, 0, sizeof(*stream));
+    if (capacity < 2) capacity = 2;
+
+    // 样本只在追加和重新分列时访问，优先放在PSRAM
+    stream->samples = heap_caps_malloc(capacity * sizeof(int32_t), MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (stream->samples == NULL) {
+        stream->samples = heap_caps_malloc(capacity * sizeof(int32_t), MALLOC_CAP_8BIT);
+    }
+    if (stream->samples == NULL) {
+        ESP_LOGE(TAG, "样本缓冲区分配失败（%u个）", (unsigned)capacity);
+        return false;
+    }
+    stream->chart = chart;
+    stream->color = color;
+    stream->axis = axis;
+    stream->capacity = capacity;
+
+    lv_obj_update_layout(chart);
+    if (!stream_layout(stream)) {
+        stream->chart = NULL;
+        chart_stream_deinit(stream);
+        return false;
+    }
+    lv_obj_add_event_cb(chart, stream_event_cb, LV_EVENT_DRAW_MAIN, stream);
+    lv_obj_add_event_cb(chart, stream_event_cb, LV_EVENT_SIZE_CHANGED, stream);
+    lv_obj_add_event_cb(chart, stream_event_cb, LV_EVENT_STYLE_CHANGED, stream);
+    lv_obj_add_event_cb(chart, stream_event_cb, LV_EVENT_DELETE, stream);
+    ESP_LOGI(TAG, "数据流曲线：%u个样本，%u列，每列%u个", (unsigned)capacity, (unsigned)stream->col_cnt,
+             (unsigned)stream->per_col);
+    return true;
+}
+
+/**
+ * @brief 释放缓冲区，并从图表上移除
+ */
+void chart_stream_deinit(chart_stream_t *stream)
+{
+    if (stream->chart != NULL) {
+        lv_obj_remove_event_cb_with_user_data(stream->chart, stream_event_cb, stream);
+        lv_obj_invalidate(stream->chart);
+    }
+    heap_caps_free(stream->samples);
+    heap_caps_free(stream->cols);
+    memset(stream, 0, sizeof(*stream));
+}
+
+/**
+ * @brief 追加一个样本
+ */
+void chart_stream_push(chart_stream_t *stream, int32_t value)
+{
+    if (stream->chart == NULL) return;
+
+    stream->samples[stream->head] = value;
+    stream->head = stream->head + 1 == stream->capacity ? 0 : stream->head + 1;
+    if (stream->count < stream->capacity) stream->count++;
+
+    col_update_t res = column_add(stream, value);
+    if (res == COL_UNCHANGED) return;
+
+    uint32_t pos = newest_pos(stream);
+    if (res == COL_CHANGED) {
+        invalidate_columns(stream, pos, pos);
+    } else if (stream_shift(stream)) {
+        // 整体左移一列
+        invalidate_columns(stream, 0, stream->col_cnt - 1);
+    } else {
+        // 新列覆盖最旧的一列，右侧一列不再与之相连
+        invalidate_columns(stream, pos, pos + 1 < stream->col_cnt ? pos + 1 : pos);
+    }
+}
+
+/**
+ * @brief 清空所有样本
+ */
+void chart_stream_clear(chart_stream_t *stream)
+{
+    if (stream->chart == NULL) return;
+
+    stream->head = 0;
+    stream->count = 0;
+    stream->cols_started = 0;
+    stream->col_fill = 0;
+    lv_obj_invalidate(stream->chart);
+}
+
+/**
+ * @brief 读取某一显示位置的列聚合
+ */
+bool chart_stream_get_column(const chart_stream_t *stream, uint32_t pos, chart_stream_col_t *col)
+{
+    uint32_t seq;
+    if (stream->chart == NULL || !column_seq_at(stream, pos, &seq)) return false;
+    *col = stream->cols[seq % stream->col_cnt];
+    return true;
+}
@@ -0,0 +1,40 @@
+#ifndef __AREA_MERGE_H
+#define __AREA_MERGE_H
+
+#include <stdint.h>
+#include "lvgl.h"
+
+// 脏区域合并：按代价模型决定是否把两个区域合并为外接矩形
+// 每个区域单独刷新要付一次固定开销（窗口设置、LVGL每块的准备），另外每个像素各有渲染和传输开销；
+// 合并省下一次固定开销，但要多画外接矩形中原本不脏的像素
+// 按y1排序后自上而下扫描，只和扫描线附近仍可能合并划算的区域比较；超过个数上限时的强制合并
+// 也只比较y1顺序中相邻的区域，数百个小区域也是近线性的
+
+/**
+ * @brief 代价模型
+ */
+typedef struct {
+    uint32_t window_ns;     // 每个区域的固定开销（纳秒）
+    uint32_t px_ns;         // 每个像素的开销（纳秒）
+} area_merge_cost_t;
+
+/**
+ * @brief 原地合并区域
+ * @param areas 区域数组，结果写回数组开头
+ * @param cnt 区域数
+ * @param max_cnt 结果最多的区域数，按代价合并后仍超过时强制合并代价增加最少的两个
+ * @param cost 代价模型
+ * @return 合并后的区域数，覆盖原有全部区域
+ */
+uint32_t area_merge(lv_area_t *areas, uint32_t cnt, uint32_t max_cnt, const area_merge_cost_t *cost);
+
+/**
+ * @brief 按代价模型计算一组区域的总开销
+ * @param areas 区域数组
+ * @param cnt 区域数
+ * @param cost 代价模型
+ * @return 总开销（纳秒）
+ */
+uint64_t area_merge_total_cost(const lv_area_t *areas, uint32_t cnt, const area_merge_cost_t *cost);
+
+#endif /* __AREA_MERGE_H */
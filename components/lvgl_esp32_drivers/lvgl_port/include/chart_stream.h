@@ -0,0 +1,85 @@
+#ifndef __CHART_STREAM_H
+#define __CHART_STREAM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "lvgl.h"
+
+// 高速数据流曲线：挂在lv_chart上的一条折线，用于每秒数百个样本的遥测（姿态、RSSI、电池）
+// 样本存入环形缓冲区，同时按像素列增量维护每列的最小值、最大值和最后一个值；
+// 绘制时每列画一段（最小值到最大值，并与上一列的最后一个值相连），耗时只与图表宽度有关，与样本数无关
+// 样本数不超过内容宽度时每列一个样本，按lv_chart的折线方式连接各点
+// 滚动方式跟随图表的lv_chart_set_update_mode：
+//   LV_CHART_UPDATE_MODE_CIRCULAR  新列从左到右循环覆盖，只重绘新写入的列
+//   LV_CHART_UPDATE_MODE_SHIFT     最新的列在最右侧，每开始一列整体左移一列，整个绘图区重绘
+// 纵向范围使用图表对应坐标轴的范围，LV_CHART_POINT_NONE表示没有数据
+
+/**
+ * @brief 一列的聚合值
+ */
+typedef struct {
+    int32_t min;    // 最小值，min > max表示这一列没有有效样本
+    int32_t max;    // 最大值
+    int32_t last;   // 最后一个有效样本，用于与下一列相连
+} chart_stream_col_t;
+
+/**
+ * @brief 数据流曲线，由调用者持有，删除图表前后都可以调用chart_stream_deinit
+ */
+typedef struct {
+    lv_obj_t *chart;            // 所在的图表，图表删除后为NULL
+    lv_color_t color;           // 线的颜色
+    lv_chart_axis_t axis;       // 使用的纵坐标轴
+    int32_t *samples;           // 样本环形缓冲区
+    uint32_t capacity;          // 显示的样本数
+    uint32_t head;              // 下一个样本的写入位置
+    uint32_t count;             // 缓冲区中的样本数
+    chart_stream_col_t *cols;   // 列聚合，按列序号取模存放
+    int32_t width;              // 建立列时的内容宽度
+    uint32_t col_cnt;           // 列数
+    uint32_t per_col;           // 每列的样本数
+    uint32_t cols_started;      // 已开始的列数，最新一列的序号为cols_started - 1
+    uint32_t col_fill;          // 最新一列已有的样本数
+} chart_stream_t;
+
+/**
+ * @brief 在图表上建立一条数据流曲线，按图表当前的内容宽度分列
+ * @param stream 数据流曲线，图表存在期间必须保持有效
+ * @param chart lv_chart对象（折线类型），其他曲线照常由lv_chart绘制
+ * @param color 线的颜色，线宽等样式取图表LV_PART_ITEMS部分
+ * @param axis LV_CHART_AXIS_PRIMARY_Y或LV_CHART_AXIS_SECONDARY_Y
+ * @param capacity 显示的样本数
+ * @return 缓冲区分配失败返回false
+ */
+bool chart_stream_init(chart_stream_t *stream, lv_obj_t *chart, lv_color_t color, lv_chart_axis_t axis,
+                       uint32_t capacity);
+
+/**
+ * @brief 释放缓冲区，并从图表上移除
+ * @param stream 数据流曲线
+ */
+void chart_stream_deinit(chart_stream_t *stream);
+
+/**
+ * @brief 追加一个样本：O(1)，只在所在列的显示发生变化时使对应的列失效
+ * @param stream 数据流曲线
+ * @param value 样本值，LV_CHART_POINT_NONE表示没有数据
+ */
+void chart_stream_push(chart_stream_t *stream, int32_t value);
+
+/**
+ * @brief 清空所有样本
+ * @param stream 数据流曲线
+ */
+void chart_stream_clear(chart_stream_t *stream);
+
+/**
+ * @brief 读取某一显示位置的列聚合（从左数第pos列）
+ * @param stream 数据流曲线
+ * @param pos 列的位置，0 ~ col_cnt-1
+ * @param col 输出
+ * @return 该位置没有列（尚无数据）时返回false
+ */
+bool chart_stream_get_column(const chart_stream_t *stream, uint32_t pos, chart_stream_col_t *col);
+
+#endif /* __CHART_STREAM_H */
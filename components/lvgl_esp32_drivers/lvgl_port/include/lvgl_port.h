@@ -2,12 +2,195 @@
 #define __LVGL_PORT_H
 
 #include <stdint.h>
+#include <stdbool.h>
+#include "freertos/FreeRTOS.h"
 #include "lvgl.h"
 #include "disp_spi.h"
 #include "ili9341.h"
 #include "touch_spi.h"
 #include "xpt2046.h"
+#include "port_stats.h"
+
+#define LV_PORT_IDLE_SLEEP_MS   1000    // 没有待运行定时器时的最长睡眠，仅作兜底
+
+/*
+ * 双核渲染模式：menuconfig中LV_USE_OS选FreeRTOS、LV_DRAW_SW_DRAW_UNIT_CNT设为2时启用。
+ * 渲染由LVGL的软件绘制线程完成，第i个绘制线程绑定到(LV_PORT_DRAW_CORE + i)号核；
+ * LVGL任务（定时器、分发绘制任务、flush_cb）、SPI中断和触摸采样留在LV_PORT_TASK_CORE。
+ * 此模式下其他任务调用LVGL接口前须lv_lock()，之后lv_unlock()。
+ */
+#define LV_PORT_TASK_CORE       0       // LVGL任务所在的核，lv_port_init也应在该核上调用（SPI中断分配在调用核）
+#define LV_PORT_DRAW_CORE       1       // 第一个绘制线程所在的核
+
+/*
+ * 条带高度自适应：DISP_BUF_SIZE是分配的缓冲区大小，即条带高度的上限。
+ * 启用后每帧开始渲染时按测得的渲染和传输耗时模型（见stripe_tuner.h）选择条带高度，
+ * 使两级流水尽量平衡；不启用时始终用满缓冲区。两种模式下都统计耗时，可用lv_port_get_stripe_stats读取。
+ */
+#define LV_PORT_STRIPE_ADAPTIVE     0   // 初始是否启用，运行时可用lv_port_set_adaptive_stripe切换
+#define LV_PORT_STRIPE_MIN_LINES    4   // 自适应时的条带高度下限（整屏宽的行数）
+
+/*
+ * 脏区域合并：替换LVGL按面积的合并规则（见area_merge.h），每个区域的固定开销和每像素开销
+ * 取自上面的耗时模型中较慢的一级；模型建立前每像素按SPI线上时间、固定开销按下面的估计值。
+ * 区域数达到LV_INV_BUF_SIZE时先合并腾出位置，不再退化为整屏刷新。
+ */
+#define LV_PORT_AREA_FIXED_US       100 // 模型建立前每个区域固定开销的估计值（微秒）
+
+/*
+ * 影子帧缓冲比较（见shadow_fb.h）：PSRAM中保存一份面板内容，每块渲染结果逐行比较，
+ * 只以较窄的窗口发送变化的部分，整块没有变化时不发送。需要LV_HOR_RES_MAX*LV_VER_RES_MAX*2字节，
+ * 每块多一次逐行比较和副本更新，适合重绘多、实际变化少的界面（文本读数、整屏刷新后大部分不变）。
+ */
+#define LV_PORT_SHADOW_DIFF         0   // 初始是否启用，运行时可用lv_port_set_shadow_diff切换
+#define LV_PORT_SHADOW_RECTS_MAX    8   // 每块最多拆分的窗口数，不超过DISP_SPI_WINDOWS_PER_FLUSH
+#define LV_PORT_SHADOW_WINDOW_US    20  // 多一个窗口的开销估计值（窗口设置的三条命令和事务间隔，微秒）
+
+/*
+ * 字形缓存（LVGL的lv_font_glyph_cache.h）：lv_font_fmt_txt字体的字形展开或解压为A8位图后按字节预算缓存，
+ * 重复绘制的字符（遥测读数的数字、固定的标题）直接从缓存混合。lv_port_init按此设置预算，覆盖LV_FONT_GLYPH_CACHE_SIZE；
+ * 运行时可用lv_font_glyph_cache_resize调整，0为关闭。
+ */
+#define LV_PORT_GLYPH_CACHE_SIZE    (8 * 1024)  // 字形缓存的字节预算（LVGL堆）
+
+/*
+ * 性能跟踪：menuconfig中启用LV_USE_PROFILER和内置分析器后可用。LVGL的LV_PROFILER_BEGIN/END和
+ * 移植层的跟踪点（disp_flush、等待上一块传完、等待SPI事务、触摸读取和采样）写入各线程自己的无锁环，
+ * 时间戳为esp_timer微秒；lv_port_handler每轮把已记录的事件以二进制流（格式见lv_profiler_builtin.h）
+ * 交给lv_port_set_trace_output设置的回调，主机上用tools/lv_trace2json.py转成Chrome/Perfetto的JSON。
+ * 未设置输出时不记录。
+ */
+#define LV_PORT_TRACE_BUF_SIZE      (32 * 1024) // 各线程的环共用的缓冲区大小（字节）
+
+/*
+ * 移植层性能计数器（见port_stats.h）：SPI总线利用率、等待挂起事务的阻塞时间、队列深度、
+ * 字节交换耗时、触摸读取延迟和刷新就绪延迟。计数器始终更新，开销为几次原子加法；
+ * 用port_stats_mark/port_stats_read按周期读取，或用lv_port_show_perf_stats在sysmon中
+ * 每LV_SYSMON_REFR_PERIOD_DEF显示或打印一次（需启用LV_USE_SYSMON）。
+ */
+
+/**
+ * @brief 条带和帧时间统计
+ */
+typedef struct {
+    bool adaptive;              // 是否启用了自适应
+    uint32_t frames;            // 已完成的帧数（有脏区域的刷新）
+    uint16_t stripe_lines;      // 最近一帧的条带高度（整屏宽的行数，窄区域每块的行数相应更多）
+    uint16_t stripe_lines_min;  // 各帧条带高度的最小值
+    uint16_t stripe_lines_max;  // 各帧条带高度的最大值
+    uint32_t stripes;           // 最近一帧的条带数
+    uint32_t frame_us;          // 最近一帧从开始渲染到最后一块传完的时间（微秒）
+    uint32_t frame_us_max;      // 各帧时间的最大值
+    uint64_t frame_us_total;    // 各帧时间之和，除以frames即平均值
+    uint32_t predicted_us;      // 最近一帧按模型预测的帧时间，模型未建立时为0
+    float render_fixed_us;      // 渲染模型：每块固定开销
+    float render_line_us;       // 渲染模型：每行开销
+    float xfer_fixed_us;        // 传输模型：每块固定开销（含窗口设置）
+    float xfer_line_us;         // 传输模型：每行开销
+    uint64_t bytes_sent;        // 累计发送的颜色数据字节数
+    uint64_t bytes_skipped;     // 累计因影子帧缓冲比较未变化而省去的字节数
+    uint32_t windows;           // 累计发送的窗口数
+} lv_port_stripe_stats_t;
+
+/**
+ * @brief 启动各阶段的时刻（esp_timer微秒，0表示尚未发生）
+ *
+ * 面板复位后不等待：复位释放5ms后即可写GRAM，LVGL、触摸初始化和第一帧渲染与复位后的等待重叠，
+ * 第一帧在面板睡眠中写入GRAM；复位释放120ms后退出睡眠，再过5ms且第一帧已写完时开显示。
+ * display_on_us即第一帧可见的时刻，可作为启动耗时的回归指标。
+ */
+typedef struct {
+    int64_t panel_reset_us;     // 面板复位释放
+    int64_t init_done_us;       // lv_port_init完成：LVGL、显示、触摸和输入设备
+    int64_t first_flush_us;     // 第一块颜色数据排队
+    int64_t first_frame_us;     // 第一帧的最后一块传完
+    int64_t display_on_us;      // 开显示，第一帧可见
+} lv_port_boot_stats_t;
 
 void lv_port_init(void); // LVGL移植初始化函数
 
+/**
+ * @brief 处理一次LVGL：把积压的触摸点交给LVGL，然后运行到期的定时器
+ * @return 距下一个定时器到期的毫秒数，LV_NO_TIMER_READY表示没有运行中的定时器
+ */
+uint32_t lv_port_handler(void);
+
+/**
+ * @brief 在LVGL任务中睡眠，直到超时或被lv_port_wake唤醒
+ * @param timeout_ms 最长睡眠时间（毫秒），超过LV_PORT_IDLE_SLEEP_MS时按后者
+ */
+void lv_port_sleep(uint32_t timeout_ms);
+
+/**
+ * @brief LVGL任务入口：循环调用lv_port_handler，按其返回值睡眠，不返回
+ * @param arg 未使用
+ */
+void lv_port_task(void *arg);
+
+/**
+ * @brief 唤醒LVGL任务（任务上下文），用于外部数据源有新数据时
+ */
+void lv_port_wake(void);
+
+/**
+ * @brief 唤醒LVGL任务（中断上下文）
+ * @param woken 输出是否需要在中断退出时切换任务
+ */
+void lv_port_wake_from_isr(BaseType_t *woken);
+
+/**
+ * @brief 启用或关闭条带高度自适应，从下一帧起生效
+ * @param enable true为按耗时模型选择，false为始终用满缓冲区
+ */
+void lv_port_set_adaptive_stripe(bool enable);
+
+/**
+ * @brief 启用或关闭按代价的脏区域合并（默认启用）
+ * @param enable true为按代价合并，false为LVGL自带的合并规则
+ */
+void lv_port_set_area_merge(bool enable);
+
+/**
+ * @brief 启用或关闭影子帧缓冲比较；启用时分配副本并使整屏失效，下一帧整屏发送后副本即与面板一致
+ * @param enable true为只发送变化的部分，false为整块发送并释放副本
+ * @return 启用时副本分配失败返回false
+ */
+bool lv_port_set_shadow_diff(bool enable);
+
+/**
+ * @brief 读取条带和帧时间统计（LVGL任务中或持有lv_lock时调用）
+ * @param stats 输出
+ */
+void lv_port_get_stripe_stats(lv_port_stripe_stats_t *stats);
+
+/**
+ * @brief 清零帧统计和字节计数，耗时模型保留
+ */
+void lv_port_reset_stripe_stats(void);
+
+/**
+ * @brief 读取启动各阶段的时刻（LVGL任务中或持有lv_lock时调用）
+ * @param stats 输出
+ */
+void lv_port_get_boot_stats(lv_port_boot_stats_t *stats);
+
+/**
+ * @brief 设置性能跟踪的输出，重新开始跟踪（LVGL任务中或持有lv_lock时调用）
+ * @param write_cb 在LVGL任务中以二进制流调用，如写UART或文件；NULL为停止跟踪
+ * @return 未启用LVGL内置分析器或第一次分配缓冲区失败时返回false
+ */
+bool lv_port_set_trace_output(void (*write_cb)(const void *buf, uint32_t size));
+
+/**
+ * @brief 显示移植层性能计数器的sysmon叠加层（LVGL任务中或持有lv_lock时调用）
+ * @param log_mode true为每个周期以LV_LOG打印一行，不显示标签
+ * @return 叠加层的标签，未启用LV_USE_SYSMON时返回NULL
+ */
+lv_obj_t *lv_port_show_perf_stats(bool log_mode);
+
+/**
+ * @brief 隐藏移植层性能计数器的sysmon叠加层，停止打印
+ */
+void lv_port_hide_perf_stats(void);
+
 #endif /* __LVGL_PORT_H */
\ No newline at end of file
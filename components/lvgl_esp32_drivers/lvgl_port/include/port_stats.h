@@ -0,0 +1,129 @@
+#ifndef __PORT_STATS_H
+#define __PORT_STATS_H
+
+#include <stdint.h>
+#include <stdatomic.h>
+#include "esp_attr.h"
+#include "esp_cpu.h"
+
+// 移植层性能计数器：disp_spi、ili9341、xpt2046和lvgl_port在热路径上更新，读取由lv_port_get_perf_stats完成
+// 每个计数器都是自由运行的32位原子量，只做relaxed加法，中断中也可调用；读取方保存上次的值按差值计算，
+// 因此可以有多个读取方（sysmon叠加层、测试）各自统计，计数器本身从不清零。
+// 最大值例外：port_stats_mark/port_stats_read取走并清零（atomic_exchange），是自上次任一读取方取走以来的最大值；
+// 只有一个读取方（sysmon叠加层）时即每个周期的最大值，有多个读取方时只有一个能看到某个周期的峰值
+// 耗时用CPU周期计数（只在同一核上取差值：SPI中断和LVGL任务都在LV_PORT_TASK_CORE），
+// 跨任务的延迟（触摸采样任务可能在另一核）用esp_timer微秒。
+// 240MHz下32位周期数约17秒回绕，读取间隔须短于此
+
+/**
+ * @brief 计数器
+ */
+typedef struct {
+    atomic_uint spi_trans;          // 显示SPI事务数
+    atomic_uint spi_bytes;          // 显示SPI发送的字节数
+    atomic_uint spi_busy_cycles;    // 事务在总线上的时间（pre_cb到post_cb）
+    atomic_uint spi_wait_cycles;    // 阻塞在disp_wait_for_pending_transactions中的时间
+    atomic_uint spi_waits;          // 实际阻塞的disp_wait_for_pending_transactions调用数
+    atomic_uint spi_ring_full;      // 排队时事务环已满、先等最早一个事务的次数
+    atomic_uint queue_depth_sum;    // 每次排队时已在队列中的事务数之和，除以排队数即平均深度
+    atomic_uint queued;             // 排队的事务数
+    atomic_uint queue_depth_max;    // 排队时队列深度的最大值（本周期，读取时清零）
+    atomic_uint windows;            // ili9341设置的窗口数
+    atomic_uint pixels;             // ili9341发送的像素数
+    atomic_uint swap_cycles;        // RGB565字节交换的时间
+    atomic_uint touch_samples;      // 采样任务产生的点数
+    atomic_uint touch_reads;        // 交给LVGL的点数
+    atomic_uint touch_latency_us;   // 交给LVGL的点从采样到读取的时间之和
+    atomic_uint touch_latency_max_us; // 上项的最大值（本周期，读取时清零）
+    atomic_uint flushes;            // 传完的块数
+    atomic_uint flush_latency_us;   // 各块从flush_cb排队到最后一段传完（LVGL可以复用缓冲区）的时间之和
+    atomic_uint flush_latency_max_us; // 上项的最大值（本周期，读取时清零）
+} port_stats_t;
+
+/**
+ * @brief 读取方的起点：上次读取时的计数器和时刻
+ */
+typedef struct {
+    uint32_t counters[sizeof(port_stats_t) / sizeof(atomic_uint)];
+    int64_t time_us;
+} port_stats_mark_t;
+
+/**
+ * @brief 一个统计周期内的值，耗时已换算为微秒
+ */
+typedef struct {
+    uint32_t period_us;             // 统计周期
+    uint32_t spi_trans;             // 显示SPI事务数
+    uint32_t spi_bytes;             // 显示SPI发送的字节数
+    uint32_t spi_busy_us;           // 总线忙的时间
+    uint8_t spi_busy_pct;           // 总线利用率（百分比）
+    uint32_t spi_wait_us;           // 阻塞在等待挂起事务中的时间
+    uint32_t spi_waits;             // 实际阻塞的等待次数
+    uint32_t spi_ring_full;         // 事务环满的次数
+    float queue_depth_avg;          // 排队时队列的平均深度
+    uint32_t queue_depth_max;       // 队列深度的最大值
+    uint32_t windows;               // 设置的窗口数
+    uint32_t pixels;                // 发送的像素数
+    uint32_t swap_us;               // RGB565字节交换的时间
+    uint32_t touch_samples;         // 采样任务产生的点数
+    uint32_t touch_reads;           // 交给LVGL的点数
+    uint32_t touch_latency_avg_us;  // 点从采样到交给LVGL的平均时间
+    uint32_t touch_latency_max_us;  // 上项的最大值
+    uint32_t flushes;               // 传完的块数
+    uint32_t flush_latency_avg_us;  // 块从排队到传完的平均时间
+    uint32_t flush_latency_max_us;  // 上项的最大值
+} port_stats_period_t;
+
+extern port_stats_t port_stats;
+
+/**
+ * @brief 计数器加n
+ */
+static inline void IRAM_ATTR port_stats_add(atomic_uint *counter, uint32_t n)
+{
+    atomic_fetch_add_explicit(counter, n, memory_order_relaxed);
+}
+
+/**
+ * @brief 把自某时刻以来的周期数加到计数器
+ * @param counter 计数器
+ * @param start 开始时的esp_cpu_get_cycle_count()
+ */
+static inline void IRAM_ATTR port_stats_add_cycles(atomic_uint *counter, esp_cpu_cycle_count_t start)
+{
+    port_stats_add(counter, (uint32_t)(esp_cpu_get_cycle_count() - start));
+}
+
+/**
+ * @brief 更新最大值（只有一个写入方时无竞争，多个时也不会变小）
+ */
+static inline void port_stats_max(atomic_uint *counter, uint32_t value)
+{
+    unsigned cur = atomic_load_explicit(counter, memory_order_relaxed);
+    while (value > cur &&
+           !atomic_compare_exchange_weak_explicit(counter, &cur, value, memory_order_relaxed, memory_order_relaxed)) {
+    }
+}
+
+/**
+ * @brief 以当前时刻作为读取方的起点，最大值清零
+ * @param mark 读取方的起点
+ */
+void port_stats_mark(port_stats_mark_t *mark);
+
+/**
+ * @brief 读取自起点以来的统计，并把起点移到当前时刻，最大值取走后清零（与port_stats_mark在同一核上调用）
+ * @param mark 读取方的起点
+ * @param out 输出
+ */
+void port_stats_read(port_stats_mark_t *mark, port_stats_period_t *out);
+
+/**
+ * @brief 把一个周期的统计格式化为几行文本，用于sysmon叠加层或日志
+ * @param stats 统计
+ * @param buf 输出
+ * @param buf_size buf的字节数
+ */
+void port_stats_format(const port_stats_period_t *stats, char *buf, uint32_t buf_size);
+
+#endif /* __PORT_STATS_H */
@@ -0,0 +1,91 @@
+#ifndef __RGB565_BLEND_H
+#define __RGB565_BLEND_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "lvgl.h"
+#include "src/draw/sw/blend/lv_draw_sw_blend_private.h"
+
+// LVGL软件绘制的RGB565填充和混合内核：ESP32-S3上打开LV_PORT_RGB565_BLEND_PIE时用PIE向量指令
+// （rgb565_blend_esp32s3.S，尚未在硬件上验证，默认关闭），否则直接调用LVGL的SWAR内核。
+// 主机测试定义RGB565_BLEND_USE_MODEL，改用逐条对应PIE指令的C参考模型（rgb565_blend.c），
+// 校验PIE的块调度和内核算法与LVGL逐位一致
+//
+// 本头文件同时作为LVGL的自定义汇编头文件，在menuconfig中选择：
+//   LV_USE_DRAW_SW_ASM = LV_DRAW_SW_ASM_CUSTOM
+//   LV_DRAW_SW_ASM_CUSTOM_INCLUDE = "lvgl_esp32_drivers/lvgl_port/include/rgb565_blend.h"
+// 未覆盖的钩子（RGB565图像直接复制）仍由LVGL用lv_memcpy处理
+
+#define RGB565_BLEND_PIE_BLOCK  8       // PIE内核每次处理的像素数（一个128位寄存器）
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_RGB565
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565(dsc)                       rgb565_blend_color(dsc)
+#endif
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_OPA
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_OPA(dsc)              rgb565_blend_color_with_opa(dsc)
+#endif
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_MASK
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_MASK(dsc)             rgb565_blend_color_with_mask(dsc)
+#endif
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_RGB565_MIX_MASK_OPA
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565_MIX_MASK_OPA(dsc)          rgb565_blend_color_mix_mask_opa(dsc)
+#endif
+#ifndef LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_OPA
+#define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_OPA(dsc)      rgb565_blend_image_with_opa(dsc)
+#endif
+#ifndef LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_MASK
+#define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_MASK(dsc)     rgb565_blend_image_with_mask(dsc)
+#endif
+#ifndef LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA
+#define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA(dsc)  rgb565_blend_image_mix_mask_opa(dsc)
+#endif
+
+/**
+ * @brief 初始化：使用PIE内核时用C参考模型校验一次，不一致时退回SWAR内核或LVGL的C实现
+ */
+void rgb565_blend_init(void);
+
+/**
+ * @brief 当前使用的实现名称（"pie"、"fallback"、"swar"、"c"或主机测试的"model"），用于日志和基准测试
+ */
+const char *rgb565_blend_impl_name(void);
+
+/**
+ * @brief 纯色填充
+ * @param dsc 填充描述，不透明度不小于LV_OPA_MAX，没有遮罩
+ * @return LV_RESULT_OK；PIE内核不可用或未打开时为SWAR内核的结果，未启用SWAR时为LV_RESULT_INVALID
+ */
+lv_result_t rgb565_blend_color(lv_draw_sw_blend_fill_dsc_t *dsc);
+
+/**
+ * @brief 纯色按dsc->opa混合
+ */
+lv_result_t rgb565_blend_color_with_opa(lv_draw_sw_blend_fill_dsc_t *dsc);
+
+/**
+ * @brief 纯色按dsc->mask_buf混合
+ */
+lv_result_t rgb565_blend_color_with_mask(lv_draw_sw_blend_fill_dsc_t *dsc);
+
+/**
+ * @brief 纯色按遮罩和不透明度混合
+ */
+lv_result_t rgb565_blend_color_mix_mask_opa(lv_draw_sw_blend_fill_dsc_t *dsc);
+
+/**
+ * @brief RGB565图像按dsc->opa混合（NORMAL模式）
+ * @param dsc 图像描述，源为RGB565
+ */
+lv_result_t rgb565_blend_image_with_opa(lv_draw_sw_blend_image_dsc_t *dsc);
+
+/**
+ * @brief RGB565图像按dsc->mask_buf混合
+ */
+lv_result_t rgb565_blend_image_with_mask(lv_draw_sw_blend_image_dsc_t *dsc);
+
+/**
+ * @brief RGB565图像按遮罩和不透明度混合
+ */
+lv_result_t rgb565_blend_image_mix_mask_opa(lv_draw_sw_blend_image_dsc_t *dsc);
+
+#endif /* __RGB565_BLEND_H */
@@ -0,0 +1,60 @@
+#ifndef __SHADOW_FB_H
+#define __SHADOW_FB_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "lvgl.h"
+#include "area_merge.h"
+
+// 影子帧缓冲：在PSRAM中保存面板GRAM当前内容的副本（LVGL字节序的RGB565）
+// 每块渲染结果逐行与副本比较，只发送变化的部分：每行找出首尾不同的像素，
+// 相邻的变化行按代价模型（见area_merge.h）合并为一个窗口，窗口的颜色数据原地紧凑排列在缓冲区开头
+// 副本按行记录是否有效，整行写过一次后才有效；无效行按整行变化处理
+
+/**
+ * @brief 影子帧缓冲
+ */
+typedef struct {
+    uint16_t *pixels;       // 面板内容副本，hor_res x ver_res
+    bool *row_valid;        // 每行的副本是否与面板一致
+    int16_t *span_x1;       // 比较结果：每行变化部分的起止列（相对于块），x1 > x2表示没有变化
+    int16_t *span_x2;
+    uint16_t hor_res;       // 面板宽度
+    uint16_t ver_res;       // 面板高度
+} shadow_fb_t;
+
+/**
+ * @brief 分配影子帧缓冲（优先PSRAM），所有行初始为无效
+ * @param fb 影子帧缓冲
+ * @param hor_res 面板宽度
+ * @param ver_res 面板高度
+ * @return true为成功
+ */
+bool shadow_fb_init(shadow_fb_t *fb, uint16_t hor_res, uint16_t ver_res);
+
+/**
+ * @brief 释放影子帧缓冲
+ * @param fb 影子帧缓冲
+ */
+void shadow_fb_deinit(shadow_fb_t *fb);
+
+/**
+ * @brief 使所有行无效，用于面板内容被绕过本模块改写后（如旋转、重新初始化）
+ * @param fb 影子帧缓冲
+ */
+void shadow_fb_invalidate(shadow_fb_t *fb);
+
+/**
+ * @brief 比较一块渲染结果与副本，更新副本，并把需要发送的部分原地紧凑排列
+ * @param fb 影子帧缓冲
+ * @param area 块在屏幕上的区域
+ * @param buf 块的颜色数据（LVGL字节序，行间无填充），返回时开头依次是各窗口的颜色数据
+ * @param rects 输出需要发送的窗口（屏幕坐标），自上而下互不重叠
+ * @param max_rects rects的容量，变化行分散时强制合并到最后一个窗口
+ * @param cost 代价模型，决定两段变化行之间的未变化行是否一并发送
+ * @return 窗口数，0表示整块都没有变化
+ */
+uint32_t shadow_fb_diff(shadow_fb_t *fb, const lv_area_t *area, uint8_t *buf, lv_area_t *rects,
+                        uint32_t max_rects, const area_merge_cost_t *cost);
+
+#endif /* __SHADOW_FB_H */
@@ -0,0 +1,86 @@
+#ifndef __STRIPE_TUNER_H
+#define __STRIPE_TUNER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "lvgl.h"
+
+// 条带高度自适应：局部刷新时LVGL按缓冲区大小把脏区域切成条带，渲染一块、DMA发送一块，两级流水
+// 分别拟合 渲染耗时 = a + b·行数、传输耗时 = c + d·行数（行数按整屏宽折算），
+// 对每帧的脏区域预测不同条带高度下的帧时间，取最小者
+// 条带小则流水的首尾（第一块渲染、最后一块传输）短，但每块的固定开销（窗口设置、LVGL每块的准备）次数多
+
+/**
+ * @brief 一级流水的耗时模型，按指数加权最小二乘拟合
+ */
+typedef struct {
+    float w;            // 样本权重和
+    float sx, sy;       // 加权的行数和、耗时和
+    float sxx, sxy;     // 加权的行数平方和、行数与耗时乘积和
+    float fixed_us;     // 每块固定开销（微秒）
+    float line_us;      // 每行开销（微秒）
+    bool valid;         // 已得到过斜率
+    bool spread;        // 近期样本的行数有足够差异，斜率是新拟合的
+} stripe_fit_t;
+
+/**
+ * @brief 条带高度选择器
+ */
+typedef struct {
+    stripe_fit_t render;    // 渲染：从上一块flush_cb返回（或开始渲染）到本块flush_cb
+    stripe_fit_t xfer;      // 传输：本块在总线上开始到最后一段颜色数据传完
+    uint16_t hor_res;       // 屏幕宽度，用于把像素数折算为整屏宽的行数
+    uint16_t min_lines;     // 条带高度下限
+    uint16_t max_lines;     // 条带高度上限（缓冲区行数）
+    bool explore;           // 模型未建立时在上限和一半之间交替，以得到不同行数的样本
+    uint32_t frames;        // 已选择的帧数，斜率过时后每STRIPE_TUNER_EXPLORE_FRAMES帧试一次其他高度
+} stripe_tuner_t;
+
+/**
+ * @brief 初始化
+ * @param t 选择器
+ * @param hor_res 屏幕宽度（像素）
+ * @param min_lines 条带高度下限
+ * @param max_lines 条带高度上限，即缓冲区按整屏宽能容纳的行数
+ */
+void stripe_tuner_init(stripe_tuner_t *t, uint16_t hor_res, uint16_t min_lines, uint16_t max_lines);
+
+/**
+ * @brief 记录一块的渲染耗时
+ * @param t 选择器
+ * @param px 条带像素数
+ * @param us 耗时（微秒）
+ */
+void stripe_tuner_add_render(stripe_tuner_t *t, uint32_t px, uint32_t us);
+
+/**
+ * @brief 记录一块的传输耗时
+ * @param t 选择器
+ * @param px 条带像素数
+ * @param us 耗时（微秒）
+ */
+void stripe_tuner_add_xfer(stripe_tuner_t *t, uint32_t px, uint32_t us);
+
+/**
+ * @brief 预测按给定条带高度刷新这些区域的帧时间
+ * @param t 选择器
+ * @param areas 脏区域
+ * @param cnt 区域数
+ * @param lines 条带高度（整屏宽的行数）
+ * @param stripes 输出条带数，可为NULL
+ * @return 预测的帧时间（微秒），模型未建立时为0
+ */
+float stripe_tuner_predict(const stripe_tuner_t *t, const lv_area_t *areas, size_t cnt, uint16_t lines,
+                           uint32_t *stripes);
+
+/**
+ * @brief 为一帧选择条带高度
+ * @param t 选择器
+ * @param areas 脏区域
+ * @param cnt 区域数
+ * @return 条带高度（整屏宽的行数），在[min_lines, max_lines]内
+ */
+uint16_t stripe_tuner_choose(stripe_tuner_t *t, const lv_area_t *areas, size_t cnt);
+
+#endif /* __STRIPE_TUNER_H */
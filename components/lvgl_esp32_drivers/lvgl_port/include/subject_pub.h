@@ -0,0 +1,72 @@
+#ifndef __SUBJECT_PUB_H
+#define __SUBJECT_PUB_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include "lvgl.h"
+
+// 从其他任务发布LVGL主题（lv_subject_t）的值
+// lv_subject_set_int等只能在LVGL任务中调用，且每次设置都同步通知所有观察者；
+// 遥测以200Hz到达而屏幕30Hz刷新时，观察者（改标签、重新布局）的大部分工作都是白做的。
+// 生产者任务不加LVGL锁，把最新值写入每个主题的无锁槽位（覆盖未应用的旧值）并唤醒LVGL任务；
+// LVGL任务在下一次刷新开始时（LV_EVENT_REFR_START）统一应用，值与主题当前值相同时不通知，
+// 因此每个主题的观察者每帧最多运行一次，且刷新间隔仍由显示的刷新周期决定。
+// 支持整数、指针和颜色类型的主题；字符串由观察者按数值格式化
+
+/**
+ * @brief 一个主题的发布槽位，由调用者持有
+ */
+typedef struct subject_pub_t {
+    lv_subject_t *subject;          // 对应的主题
+    _Atomic uintptr_t value;        // 最新发布的值（整数、指针或颜色的32位值）
+    atomic_bool dirty;              // 是否有尚未应用的值
+    struct subject_pub_t *next;     // 已登记的槽位链表，只在LVGL任务中访问
+} subject_pub_t;
+
+/**
+ * @brief 为主题建立发布槽位并登记（LVGL任务中或持有lv_lock时调用）
+ * @param pub 发布槽位，登记期间必须保持有效
+ * @param subject 已初始化的主题
+ */
+void subject_pub_init(subject_pub_t *pub, lv_subject_t *subject);
+
+/**
+ * @brief 取消登记，未应用的值丢弃（LVGL任务中或持有lv_lock时调用）
+ * @param pub 发布槽位
+ */
+void subject_pub_deinit(subject_pub_t *pub);
+
+/**
+ * @brief 发布整数值（任意任务，不加锁、不阻塞）
+ * @param pub 整数主题的发布槽位
+ * @param value 新值
+ */
+void subject_pub_int(subject_pub_t *pub, int32_t value);
+
+/**
+ * @brief 发布指针值（任意任务），指向的数据在应用前后都必须保持有效
+ * @param pub 指针主题的发布槽位
+ * @param ptr 新值
+ */
+void subject_pub_pointer(subject_pub_t *pub, void *ptr);
+
+/**
+ * @brief 发布颜色值（任意任务）
+ * @param pub 颜色主题的发布槽位
+ * @param color 新值
+ */
+void subject_pub_color(subject_pub_t *pub, lv_color_t color);
+
+/**
+ * @brief 是否有尚未应用的值
+ */
+bool subject_pub_pending(void);
+
+/**
+ * @brief 应用所有未应用的值（LVGL任务中或持有lv_lock时调用），值未变的主题不通知观察者
+ * @return 通知了观察者的主题数
+ */
+uint32_t subject_pub_apply(void);
+
+#endif /* __SUBJECT_PUB_H */
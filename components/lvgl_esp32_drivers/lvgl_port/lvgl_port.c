@@ -1,32 +1,367 @@
 #include "lvgl_port.h"
 #include <stdint.h>
+#include <stdatomic.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "freertos/semphr.h"
 #include "esp_log.h"
 #include "esp_timer.h"
+#include "esp_cpu.h"
+#include "stripe_tuner.h"
+#include "area_merge.h"
+#include "shadow_fb.h"
+#include "subject_pub.h"
+#include "rgb565_blend.h"
+#include "src/display/lv_display_private.h"
+#include "src/misc/lv_profiler_builtin_private.h"
+#include "src/core/lv_global.h"
 
 #define TAG "LVGL_PORT" // 日志标签
 
+#define STRIPE_RING_SIZE    4   // 记录最近几块的排队和传完时刻，至少覆盖在途的两块和再前一块
+
+// 一块拆出的窗口全部排入SPI事务环，环的容量按DISP_SPI_WINDOWS_PER_FLUSH计算
+_Static_assert(LV_PORT_SHADOW_RECTS_MAX <= DISP_SPI_WINDOWS_PER_FLUSH,
+               "LV_PORT_SHADOW_RECTS_MAX超过了SPI事务环按块预留的窗口数");
+
+/**
+ * @brief 一块颜色数据的传输记录
+ */
+typedef struct {
+    int64_t queued_us;  // flush_cb开始排队的时刻
+    int64_t done_us;    // 最后一段颜色数据传完的时刻（中断中写入）
+    uint32_t px;        // 像素数
+} stripe_rec_t;
+
+/**
+ * @brief 一帧的条带记录
+ */
+typedef struct {
+    int64_t start_us;       // 开始渲染的时刻
+    uint32_t first_seq;     // 第一块的序号
+    uint32_t last_seq;      // 最后一块的序号
+    uint16_t lines;         // 条带高度
+    uint32_t predicted_us;  // 预测的帧时间
+    bool pending;           // 已渲染完，等最后一块传完后计入统计
+} stripe_frame_t;
+
 static lv_display_t *disp_drv; // 显示驱动实例
+static SemaphoreHandle_t flush_done_sem = NULL; // 颜色数据DMA传输完成信号
+static bool flush_in_flight = false;            // 上一块颜色数据是否仍在传输
+static lv_indev_t *touch_indev;                 // 触摸输入设备
+static TaskHandle_t lvgl_task_handle = NULL;    // 运行LVGL的任务，lv_port_sleep首次调用时记录
+static bool in_handler = false;                 // 是否正在lv_port_handler中
+static void (*trace_write_cb)(const void *buf, uint32_t size); // 性能跟踪的输出，NULL为不跟踪
+
+static lv_draw_buf_t draw_buf1, draw_buf2;      // 显示缓冲区，data_size随条带高度调整
+static uint32_t draw_buf_stride;                // 整屏宽一行的字节数
+static stripe_tuner_t stripe_tuner;             // 条带高度选择器
+static bool stripe_adaptive = LV_PORT_STRIPE_ADAPTIVE; // 是否启用条带高度自适应
+static stripe_rec_t stripe_ring[STRIPE_RING_SIZE]; // 最近几块的传输记录，按序号取模
+static uint32_t stripe_seq;                     // 已排队的块数
+static atomic_uint stripe_done_seq;             // 已传完的块数，只由传输完成中断递增
+static int64_t render_start_us;                 // 当前块开始渲染的时刻
+static lv_port_stripe_stats_t stripe_stats;     // 对外的统计
+static stripe_frame_t render_frame;             // 正在渲染的帧
+static stripe_frame_t xfer_frame;               // 已渲染完、最后一块可能仍在传输的帧
+static shadow_fb_t shadow_fb;                   // 面板内容副本，pixels为NULL表示未启用比较
+static lv_display_rotation_t panel_rotation = LV_DISPLAY_ROTATION_0; // 面板当前的扫描方向
+static lv_port_boot_stats_t boot_stats;         // 启动各阶段的时刻
+static lv_timer_t *boot_timer;                  // 推进面板上电时序，显示开启后删除
+static bool boot_frame_queued;                  // 第一帧是否已全部排队
+static uint32_t boot_frame_seq;                 // 第一帧最后一块的序号
+
+// 影子帧缓冲比较中合并变化行的代价：窗口设置的开销和每像素的SPI线上时间
+static const area_merge_cost_t shadow_cost = {
+    .window_ns = LV_PORT_SHADOW_WINDOW_US * 1000,
+    .px_ns = (uint32_t)(16ULL * 1000000000ULL / LCD_SPI_CLOCK_HZ),
+};
 
 // 函数声明
 static void disp_flush(lv_display_t *disp_drv, const lv_area_t *area, unsigned char *color_p);
+static void disp_flush_done(void *user_ctx);
 static void lv_disp_init(void);
 static void indev_read(lv_indev_t *indev_drv, lv_indev_data_t *data);
+static void indev_ready(void *user_ctx);
 static void lv_indev_init(void);
-static void lv_timer_cb(void *arg);
-static void lv_tick_init(void);
+static uint32_t tick_get_cb(void);
+static void timer_resume_cb(void *data);
+static void stripe_event_cb(lv_event_t *e);
+static void stripe_xfer_done(uint32_t seq);
+static void stripe_frame_finish(int64_t done_us);
+static uint32_t merge_areas_cb(lv_display_t *disp, lv_area_t *areas, uint32_t cnt, uint32_t max_cnt);
+static void rotation_event_cb(lv_event_t *e);
+static void boot_timer_cb(lv_timer_t *timer);
+static void refr_start_cb(lv_event_t *e);
+static uint32_t trace_tick_get_cb(void);
+static int trace_tid_get_cb(void);
+static int trace_cpu_get_cb(void);
+#if LV_USE_PROFILER && LV_USE_PROFILER_BUILTIN
+static void trace_init(void (*write_cb)(const void *buf, uint32_t size));
+#endif
+#if LV_USE_SYSMON
+static void perf_stats_format_cb(char *buf, uint32_t buf_size, void *user_data);
+#endif
 
 /**
  * @brief 显示刷新函数（LVGL回调）
  * @param disp_drv 显示驱动实例
  * @param area 刷新区域
  * @param color_p 颜色数据指针
+ *
+ * 窗口设置和颜色数据排入SPI队列后，只等待上一块的DMA结束：
+ * 本块紧跟其后在总线上传输，而LVGL接下来要渲染的正是上一块的缓冲区，
+ * 此时已可安全复用，因此直接通知LVGL刷新就绪。
+ * 启用影子帧缓冲比较时本块可能拆成几个窗口或整块不发送，比较的耗时计入渲染。
  */
 static void disp_flush(lv_display_t *disp_drv, const lv_area_t *area, unsigned char *color_p)
 {
-    ili9341_flush(disp_drv, area, color_p);
-    lv_disp_flush_ready(disp_drv);
+    LV_PROFILER_BEGIN;
+    uint32_t area_px = (uint32_t)lv_area_get_size(area);
+    lv_area_t rects[LV_PORT_SHADOW_RECTS_MAX];
+    uint32_t rect_cnt = 1;
+    uint32_t px = area_px;
+
+    if (shadow_fb.pixels != NULL) {
+        rect_cnt = shadow_fb_diff(&shadow_fb, area, color_p, rects, LV_PORT_SHADOW_RECTS_MAX, &shadow_cost);
+        px = 0;
+        for (uint32_t i = 0; i < rect_cnt; i++) px += (uint32_t)lv_area_get_size(&rects[i]);
+    } else {
+        rects[0] = *area;
+    }
+    stripe_stats.bytes_sent += (uint64_t)px * sizeof(uint16_t);
+    stripe_stats.bytes_skipped += (uint64_t)(area_px - px) * sizeof(uint16_t);
+    stripe_stats.windows += rect_cnt;
+
+    int64_t now = esp_timer_get_time();
+    stripe_tuner_add_render(&stripe_tuner, area_px, (uint32_t)(now - render_start_us));
+
+    if (rect_cnt > 0) {
+        stripe_rec_t *rec = &stripe_ring[stripe_seq % STRIPE_RING_SIZE];
+        if (boot_stats.first_flush_us == 0) boot_stats.first_flush_us = now;
+        rec->queued_us = now;
+        rec->px = px;
+
+        // 各窗口的颜色数据在缓冲区中依次紧凑排列
+        uint8_t *data = color_p;
+        for (uint32_t i = 0; i < rect_cnt; i++) {
+            ili9341_flush_window(disp_drv, &rects[i], data, i == rect_cnt - 1);
+            data += lv_area_get_size(&rects[i]) * sizeof(uint16_t);
+        }
+    }
+
+    if (flush_in_flight) {
+        LV_PROFILER_BEGIN_TAG("disp_flush_wait");
+        xSemaphoreTake(flush_done_sem, portMAX_DELAY);
+        LV_PROFILER_END_TAG("disp_flush_wait");
+        stripe_xfer_done(stripe_seq - 1);
+    }
+    // 整块没有变化时没有排队任何传输，不占用序号
+    flush_in_flight = rect_cnt > 0;
+    if (flush_in_flight) stripe_seq++;
+    lv_display_flush_ready(disp_drv);
+    render_start_us = esp_timer_get_time();
+    LV_PROFILER_END;
+}
+
+/**
+ * @brief 颜色数据传输完成通知（disp_spi post_cb中调用，中断上下文）
+ * @param user_ctx 未使用
+ */
+static void IRAM_ATTR disp_flush_done(void *user_ctx)
+{
+    uint32_t seq = atomic_load_explicit(&stripe_done_seq, memory_order_relaxed);
+    stripe_ring[seq % STRIPE_RING_SIZE].done_us = esp_timer_get_time();
+    atomic_store_explicit(&stripe_done_seq, seq + 1, memory_order_release);
+
+    BaseType_t woken = pdFALSE;
+    xSemaphoreGiveFromISR(flush_done_sem, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+/**
+ * @brief 一块传完后记录传输耗时（LVGL任务，已确认该块传完）
+ * @param seq 块序号
+ *
+ * 传输从排队和上一块传完两者中较晚的时刻算起，不计在总线上排队等待的时间。
+ */
+static void stripe_xfer_done(uint32_t seq)
+{
+    const stripe_rec_t *rec = &stripe_ring[seq % STRIPE_RING_SIZE];
+    int64_t start_us = rec->queued_us;
+    if (seq > 0) {
+        int64_t prev_done_us = stripe_ring[(seq - 1) % STRIPE_RING_SIZE].done_us;
+        if (prev_done_us > start_us) start_us = prev_done_us;
+    }
+    stripe_tuner_add_xfer(&stripe_tuner, rec->px, (uint32_t)(rec->done_us - start_us));
+
+    // 刷新就绪延迟：LVGL交出缓冲区到DMA读完、缓冲区可以复用
+    uint32_t latency_us = (uint32_t)(rec->done_us - rec->queued_us);
+    port_stats_add(&port_stats.flushes, 1);
+    port_stats_add(&port_stats.flush_latency_us, latency_us);
+    port_stats_max(&port_stats.flush_latency_max_us, latency_us);
+
+    if (boot_frame_queued && seq == boot_frame_seq && boot_stats.first_frame_us == 0) {
+        boot_stats.first_frame_us = rec->done_us;
+    }
+
+    if (xfer_frame.pending && seq == xfer_frame.last_seq) {
+        stripe_frame_finish(rec->done_us);
+    }
+}
+
+/**
+ * @brief 一帧的最后一块传完，计入统计
+ * @param done_us 最后一块传完的时刻
+ */
+static void stripe_frame_finish(int64_t done_us)
+{
+    uint32_t frame_us = (uint32_t)(done_us - xfer_frame.start_us);
+    uint16_t lines = xfer_frame.lines;
+
+    xfer_frame.pending = false;
+    stripe_stats.stripe_lines_min = stripe_stats.frames == 0 || lines < stripe_stats.stripe_lines_min ?
+                                    lines : stripe_stats.stripe_lines_min;
+    stripe_stats.stripe_lines_max = lines > stripe_stats.stripe_lines_max ? lines : stripe_stats.stripe_lines_max;
+    stripe_stats.frames++;
+    stripe_stats.stripe_lines = lines;
+    stripe_stats.stripes = xfer_frame.last_seq - xfer_frame.first_seq + 1;
+    stripe_stats.frame_us = frame_us;
+    if (frame_us > stripe_stats.frame_us_max) stripe_stats.frame_us_max = frame_us;
+    stripe_stats.frame_us_total += frame_us;
+    stripe_stats.predicted_us = xfer_frame.predicted_us;
+}
+
+/**
+ * @brief 渲染开始/结束（LVGL显示事件）
+ * @param e 事件
+ *
+ * 开始渲染时脏区域已合并，按这些区域选择条带高度，通过缓冲区的data_size限制
+ * lv_refr.c中get_max_row每块的行数；缓冲区本身不变，上一块仍可在传输中。
+ */
+static void stripe_event_cb(lv_event_t *e)
+{
+    lv_display_t *disp = lv_event_get_target(e);
+
+    if (lv_event_get_code(e) == LV_EVENT_RENDER_READY) {
+        // 上一帧的最后一块在本帧第一次flush_cb时已确认传完并计入统计，xfer_frame可以覆盖
+        render_frame.last_seq = stripe_seq - 1;
+        render_frame.pending = stripe_seq != render_frame.first_seq;
+        xfer_frame = render_frame;
+        if (!boot_frame_queued && render_frame.pending) {
+            // 第一帧已全部排队，传完后即可开显示，不必等定时器的下一个周期
+            boot_frame_queued = true;
+            boot_frame_seq = render_frame.last_seq;
+            if (boot_timer != NULL) lv_timer_ready(boot_timer);
+        }
+        return;
+    }
+
+    lv_area_t areas[LV_INV_BUF_SIZE];
+    size_t cnt = 0;
+    for (uint32_t i = 0; i < disp->inv_p; i++) {
+        if (!disp->inv_area_joined[i]) areas[cnt++] = disp->inv_areas[i];
+    }
+
+    uint16_t lines = stripe_tuner.max_lines;
+    if (stripe_adaptive) {
+        lines = stripe_tuner_choose(&stripe_tuner, areas, cnt);
+    }
+    draw_buf1.data_size = lines * draw_buf_stride;
+    draw_buf2.data_size = lines * draw_buf_stride;
+
+    render_frame.start_us = esp_timer_get_time();
+    render_frame.first_seq = stripe_seq;
+    render_frame.lines = lines;
+    render_frame.predicted_us = (uint32_t)stripe_tuner_predict(&stripe_tuner, areas, cnt, lines, NULL);
+    render_start_us = render_frame.start_us;
+}
+
+/**
+ * @brief 合并脏区域（LVGL回调，刷新前和区域缓冲区满时调用）
+ * @param disp 显示驱动实例
+ * @param areas 区域数组，原地合并
+ * @param cnt 区域数
+ * @param max_cnt 结果最多的区域数
+ * @return 合并后的区域数
+ *
+ * 渲染和传输两级流水，多一个区域或多一些像素的代价取决于较慢的一级，两项分别取两级中的较大者。
+ */
+static uint32_t merge_areas_cb(lv_display_t *disp, lv_area_t *areas, uint32_t cnt, uint32_t max_cnt)
+{
+    area_merge_cost_t cost = {
+        .window_ns = LV_PORT_AREA_FIXED_US * 1000,
+        .px_ns = (uint32_t)(16ULL * 1000000000ULL / LCD_SPI_CLOCK_HZ),
+    };
+
+    const stripe_fit_t *render = &stripe_tuner.render, *xfer = &stripe_tuner.xfer;
+    if (render->valid && xfer->valid) {
+        float fixed_us = render->fixed_us > xfer->fixed_us ? render->fixed_us : xfer->fixed_us;
+        float line_us = render->line_us > xfer->line_us ? render->line_us : xfer->line_us;
+        cost.window_ns = (uint32_t)(fixed_us * 1000.0f);
+        cost.px_ns = (uint32_t)(line_us * 1000.0f / LV_HOR_RES_MAX) + 1;
+    }
+    return area_merge(areas, cnt, max_cnt, &cost);
+}
+
+/**
+ * @brief 显示分辨率改变（LVGL显示事件，lv_display_set_rotation中发出）
+ * @param e 事件
+ *
+ * 旋转由面板的扫描方向完成：LVGL按旋转后的分辨率渲染，flush_cb收到的区域直接写入面板，
+ * 每帧没有额外开销。LVGL随后整屏重绘；影子帧缓冲按新的宽高重新分配，全部行无效。
+ * 触摸坐标仍按未旋转的屏幕给出，由LVGL换算（见xpt2046.h）。
+ */
+static void rotation_event_cb(lv_event_t *e)
+{
+    lv_display_rotation_t rotation = lv_display_get_rotation(lv_event_get_target(e));
+    if (rotation == panel_rotation) return;
+
+    ili9341_set_rotation(rotation);
+    panel_rotation = rotation;
+    if (shadow_fb.pixels != NULL) {
+        shadow_fb_deinit(&shadow_fb);
+        lv_port_set_shadow_diff(true);
+    }
+}
+
+/**
+ * @brief 刷新开始（LVGL显示事件）：应用其他任务发布的主题值，观察者造成的失效计入本帧
+ * @param e 事件
+ */
+static void refr_start_cb(lv_event_t *e)
+{
+    subject_pub_apply();
+}
+
+/**
+ * @brief 推进面板上电时序（LVGL定时器）
+ * @param timer 定时器
+ *
+ * 按ili9341_power_on_step返回的等待时间调整周期；开显示要等第一帧传完，传完前按查询间隔重试。
+ */
+static void boot_timer_cb(lv_timer_t *timer)
+{
+    if (boot_frame_queued && boot_stats.first_frame_us == 0 &&
+        atomic_load_explicit(&stripe_done_seq, memory_order_acquire) > boot_frame_seq) {
+        // 之后的块还没有确认传完，记录仍在环形缓冲中
+        boot_stats.first_frame_us = stripe_ring[boot_frame_seq % STRIPE_RING_SIZE].done_us;
+    }
+
+    uint32_t wait_us = ili9341_power_on_step(boot_stats.first_frame_us != 0);
+    if (wait_us > 0) {
+        lv_timer_set_period(timer, (wait_us + 999) / 1000);
+        return;
+    }
+
+    boot_stats.display_on_us = esp_timer_get_time();
+    lv_timer_delete(timer);
+    boot_timer = NULL;
+    ESP_LOGI(TAG, "启动：复位后%lld ms初始化完成，%lld ms第一块，%lld ms第一帧传完，%lld ms开显示",
+             (long long)(boot_stats.init_done_us - boot_stats.panel_reset_us) / 1000,
+             (long long)(boot_stats.first_flush_us - boot_stats.panel_reset_us) / 1000,
+             (long long)(boot_stats.first_frame_us - boot_stats.panel_reset_us) / 1000,
+             (long long)(boot_stats.display_on_us - boot_stats.panel_reset_us) / 1000);
 }
 
 /**
@@ -34,13 +369,40 @@ static void disp_flush(lv_display_t *disp_drv, const lv_area_t *area, unsigned c
  */
 static void lv_disp_init(void)
 {
-    static lv_color_t disp_buf1[DISP_BUF_SIZE];    	//创建第一个10行的显示缓冲区
-	static lv_color_t disp_buf2[DISP_BUF_SIZE];    	//创建第二个10行的显示缓冲区
+    // 缓冲区按RGB565（每像素2字节）分配，lv_display_set_buffers的大小参数单位为字节
+    static uint8_t disp_buf1[DISP_BUF_SIZE * 2] __attribute__((aligned(LV_DRAW_BUF_ALIGN)));   //第一个40行的显示缓冲区
+    static uint8_t disp_buf2[DISP_BUF_SIZE * 2] __attribute__((aligned(LV_DRAW_BUF_ALIGN)));   //第二个40行的显示缓冲区
+
+    // 最多两块颜色数据同时在途（上一块和刚排队的一块），两次完成通知都不能丢
+    flush_done_sem = xSemaphoreCreateCounting(2, 0);
+    if (flush_done_sem == NULL) {
+        ESP_LOGE(TAG, "刷新完成信号量创建失败");
+        return;
+    }
+    disp_spi_set_flush_done_cb(disp_flush_done, NULL);
 
     disp_drv = lv_display_create(LV_HOR_RES_MAX, LV_VER_RES_MAX);
 
     lv_display_set_flush_cb(disp_drv, disp_flush);
-    lv_display_set_buffers(disp_drv, disp_buf1, disp_buf2, DISP_BUF_SIZE, LV_DISPLAY_RENDER_MODE_PARTIAL);
+
+    // 与lv_display_set_buffers相同，只是缓冲区描述由这里持有，以便每帧调整可用大小
+    draw_buf_stride = lv_draw_buf_width_to_stride(LV_HOR_RES_MAX, LV_COLOR_FORMAT_RGB565);
+    uint32_t buf_lines = sizeof(disp_buf1) / draw_buf_stride;
+    lv_draw_buf_init(&draw_buf1, LV_HOR_RES_MAX, buf_lines, LV_COLOR_FORMAT_RGB565, draw_buf_stride,
+                     disp_buf1, sizeof(disp_buf1));
+    lv_draw_buf_init(&draw_buf2, LV_HOR_RES_MAX, buf_lines, LV_COLOR_FORMAT_RGB565, draw_buf_stride,
+                     disp_buf2, sizeof(disp_buf2));
+    lv_display_set_draw_buffers(disp_drv, &draw_buf1, &draw_buf2);
+    lv_display_set_render_mode(disp_drv, LV_DISPLAY_RENDER_MODE_PARTIAL);
+
+    stripe_tuner_init(&stripe_tuner, LV_HOR_RES_MAX, LV_PORT_STRIPE_MIN_LINES, buf_lines);
+    lv_display_add_event_cb(disp_drv, stripe_event_cb, LV_EVENT_RENDER_START, NULL);
+    lv_display_add_event_cb(disp_drv, stripe_event_cb, LV_EVENT_RENDER_READY, NULL);
+    lv_display_add_event_cb(disp_drv, rotation_event_cb, LV_EVENT_RESOLUTION_CHANGED, NULL);
+    lv_display_add_event_cb(disp_drv, refr_start_cb, LV_EVENT_REFR_START, NULL);
+    lv_port_set_area_merge(true);
+    lv_port_set_shadow_diff(LV_PORT_SHADOW_DIFF);
+    boot_timer = lv_timer_create(boot_timer_cb, ILI9341_RESET_SLPOUT_US / 1000, NULL);
     ESP_LOGI(TAG, "显示驱动初始化完成");
 }
 
@@ -54,69 +416,378 @@ static void IRAM_ATTR indev_read(lv_indev_t *indev_drv, lv_indev_data_t *data)
     xpt2046_read(indev_drv, data);
 }
 
+/**
+ * @brief 触摸采样任务写入新点后的通知（采样任务上下文）
+ * @param user_ctx 未使用
+ */
+static void indev_ready(void *user_ctx)
+{
+    lv_port_wake();
+}
+
 /**
  * @brief 初始化输入设备（触摸屏）
  */
 static void lv_indev_init(void)
 {
-    lv_indev_t *indev = lv_indev_create();
-    lv_indev_set_type(indev, LV_INDEV_TYPE_POINTER);
-    lv_indev_set_read_cb(indev, indev_read);
+    touch_indev = lv_indev_create();
+    lv_indev_set_type(touch_indev, LV_INDEV_TYPE_POINTER);
+    lv_indev_set_read_cb(touch_indev, indev_read);
+
+    // 采样在xpt2046任务中完成，新点到达时唤醒LVGL任务，由lv_port_handler逐个交给LVGL
+    lv_indev_set_mode(touch_indev, LV_INDEV_MODE_EVENT);
+    xpt2046_set_ready_cb(indev_ready, NULL);
     ESP_LOGI(TAG, "触摸输入设备初始化完成");
 }
 
 /**
- * @brief LVGL定时器回调函数
- * @param arg 参数（tick间隔）
+ * @brief LVGL时基：直接读取esp_timer，不需要周期性的lv_tick_inc
+ * @return 毫秒数
  */
-static void lv_timer_cb(void *arg)
+static uint32_t tick_get_cb(void)
 {
-    uint32_t tick_interval = *((uint32_t*)arg);
-    lv_tick_inc(tick_interval);
+    return (uint32_t)(esp_timer_get_time() / 1000);
 }
 
 /**
- * @brief 初始化LVGL定时器
+ * @brief 性能跟踪的时基：esp_timer微秒的低32位
  */
-static void lv_tick_init(void)
+static uint32_t trace_tick_get_cb(void)
 {
-    static uint32_t tick_interval = 5; // tick间隔，单位ms
-    const esp_timer_create_args_t timer_args = {
-        .arg = &tick_interval,
-        .callback = lv_timer_cb,
-        .name = "lvgl_tick",
-        .dispatch_method = ESP_TIMER_TASK,
-        .skip_unhandled_events = true,
-    };
+    return (uint32_t)esp_timer_get_time();
+}
 
-    esp_timer_handle_t timer_handle;
-    esp_err_t ret = esp_timer_create(&timer_args, &timer_handle);
-    if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "定时器创建失败: %s", esp_err_to_name(ret));
-        return;
+/**
+ * @brief 性能跟踪的线程号：FreeRTOS任务句柄
+ */
+static int trace_tid_get_cb(void)
+{
+    return (int)(uintptr_t)xTaskGetCurrentTaskHandle();
+}
+
+/**
+ * @brief 性能跟踪的核号
+ */
+static int trace_cpu_get_cb(void)
+{
+    return esp_cpu_get_core_id();
+}
+
+#if LV_USE_PROFILER && LV_USE_PROFILER_BUILTIN
+/**
+ * @brief 按移植层的缓冲区大小和时基初始化分析器；已初始化时只重新开始输出
+ * @param write_cb 二进制流的输出
+ */
+static void trace_init(void (*write_cb)(const void *buf, uint32_t size))
+{
+    lv_profiler_builtin_config_t config;
+    lv_profiler_builtin_config_init(&config);
+    config.buf_size = LV_PORT_TRACE_BUF_SIZE;
+    config.tick_per_sec = 1000000;
+    config.tick_get_cb = trace_tick_get_cb;
+    config.tid_get_cb = trace_tid_get_cb;
+    config.cpu_get_cb = trace_cpu_get_cb;
+    config.flush_cb = NULL;
+    config.flush_bin_cb = write_cb;
+    lv_profiler_builtin_init(&config);
+}
+#endif
+
+/**
+ * @brief LVGL定时器被创建或恢复时调用（持有LVGL锁的任意任务）
+ * @param data 未使用
+ *
+ * LVGL任务在lv_port_handler内部的恢复会计入lv_timer_handler返回的等待时间，
+ * 其余情况（两次处理之间，或其他任务在lv_lock下操作）都需要唤醒。
+ */
+static void timer_resume_cb(void *data)
+{
+    if (!in_handler || xTaskGetCurrentTaskHandle() != lvgl_task_handle) {
+        lv_port_wake();
     }
+}
 
-    ret = esp_timer_start_periodic(timer_handle, tick_interval * 1000); // 转换为微秒
-    if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "定时器启动失败: %s", esp_err_to_name(ret));
-        return;
+#if LV_USE_OS == LV_OS_FREERTOS
+/**
+ * @brief 绘制线程入口，与lv_freertos.c中的prvRunThread相同
+ */
+static void draw_thread_entry(void *arg)
+{
+    lv_thread_t *thread = arg;
+    thread->pvStartRoutine(thread->pTaskArg);
+    vTaskDelete(NULL);
+}
+
+/**
+ * @brief 替换LVGL的lv_thread_init（链接时--wrap），把绘制线程依次绑定到各个核
+ *
+ * LVGL的FreeRTOS适配层用xTaskCreate创建线程，无法指定核；9.2中只有软件绘制单元
+ * 会创建线程，因此这里按创建顺序从LV_PORT_DRAW_CORE开始轮流分配。
+ */
+lv_result_t __wrap_lv_thread_init(lv_thread_t *thread, lv_thread_prio_t prio, void (*callback)(void *),
+                                  size_t stack_size, void *user_data)
+{
+    static uint32_t thread_cnt = 0;
+    BaseType_t core = (LV_PORT_DRAW_CORE + thread_cnt) % portNUM_PROCESSORS;
+
+    thread->pTaskArg = user_data;
+    thread->pvStartRoutine = callback;
+    if (xTaskCreatePinnedToCore(draw_thread_entry, "lv_draw", stack_size / sizeof(StackType_t), thread,
+                                tskIDLE_PRIORITY + prio, &thread->xTaskHandle, core) != pdPASS) {
+        ESP_LOGE(TAG, "绘制线程创建失败");
+        return LV_RESULT_INVALID;
+    }
+    ESP_LOGI(TAG, "绘制线程%lu绑定到核%d", (unsigned long)thread_cnt, (int)core);
+    thread_cnt++;
+    return LV_RESULT_OK;
+}
+#endif
+
+/**
+ * @brief 处理一次LVGL：把积压的触摸点逐个交给LVGL，然后运行到期的定时器
+ */
+uint32_t lv_port_handler(void)
+{
+    in_handler = true;
+
+    // 每个采样点单独调用一次lv_indev_read，按下/拖动/松开的时序不会被合并
+    // lv_timer_handler自己加锁，而FreeRTOS适配层的锁不可重入，两段分开加锁
+    uint32_t pending = xpt2046_pending();
+    if (pending > 0) {
+        lv_lock();
+        while (pending-- > 0) {
+            lv_indev_read(touch_indev);
+        }
+        lv_unlock();
+    }
+
+    // 有新发布的主题值：恢复暂停的刷新定时器，距上次刷新满一个周期时在刷新开始时应用，
+    // 高频发布合并为每帧一次
+    if (subject_pub_pending()) {
+        lv_lock();
+        lv_timer_resume(lv_display_get_refr_timer(disp_drv));
+        lv_unlock();
+    }
+
+    uint32_t time_until_next = lv_timer_handler();
+    in_handler = false;
+
+#if LV_USE_PROFILER && LV_USE_PROFILER_BUILTIN
+    // 记录时各线程只写自己的环，输出在这里集中进行，不影响被测的渲染耗时
+    if (trace_write_cb) lv_profiler_builtin_flush();
+#endif
+    return time_until_next;
+}
+
+/**
+ * @brief 睡眠到超时或被唤醒
+ */
+void lv_port_sleep(uint32_t timeout_ms)
+{
+    lvgl_task_handle = xTaskGetCurrentTaskHandle();
+
+    if (timeout_ms > LV_PORT_IDLE_SLEEP_MS) timeout_ms = LV_PORT_IDLE_SLEEP_MS;
+    // 向上取整到节拍，避免节拍大于1ms时0节拍的忙等
+    TickType_t ticks = (timeout_ms + portTICK_PERIOD_MS - 1) / portTICK_PERIOD_MS;
+    ulTaskNotifyTake(pdTRUE, ticks);
+}
+
+/**
+ * @brief LVGL任务主循环
+ */
+void lv_port_task(void *arg)
+{
+    for (;;) {
+        lv_port_sleep(lv_port_handler());
+    }
+}
+
+/**
+ * @brief 唤醒LVGL任务（任务上下文）
+ */
+void lv_port_wake(void)
+{
+    TaskHandle_t task = lvgl_task_handle;
+    if (task != NULL) {
+        xTaskNotifyGive(task);
+    }
+}
+
+/**
+ * @brief 唤醒LVGL任务（中断上下文）
+ */
+void IRAM_ATTR lv_port_wake_from_isr(BaseType_t *woken)
+{
+    TaskHandle_t task = lvgl_task_handle;
+    if (task != NULL) {
+        vTaskNotifyGiveFromISR(task, woken);
+    }
+}
+
+/**
+ * @brief 启用或关闭条带高度自适应
+ */
+void lv_port_set_adaptive_stripe(bool enable)
+{
+    stripe_adaptive = enable;
+}
+
+/**
+ * @brief 启用或关闭按代价的脏区域合并
+ */
+void lv_port_set_area_merge(bool enable)
+{
+    lv_display_set_merge_areas_cb(disp_drv, enable ? merge_areas_cb : NULL);
+}
+
+/**
+ * @brief 启用或关闭影子帧缓冲比较
+ */
+bool lv_port_set_shadow_diff(bool enable)
+{
+    if (!enable) {
+        shadow_fb_deinit(&shadow_fb);
+        return true;
+    }
+    if (shadow_fb.pixels == NULL &&
+        !shadow_fb_init(&shadow_fb, lv_display_get_horizontal_resolution(disp_drv),
+                        lv_display_get_vertical_resolution(disp_drv))) {
+        return false;
     }
-    ESP_LOGI(TAG, "LVGL定时器初始化完成，间隔: %lu ms", (unsigned long)tick_interval);
+    // 副本的各行在整行发送一次后才有效，整屏重绘使其尽快全部有效
+    shadow_fb_invalidate(&shadow_fb);
+    lv_obj_invalidate(lv_display_get_screen_active(disp_drv));
+    return true;
+}
+
+/**
+ * @brief 读取条带和帧时间统计
+ */
+void lv_port_get_stripe_stats(lv_port_stripe_stats_t *stats)
+{
+    // 最后一块已传完但还没有下一次flush_cb来确认时，在这里计入
+    if (xfer_frame.pending &&
+        atomic_load_explicit(&stripe_done_seq, memory_order_acquire) > xfer_frame.last_seq) {
+        stripe_frame_finish(stripe_ring[xfer_frame.last_seq % STRIPE_RING_SIZE].done_us);
+    }
+
+    *stats = stripe_stats;
+    stats->adaptive = stripe_adaptive;
+    stats->render_fixed_us = stripe_tuner.render.fixed_us;
+    stats->render_line_us = stripe_tuner.render.line_us;
+    stats->xfer_fixed_us = stripe_tuner.xfer.fixed_us;
+    stats->xfer_line_us = stripe_tuner.xfer.line_us;
+}
+
+/**
+ * @brief 清零帧统计
+ */
+void lv_port_reset_stripe_stats(void)
+{
+    stripe_stats = (lv_port_stripe_stats_t){0};
+}
+
+/**
+ * @brief 读取启动各阶段的时刻
+ */
+void lv_port_get_boot_stats(lv_port_boot_stats_t *stats)
+{
+    *stats = boot_stats;
+}
+
+/**
+ * @brief 设置性能跟踪的输出
+ */
+bool lv_port_set_trace_output(void (*write_cb)(const void *buf, uint32_t size))
+{
+#if LV_USE_PROFILER && LV_USE_PROFILER_BUILTIN
+    if (write_cb == NULL) {
+        trace_write_cb = NULL;
+        lv_profiler_builtin_set_enable(false);
+        return true;
+    }
+
+    // 第一次分配分析器，之后只重新开始输出：丢弃之前的记录，输出流从头部开始。
+    // 触摸任务等不持有lv_lock的线程此时可能仍在记录，分析器的缓冲区分配后不再释放
+    trace_init(write_cb);
+    if (LV_GLOBAL_DEFAULT()->profiler_context == NULL) {
+        ESP_LOGE(TAG, "分析器缓冲区分配失败，不能跟踪");
+        trace_write_cb = NULL;
+        return false;
+    }
+    trace_write_cb = write_cb;
+    return true;
+#else
+    ESP_LOGW(TAG, "未启用LVGL内置分析器（LV_USE_PROFILER），不能跟踪");
+    return false;
+#endif
+}
+
+#if LV_USE_SYSMON
+/**
+ * @brief 格式化一个sysmon周期的移植层计数器（sysmon定时器，LVGL任务）
+ * @param user_data 本叠加层的读取起点
+ */
+static void perf_stats_format_cb(char *buf, uint32_t buf_size, void *user_data)
+{
+    port_stats_period_t stats;
+    port_stats_read(user_data, &stats);
+    port_stats_format(&stats, buf, buf_size);
+}
+#endif
+
+/**
+ * @brief 显示移植层性能计数器的sysmon叠加层
+ */
+lv_obj_t *lv_port_show_perf_stats(bool log_mode)
+{
+#if LV_USE_SYSMON
+    static port_stats_mark_t mark;
+    port_stats_mark(&mark);
+    lv_sysmon_show_port(disp_drv, perf_stats_format_cb, &mark, log_mode);
+    return disp_drv->port_label;
+#else
+    ESP_LOGW(TAG, "未启用LV_USE_SYSMON，不能显示性能计数器");
+    return NULL;
+#endif
+}
+
+/**
+ * @brief 隐藏移植层性能计数器的sysmon叠加层
+ */
+void lv_port_hide_perf_stats(void)
+{
+#if LV_USE_SYSMON
+    lv_sysmon_hide_port(disp_drv);
+#endif
 }
 
 /**
  * @brief LVGL移植初始化函数
+ *
+ * 面板复位后不等待，其余初始化与复位后的等待重叠；面板在第一帧写完后由LVGL定时器开显示。
  */
 void lv_port_init(void)
 {
     lv_init();
+#if LV_USE_PROFILER && LV_USE_PROFILER_BUILTIN
+    // lv_init按LVGL的默认配置分配了分析器：其他任务开始记录之前释放，第一次设置输出时再按移植层的大小分配
+    lv_profiler_builtin_uninit();
+#endif
+    lv_font_glyph_cache_resize(LV_PORT_GLYPH_CACHE_SIZE, true);
+    rgb565_blend_init();
+#if LV_USE_OS != LV_OS_NONE
+    ESP_LOGI(TAG, "LVGL核心初始化完成，%d个软件绘制单元", LV_DRAW_SW_DRAW_UNIT_CNT);
+#else
     ESP_LOGI(TAG, "LVGL核心初始化完成");
+#endif
 
     disp_spi_init();
     ESP_LOGI(TAG, "显示SPI总线初始化完成");
 
     ili9341_init();
-    ESP_LOGI(TAG, "ILI9341显示屏初始化完成");
+    boot_stats.panel_reset_us = esp_timer_get_time();
+    ESP_LOGI(TAG, "ILI9341显示屏已复位");
 
     tp_spi_init();
     ESP_LOGI(TAG, "触摸SPI总线初始化完成");
@@ -124,9 +795,12 @@ void lv_port_init(void)
     xpt2046_init();
     ESP_LOGI(TAG, "XPT2046触摸屏初始化完成");
 
+    lv_tick_set_cb(tick_get_cb);
+    lv_timer_handler_set_resume_cb(timer_resume_cb, NULL);
+
     lv_disp_init();
     lv_indev_init();
-    lv_tick_init();
 
+    boot_stats.init_done_us = esp_timer_get_time();
     ESP_LOGI(TAG, "LVGL移植初始化全部完成");
 }
\ No newline at end of file
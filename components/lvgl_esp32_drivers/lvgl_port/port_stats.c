@@ -0,0 +1,119 @@
+#include "port_stats.h"
+#include <stddef.h>
+#include <stdio.h>
+#include "esp_timer.h"
+#include "esp_rom_sys.h"
+
+#define COUNTER_CNT         (sizeof(port_stats_t) / sizeof(atomic_uint))
+#define COUNTER_INDEX(f)    (offsetof(port_stats_t, f) / sizeof(atomic_uint))
+
+_Static_assert(sizeof(port_stats_t) % sizeof(atomic_uint) == 0, "port_stats_t只能包含atomic_uint");
+
+port_stats_t port_stats;
+
+/**
+ * @brief 读取全部计数器
+ */
+static void counters_load(uint32_t *out)
+{
+    const atomic_uint *counters = (const atomic_uint *)&port_stats;
+    for (size_t i = 0; i < COUNTER_CNT; i++) {
+        out[i] = atomic_load_explicit(&counters[i], memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief 取走最大值并清零，下一个周期从0开始
+ */
+static uint32_t max_take(atomic_uint *counter)
+{
+    return atomic_exchange_explicit(counter, 0, memory_order_relaxed);
+}
+
+/**
+ * @brief 周期数换算为微秒
+ *
+ * 按CPU频率换算，不用读取周期内的周期数和esp_timer现场校准：
+ * 两者不是同时读取，被抢占或周期很短时比值偏差大，且随每次读取变化。
+ */
+static uint32_t cycles_to_us(uint32_t cycles)
+{
+    return cycles / esp_rom_get_cpu_ticks_per_us();
+}
+
+/**
+ * @brief 平均值，个数为0时为0
+ */
+static uint32_t avg(uint32_t sum, uint32_t cnt)
+{
+    return cnt > 0 ? sum / cnt : 0;
+}
+
+/**
+ * @brief 以当前时刻作为读取方的起点
+ */
+void port_stats_mark(port_stats_mark_t *mark)
+{
+    counters_load(mark->counters);
+    mark->time_us = esp_timer_get_time();
+    max_take(&port_stats.queue_depth_max);
+    max_take(&port_stats.touch_latency_max_us);
+    max_take(&port_stats.flush_latency_max_us);
+}
+
+/**
+ * @brief 读取自起点以来的统计
+ */
+void port_stats_read(port_stats_mark_t *mark, port_stats_period_t *out)
+{
+    port_stats_mark_t now;
+    counters_load(now.counters);
+    now.time_us = esp_timer_get_time();
+
+    uint32_t d[COUNTER_CNT];
+    for (size_t i = 0; i < COUNTER_CNT; i++) d[i] = now.counters[i] - mark->counters[i];
+
+    uint32_t period_us = (uint32_t)(now.time_us - mark->time_us);
+
+    out->period_us = period_us;
+    out->spi_trans = d[COUNTER_INDEX(spi_trans)];
+    out->spi_bytes = d[COUNTER_INDEX(spi_bytes)];
+    out->spi_busy_us = cycles_to_us(d[COUNTER_INDEX(spi_busy_cycles)]);
+    uint64_t busy_pct = period_us > 0 ? 100ULL * out->spi_busy_us / period_us : 0;
+    out->spi_busy_pct = (uint8_t)(busy_pct < 100 ? busy_pct : 100);
+    out->spi_wait_us = cycles_to_us(d[COUNTER_INDEX(spi_wait_cycles)]);
+    out->spi_waits = d[COUNTER_INDEX(spi_waits)];
+    out->spi_ring_full = d[COUNTER_INDEX(spi_ring_full)];
+    out->queue_depth_avg = d[COUNTER_INDEX(queued)] > 0 ?
+                           (float)d[COUNTER_INDEX(queue_depth_sum)] / d[COUNTER_INDEX(queued)] : 0;
+    out->queue_depth_max = max_take(&port_stats.queue_depth_max);
+    out->windows = d[COUNTER_INDEX(windows)];
+    out->pixels = d[COUNTER_INDEX(pixels)];
+    out->swap_us = cycles_to_us(d[COUNTER_INDEX(swap_cycles)]);
+    out->touch_samples = d[COUNTER_INDEX(touch_samples)];
+    out->touch_reads = d[COUNTER_INDEX(touch_reads)];
+    out->touch_latency_avg_us = avg(d[COUNTER_INDEX(touch_latency_us)], out->touch_reads);
+    out->touch_latency_max_us = max_take(&port_stats.touch_latency_max_us);
+    out->flushes = d[COUNTER_INDEX(flushes)];
+    out->flush_latency_avg_us = avg(d[COUNTER_INDEX(flush_latency_us)], out->flushes);
+    out->flush_latency_max_us = max_take(&port_stats.flush_latency_max_us);
+
+    *mark = now;
+}
+
+/**
+ * @brief 格式化一个周期的统计
+ */
+void port_stats_format(const port_stats_period_t *stats, char *buf, uint32_t buf_size)
+{
+    uint32_t depth_x10 = (uint32_t)(stats->queue_depth_avg * 10.0f + 0.5f);
+    snprintf(buf, buf_size,
+             "SPI %u%% %u kB, wait %u us\n"
+             "queue %u.%u/%u, %u win, swap %u us\n"
+             "touch %u us (max %u), flush %u us",
+             (unsigned)stats->spi_busy_pct, (unsigned)(stats->spi_bytes / 1024), (unsigned)stats->spi_wait_us,
+             (unsigned)(depth_x10 / 10), (unsigned)(depth_x10 % 10), (unsigned)stats->queue_depth_max,
+             (unsigned)stats->windows, (unsigned)stats->swap_us,
+             (unsigned)stats->touch_latency_avg_us, (unsigned)stats->touch_latency_max_us,
+             (unsigned)stats->flush_latency_avg_us);
+}
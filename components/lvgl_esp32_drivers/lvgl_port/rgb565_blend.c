@@ -0,0 +1,543 @@
+#include "rgb565_blend.h"
+#include <stdbool.h>
+#include <string.h>
+#include "esp_log.h"
+#include "src/draw/sw/blend/swar/lv_blend_swar.h"
+
+// 日志标签
+static const char *TAG = "RGB565_BLEND";
+
+// 按PIE内核的块调度只在打开PIE的目标板（RGB565_BLEND_USE_PIE）和主机测试（RGB565_BLEND_USE_MODEL，
+// 逐条对应PIE指令的C参考模型）中编译；其余情况钩子直接调用SWAR内核，见文件末尾
+#if defined(RGB565_BLEND_USE_PIE) || defined(RGB565_BLEND_USE_MODEL)
+
+// PIE内核把每个通道放在16位通道中，按LVGL的公式 bg + ((fg - bg) * m >> 5)（m = (mix + 4) >> 3）混合：
+//   蓝色在位0-4；绿色留在位5-10，乘积不移位，混合后丢弃低5位；
+//   红色右移5位到位6-10（乘积不超出int16），混合后丢弃低6位再左移5位回到位11-15
+// 移位都用EE.VMUL的SAR（固定为5）完成：乘1即右移5位，乘0x400即左移5位。
+// 与lv_color_16_16_mix逐位一致（包括mix为0、255和前景背景相同的情况），推导见swar/lv_blend_swar.c
+
+#define PIE_SAR         5
+#define CHUNK_PX        64          // 权重和未对齐源像素的暂存块
+#define MIX_WEIGHT(mix) (((uint32_t)(mix) + 4) >> 3)
+
+/**
+ * @brief 内核的常量，字段偏移与rgb565_blend_esp32s3.S一致，由EE.VLDBC.16广播到8个通道
+ */
+typedef struct {
+    uint16_t color;         // 纯色填充的颜色
+    uint16_t fg_b;          // 前景蓝色，位0-4
+    uint16_t fg_g5;         // 前景绿色，位5-10
+    uint16_t fg_r6;         // 前景红色，位6-10
+    uint16_t m;             // 混合权重，0-32
+    uint16_t mask_b;        // 0x001F
+    uint16_t mask_g;        // 0x07E0
+    uint16_t mask_r;        // 0xF800
+    uint16_t mask_r6;       // 0x07C0
+    uint16_t one;           // 1：右移5位
+    uint16_t k400;          // 0x0400：左移5位
+} __attribute__((aligned(16))) pie_consts_t;
+
+/**
+ * @brief 内核：处理blocks个RGB565_BLEND_PIE_BLOCK像素的块
+ * @param c 常量
+ * @param dest 目标，16字节对齐
+ * @param src 源图像，16字节对齐；纯色内核不使用
+ * @param w 每个像素的权重，16字节对齐；整体权重的内核不使用
+ * @param blocks 块数
+ */
+typedef void (*pie_kernel_t)(const pie_consts_t *c, uint16_t *dest, const uint16_t *src, const uint16_t *w,
+                             size_t blocks);
+
+#if defined(RGB565_BLEND_USE_PIE)
+// PIE内核（rgb565_blend_esp32s3.S）
+void rgb565_blend_fill_pie(const pie_consts_t *c, uint16_t *dest, const uint16_t *src, const uint16_t *w, size_t blocks);
+void rgb565_blend_fill_mix_pie(const pie_consts_t *c, uint16_t *dest, const uint16_t *src, const uint16_t *w, size_t blocks);
+void rgb565_blend_fill_mix_w_pie(const pie_consts_t *c, uint16_t *dest, const uint16_t *src, const uint16_t *w, size_t blocks);
+void rgb565_blend_image_mix_pie(const pie_consts_t *c, uint16_t *dest, const uint16_t *src, const uint16_t *w, size_t blocks);
+void rgb565_blend_image_mix_w_pie(const pie_consts_t *c, uint16_t *dest, const uint16_t *src, const uint16_t *w, size_t blocks);
+
+#define KERNEL(name)    name##_pie
+
+static bool pie_ok = false;     // PIE内核已通过校验
+#else
+#define KERNEL(name)    name##_model
+#endif
+
+/**
+ * @brief 整体不透明度、遮罩、遮罩加不透明度三种混合
+ */
+typedef enum {
+    MIX_OPA,
+    MIX_MASK,
+    MIX_MASK_OPA,
+} mix_mode_t;
+
+/* ---------------- C参考模型：逐条对应PIE指令 ---------------- */
+
+// 128位寄存器，8个16位通道
+typedef struct {
+    uint16_t h[RGB565_BLEND_PIE_BLOCK];
+} pie_q_t;
+
+// EE.VLD.128.IP
+static inline pie_q_t q_ld(const uint16_t *p)
+{
+    pie_q_t q;
+    memcpy(q.h, p, sizeof(q.h));
+    return q;
+}
+
+// EE.VST.128.IP
+static inline void q_st(uint16_t *p, pie_q_t q)
+{
+    memcpy(p, q.h, sizeof(q.h));
+}
+
+// EE.VLDBC.16
+static inline pie_q_t q_bc(uint16_t v)
+{
+    pie_q_t q;
+    for (int i = 0; i < RGB565_BLEND_PIE_BLOCK; i++) q.h[i] = v;
+    return q;
+}
+
+// EE.ANDQ
+static inline pie_q_t q_and(pie_q_t a, pie_q_t b)
+{
+    for (int i = 0; i < RGB565_BLEND_PIE_BLOCK; i++) a.h[i] &= b.h[i];
+    return a;
+}
+
+// EE.ORQ
+static inline pie_q_t q_or(pie_q_t a, pie_q_t b)
+{
+    for (int i = 0; i < RGB565_BLEND_PIE_BLOCK; i++) a.h[i] |= b.h[i];
+    return a;
+}
+
+static inline uint16_t sat_s16(int32_t v)
+{
+    return (uint16_t)(int16_t)(v > INT16_MAX ? INT16_MAX : v < INT16_MIN ? INT16_MIN : v);
+}
+
+// EE.VADDS.S16：有符号饱和加
+static inline pie_q_t q_adds(pie_q_t a, pie_q_t b)
+{
+    for (int i = 0; i < RGB565_BLEND_PIE_BLOCK; i++) a.h[i] = sat_s16((int16_t)a.h[i] + (int16_t)b.h[i]);
+    return a;
+}
+
+// EE.VSUBS.S16：有符号饱和减
+static inline pie_q_t q_subs(pie_q_t a, pie_q_t b)
+{
+    for (int i = 0; i < RGB565_BLEND_PIE_BLOCK; i++) a.h[i] = sat_s16((int16_t)a.h[i] - (int16_t)b.h[i]);
+    return a;
+}
+
+// EE.VMUL.S16：有符号乘积算术右移SAR位，保留低16位
+static inline pie_q_t q_mul_s16(pie_q_t a, pie_q_t b)
+{
+    for (int i = 0; i < RGB565_BLEND_PIE_BLOCK; i++) {
+        a.h[i] = (uint16_t)(((int32_t)(int16_t)a.h[i] * (int16_t)b.h[i]) >> PIE_SAR);
+    }
+    return a;
+}
+
+// EE.VMUL.U16：无符号乘积右移SAR位，保留低16位
+static inline pie_q_t q_mul_u16(pie_q_t a, pie_q_t b)
+{
+    for (int i = 0; i < RGB565_BLEND_PIE_BLOCK; i++) a.h[i] = (uint16_t)(((uint32_t)a.h[i] * b.h[i]) >> PIE_SAR);
+    return a;
+}
+
+/**
+ * @brief 汇编中的split_fg：把前景像素拆成三个通道
+ */
+static inline void split_fg_model(const pie_consts_t *c, pie_q_t f, pie_q_t *f_b, pie_q_t *f_g5, pie_q_t *f_r6)
+{
+    *f_b = q_and(f, q_bc(c->mask_b));
+    *f_g5 = q_and(f, q_bc(c->mask_g));
+    *f_r6 = q_mul_u16(q_and(f, q_bc(c->mask_r)), q_bc(c->one));
+}
+
+/**
+ * @brief 汇编中的mix_block：8个目标像素b与前景按权重m混合
+ */
+static inline pie_q_t mix_block_model(const pie_consts_t *c, pie_q_t b, pie_q_t m,
+                                      pie_q_t f_b, pie_q_t f_g5, pie_q_t f_r6)
+{
+    pie_q_t res, t, d;
+
+    t = q_and(b, q_bc(c->mask_b));
+    d = q_mul_s16(q_subs(f_b, t), m);
+    res = q_adds(t, d);
+
+    t = q_and(b, q_bc(c->mask_g));
+    d = q_mul_s16(q_subs(f_g5, t), m);
+    t = q_and(q_adds(t, d), q_bc(c->mask_g));
+    res = q_or(res, t);
+
+    t = q_mul_u16(q_and(b, q_bc(c->mask_r)), q_bc(c->one));
+    d = q_mul_s16(q_subs(f_r6, t), m);
+    t = q_and(q_adds(t, d), q_bc(c->mask_r6));
+    t = q_mul_u16(t, q_bc(c->k400));
+    return q_or(res, t);
+}
+
+static void rgb565_blend_fill_model(const pie_consts_t *c, uint16_t *dest, const uint16_t *src, const uint16_t *w,
+                                    size_t blocks)
+{
+    (void)src;
+    (void)w;
+    pie_q_t color = q_bc(c->color);
+    for (; blocks > 0; blocks--, dest += RGB565_BLEND_PIE_BLOCK) {
+        q_st(dest, color);
+    }
+}
+
+static void rgb565_blend_fill_mix_model(const pie_consts_t *c, uint16_t *dest, const uint16_t *src,
+                                        const uint16_t *w, size_t blocks)
+{
+    (void)src;
+    (void)w;
+    pie_q_t f_b = q_bc(c->fg_b), f_g5 = q_bc(c->fg_g5), f_r6 = q_bc(c->fg_r6), m = q_bc(c->m);
+    for (; blocks > 0; blocks--, dest += RGB565_BLEND_PIE_BLOCK) {
+        q_st(dest, mix_block_model(c, q_ld(dest), m, f_b, f_g5, f_r6));
+    }
+}
+
+static void rgb565_blend_fill_mix_w_model(const pie_consts_t *c, uint16_t *dest, const uint16_t *src,
+                                          const uint16_t *w, size_t blocks)
+{
+    (void)src;
+    pie_q_t f_b = q_bc(c->fg_b), f_g5 = q_bc(c->fg_g5), f_r6 = q_bc(c->fg_r6);
+    for (; blocks > 0; blocks--, dest += RGB565_BLEND_PIE_BLOCK, w += RGB565_BLEND_PIE_BLOCK) {
+        q_st(dest, mix_block_model(c, q_ld(dest), q_ld(w), f_b, f_g5, f_r6));
+    }
+}
+
+static void rgb565_blend_image_mix_model(const pie_consts_t *c, uint16_t *dest, const uint16_t *src,
+                                         const uint16_t *w, size_t blocks)
+{
+    (void)w;
+    pie_q_t m = q_bc(c->m);
+    for (; blocks > 0; blocks--, dest += RGB565_BLEND_PIE_BLOCK, src += RGB565_BLEND_PIE_BLOCK) {
+        pie_q_t f_b, f_g5, f_r6;
+        split_fg_model(c, q_ld(src), &f_b, &f_g5, &f_r6);
+        q_st(dest, mix_block_model(c, q_ld(dest), m, f_b, f_g5, f_r6));
+    }
+}
+
+static void rgb565_blend_image_mix_w_model(const pie_consts_t *c, uint16_t *dest, const uint16_t *src,
+                                           const uint16_t *w, size_t blocks)
+{
+    for (; blocks > 0; blocks--, dest += RGB565_BLEND_PIE_BLOCK, src += RGB565_BLEND_PIE_BLOCK,
+         w += RGB565_BLEND_PIE_BLOCK) {
+        pie_q_t f_b, f_g5, f_r6;
+        split_fg_model(c, q_ld(src), &f_b, &f_g5, &f_r6);
+        q_st(dest, mix_block_model(c, q_ld(dest), q_ld(w), f_b, f_g5, f_r6));
+    }
+}
+
+/* ---------------- 按行调度：头尾逐像素，中间按块调用内核 ---------------- */
+
+static void consts_init(pie_consts_t *c, uint16_t color, lv_opa_t opa)
+{
+    c->color = color;
+    c->fg_b = color & 0x001F;
+    c->fg_g5 = color & 0x07E0;
+    c->fg_r6 = (color & 0xF800) >> 5;
+    c->m = (uint16_t)MIX_WEIGHT(opa);
+    c->mask_b = 0x001F;
+    c->mask_g = 0x07E0;
+    c->mask_r = 0xF800;
+    c->mask_r6 = 0x07C0;
+    c->one = 1;
+    c->k400 = 0x0400;
+}
+
+static inline void *next_row(const void *buf, int32_t stride)
+{
+    return (void *)((uint8_t *)buf + stride);
+}
+
+/**
+ * @brief 像素x的混合比例（0-255），与LVGL的参考循环相同
+ */
+static inline uint8_t px_mix(mix_mode_t mode, const lv_opa_t *mask, lv_opa_t opa, int32_t x)
+{
+    switch (mode) {
+    case MIX_OPA:   return opa;
+    case MIX_MASK:  return mask[x];
+    default:        return LV_OPA_MIX2(mask[x], opa);
+    }
+}
+
+/**
+ * @brief 混合一行：src为NULL时前景为c->color
+ */
+static void mix_row(const pie_consts_t *c, uint16_t *dest, const uint16_t *src, mix_mode_t mode,
+                    const lv_opa_t *mask, lv_opa_t opa, int32_t w)
+{
+    uint16_t src_buf[CHUNK_PX] __attribute__((aligned(16)));
+    uint16_t w_buf[CHUNK_PX] __attribute__((aligned(16)));
+    int32_t x = 0;
+
+    // 头部逐像素处理到目标16字节对齐
+    for (; x < w && ((uintptr_t)&dest[x] & 15) != 0; x++) {
+        dest[x] = lv_color_16_16_mix(src ? src[x] : c->color, dest[x], px_mix(mode, mask, opa, x));
+    }
+
+    int32_t body_end = x + (w - x) / RGB565_BLEND_PIE_BLOCK * RGB565_BLEND_PIE_BLOCK;
+    while (x < body_end) {
+        int32_t n = body_end - x < CHUNK_PX ? body_end - x : CHUNK_PX;
+        const uint16_t *s = NULL;
+        if (src) {
+            s = &src[x];
+            // 源与目标对齐方式不同时先复制到对齐的暂存块
+            if (((uintptr_t)s & 15) != 0) {
+                memcpy(src_buf, s, n * sizeof(uint16_t));
+                s = src_buf;
+            }
+        }
+
+        if (mode == MIX_OPA) {
+            if (src) KERNEL(rgb565_blend_image_mix)(c, &dest[x], s, NULL, n / RGB565_BLEND_PIE_BLOCK);
+            else KERNEL(rgb565_blend_fill_mix)(c, &dest[x], NULL, NULL, n / RGB565_BLEND_PIE_BLOCK);
+        }
+        else {
+            for (int32_t i = 0; i < n; i++) {
+                w_buf[i] = (uint16_t)MIX_WEIGHT(px_mix(mode, mask, opa, x + i));
+            }
+            if (src) KERNEL(rgb565_blend_image_mix_w)(c, &dest[x], s, w_buf, n / RGB565_BLEND_PIE_BLOCK);
+            else KERNEL(rgb565_blend_fill_mix_w)(c, &dest[x], NULL, w_buf, n / RGB565_BLEND_PIE_BLOCK);
+        }
+        x += n;
+    }
+
+    for (; x < w; x++) {
+        dest[x] = lv_color_16_16_mix(src ? src[x] : c->color, dest[x], px_mix(mode, mask, opa, x));
+    }
+}
+
+/**
+ * @brief 纯色混合的公共部分
+ */
+static void blend_color(lv_draw_sw_blend_fill_dsc_t *dsc, mix_mode_t mode)
+{
+    pie_consts_t c;
+    consts_init(&c, lv_color_to_u16(dsc->color), dsc->opa);
+
+    uint16_t *dest = dsc->dest_buf;
+    const lv_opa_t *mask = dsc->mask_buf;
+    for (int32_t y = 0; y < dsc->dest_h; y++) {
+        mix_row(&c, dest, NULL, mode, mask, dsc->opa, dsc->dest_w);
+        dest = next_row(dest, dsc->dest_stride);
+        if (mask) mask += dsc->mask_stride;
+    }
+}
+
+/**
+ * @brief 图像混合的公共部分
+ */
+static void blend_image(lv_draw_sw_blend_image_dsc_t *dsc, mix_mode_t mode)
+{
+    pie_consts_t c;
+    consts_init(&c, 0, dsc->opa);
+
+    uint16_t *dest = dsc->dest_buf;
+    const uint16_t *src = dsc->src_buf;
+    const lv_opa_t *mask = dsc->mask_buf;
+    for (int32_t y = 0; y < dsc->dest_h; y++) {
+        mix_row(&c, dest, src, mode, mask, dsc->opa, dsc->dest_w);
+        dest = next_row(dest, dsc->dest_stride);
+        src = next_row(src, dsc->src_stride);
+        if (mask) mask += dsc->mask_stride;
+    }
+}
+
+// PIE内核未通过校验时的退回实现：有SWAR内核时用它，否则由LVGL执行C循环
+#if defined(RGB565_BLEND_USE_PIE)
+#if LV_USE_DRAW_SW_SWAR
+#define FALLBACK(swar_fn, dsc)      do { if (!pie_ok) return swar_fn(dsc); } while (0)
+#else
+#define FALLBACK(swar_fn, dsc)      do { if (!pie_ok) return LV_RESULT_INVALID; } while (0)
+#endif
+#else   /* RGB565_BLEND_USE_MODEL */
+#define FALLBACK(swar_fn, dsc)      do { } while (0)
+#endif
+
+lv_result_t rgb565_blend_color(lv_draw_sw_blend_fill_dsc_t *dsc)
+{
+    FALLBACK(lv_color_blend_to_rgb565_swar, dsc);
+
+    pie_consts_t c;
+    consts_init(&c, lv_color_to_u16(dsc->color), LV_OPA_COVER);
+
+    uint16_t *dest = dsc->dest_buf;
+    int32_t w = dsc->dest_w;
+    for (int32_t y = 0; y < dsc->dest_h; y++) {
+        int32_t x = 0;
+        for (; x < w && ((uintptr_t)&dest[x] & 15) != 0; x++) dest[x] = c.color;
+        int32_t blocks = (w - x) / RGB565_BLEND_PIE_BLOCK;
+        KERNEL(rgb565_blend_fill)(&c, &dest[x], NULL, NULL, blocks);
+        for (x += blocks * RGB565_BLEND_PIE_BLOCK; x < w; x++) dest[x] = c.color;
+        dest = next_row(dest, dsc->dest_stride);
+    }
+    return LV_RESULT_OK;
+}
+
+lv_result_t rgb565_blend_color_with_opa(lv_draw_sw_blend_fill_dsc_t *dsc)
+{
+    FALLBACK(lv_color_blend_to_rgb565_with_opa_swar, dsc);
+    blend_color(dsc, MIX_OPA);
+    return LV_RESULT_OK;
+}
+
+lv_result_t rgb565_blend_color_with_mask(lv_draw_sw_blend_fill_dsc_t *dsc)
+{
+    FALLBACK(lv_color_blend_to_rgb565_with_mask_swar, dsc);
+    blend_color(dsc, MIX_MASK);
+    return LV_RESULT_OK;
+}
+
+lv_result_t rgb565_blend_color_mix_mask_opa(lv_draw_sw_blend_fill_dsc_t *dsc)
+{
+    FALLBACK(lv_color_blend_to_rgb565_mix_mask_opa_swar, dsc);
+    blend_color(dsc, MIX_MASK_OPA);
+    return LV_RESULT_OK;
+}
+
+lv_result_t rgb565_blend_image_with_opa(lv_draw_sw_blend_image_dsc_t *dsc)
+{
+    FALLBACK(lv_rgb565_blend_normal_to_rgb565_with_opa_swar, dsc);
+    blend_image(dsc, MIX_OPA);
+    return LV_RESULT_OK;
+}
+
+lv_result_t rgb565_blend_image_with_mask(lv_draw_sw_blend_image_dsc_t *dsc)
+{
+    FALLBACK(lv_rgb565_blend_normal_to_rgb565_with_mask_swar, dsc);
+    blend_image(dsc, MIX_MASK);
+    return LV_RESULT_OK;
+}
+
+lv_result_t rgb565_blend_image_mix_mask_opa(lv_draw_sw_blend_image_dsc_t *dsc)
+{
+    FALLBACK(lv_rgb565_blend_normal_to_rgb565_mix_mask_opa_swar, dsc);
+    blend_image(dsc, MIX_MASK_OPA);
+    return LV_RESULT_OK;
+}
+
+#else   /* 未打开PIE的目标板 */
+
+// 不经过PIE的块调度和暂存块，直接调用SWAR内核；未启用SWAR时返回LV_RESULT_INVALID，由LVGL执行C循环
+#if LV_USE_DRAW_SW_SWAR
+#define DIRECT(swar_fn, dsc)        swar_fn(dsc)
+#else
+#define DIRECT(swar_fn, dsc)        ((void)(dsc), LV_RESULT_INVALID)
+#endif
+
+lv_result_t rgb565_blend_color(lv_draw_sw_blend_fill_dsc_t *dsc)
+{
+    return DIRECT(lv_color_blend_to_rgb565_swar, dsc);
+}
+
+lv_result_t rgb565_blend_color_with_opa(lv_draw_sw_blend_fill_dsc_t *dsc)
+{
+    return DIRECT(lv_color_blend_to_rgb565_with_opa_swar, dsc);
+}
+
+lv_result_t rgb565_blend_color_with_mask(lv_draw_sw_blend_fill_dsc_t *dsc)
+{
+    return DIRECT(lv_color_blend_to_rgb565_with_mask_swar, dsc);
+}
+
+lv_result_t rgb565_blend_color_mix_mask_opa(lv_draw_sw_blend_fill_dsc_t *dsc)
+{
+    return DIRECT(lv_color_blend_to_rgb565_mix_mask_opa_swar, dsc);
+}
+
+lv_result_t rgb565_blend_image_with_opa(lv_draw_sw_blend_image_dsc_t *dsc)
+{
+    return DIRECT(lv_rgb565_blend_normal_to_rgb565_with_opa_swar, dsc);
+}
+
+lv_result_t rgb565_blend_image_with_mask(lv_draw_sw_blend_image_dsc_t *dsc)
+{
+    return DIRECT(lv_rgb565_blend_normal_to_rgb565_with_mask_swar, dsc);
+}
+
+lv_result_t rgb565_blend_image_mix_mask_opa(lv_draw_sw_blend_image_dsc_t *dsc)
+{
+    return DIRECT(lv_rgb565_blend_normal_to_rgb565_mix_mask_opa_swar, dsc);
+}
+
+#endif
+
+/**
+ * @brief 当前使用的实现名称
+ */
+const char *rgb565_blend_impl_name(void)
+{
+#if defined(RGB565_BLEND_USE_PIE)
+    return pie_ok ? "pie" : "fallback";
+#elif defined(RGB565_BLEND_USE_MODEL)
+    return "model";
+#else
+    return LV_USE_DRAW_SW_SWAR ? "swar" : "c";
+#endif
+}
+
+#if defined(RGB565_BLEND_USE_PIE)
+/**
+ * @brief 一个PIE内核与C参考模型的结果是否一致
+ */
+static bool check_kernel(pie_kernel_t pie, pie_kernel_t model, const pie_consts_t *c, const uint16_t *dest,
+                         const uint16_t *src, const uint16_t *w, size_t px)
+{
+    static uint16_t out_pie[3 * RGB565_BLEND_PIE_BLOCK] __attribute__((aligned(16)));
+    static uint16_t out_model[3 * RGB565_BLEND_PIE_BLOCK] __attribute__((aligned(16)));
+
+    memcpy(out_pie, dest, px * sizeof(uint16_t));
+    memcpy(out_model, dest, px * sizeof(uint16_t));
+    pie(c, out_pie, src, w, px / RGB565_BLEND_PIE_BLOCK);
+    model(c, out_model, src, w, px / RGB565_BLEND_PIE_BLOCK);
+    return memcmp(out_pie, out_model, px * sizeof(uint16_t)) == 0;
+}
+#endif
+
+/**
+ * @brief 初始化，使用PIE内核时先校验
+ */
+void rgb565_blend_init(void)
+{
+#if defined(RGB565_BLEND_USE_PIE)
+    static uint16_t dest[3 * RGB565_BLEND_PIE_BLOCK] __attribute__((aligned(16)));
+    static uint16_t src[3 * RGB565_BLEND_PIE_BLOCK] __attribute__((aligned(16)));
+    static uint16_t w[3 * RGB565_BLEND_PIE_BLOCK] __attribute__((aligned(16)));
+    const size_t px = sizeof(dest) / sizeof(dest[0]);
+
+    // 包括全0、全1的像素和权重0、32的情况
+    uint32_t seed = 1;
+    for (size_t i = 0; i < px; i++) {
+        seed = seed * 1103515245u + 12345u;
+        dest[i] = i == 0 ? 0x0000 : i == 1 ? 0xFFFF : (uint16_t)(seed >> 16);
+        src[i] = i == 0 ? 0xFFFF : i == 1 ? 0x0000 : (uint16_t)(seed >> 8);
+        w[i] = (uint16_t)(i % 33);
+    }
+
+    pie_consts_t c;
+    consts_init(&c, 0xA5F3, 100);
+    pie_ok = check_kernel(rgb565_blend_fill_pie, rgb565_blend_fill_model, &c, dest, src, w, px)
+             && check_kernel(rgb565_blend_fill_mix_pie, rgb565_blend_fill_mix_model, &c, dest, src, w, px)
+             && check_kernel(rgb565_blend_fill_mix_w_pie, rgb565_blend_fill_mix_w_model, &c, dest, src, w, px)
+             && check_kernel(rgb565_blend_image_mix_pie, rgb565_blend_image_mix_model, &c, dest, src, w, px)
+             && check_kernel(rgb565_blend_image_mix_w_pie, rgb565_blend_image_mix_w_model, &c, dest, src, w, px);
+    if (!pie_ok) {
+        ESP_LOGW(TAG, "PIE内核校验失败，使用%s", LV_USE_DRAW_SW_SWAR ? "SWAR内核" : "LVGL的C实现");
+    }
+#endif
+    ESP_LOGI(TAG, "RGB565混合实现: %s", rgb565_blend_impl_name());
+}
@@ -0,0 +1,182 @@
+#include "shadow_fb.h"
+#include <string.h>
+#include "esp_log.h"
+#include "esp_heap_caps.h"
+#include "src/misc/lv_area_private.h"
+
+#define TAG "SHADOW_FB" // 日志标签
+
+// 按32位字比较（PSRAM经cache按32位访问）；may_alias：以字访问16位像素数组不违反严格别名规则
+typedef uint32_t __attribute__((may_alias)) diff_word_t;
+
+/**
+ * @brief 两行像素是否可以按字比较：起始地址模4相同
+ */
+static inline bool same_alignment(const uint16_t *a, const uint16_t *b)
+{
+    return (((uintptr_t)a ^ (uintptr_t)b) & 3) == 0;
+}
+
+/**
+ * @brief 从左找第一个不同的像素
+ * @return 下标，全部相同时为n
+ */
+static int32_t first_diff(const uint16_t *a, const uint16_t *b, int32_t n)
+{
+    int32_t i = 0;
+    if (same_alignment(a, b)) {
+        if (((uintptr_t)a & 3) != 0 && n > 0) {
+            if (a[0] != b[0]) return 0;
+            i = 1;
+        }
+        const diff_word_t *wa = (const diff_word_t *)(a + i), *wb = (const diff_word_t *)(b + i);
+        while (i + 2 <= n && *wa == *wb) {
+            wa++;
+            wb++;
+            i += 2;
+        }
+    }
+    // 不同的字中逐像素定位，或地址对不齐时逐像素比较
+    while (i < n && a[i] == b[i]) i++;
+    return i;
+}
+
+/**
+ * @brief 从右找最后一个不同的像素，调用者已确认至少有一个
+ * @return 下标
+ */
+static int32_t last_diff(const uint16_t *a, const uint16_t *b, int32_t n)
+{
+    int32_t i = n;  // [i, n)已确认相同
+    if (same_alignment(a, b)) {
+        if (((uintptr_t)(a + i) & 3) != 0) {
+            if (a[i - 1] != b[i - 1]) return i - 1;
+            i--;
+        }
+        const diff_word_t *wa = (const diff_word_t *)(a + i), *wb = (const diff_word_t *)(b + i);
+        while (i >= 2 && wa[-1] == wb[-1]) {
+            wa--;
+            wb--;
+            i -= 2;
+        }
+    }
+    while (a[i - 1] == b[i - 1]) i--;
+    return i - 1;
+}
+
+/**
+ * @brief 分配影子帧缓冲（优先PSRAM），所有行初始为无效
+ */
+bool shadow_fb_init(shadow_fb_t *fb, uint16_t hor_res, uint16_t ver_res)
+{
+    size_t size = (size_t)hor_res * ver_res * sizeof(uint16_t);
+
+    memset(fb, 0, sizeof(*fb));
+    fb->pixels = heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (fb->pixels == NULL) {
+        ESP_LOGW(TAG, "PSRAM不足，影子帧缓冲改用内部RAM");
+        fb->pixels = heap_caps_malloc(size, MALLOC_CAP_8BIT);
+    }
+    fb->row_valid = heap_caps_calloc(ver_res, sizeof(bool), MALLOC_CAP_8BIT);
+    fb->span_x1 = heap_caps_malloc(ver_res * sizeof(int16_t), MALLOC_CAP_8BIT);
+    fb->span_x2 = heap_caps_malloc(ver_res * sizeof(int16_t), MALLOC_CAP_8BIT);
+    if (fb->pixels == NULL || fb->row_valid == NULL || fb->span_x1 == NULL || fb->span_x2 == NULL) {
+        ESP_LOGE(TAG, "影子帧缓冲分配失败（%u字节）", (unsigned)size);
+        shadow_fb_deinit(fb);
+        return false;
+    }
+    fb->hor_res = hor_res;
+    fb->ver_res = ver_res;
+    ESP_LOGI(TAG, "影子帧缓冲%ux%u，%u字节", hor_res, ver_res, (unsigned)size);
+    return true;
+}
+
+/**
+ * @brief 释放影子帧缓冲
+ */
+void shadow_fb_deinit(shadow_fb_t *fb)
+{
+    heap_caps_free(fb->pixels);
+    heap_caps_free(fb->row_valid);
+    heap_caps_free(fb->span_x1);
+    heap_caps_free(fb->span_x2);
+    memset(fb, 0, sizeof(*fb));
+}
+
+/**
+ * @brief 使所有行无效
+ */
+void shadow_fb_invalidate(shadow_fb_t *fb)
+{
+    if (fb->row_valid != NULL) {
+        memset(fb->row_valid, 0, fb->ver_res * sizeof(bool));
+    }
+}
+
+/**
+ * @brief 比较一块渲染结果与副本，更新副本，并把需要发送的部分原地紧凑排列
+ *
+ * 第一遍逐行比较并更新副本，记下每行变化的起止列；第二遍自上而下把变化行归入窗口：
+ * 并入上一个窗口多发送的像素（中间未变化的行、左右扩展的列）不超过一次固定开销时并入，否则另起一个窗口；
+ * 第三遍按窗口逐行搬移颜色数据。窗口自上而下且互不重叠，每行最多搬移一整行，
+ * 写入位置总在读取位置之前，可以原地进行。
+ */
+uint32_t shadow_fb_diff(shadow_fb_t *fb, const lv_area_t *area, uint8_t *buf, lv_area_t *rects,
+                        uint32_t max_rects, const area_merge_cost_t *cost)
+{
+    int32_t w = lv_area_get_width(area);
+    int32_t h = lv_area_get_height(area);
+    const uint16_t *src = (const uint16_t *)buf;
+
+    for (int32_t r = 0; r < h; r++, src += w) {
+        int32_t y = area->y1 + r;
+        uint16_t *dst = fb->pixels + (size_t)y * fb->hor_res + area->x1;
+        int32_t x1, x2;
+
+        if (!fb->row_valid[y]) {
+            x1 = 0;
+            x2 = w - 1;
+            fb->row_valid[y] = w == fb->hor_res;
+        } else {
+            x1 = first_diff(src, dst, w);
+            if (x1 == w) {
+                fb->span_x1[r] = 1;
+                fb->span_x2[r] = 0;
+                continue;
+            }
+            x2 = last_diff(src, dst, w);
+        }
+        memcpy(dst + x1, src + x1, (size_t)(x2 - x1 + 1) * sizeof(uint16_t));
+        fb->span_x1[r] = (int16_t)x1;
+        fb->span_x2[r] = (int16_t)x2;
+    }
+
+    uint32_t cnt = 0;
+    for (int32_t r = 0; r < h; r++) {
+        if (fb->span_x1[r] > fb->span_x2[r]) continue;
+        lv_area_t row = {area->x1 + fb->span_x1[r], area->y1 + r, area->x1 + fb->span_x2[r], area->y1 + r};
+
+        if (cnt > 0) {
+            lv_area_t *last = &rects[cnt - 1];
+            lv_area_t joined;
+            lv_area_join(&joined, last, &row);
+            int64_t extra_px = (int64_t)lv_area_get_size(&joined) - lv_area_get_size(last) - lv_area_get_size(&row);
+            if (cnt == max_rects || extra_px * cost->px_ns <= (int64_t)cost->window_ns) {
+                *last = joined;
+                continue;
+            }
+        }
+        rects[cnt++] = row;
+    }
+
+    uint8_t *out = buf;
+    for (uint32_t i = 0; i < cnt; i++) {
+        size_t row_bytes = (size_t)lv_area_get_width(&rects[i]) * sizeof(uint16_t);
+        for (int32_t y = rects[i].y1; y <= rects[i].y2; y++) {
+            const uint8_t *in = buf + ((size_t)(y - area->y1) * w + (rects[i].x1 - area->x1)) * sizeof(uint16_t);
+            if (out != in) memmove(out, in, row_bytes);
+            out += row_bytes;
+        }
+    }
+    return cnt;
+}
@@ -0,0 +1,141 @@
+#include "stripe_tuner.h"
+
+#define STRIPE_TUNER_DECAY      0.95f   // 每个样本后旧样本权重的衰减，约最近20块起作用
+#define STRIPE_TUNER_MIN_WEIGHT 3.0f    // 拟合斜率所需的最小样本权重
+#define STRIPE_TUNER_MIN_VAR    1.0f    // 拟合斜率所需的行数方差（行²），样本行数都相同时只更新固定开销
+#define STRIPE_TUNER_EXPLORE_FRAMES 16  // 斜率过时后试探其他高度的帧间隔
+
+/**
+ * @brief 加入一个样本并重新拟合
+ * @param f 模型
+ * @param x 行数
+ * @param y 耗时（微秒）
+ *
+ * 条带高度稳定后样本的行数几乎相同，无法区分固定开销和每行开销，
+ * 此时保留上次的斜率，只按加权均值修正截距。
+ */
+static void fit_add(stripe_fit_t *f, float x, float y)
+{
+    f->w = f->w * STRIPE_TUNER_DECAY + 1.0f;
+    f->sx = f->sx * STRIPE_TUNER_DECAY + x;
+    f->sy = f->sy * STRIPE_TUNER_DECAY + y;
+    f->sxx = f->sxx * STRIPE_TUNER_DECAY + x * x;
+    f->sxy = f->sxy * STRIPE_TUNER_DECAY + x * y;
+
+    float den = f->w * f->sxx - f->sx * f->sx;
+    f->spread = f->w >= STRIPE_TUNER_MIN_WEIGHT && den >= STRIPE_TUNER_MIN_VAR * f->w * f->w;
+    if (f->spread) {
+        float slope = (f->w * f->sxy - f->sx * f->sy) / den;
+        f->line_us = slope > 0.0f ? slope : 0.0f;
+        f->valid = true;
+    }
+    if (f->valid) {
+        float fixed = (f->sy - f->line_us * f->sx) / f->w;
+        f->fixed_us = fixed > 0.0f ? fixed : 0.0f;
+    }
+}
+
+/**
+ * @brief 初始化
+ */
+void stripe_tuner_init(stripe_tuner_t *t, uint16_t hor_res, uint16_t min_lines, uint16_t max_lines)
+{
+    *t = (stripe_tuner_t){0};
+    t->hor_res = hor_res;
+    t->max_lines = max_lines;
+    t->min_lines = min_lines < max_lines ? min_lines : max_lines;
+    if (t->min_lines == 0) t->min_lines = 1;
+}
+
+/**
+ * @brief 记录一块的渲染耗时
+ */
+void stripe_tuner_add_render(stripe_tuner_t *t, uint32_t px, uint32_t us)
+{
+    fit_add(&t->render, (float)px / t->hor_res, (float)us);
+}
+
+/**
+ * @brief 记录一块的传输耗时
+ */
+void stripe_tuner_add_xfer(stripe_tuner_t *t, uint32_t px, uint32_t us)
+{
+    fit_add(&t->xfer, (float)px / t->hor_res, (float)us);
+}
+
+/**
+ * @brief 预测帧时间
+ *
+ * 按lv_refr.c的get_max_row切分：每块的行数为缓冲区像素数除以区域宽度，不超过区域高度。
+ * 按lvgl_port的流水方式模拟：本块渲染完后排队，flush_cb等上一块传完才返回，
+ * 所以下一块的渲染从 max(本块渲染完, 上一块传完) 开始，本块的传输也从这一刻开始。
+ */
+float stripe_tuner_predict(const stripe_tuner_t *t, const lv_area_t *areas, size_t cnt, uint16_t lines,
+                           uint32_t *stripes)
+{
+    if (!t->render.valid || !t->xfer.valid) {
+        if (stripes != NULL) *stripes = 0;
+        return 0.0f;
+    }
+
+    uint32_t budget_px = (uint32_t)lines * t->hor_res;
+    uint32_t n = 0;
+    float render_start = 0.0f, xfer_end = 0.0f;
+
+    for (size_t i = 0; i < cnt; i++) {
+        int32_t w = lv_area_get_width(&areas[i]);
+        int32_t h = lv_area_get_height(&areas[i]);
+        if (w <= 0 || h <= 0) continue;
+
+        int32_t rows = (int32_t)(budget_px / (uint32_t)w);
+        if (rows < 1) rows = 1;
+        if (rows > h) rows = h;
+
+        for (int32_t y = 0; y < h; y += rows) {
+            int32_t part = h - y < rows ? h - y : rows;
+            float x = (float)part * w / t->hor_res;
+            float render_end = render_start + t->render.fixed_us + t->render.line_us * x;
+            float xfer_start = render_end > xfer_end ? render_end : xfer_end;
+            xfer_end = xfer_start + t->xfer.fixed_us + t->xfer.line_us * x;
+            render_start = xfer_start;
+            n++;
+        }
+    }
+
+    if (stripes != NULL) *stripes = n;
+    return xfer_end;
+}
+
+/**
+ * @brief 选择条带高度
+ *
+ * 从上限往下逐个预测，只有明显更快（超过1微秒）才换成更小的高度，
+ * 预测相同时用大条带，少一些窗口设置。
+ * 高度稳定后样本行数趋同，斜率不再更新；为跟上负载变化（如总线时钟、绘制内容改变），
+ * 斜率过时时每STRIPE_TUNER_EXPLORE_FRAMES帧用一次减半（或加倍）的高度。
+ */
+uint16_t stripe_tuner_choose(stripe_tuner_t *t, const lv_area_t *areas, size_t cnt)
+{
+    if (!t->render.valid || !t->xfer.valid) {
+        t->explore = !t->explore;
+        return t->explore || t->max_lines / 2 < t->min_lines ? t->max_lines : t->max_lines / 2;
+    }
+
+    uint16_t best_lines = t->max_lines;
+    float best = stripe_tuner_predict(t, areas, cnt, best_lines, NULL);
+    for (uint16_t lines = t->max_lines - 1; lines >= t->min_lines && lines > 0; lines--) {
+        float frame = stripe_tuner_predict(t, areas, cnt, lines, NULL);
+        if (frame < best - 1.0f) {
+            best = frame;
+            best_lines = lines;
+        }
+    }
+
+    if ((!t->render.spread || !t->xfer.spread) && ++t->frames % STRIPE_TUNER_EXPLORE_FRAMES == 0) {
+        uint32_t probe = best_lines > t->max_lines / 2 ? best_lines / 2 : best_lines * 2;
+        if (probe < t->min_lines) probe = t->min_lines;
+        if (probe > t->max_lines) probe = t->max_lines;
+        return (uint16_t)probe;
+    }
+    return best_lines;
+}
@@ -0,0 +1,118 @@
+#include "subject_pub.h"
+#include "esp_log.h"
+#include "lvgl_port.h"
+
+#define TAG "SUBJECT_PUB" // 日志标签
+
+static subject_pub_t *pub_list;         // 已登记的槽位，只在LVGL任务中访问
+static atomic_bool pub_pending;         // 任一槽位有未应用的值；由false变为true的发布者负责唤醒LVGL任务
+
+/**
+ * @brief 写入最新值并标记未应用
+ *
+ * 先写值再置位（release），应用时先清位再读值（acquire）：清位之后到达的值会再次置位，
+ * 最迟在下一帧应用，不会丢失；同一个值被应用两次时由变化检测跳过。
+ */
+static void pub_store(subject_pub_t *pub, uintptr_t value)
+{
+    atomic_store_explicit(&pub->value, value, memory_order_relaxed);
+    atomic_store_explicit(&pub->dirty, true, memory_order_release);
+    if (!atomic_exchange_explicit(&pub_pending, true, memory_order_acq_rel)) {
+        lv_port_wake();
+    }
+}
+
+/**
+ * @brief 为主题建立发布槽位并登记
+ */
+void subject_pub_init(subject_pub_t *pub, lv_subject_t *subject)
+{
+    pub->subject = subject;
+    atomic_init(&pub->dirty, false);
+    atomic_init(&pub->value, 0);
+    pub->next = pub_list;
+    pub_list = pub;
+}
+
+/**
+ * @brief 取消登记
+ */
+void subject_pub_deinit(subject_pub_t *pub)
+{
+    for (subject_pub_t **p = &pub_list; *p != NULL; p = &(*p)->next) {
+        if (*p == pub) {
+            *p = pub->next;
+            break;
+        }
+    }
+    pub->next = NULL;
+}
+
+void subject_pub_int(subject_pub_t *pub, int32_t value)
+{
+    pub_store(pub, (uintptr_t)(uint32_t)value);
+}
+
+void subject_pub_pointer(subject_pub_t *pub, void *ptr)
+{
+    pub_store(pub, (uintptr_t)ptr);
+}
+
+void subject_pub_color(subject_pub_t *pub, lv_color_t color)
+{
+    pub_store(pub, (uintptr_t)lv_color_to_u32(color));
+}
+
+/**
+ * @brief 是否有尚未应用的值
+ */
+bool subject_pub_pending(void)
+{
+    return atomic_load_explicit(&pub_pending, memory_order_acquire);
+}
+
+/**
+ * @brief 按主题类型应用一个值
+ * @return 值有变化并通知了观察者时返回true
+ */
+static bool pub_apply_one(subject_pub_t *pub, uintptr_t value)
+{
+    lv_subject_t *subject = pub->subject;
+
+    switch (subject->type) {
+    case LV_SUBJECT_TYPE_INT:
+        if (lv_subject_get_int(subject) == (int32_t)(uint32_t)value) return false;
+        lv_subject_set_int(subject, (int32_t)(uint32_t)value);
+        return true;
+    case LV_SUBJECT_TYPE_POINTER:
+        if ((uintptr_t)lv_subject_get_pointer(subject) == value) return false;
+        lv_subject_set_pointer(subject, (void *)value);
+        return true;
+    case LV_SUBJECT_TYPE_COLOR: {
+        lv_color_t color = lv_color_hex((uint32_t)value & 0xFFFFFF);
+        if (lv_color_eq(lv_subject_get_color(subject), color)) return false;
+        lv_subject_set_color(subject, color);
+        return true;
+    }
+    default:
+        ESP_LOGW(TAG, "不支持的主题类型：%d", (int)subject->type);
+        return false;
+    }
+}
+
+/**
+ * @brief 应用所有未应用的值
+ */
+uint32_t subject_pub_apply(void)
+{
+    // 先清总标志：扫描期间到达的值会重新置位并唤醒，留到下一帧
+    if (!atomic_exchange_explicit(&pub_pending, false, memory_order_acq_rel)) return 0;
+
+    uint32_t notified = 0;
+    for (subject_pub_t *pub = pub_list; pub != NULL; pub = pub->next) {
+        if (!atomic_exchange_explicit(&pub->dirty, false, memory_order_acquire)) continue;
+        uintptr_t value = atomic_load_explicit(&pub->value, memory_order_relaxed);
+        if (pub_apply_one(pub, value)) notified++;
+    }
+    return notified;
+}
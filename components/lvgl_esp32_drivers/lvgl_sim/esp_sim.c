@@ -0,0 +1,289 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <time.h>
+#include <pthread.h>
+#include "esp_err.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include "esp_rom_gpio.h"
+#include "esp_rom_sys.h"
+
+// 主机仿真：日志、错误码、堆、esp_timer
+
+static esp_log_level_t log_level = ESP_LOG_INFO;   // 全局日志级别
+
+/**
+ * @brief 错误码转字符串
+ * @param code 错误码
+ * @return 错误名称
+ */
+const char *esp_err_to_name(esp_err_t code)
+{
+    switch (code) {
+    case ESP_OK:                return "ESP_OK";
+    case ESP_FAIL:              return "ESP_FAIL";
+    case ESP_ERR_NO_MEM:        return "ESP_ERR_NO_MEM";
+    case ESP_ERR_INVALID_ARG:   return "ESP_ERR_INVALID_ARG";
+    case ESP_ERR_INVALID_STATE: return "ESP_ERR_INVALID_STATE";
+    case ESP_ERR_INVALID_SIZE:  return "ESP_ERR_INVALID_SIZE";
+    case ESP_ERR_NOT_FOUND:     return "ESP_ERR_NOT_FOUND";
+    case ESP_ERR_NOT_SUPPORTED: return "ESP_ERR_NOT_SUPPORTED";
+    case ESP_ERR_TIMEOUT:       return "ESP_ERR_TIMEOUT";
+    default:                    return "UNKNOWN ERROR";
+    }
+}
+
+/**
+ * @brief 设置日志级别（仿真中忽略tag，全局生效）
+ */
+void esp_log_level_set(const char *tag, esp_log_level_t level)
+{
+    (void)tag;
+    log_level = level;
+}
+
+/**
+ * @brief 输出一条日志
+ */
+void esp_log_write(esp_log_level_t level, const char *tag, const char *format, ...)
+{
+    static const char letters[] = {'N', 'E', 'W', 'I', 'D', 'V'};
+    if (level > log_level) return;
+
+    va_list args;
+    va_start(args, format);
+    printf("%c (%lld) %s: ", letters[level], (long long)(esp_timer_get_time() / 1000), tag);
+    vprintf(format, args);
+    printf("\n");
+    va_end(args);
+}
+
+void *heap_caps_malloc(size_t size, uint32_t caps)
+{
+    (void)caps;
+    return malloc(size);
+}
+
+void *heap_caps_calloc(size_t n, size_t size, uint32_t caps)
+{
+    (void)caps;
+    return calloc(n, size);
+}
+
+void heap_caps_free(void *ptr)
+{
+    free(ptr);
+}
+
+void esp_rom_gpio_pad_select_gpio(uint32_t iopad_num)
+{
+    (void)iopad_num;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+#define TICKS_CALIB_NS      20000000        // 测定TSC频率的时长
+#define TICKS_CALIB_TRIES   8               // 每个端点的读数次数
+
+static uint32_t cpu_ticks_per_us;                  // TSC频率（每微秒周期数），只测定一次
+static pthread_once_t cpu_ticks_once = PTHREAD_ONCE_INIT;
+
+static uint64_t monotonic_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief 同一时刻的TSC和单调时钟读数：TSC夹在两次时钟读数之间，取间隔最短的一次，中间被抢占的读数不用
+ */
+static void tsc_time_pair(uint64_t *tsc, uint64_t *ns)
+{
+    uint64_t best = UINT64_MAX;
+    for (int i = 0; i < TICKS_CALIB_TRIES; i++) {
+        uint64_t t0 = monotonic_ns();
+        uint64_t c = __builtin_ia32_rdtsc();
+        uint64_t t1 = monotonic_ns();
+        if (t1 - t0 < best) {
+            best = t1 - t0;
+            *tsc = c;
+            *ns = t0 + (t1 - t0) / 2;
+        }
+    }
+}
+
+static void cpu_ticks_init(void)
+{
+    uint64_t c0, t0, c1, t1;
+    tsc_time_pair(&c0, &t0);
+    do {
+        tsc_time_pair(&c1, &t1);
+    } while (t1 - t0 < TICKS_CALIB_NS);
+    cpu_ticks_per_us = (uint32_t)(((c1 - c0) * 1000 + (t1 - t0) / 2) / (t1 - t0));
+}
+#endif
+
+/**
+ * @brief CPU周期计数每微秒的周期数，不随调用时的负载变化
+ */
+uint32_t esp_rom_get_cpu_ticks_per_us(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    pthread_once(&cpu_ticks_once, cpu_ticks_init);
+    return cpu_ticks_per_us;
+#else
+    return 1000;    // esp_cpu_get_cycle_count按1GHz由单调时钟换算
+#endif
+}
+
+static struct timespec boot_time;                  // 仿真“上电”时刻
+static pthread_once_t boot_once = PTHREAD_ONCE_INIT;
+
+static void boot_time_init(void)
+{
+    clock_gettime(CLOCK_MONOTONIC, &boot_time);
+}
+
+/**
+ * @brief 获取自启动以来的时间（微秒）
+ */
+int64_t esp_timer_get_time(void)
+{
+    struct timespec now;
+
+    pthread_once(&boot_once, boot_time_init);
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (int64_t)(now.tv_sec - boot_time.tv_sec) * 1000000 +
+           (now.tv_nsec - boot_time.tv_nsec) / 1000;
+}
+
+// esp_timer实例：每个定时器一个线程
+struct esp_timer {
+    esp_timer_cb_t callback;
+    void *arg;
+    uint64_t period_us;       // 0表示单次
+    uint64_t timeout_us;
+    bool armed;
+    bool thread_started;
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+};
+
+static void timespec_add_us(struct timespec *ts, uint64_t us)
+{
+    ts->tv_sec += us / 1000000;
+    ts->tv_nsec += (long)(us % 1000000) * 1000;
+    if (ts->tv_nsec >= 1000000000L) {
+        ts->tv_sec++;
+        ts->tv_nsec -= 1000000000L;
+    }
+}
+
+static void *esp_timer_thread(void *arg)
+{
+    struct esp_timer *timer = arg;
+    struct timespec deadline;
+
+    pthread_mutex_lock(&timer->lock);
+    while (1) {
+        while (!timer->armed) {
+            pthread_cond_wait(&timer->cond, &timer->lock);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        timespec_add_us(&deadline, timer->timeout_us);
+
+        while (timer->armed) {
+            int ret = pthread_cond_timedwait(&timer->cond, &timer->lock, &deadline);
+            if (ret == 0) continue;               // 被stop或重新start唤醒
+            if (!timer->armed) break;
+
+            pthread_mutex_unlock(&timer->lock);
+            timer->callback(timer->arg);
+            pthread_mutex_lock(&timer->lock);
+
+            if (timer->period_us == 0) {
+                timer->armed = false;
+            } else {
+                timespec_add_us(&deadline, timer->period_us);
+            }
+        }
+    }
+    return NULL;
+}
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t *create_args, esp_timer_handle_t *out_handle)
+{
+    if (create_args == NULL || create_args->callback == NULL || out_handle == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    struct esp_timer *timer = calloc(1, sizeof(*timer));
+    if (timer == NULL) return ESP_ERR_NO_MEM;
+
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&timer->cond, &attr);
+    pthread_condattr_destroy(&attr);
+    pthread_mutex_init(&timer->lock, NULL);
+
+    timer->callback = create_args->callback;
+    timer->arg = create_args->arg;
+    *out_handle = timer;
+    return ESP_OK;
+}
+
+static esp_err_t esp_timer_start(esp_timer_handle_t timer, uint64_t timeout_us, uint64_t period_us)
+{
+    if (timer == NULL) return ESP_ERR_INVALID_ARG;
+
+    pthread_mutex_lock(&timer->lock);
+    if (timer->armed) {
+        pthread_mutex_unlock(&timer->lock);
+        return ESP_ERR_INVALID_STATE;
+    }
+    timer->timeout_us = timeout_us;
+    timer->period_us = period_us;
+    timer->armed = true;
+    if (!timer->thread_started) {
+        pthread_create(&timer->thread, NULL, esp_timer_thread, timer);
+        pthread_detach(timer->thread);
+        timer->thread_started = true;
+    }
+    pthread_cond_broadcast(&timer->cond);
+    pthread_mutex_unlock(&timer->lock);
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t timer, uint64_t period_us)
+{
+    return esp_timer_start(timer, period_us, period_us);
+}
+
+esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeout_us)
+{
+    return esp_timer_start(timer, timeout_us, 0);
+}
+
+esp_err_t esp_timer_stop(esp_timer_handle_t timer)
+{
+    if (timer == NULL) return ESP_ERR_INVALID_ARG;
+
+    pthread_mutex_lock(&timer->lock);
+    bool was_armed = timer->armed;
+    timer->armed = false;
+    pthread_cond_broadcast(&timer->cond);
+    pthread_mutex_unlock(&timer->lock);
+    return was_armed ? ESP_OK : ESP_ERR_INVALID_STATE;
+}
+
+esp_err_t esp_timer_delete(esp_timer_handle_t timer)
+{
+    if (timer == NULL) return ESP_ERR_INVALID_ARG;
+    if (timer->armed) return ESP_ERR_INVALID_STATE;
+    // 线程已分离且处于等待状态，仿真中不回收定时器内存以免与线程竞争
+    return ESP_OK;
+}
@@ -0,0 +1,321 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+#include <pthread.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+
+// 主机仿真：FreeRTOS队列与任务，基于pthread实现
+
+// 队列控制块
+struct QueueDefinition {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;       // 任意状态变化时广播
+    uint8_t *storage;          // 环形存储区
+    UBaseType_t length;        // 队列长度
+    UBaseType_t item_size;     // 元素大小（信号量为0）
+    UBaseType_t head;          // 读位置
+    UBaseType_t count;         // 当前元素个数
+};
+
+// 任务控制块
+struct tskTaskControlBlock {
+    pthread_t thread;
+    TaskFunction_t entry;
+    void *arg;
+    pthread_mutex_t notify_lock;
+    pthread_cond_t notify_cond;     // 通知值变化时广播
+    uint32_t notify_value;          // 任务通知值（按计数信号量使用）
+};
+
+static __thread struct tskTaskControlBlock *current_task = NULL; // 当前线程对应的任务
+
+/**
+ * @brief 把节拍数换算为绝对超时时刻
+ * @param ticks 等待节拍数
+ * @param ts 输出的CLOCK_MONOTONIC时刻
+ */
+static void ticks_to_deadline(TickType_t ticks, struct timespec *ts)
+{
+    clock_gettime(CLOCK_MONOTONIC, ts);
+    uint64_t ns = (uint64_t)ticks * portTICK_PERIOD_MS * 1000000ULL;
+    ts->tv_sec += ns / 1000000000ULL;
+    ts->tv_nsec += (long)(ns % 1000000000ULL);
+    if (ts->tv_nsec >= 1000000000L) {
+        ts->tv_sec++;
+        ts->tv_nsec -= 1000000000L;
+    }
+}
+
+/**
+ * @brief 在条件变量上等待，直到pred为真或超时
+ * @return pdTRUE表示条件满足
+ */
+static BaseType_t queue_wait(QueueHandle_t q, TickType_t ticks, bool (*pred)(QueueHandle_t))
+{
+    struct timespec deadline;
+
+    if (pred(q)) return pdTRUE;
+    if (ticks == 0) return pdFALSE;
+    if (ticks != portMAX_DELAY) ticks_to_deadline(ticks, &deadline);
+
+    while (!pred(q)) {
+        if (ticks == portMAX_DELAY) {
+            pthread_cond_wait(&q->cond, &q->lock);
+        } else if (pthread_cond_timedwait(&q->cond, &q->lock, &deadline) != 0) {
+            return pred(q) ? pdTRUE : pdFALSE;
+        }
+    }
+    return pdTRUE;
+}
+
+static bool queue_has_space(QueueHandle_t q)
+{
+    return q->count < q->length;
+}
+
+static bool queue_has_item(QueueHandle_t q)
+{
+    return q->count > 0;
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t uxQueueLength, UBaseType_t uxItemSize)
+{
+    if (uxQueueLength == 0) return NULL;
+
+    QueueHandle_t q = calloc(1, sizeof(*q));
+    if (q == NULL) return NULL;
+
+    if (uxItemSize > 0) {
+        q->storage = calloc(uxQueueLength, uxItemSize);
+        if (q->storage == NULL) {
+            free(q);
+            return NULL;
+        }
+    }
+
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&q->cond, &attr);
+    pthread_condattr_destroy(&attr);
+    pthread_mutex_init(&q->lock, NULL);
+
+    q->length = uxQueueLength;
+    q->item_size = uxItemSize;
+    return q;
+}
+
+void vQueueDelete(QueueHandle_t xQueue)
+{
+    if (xQueue == NULL) return;
+    pthread_cond_destroy(&xQueue->cond);
+    pthread_mutex_destroy(&xQueue->lock);
+    free(xQueue->storage);
+    free(xQueue);
+}
+
+BaseType_t xQueueSend(QueueHandle_t xQueue, const void *pvItemToQueue, TickType_t xTicksToWait)
+{
+    pthread_mutex_lock(&xQueue->lock);
+    BaseType_t ret = queue_wait(xQueue, xTicksToWait, queue_has_space);
+    if (ret == pdTRUE) {
+        if (xQueue->item_size > 0) {
+            UBaseType_t tail = (xQueue->head + xQueue->count) % xQueue->length;
+            memcpy(xQueue->storage + tail * xQueue->item_size, pvItemToQueue, xQueue->item_size);
+        }
+        xQueue->count++;
+        pthread_cond_broadcast(&xQueue->cond);
+    }
+    pthread_mutex_unlock(&xQueue->lock);
+    return ret;
+}
+
+BaseType_t xQueueSendFromISR(QueueHandle_t xQueue, const void *pvItemToQueue, BaseType_t *pxHigherPriorityTaskWoken)
+{
+    if (pxHigherPriorityTaskWoken) *pxHigherPriorityTaskWoken = pdFALSE;
+    return xQueueSend(xQueue, pvItemToQueue, 0);
+}
+
+BaseType_t xQueueReceive(QueueHandle_t xQueue, void *pvBuffer, TickType_t xTicksToWait)
+{
+    pthread_mutex_lock(&xQueue->lock);
+    BaseType_t ret = queue_wait(xQueue, xTicksToWait, queue_has_item);
+    if (ret == pdTRUE) {
+        if (xQueue->item_size > 0) {
+            memcpy(pvBuffer, xQueue->storage + xQueue->head * xQueue->item_size, xQueue->item_size);
+        }
+        xQueue->head = (xQueue->head + 1) % xQueue->length;
+        xQueue->count--;
+        pthread_cond_broadcast(&xQueue->cond);
+    }
+    pthread_mutex_unlock(&xQueue->lock);
+    return ret;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t xQueue)
+{
+    pthread_mutex_lock(&xQueue->lock);
+    UBaseType_t count = xQueue->count;
+    pthread_mutex_unlock(&xQueue->lock);
+    return count;
+}
+
+/**
+ * @brief 分配并初始化任务控制块
+ */
+static struct tskTaskControlBlock *task_alloc(void)
+{
+    struct tskTaskControlBlock *task = calloc(1, sizeof(*task));
+    if (task == NULL) return NULL;
+
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&task->notify_cond, &attr);
+    pthread_condattr_destroy(&attr);
+    pthread_mutex_init(&task->notify_lock, NULL);
+    return task;
+}
+
+static void *task_entry(void *arg)
+{
+    struct tskTaskControlBlock *task = arg;
+    current_task = task;
+    task->entry(task->arg);
+    return NULL;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t pxTaskCode, const char *pcName, uint32_t usStackDepth,
+                                   void *pvParameters, UBaseType_t uxPriority, TaskHandle_t *pxCreatedTask,
+                                   BaseType_t xCoreID)
+{
+    (void)pcName;
+    (void)usStackDepth;
+    (void)uxPriority;
+    (void)xCoreID;
+
+    struct tskTaskControlBlock *task = task_alloc();
+    if (task == NULL) return pdFAIL;
+    task->entry = pxTaskCode;
+    task->arg = pvParameters;
+
+    if (pthread_create(&task->thread, NULL, task_entry, task) != 0) {
+        free(task);
+        return pdFAIL;
+    }
+    pthread_detach(task->thread);
+    if (pxCreatedTask) *pxCreatedTask = task;
+    return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t pxTaskCode, const char *pcName, uint32_t usStackDepth,
+                       void *pvParameters, UBaseType_t uxPriority, TaskHandle_t *pxCreatedTask)
+{
+    return xTaskCreatePinnedToCore(pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority,
+                                   pxCreatedTask, tskNO_AFFINITY);
+}
+
+void vTaskDelete(TaskHandle_t xTaskToDelete)
+{
+    if (xTaskToDelete == NULL || xTaskToDelete == current_task) {
+        pthread_exit(NULL);
+    }
+    // 仿真不支持删除其他任务
+}
+
+void vTaskDelay(TickType_t xTicksToDelay)
+{
+    struct timespec ts = {
+        .tv_sec = (xTicksToDelay * portTICK_PERIOD_MS) / 1000,
+        .tv_nsec = (long)((xTicksToDelay * portTICK_PERIOD_MS) % 1000) * 1000000L,
+    };
+    while (nanosleep(&ts, &ts) != 0) {
+    }
+}
+
+/**
+ * @brief 周期性延时：唤醒时刻为*pxPreviousWakeTime + xTimeIncrement，与FreeRTOS一致不累积误差
+ * @return pdTRUE表示发生了延时，pdFALSE表示唤醒时刻已过
+ */
+BaseType_t xTaskDelayUntil(TickType_t *pxPreviousWakeTime, TickType_t xTimeIncrement)
+{
+    TickType_t wake = *pxPreviousWakeTime + xTimeIncrement;
+    *pxPreviousWakeTime = wake;
+
+    int64_t wake_us = (int64_t)wake * portTICK_PERIOD_MS * 1000;
+    int64_t now_us = esp_timer_get_time();
+    if (wake_us <= now_us) return pdFALSE;
+
+    int64_t us = wake_us - now_us;
+    struct timespec ts = {
+        .tv_sec = (time_t)(us / 1000000),
+        .tv_nsec = (long)(us % 1000000) * 1000L,
+    };
+    while (nanosleep(&ts, &ts) != 0) {
+    }
+    return pdTRUE;
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+    return (TickType_t)(esp_timer_get_time() / (1000 * portTICK_PERIOD_MS));
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void)
+{
+    if (current_task == NULL) {
+        // 非xTaskCreate创建的线程（如测试主线程）首次查询时补建控制块
+        current_task = task_alloc();
+        if (current_task) current_task->thread = pthread_self();
+    }
+    return current_task;
+}
+
+/**
+ * @brief 等待当前任务的通知值非0（轻量计数信号量）
+ * @param xClearCountOnExit pdTRUE时返回前清零，否则减1
+ * @param xTicksToWait 最长等待节拍数
+ * @return 返回前的通知值，超时为0
+ */
+uint32_t ulTaskNotifyTake(BaseType_t xClearCountOnExit, TickType_t xTicksToWait)
+{
+    struct tskTaskControlBlock *task = xTaskGetCurrentTaskHandle();
+    struct timespec deadline;
+
+    if (xTicksToWait != portMAX_DELAY) ticks_to_deadline(xTicksToWait, &deadline);
+
+    pthread_mutex_lock(&task->notify_lock);
+    while (task->notify_value == 0 && xTicksToWait != 0) {
+        if (xTicksToWait == portMAX_DELAY) {
+            pthread_cond_wait(&task->notify_cond, &task->notify_lock);
+        } else if (pthread_cond_timedwait(&task->notify_cond, &task->notify_lock, &deadline) != 0) {
+            break;
+        }
+    }
+    uint32_t value = task->notify_value;
+    if (value != 0) task->notify_value = xClearCountOnExit ? 0 : value - 1;
+    pthread_mutex_unlock(&task->notify_lock);
+    return value;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t xTaskToNotify)
+{
+    if (xTaskToNotify == NULL) return pdFAIL;
+
+    pthread_mutex_lock(&xTaskToNotify->notify_lock);
+    xTaskToNotify->notify_value++;
+    pthread_cond_broadcast(&xTaskToNotify->notify_cond);
+    pthread_mutex_unlock(&xTaskToNotify->notify_lock);
+    return pdPASS;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPriorityTaskWoken)
+{
+    xTaskNotifyGive(xTaskToNotify);
+    if (pxHigherPriorityTaskWoken) *pxHigherPriorityTaskWoken = pdTRUE;
+}
@@ -0,0 +1,166 @@
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "driver/gpio.h"
+#include "gpio_sim.h"
+
+// 主机仿真：GPIO电平表与边沿中断分发
+
+// 单个引脚状态
+typedef struct {
+    atomic_uint level;          // 当前电平
+    atomic_uint write_count;    // gpio_set_level调用次数
+    gpio_mode_t mode;
+    gpio_int_type_t intr_type;
+    bool intr_enabled;
+    gpio_isr_t isr;
+    void *isr_arg;
+    gpio_sim_output_hook_t out_hook;
+    void *out_hook_ctx;
+} gpio_sim_pin_t;
+
+static gpio_sim_pin_t pins[GPIO_NUM_MAX];
+static pthread_mutex_t isr_lock = PTHREAD_MUTEX_INITIALIZER;   // 保护中断配置
+
+static bool gpio_is_valid(gpio_num_t gpio_num)
+{
+    return gpio_num >= 0 && gpio_num < GPIO_NUM_MAX;
+}
+
+esp_err_t gpio_config(const gpio_config_t *pGPIOConfig)
+{
+    if (pGPIOConfig == NULL) return ESP_ERR_INVALID_ARG;
+
+    for (int i = 0; i < GPIO_NUM_MAX; i++) {
+        if ((pGPIOConfig->pin_bit_mask & BIT64(i)) == 0) continue;
+        pthread_mutex_lock(&isr_lock);
+        pins[i].mode = pGPIOConfig->mode;
+        pins[i].intr_type = pGPIOConfig->intr_type;
+        pins[i].intr_enabled = pGPIOConfig->intr_type != GPIO_INTR_DISABLE;
+        pthread_mutex_unlock(&isr_lock);
+        if (pGPIOConfig->pull_up_en == GPIO_PULLUP_ENABLE) {
+            atomic_store(&pins[i].level, 1);
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t gpio_set_direction(gpio_num_t gpio_num, gpio_mode_t mode)
+{
+    if (!gpio_is_valid(gpio_num)) return ESP_ERR_INVALID_ARG;
+    pins[gpio_num].mode = mode;
+    return ESP_OK;
+}
+
+esp_err_t gpio_set_level(gpio_num_t gpio_num, uint32_t level)
+{
+    if (!gpio_is_valid(gpio_num)) return ESP_ERR_INVALID_ARG;
+    atomic_store(&pins[gpio_num].level, level ? 1 : 0);
+    atomic_fetch_add(&pins[gpio_num].write_count, 1);
+
+    pthread_mutex_lock(&isr_lock);
+    gpio_sim_output_hook_t hook = pins[gpio_num].out_hook;
+    void *hook_ctx = pins[gpio_num].out_hook_ctx;
+    pthread_mutex_unlock(&isr_lock);
+    if (hook) hook(hook_ctx, gpio_num, level ? 1 : 0);
+    return ESP_OK;
+}
+
+int gpio_get_level(gpio_num_t gpio_num)
+{
+    if (!gpio_is_valid(gpio_num)) return 0;
+    return (int)atomic_load(&pins[gpio_num].level);
+}
+
+esp_err_t gpio_set_intr_type(gpio_num_t gpio_num, gpio_int_type_t intr_type)
+{
+    if (!gpio_is_valid(gpio_num)) return ESP_ERR_INVALID_ARG;
+    pthread_mutex_lock(&isr_lock);
+    pins[gpio_num].intr_type = intr_type;
+    pthread_mutex_unlock(&isr_lock);
+    return ESP_OK;
+}
+
+esp_err_t gpio_intr_enable(gpio_num_t gpio_num)
+{
+    if (!gpio_is_valid(gpio_num)) return ESP_ERR_INVALID_ARG;
+    pthread_mutex_lock(&isr_lock);
+    pins[gpio_num].intr_enabled = true;
+    pthread_mutex_unlock(&isr_lock);
+    return ESP_OK;
+}
+
+esp_err_t gpio_intr_disable(gpio_num_t gpio_num)
+{
+    if (!gpio_is_valid(gpio_num)) return ESP_ERR_INVALID_ARG;
+    pthread_mutex_lock(&isr_lock);
+    pins[gpio_num].intr_enabled = false;
+    pthread_mutex_unlock(&isr_lock);
+    return ESP_OK;
+}
+
+esp_err_t gpio_install_isr_service(int intr_alloc_flags)
+{
+    (void)intr_alloc_flags;
+    return ESP_OK;
+}
+
+esp_err_t gpio_isr_handler_add(gpio_num_t gpio_num, gpio_isr_t isr_handler, void *args)
+{
+    if (!gpio_is_valid(gpio_num)) return ESP_ERR_INVALID_ARG;
+    pthread_mutex_lock(&isr_lock);
+    pins[gpio_num].isr = isr_handler;
+    pins[gpio_num].isr_arg = args;
+    pthread_mutex_unlock(&isr_lock);
+    return ESP_OK;
+}
+
+esp_err_t gpio_isr_handler_remove(gpio_num_t gpio_num)
+{
+    return gpio_isr_handler_add(gpio_num, NULL, NULL);
+}
+
+/**
+ * @brief 从外部驱动输入引脚电平，满足中断条件时在调用线程中执行ISR
+ */
+void gpio_sim_drive_input(gpio_num_t gpio_num, uint32_t level)
+{
+    if (!gpio_is_valid(gpio_num)) return;
+
+    level = level ? 1 : 0;
+    uint32_t prev = atomic_exchange(&pins[gpio_num].level, level);
+
+    pthread_mutex_lock(&isr_lock);
+    bool enabled = pins[gpio_num].intr_enabled;
+    gpio_int_type_t intr_type = pins[gpio_num].intr_type;
+    gpio_isr_t isr = pins[gpio_num].isr;
+    void *isr_arg = pins[gpio_num].isr_arg;
+    pthread_mutex_unlock(&isr_lock);
+    if (!enabled || isr == NULL) return;
+
+    bool fire = false;
+    switch (intr_type) {
+    case GPIO_INTR_POSEDGE:    fire = prev == 0 && level == 1; break;
+    case GPIO_INTR_NEGEDGE:    fire = prev == 1 && level == 0; break;
+    case GPIO_INTR_ANYEDGE:    fire = prev != level; break;
+    case GPIO_INTR_LOW_LEVEL:  fire = level == 0; break;
+    case GPIO_INTR_HIGH_LEVEL: fire = level == 1; break;
+    default: break;
+    }
+    if (fire) isr(isr_arg);
+}
+
+void gpio_sim_set_output_hook(gpio_num_t gpio_num, gpio_sim_output_hook_t hook, void *user_ctx)
+{
+    if (!gpio_is_valid(gpio_num)) return;
+    pthread_mutex_lock(&isr_lock);
+    pins[gpio_num].out_hook = hook;
+    pins[gpio_num].out_hook_ctx = user_ctx;
+    pthread_mutex_unlock(&isr_lock);
+}
+
+uint32_t gpio_sim_get_write_count(gpio_num_t gpio_num)
+{
+    if (!gpio_is_valid(gpio_num)) return 0;
+    return atomic_load(&pins[gpio_num].write_count);
+}
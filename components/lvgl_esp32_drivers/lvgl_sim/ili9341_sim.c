@@ -0,0 +1,333 @@
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include "driver/gpio.h"
+#include "esp_timer.h"
+#include "gpio_sim.h"
+#include "spi_sim.h"
+#include "ili9341_sim.h"
+
+// 主机仿真：ILI9341面板模型
+
+// MADCTL位定义
+#define MADCTL_MY   0x80    // 行地址顺序
+#define MADCTL_MX   0x40    // 列地址顺序
+#define MADCTL_MV   0x20    // 行列交换
+
+// 数据手册的上电时序最小值
+#define RESET_PULSE_US      10      // RST低电平
+#define RESET_CMD_US        5000    // RST释放后到第一条命令
+#define RESET_SLPOUT_US     120000  // RST释放后到SLPOUT
+#define SLPOUT_CMD_US       5000    // SLPOUT后到下一条命令
+
+// 面板寄存器与GRAM
+typedef struct {
+    pthread_mutex_t lock;
+    spi_host_device_t host;
+    int dc_io_num;
+
+    uint16_t gram[ILI9341_SIM_GRAM_H][ILI9341_SIM_GRAM_W];
+    uint8_t madctl;
+    bool sleeping;
+    bool display_on;
+
+    uint8_t cmd;            // 当前命令
+    uint32_t param_idx;     // 当前命令已收到的参数字节数
+    uint8_t params[4];      // CASET/PASET参数
+    uint16_t sc, ec;        // 列窗口
+    uint16_t sp, ep;        // 页窗口
+    uint16_t cur_c, cur_p;  // 写指针
+    int pending_byte;       // RAMWR中等待配对的高字节，-1表示无
+
+    ili9341_sim_boot_t boot;        // 上电时序记录
+    int64_t rst_low_us;             // RST拉低的时刻
+    uint64_t pixels_since_reset;    // 复位后写入GRAM的像素数
+
+    ili9341_sim_frame_t total;      // 累计统计（不含总线部分）
+    ili9341_sim_frame_t frame_base; // frame_begin时的快照
+    spi_sim_stats_t bus_base;
+} ili9341_sim_t;
+
+static ili9341_sim_t panel = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .pending_byte = -1,
+};
+
+/**
+ * @brief 复位后的寄存器状态（GRAM内容保持不变，与真实面板一致为未定义）
+ */
+static void panel_reset(void)
+{
+    panel.madctl = 0;
+    panel.sleeping = true;
+    panel.display_on = false;
+    panel.cmd = 0;
+    panel.param_idx = 0;
+    panel.sc = 0;
+    panel.ec = ILI9341_SIM_GRAM_W - 1;
+    panel.sp = 0;
+    panel.ep = ILI9341_SIM_GRAM_H - 1;
+    panel.pending_byte = -1;
+}
+
+/**
+ * @brief 按MADCTL把逻辑地址（列c，页p）映射到GRAM物理位置并写入
+ */
+static void panel_write_pixel(uint16_t c, uint16_t p, uint16_t color)
+{
+    int col = (panel.madctl & MADCTL_MV) ? p : c;
+    int row = (panel.madctl & MADCTL_MV) ? c : p;
+    if (panel.madctl & MADCTL_MX) col = ILI9341_SIM_GRAM_W - 1 - col;
+    if (panel.madctl & MADCTL_MY) row = ILI9341_SIM_GRAM_H - 1 - row;
+
+    if (col < 0 || col >= ILI9341_SIM_GRAM_W || row < 0 || row >= ILI9341_SIM_GRAM_H) return;
+    panel.gram[row][col] = color;
+    panel.total.pixels_written++;
+    if (panel.pixels_since_reset++ == 0) panel.boot.first_pixel_us = esp_timer_get_time();
+}
+
+/**
+ * @brief 写入一个像素并推进窗口内的写指针（先列后页）
+ */
+static void panel_ram_write(uint16_t color)
+{
+    if (panel.cur_p > panel.ep) return;     // 窗口已写满，多余数据丢弃
+
+    panel_write_pixel(panel.cur_c, panel.cur_p, color);
+    if (panel.cur_c >= panel.ec) {
+        panel.cur_c = panel.sc;
+        panel.cur_p++;
+    } else {
+        panel.cur_c++;
+    }
+}
+
+/**
+ * @brief 按数据手册检查命令的时刻并记录上电过程
+ */
+static void panel_check_timing(uint8_t cmd)
+{
+    ili9341_sim_boot_t *boot = &panel.boot;
+    int64_t now = esp_timer_get_time();
+
+    if (now - boot->reset_release_us < RESET_CMD_US) boot->timing_violations++;
+    if (boot->slpout_us != 0 && now - boot->slpout_us < SLPOUT_CMD_US) boot->timing_violations++;
+    if (cmd == 0x11) {
+        if (now - boot->reset_release_us < RESET_SLPOUT_US) boot->timing_violations++;
+        boot->slpout_us = now;
+    } else if (cmd == 0x29 && boot->display_on_us == 0) {
+        boot->display_on_us = now;
+        boot->pixels_before_on = panel.pixels_since_reset;
+    }
+}
+
+static void panel_command(uint8_t cmd)
+{
+    panel_check_timing(cmd);
+    panel.cmd = cmd;
+    panel.param_idx = 0;
+    panel.pending_byte = -1;
+    panel.total.cmd_count++;
+
+    switch (cmd) {
+    case 0x01:                              // SWRESET
+        panel_reset();
+        break;
+    case 0x10:                              // SLPIN
+        panel.sleeping = true;
+        break;
+    case 0x11:                              // SLPOUT
+        panel.sleeping = false;
+        break;
+    case 0x28:                              // DISPOFF
+        panel.display_on = false;
+        break;
+    case 0x29:                              // DISPON
+        panel.display_on = true;
+        break;
+    case 0x2C:                              // RAMWR：写指针回到窗口起点
+        panel.cur_c = panel.sc;
+        panel.cur_p = panel.sp;
+        panel.total.ramwr_count++;
+        break;
+    case 0x3C:                              // RAMWRC：从上次位置继续
+        panel.total.ramwr_count++;
+        break;
+    default:
+        break;
+    }
+}
+
+static void panel_data(uint8_t data)
+{
+    switch (panel.cmd) {
+    case 0x2A:                              // CASET
+    case 0x2B:                              // PASET
+        if (panel.param_idx < 4) panel.params[panel.param_idx] = data;
+        if (++panel.param_idx == 4) {
+            uint16_t start = (uint16_t)(panel.params[0] << 8 | panel.params[1]);
+            uint16_t end = (uint16_t)(panel.params[2] << 8 | panel.params[3]);
+            if (panel.cmd == 0x2A) {
+                panel.sc = start;
+                panel.ec = end;
+                panel.total.window_count++;
+            } else {
+                panel.sp = start;
+                panel.ep = end;
+            }
+        }
+        break;
+    case 0x2C:
+    case 0x3C:
+        if (panel.pending_byte < 0) {
+            panel.pending_byte = data;
+        } else {
+            panel_ram_write((uint16_t)(panel.pending_byte << 8 | data));   // 线上为大端RGB565
+            panel.pending_byte = -1;
+        }
+        break;
+    case 0x36:                              // MADCTL
+        if (panel.param_idx++ == 0) panel.madctl = data;
+        break;
+    default:
+        panel.param_idx++;
+        break;
+    }
+}
+
+/**
+ * @brief SPI从设备回调：DC=0时每个字节是命令，DC=1时是参数或像素数据
+ */
+static void panel_transfer(void *user_ctx, const spi_transaction_t *trans,
+                           const uint8_t *mosi, size_t cmd_len, size_t len, uint8_t *miso)
+{
+    (void)user_ctx;
+    (void)trans;
+    (void)cmd_len;
+    (void)miso;
+
+    bool is_data = gpio_get_level(panel.dc_io_num) != 0;
+
+    pthread_mutex_lock(&panel.lock);
+    for (size_t i = 0; i < len; i++) {
+        if (is_data) {
+            panel_data(mosi[i]);
+        } else {
+            panel_command(mosi[i]);
+        }
+    }
+    pthread_mutex_unlock(&panel.lock);
+}
+
+/**
+ * @brief RST引脚监视：低电平期间面板保持复位
+ */
+static void panel_rst_hook(void *user_ctx, gpio_num_t gpio_num, uint32_t level)
+{
+    (void)user_ctx;
+    (void)gpio_num;
+
+    int64_t now = esp_timer_get_time();
+    pthread_mutex_lock(&panel.lock);
+    if (level == 0) {
+        panel_reset();
+        panel.rst_low_us = now;
+    } else if (panel.rst_low_us != 0) {
+        // 复位释放：重新开始记录上电过程，之前的违例保留
+        uint32_t violations = panel.boot.timing_violations;
+        if (now - panel.rst_low_us < RESET_PULSE_US) violations++;
+        memset(&panel.boot, 0, sizeof(panel.boot));
+        panel.boot.reset_release_us = now;
+        panel.boot.timing_violations = violations;
+        panel.pixels_since_reset = 0;
+        panel.rst_low_us = 0;
+    }
+    pthread_mutex_unlock(&panel.lock);
+}
+
+void ili9341_sim_init(spi_host_device_t host, int cs_io_num, int dc_io_num, int rst_io_num)
+{
+    pthread_mutex_lock(&panel.lock);
+    panel.host = host;
+    panel.dc_io_num = dc_io_num;
+    panel_reset();
+    memset(panel.gram, 0, sizeof(panel.gram));
+    memset(&panel.total, 0, sizeof(panel.total));
+    pthread_mutex_unlock(&panel.lock);
+
+    spi_sim_attach_model(cs_io_num, panel_transfer, NULL);
+    if (rst_io_num >= 0) gpio_sim_set_output_hook(rst_io_num, panel_rst_hook, NULL);
+}
+
+uint16_t ili9341_sim_get_gram(int col, int row)
+{
+    if (col < 0 || col >= ILI9341_SIM_GRAM_W || row < 0 || row >= ILI9341_SIM_GRAM_H) return 0;
+    pthread_mutex_lock(&panel.lock);
+    uint16_t color = panel.gram[row][col];
+    pthread_mutex_unlock(&panel.lock);
+    return color;
+}
+
+uint16_t ili9341_sim_get_pixel(int x, int y)
+{
+    // 面板竖装、横向观看：观看坐标x对应GRAM行，y对应GRAM列
+    return ili9341_sim_get_gram(y, x);
+}
+
+uint8_t ili9341_sim_get_madctl(void)
+{
+    pthread_mutex_lock(&panel.lock);
+    uint8_t madctl = panel.madctl;
+    pthread_mutex_unlock(&panel.lock);
+    return madctl;
+}
+
+bool ili9341_sim_is_display_on(void)
+{
+    pthread_mutex_lock(&panel.lock);
+    bool on = panel.display_on && !panel.sleeping;
+    pthread_mutex_unlock(&panel.lock);
+    return on;
+}
+
+void ili9341_sim_get_boot(ili9341_sim_boot_t *boot)
+{
+    pthread_mutex_lock(&panel.lock);
+    *boot = panel.boot;
+    pthread_mutex_unlock(&panel.lock);
+}
+
+void ili9341_sim_frame_begin(void)
+{
+    spi_sim_stats_t bus;
+    spi_sim_get_stats(panel.host, &bus);
+
+    pthread_mutex_lock(&panel.lock);
+    panel.frame_base = panel.total;
+    panel.bus_base = bus;
+    pthread_mutex_unlock(&panel.lock);
+}
+
+void ili9341_sim_frame_end(ili9341_sim_frame_t *frame)
+{
+    spi_sim_stats_t bus;
+    spi_sim_get_stats(panel.host, &bus);
+
+    pthread_mutex_lock(&panel.lock);
+    frame->trans_count = bus.trans_count - panel.bus_base.trans_count;
+    frame->bus_bytes = (bus.tx_bytes + bus.rx_bytes) - (panel.bus_base.tx_bytes + panel.bus_base.rx_bytes);
+    frame->wire_time_ns = bus.wire_time_ns - panel.bus_base.wire_time_ns;
+    frame->cmd_count = panel.total.cmd_count - panel.frame_base.cmd_count;
+    frame->window_count = panel.total.window_count - panel.frame_base.window_count;
+    frame->ramwr_count = panel.total.ramwr_count - panel.frame_base.ramwr_count;
+    frame->pixels_written = panel.total.pixels_written - panel.frame_base.pixels_written;
+    pthread_mutex_unlock(&panel.lock);
+}
+
+void ili9341_sim_print_frame(const char *name, const ili9341_sim_frame_t *frame)
+{
+    printf("[ili9341_sim] %s: %u trans, %llu bytes, wire %.3f ms, %u cmds, %u windows, %u RAMWR, %llu px\n",
+           name, (unsigned)frame->trans_count, (unsigned long long)frame->bus_bytes,
+           frame->wire_time_ns / 1e6, (unsigned)frame->cmd_count, (unsigned)frame->window_count,
+           (unsigned)frame->ramwr_count, (unsigned long long)frame->pixels_written);
+}
@@ -0,0 +1,12 @@
+#ifndef __ESP_ATTR_H
+#define __ESP_ATTR_H
+
+// 主机仿真：内存段属性在主机上没有意义，全部展开为空
+
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define DMA_ATTR
+#define WORD_ALIGNED_ATTR __attribute__((aligned(4)))
+#define EXT_RAM_BSS_ATTR
+
+#endif /* __ESP_ATTR_H */
@@ -0,0 +1,9 @@
+#ifndef __ESP_BIT_DEFS_H
+#define __ESP_BIT_DEFS_H
+
+#include <stdint.h>
+
+#define BIT(nr)     (1UL << (nr))
+#define BIT64(nr)   (1ULL << (nr))
+
+#endif /* __ESP_BIT_DEFS_H */
@@ -0,0 +1,33 @@
+#ifndef __ESP_CPU_H
+#define __ESP_CPU_H
+
+#include <stdint.h>
+#include <time.h>
+
+// 主机仿真：CPU周期计数，x86上读TSC，其他平台按1GHz由单调时钟换算
+
+typedef uint32_t esp_cpu_cycle_count_t;
+
+/**
+ * @brief 读取CPU周期计数（32位，会回绕）
+ */
+static inline esp_cpu_cycle_count_t esp_cpu_get_cycle_count(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return (esp_cpu_cycle_count_t)__builtin_ia32_rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (esp_cpu_cycle_count_t)((uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec);
+#endif
+}
+
+/**
+ * @brief 当前核号，主机上只有一个核
+ */
+static inline int esp_cpu_get_core_id(void)
+{
+    return 0;
+}
+
+#endif /* __ESP_CPU_H */
@@ -0,0 +1,21 @@
+#ifndef __ESP_HEAP_CAPS_H
+#define __ESP_HEAP_CAPS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// 主机仿真：所有内存能力都由系统堆满足
+
+#define MALLOC_CAP_EXEC     (1 << 0)
+#define MALLOC_CAP_32BIT    (1 << 1)
+#define MALLOC_CAP_8BIT     (1 << 2)
+#define MALLOC_CAP_DMA      (1 << 3)
+#define MALLOC_CAP_SPIRAM   (1 << 10)
+#define MALLOC_CAP_INTERNAL (1 << 11)
+#define MALLOC_CAP_DEFAULT  (1 << 12)
+
+void *heap_caps_malloc(size_t size, uint32_t caps);
+void *heap_caps_calloc(size_t n, size_t size, uint32_t caps);
+void heap_caps_free(void *ptr);
+
+#endif /* __ESP_HEAP_CAPS_H */
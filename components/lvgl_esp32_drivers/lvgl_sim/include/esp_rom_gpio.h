@@ -0,0 +1,8 @@
+#ifndef __ESP_ROM_GPIO_H
+#define __ESP_ROM_GPIO_H
+
+#include <stdint.h>
+
+void esp_rom_gpio_pad_select_gpio(uint32_t iopad_num);
+
+#endif /* __ESP_ROM_GPIO_H */
@@ -0,0 +1,13 @@
+#ifndef __ESP_ROM_SYS_H
+#define __ESP_ROM_SYS_H
+
+#include <stdint.h>
+
+/**
+ * @brief CPU周期计数（esp_cpu_get_cycle_count）每微秒的周期数
+ *
+ * 主机仿真：x86上为TSC频率，首次调用时对照单调时钟测定一次，之后不变；其他平台为1000
+ */
+uint32_t esp_rom_get_cpu_ticks_per_us(void);
+
+#endif /* __ESP_ROM_SYS_H */
@@ -0,0 +1,8 @@
+#ifndef __ESP_SYSTEM_H
+#define __ESP_SYSTEM_H
+
+#include "esp_err.h"
+#include "esp_attr.h"
+#include "esp_bit_defs.h"
+
+#endif /* __ESP_SYSTEM_H */
@@ -0,0 +1,26 @@
+#ifndef __FREERTOS_FREERTOS_H
+#define __FREERTOS_FREERTOS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// 主机仿真：FreeRTOS内核子集，任务为pthread，节拍为1ms
+
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdFALSE     ((BaseType_t)0)
+#define pdTRUE      ((BaseType_t)1)
+#define pdPASS      pdTRUE
+#define pdFAIL      pdFALSE
+
+#define configTICK_RATE_HZ      1000
+#define portTICK_PERIOD_MS      ((TickType_t)1000 / configTICK_RATE_HZ)
+#define portMAX_DELAY           ((TickType_t)0xffffffffUL)
+#define pdMS_TO_TICKS(xTimeInMs) ((TickType_t)(((TickType_t)(xTimeInMs) * (TickType_t)configTICK_RATE_HZ) / (TickType_t)1000U))
+#define tskNO_AFFINITY          ((BaseType_t)0x7FFFFFFF)
+
+#define portYIELD_FROM_ISR(x)   ((void)(x))
+
+#endif /* __FREERTOS_FREERTOS_H */
@@ -0,0 +1,27 @@
+#ifndef __FREERTOS_SEMPHR_H
+#define __FREERTOS_SEMPHR_H
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+
+// 主机仿真：信号量用元素大小为0的队列实现（二值信号量长度为1），与FreeRTOS一致
+
+typedef QueueHandle_t SemaphoreHandle_t;
+
+#define xSemaphoreCreateBinary()            xQueueCreate(1, 0)
+#define xSemaphoreGive(xSemaphore)          xQueueSend((xSemaphore), NULL, 0)
+#define xSemaphoreGiveFromISR(xSemaphore, pxHigherPriorityTaskWoken) \
+    xQueueSendFromISR((xSemaphore), NULL, (pxHigherPriorityTaskWoken))
+#define xSemaphoreTake(xSemaphore, xBlockTime) xQueueReceive((xSemaphore), NULL, (xBlockTime))
+#define vSemaphoreDelete(xSemaphore)        vQueueDelete(xSemaphore)
+
+static inline SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t uxMaxCount, UBaseType_t uxInitialCount)
+{
+    SemaphoreHandle_t sem = xQueueCreate(uxMaxCount, 0);
+    for (UBaseType_t i = 0; sem != NULL && i < uxInitialCount; i++) {
+        xQueueSend(sem, NULL, 0);
+    }
+    return sem;
+}
+
+#endif /* __FREERTOS_SEMPHR_H */
@@ -0,0 +1,39 @@
+#ifndef __GPIO_SIM_H
+#define __GPIO_SIM_H
+
+#include <stdint.h>
+#include "driver/gpio.h"
+
+// 主机仿真：GPIO外部激励接口（仅在主机构建中存在）
+
+/**
+ * @brief 从外部驱动输入引脚电平，满足中断边沿条件时在调用线程中执行ISR
+ * @param gpio_num 引脚号
+ * @param level 电平
+ */
+void gpio_sim_drive_input(gpio_num_t gpio_num, uint32_t level);
+
+/**
+ * @brief 输出引脚电平变化回调（用于从设备模型监视RST等引脚）
+ * @param user_ctx 用户上下文
+ * @param gpio_num 引脚号
+ * @param level 新电平
+ */
+typedef void (*gpio_sim_output_hook_t)(void *user_ctx, gpio_num_t gpio_num, uint32_t level);
+
+/**
+ * @brief 注册输出引脚回调，gpio_set_level后在调用线程中执行
+ * @param gpio_num 引脚号
+ * @param hook 回调函数，NULL表示取消
+ * @param user_ctx 用户上下文
+ */
+void gpio_sim_set_output_hook(gpio_num_t gpio_num, gpio_sim_output_hook_t hook, void *user_ctx);
+
+/**
+ * @brief 读取引脚电平写入次数（用于统计DC翻转等）
+ * @param gpio_num 引脚号
+ * @return 调用gpio_set_level的次数
+ */
+uint32_t gpio_sim_get_write_count(gpio_num_t gpio_num);
+
+#endif /* __GPIO_SIM_H */
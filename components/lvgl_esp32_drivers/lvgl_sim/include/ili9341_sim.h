@@ -0,0 +1,97 @@
+#ifndef __ILI9341_SIM_H
+#define __ILI9341_SIM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "driver/spi_master.h"
+
+// 主机仿真：ILI9341面板模型（仅在主机构建中存在）
+// 按DC电平解析SPI字节流，执行CASET/PASET/RAMWR/MADCTL等命令，写入240x320的GRAM
+
+#define ILI9341_SIM_GRAM_W  240     // GRAM物理列数
+#define ILI9341_SIM_GRAM_H  320     // GRAM物理行数
+#define ILI9341_SIM_VIEW_W  320     // 手柄上横向观看时的宽度
+#define ILI9341_SIM_VIEW_H  240     // 手柄上横向观看时的高度
+
+// 一帧内的总线与面板统计
+typedef struct {
+    uint32_t trans_count;       // SPI事务数
+    uint64_t bus_bytes;         // 线上字节数（MOSI+MISO）
+    uint64_t wire_time_ns;      // 按时钟折算的线上时间
+    uint32_t cmd_count;         // 命令字节数（DC=0）
+    uint32_t window_count;      // 窗口设置次数（CASET）
+    uint32_t ramwr_count;       // RAMWR/RAMWRC次数
+    uint64_t pixels_written;    // 写入GRAM的像素数
+} ili9341_sim_frame_t;
+
+// 上电过程记录（esp_timer时刻，0表示尚未发生），RST释放时重新开始
+typedef struct {
+    int64_t reset_release_us;   // RST释放
+    int64_t first_pixel_us;     // 复位后第一次写入GRAM
+    int64_t slpout_us;          // 收到SLPOUT
+    int64_t display_on_us;      // 复位后第一次收到DISPON，此后GRAM内容可见
+    uint64_t pixels_before_on;  // 收到DISPON时复位后已写入GRAM的像素数
+    uint32_t timing_violations; // 不满足数据手册最小间隔的次数：RST脉冲不足10us、RST释放后5ms内的命令、
+                                // RST释放后120ms内的SLPOUT、SLPOUT后5ms内的命令（跨复位累计）
+} ili9341_sim_boot_t;
+
+/**
+ * @brief 初始化面板模型并挂到SPI总线上
+ * @param host 面板所在的SPI主机
+ * @param cs_io_num 片选引脚
+ * @param dc_io_num 数据/命令引脚
+ * @param rst_io_num 复位引脚，-1表示不监视
+ */
+void ili9341_sim_init(spi_host_device_t host, int cs_io_num, int dc_io_num, int rst_io_num);
+
+/**
+ * @brief 读取GRAM中的物理像素
+ * @param col 物理列（0~239）
+ * @param row 物理行（0~319）
+ * @return 面板收到的RGB565值（按线上大端顺序组合）
+ */
+uint16_t ili9341_sim_get_gram(int col, int row);
+
+/**
+ * @brief 读取手柄上横向观看时的像素，与MADCTL=0x28（横向）时的逻辑坐标一致
+ * @param x 横坐标（0~319）
+ * @param y 纵坐标（0~239）
+ * @return RGB565值
+ */
+uint16_t ili9341_sim_get_pixel(int x, int y);
+
+/**
+ * @brief 读取当前MADCTL寄存器
+ */
+uint8_t ili9341_sim_get_madctl(void);
+
+/**
+ * @brief 面板是否已退出睡眠并开启显示
+ */
+bool ili9341_sim_is_display_on(void);
+
+/**
+ * @brief 读取上电过程记录
+ * @param boot 输出
+ */
+void ili9341_sim_get_boot(ili9341_sim_boot_t *boot);
+
+/**
+ * @brief 标记一帧开始，记录统计起点
+ */
+void ili9341_sim_frame_begin(void);
+
+/**
+ * @brief 标记一帧结束
+ * @param frame 输出自frame_begin以来的统计
+ */
+void ili9341_sim_frame_end(ili9341_sim_frame_t *frame);
+
+/**
+ * @brief 打印一帧统计
+ * @param name 帧名称
+ * @param frame 统计数据
+ */
+void ili9341_sim_print_frame(const char *name, const ili9341_sim_frame_t *frame);
+
+#endif /* __ILI9341_SIM_H */
@@ -0,0 +1,90 @@
+#ifndef __SPI_SIM_H
+#define __SPI_SIM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "driver/spi_master.h"
+
+// 主机仿真：SPI总线控制与统计接口（仅在主机构建中存在）
+
+// 总线统计
+typedef struct {
+    uint32_t trans_count;    // 已完成事务数
+    uint64_t tx_bytes;       // MOSI方向字节数（不含命令/地址相位）
+    uint64_t rx_bytes;       // MISO方向字节数
+    uint64_t wire_time_ns;   // 按时钟频率折算的线上时间（纳秒）
+    uint32_t torn_count;     // 传输期间发送缓冲区被改写的事务数（撕裂）
+    uint32_t max_in_air;     // 同时在途（已排队未取回）的最大事务数
+    uint64_t cb_cycles_min;  // 各事务pre_cb返回到调用post_cb的CPU周期数之和
+    uint64_t cb_cycles_max;  // 各事务调用pre_cb到post_cb返回的CPU周期数之和；
+                             // 设备在pre_cb和post_cb中计时的总线忙时间落在两者之间
+} spi_sim_stats_t;
+
+/**
+ * @brief 事务监视回调，在“DMA”完成后、post_cb之前调用
+ * @param host SPI主机
+ * @param trans 完成的事务
+ * @param start_us 开始传输时刻（仿真总线时间线，esp_timer时基）
+ * @param end_us 传输结束时刻（同上）
+ * @param user_ctx 用户上下文
+ */
+typedef void (*spi_sim_monitor_cb_t)(spi_host_device_t host, const spi_transaction_t *trans,
+                                     int64_t start_us, int64_t end_us, void *user_ctx);
+
+/**
+ * @brief 从设备模型：在每个事务的线上阶段被调用，解析MOSI并填写MISO
+ * @param user_ctx 注册时传入的上下文
+ * @param trans 当前事务
+ * @param mosi 线上MOSI字节流（命令相位+数据相位，地址相位不含在内）
+ * @param cmd_len mosi中命令相位的字节数
+ * @param len mosi总字节数
+ * @param miso 输出的MISO字节流，与mosi逐字节对应，调用前已清零
+ */
+typedef void (*spi_sim_model_cb_t)(void *user_ctx, const spi_transaction_t *trans,
+                                   const uint8_t *mosi, size_t cmd_len, size_t len, uint8_t *miso);
+
+/**
+ * @brief 把从设备模型挂到某个片选引脚上
+ * @param cs_io_num 设备配置中的spics_io_num
+ * @param cb 模型回调，NULL表示移除
+ * @param user_ctx 用户上下文
+ */
+void spi_sim_attach_model(int cs_io_num, spi_sim_model_cb_t cb, void *user_ctx);
+
+/**
+ * @brief 设置线上时间的实时缩放比例
+ * @param percent 100为按真实时钟休眠，0为不休眠（仅统计）
+ */
+void spi_sim_set_time_scale(uint32_t percent);
+
+/**
+ * @brief 设置直通模式：队列事务在spi_device_queue_trans中立即完成，
+ *        只调用pre_cb/post_cb并计数，不执行从设备模型、不占用线上时间，
+ *        用于测量驱动侧每个事务的开销
+ * @param host SPI主机
+ * @param bypass true为直通
+ */
+void spi_sim_set_bypass(spi_host_device_t host, bool bypass);
+
+/**
+ * @brief 读取总线统计
+ * @param host SPI主机
+ * @param stats 输出统计
+ */
+void spi_sim_get_stats(spi_host_device_t host, spi_sim_stats_t *stats);
+
+/**
+ * @brief 清零总线统计
+ * @param host SPI主机
+ */
+void spi_sim_reset_stats(spi_host_device_t host);
+
+/**
+ * @brief 注册事务监视回调
+ * @param host SPI主机
+ * @param cb 回调函数，NULL表示取消
+ * @param user_ctx 用户上下文
+ */
+void spi_sim_set_monitor(spi_host_device_t host, spi_sim_monitor_cb_t cb, void *user_ctx);
+
+#endif /* __SPI_SIM_H */
@@ -0,0 +1,42 @@
+#ifndef __XPT2046_SIM_H
+#define __XPT2046_SIM_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// 主机仿真：XPT2046触摸控制器模型（仅在主机构建中存在）
+// 解析MOSI上的控制字节，在其后16个时钟内输出12位转换结果，按脚本回放采样
+
+// 一次完整采样的原始12位转换值
+typedef struct {
+    uint16_t x;     // CMD_X_READ（通道001）
+    uint16_t y;     // CMD_Y_READ（通道101）
+    uint16_t z1;    // CMD_Z1_READ（通道011）
+    uint16_t z2;    // CMD_Z2_READ（通道100）
+} xpt2046_sim_sample_t;
+
+/**
+ * @brief 初始化触摸模型并挂到SPI总线上，PENIRQ置为未触摸（高电平）
+ * @param cs_io_num 片选引脚
+ * @param irq_io_num PENIRQ引脚
+ */
+void xpt2046_sim_init(int cs_io_num, int irq_io_num);
+
+/**
+ * @brief 按下触摸屏：装载采样脚本并拉低PENIRQ（产生下降沿）
+ * @param samples 采样序列，某通道在同一采样内被重复转换时前进到下一个采样，末尾保持最后一个
+ * @param count 采样个数
+ */
+void xpt2046_sim_press(const xpt2046_sim_sample_t *samples, size_t count);
+
+/**
+ * @brief 松开触摸屏：PENIRQ回到高电平，之后的转换结果为0
+ */
+void xpt2046_sim_release(void);
+
+/**
+ * @brief 读取累计转换次数
+ */
+uint32_t xpt2046_sim_get_conversion_count(void);
+
+#endif /* __XPT2046_SIM_H */
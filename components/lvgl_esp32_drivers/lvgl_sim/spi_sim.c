@@ -0,0 +1,543 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+#include <pthread.h>
+#include "driver/spi_master.h"
+#include "esp_timer.h"
+#include "esp_cpu.h"
+#include "spi_sim.h"
+
+// 主机仿真：SPI主机驱动，队列事务由每个设备的“DMA”线程按顺序完成
+
+// 单个SPI主机（总线）状态
+typedef struct {
+    bool initialized;
+    spi_bus_config_t bus_cfg;
+    pthread_mutex_t bus_lock;          // 同一时刻总线上只有一个事务
+    pthread_mutex_t stats_lock;        // 保护统计与监视回调
+    spi_sim_stats_t stats;
+    spi_sim_monitor_cb_t monitor;
+    void *monitor_ctx;
+    uint64_t busy_until_ns;            // 上一个事务在仿真总线时间线上的结束时刻
+    bool bypass;                       // 直通模式：排队即完成，不经过“DMA”线程
+} spi_sim_host_t;
+
+// SPI设备：待传输队列 + 已完成队列
+struct spi_device_t {
+    spi_host_device_t host;
+    spi_device_interface_config_t cfg;
+    pthread_t dma_thread;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;               // 任意队列状态变化时广播
+    spi_transaction_t **pending;       // 已排队、等待传输
+    uint64_t *pending_ns;              // 各待传输事务的排队时刻
+    spi_transaction_t **done;          // 已完成、等待取回
+    int pending_head, pending_count;
+    int done_head, done_count;
+    int in_flight;                     // 已排队但尚未被取回的事务数
+};
+
+static spi_sim_host_t hosts[SPI_HOST_MAX] = {
+    [0 ... SPI_HOST_MAX - 1] = {
+        .bus_lock = PTHREAD_MUTEX_INITIALIZER,
+        .stats_lock = PTHREAD_MUTEX_INITIALIZER,
+    },
+};
+static volatile uint32_t time_scale_percent = 100;   // 线上时间实时缩放比例
+
+// 按片选引脚挂接的从设备模型
+#define SPI_SIM_MAX_MODELS 4
+static struct {
+    int cs_io_num;
+    spi_sim_model_cb_t cb;
+    void *user_ctx;
+} models[SPI_SIM_MAX_MODELS];
+static pthread_mutex_t models_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * @brief 把节拍数换算为绝对超时时刻
+ */
+static void ticks_to_deadline(TickType_t ticks, struct timespec *ts)
+{
+    clock_gettime(CLOCK_MONOTONIC, ts);
+    uint64_t ns = (uint64_t)ticks * portTICK_PERIOD_MS * 1000000ULL;
+    ts->tv_sec += ns / 1000000000ULL;
+    ts->tv_nsec += (long)(ns % 1000000000ULL);
+    if (ts->tv_nsec >= 1000000000L) {
+        ts->tv_sec++;
+        ts->tv_nsec -= 1000000000L;
+    }
+}
+
+/**
+ * @brief 在设备条件变量上等待，直到pred为真或超时（调用者持有dev->lock）
+ * @return true表示条件满足
+ */
+static bool dev_wait(spi_device_handle_t dev, TickType_t ticks, bool (*pred)(spi_device_handle_t))
+{
+    struct timespec deadline;
+
+    if (pred(dev)) return true;
+    if (ticks == 0) return false;
+    if (ticks != portMAX_DELAY) ticks_to_deadline(ticks, &deadline);
+
+    while (!pred(dev)) {
+        if (ticks == portMAX_DELAY) {
+            pthread_cond_wait(&dev->cond, &dev->lock);
+        } else if (pthread_cond_timedwait(&dev->cond, &dev->lock, &deadline) != 0) {
+            return pred(dev);
+        }
+    }
+    return true;
+}
+
+static bool dev_can_queue(spi_device_handle_t dev)
+{
+    return dev->in_flight < dev->cfg.queue_size;
+}
+
+static bool dev_has_pending(spi_device_handle_t dev)
+{
+    return dev->pending_count > 0;
+}
+
+static bool dev_has_done(spi_device_handle_t dev)
+{
+    return dev->done_count > 0;
+}
+
+/**
+ * @brief 计算事务在线上的总位数（命令+地址+哑位+数据）
+ */
+static uint64_t trans_wire_bits(spi_device_handle_t dev, const spi_transaction_t *trans)
+{
+    const spi_transaction_ext_t *ext = (const spi_transaction_ext_t *)trans;
+    uint64_t bits = 0;
+
+    bits += (trans->flags & SPI_TRANS_VARIABLE_CMD) ? ext->command_bits : dev->cfg.command_bits;
+    bits += (trans->flags & SPI_TRANS_VARIABLE_ADDR) ? ext->address_bits : dev->cfg.address_bits;
+    if (!(dev->cfg.flags & SPI_DEVICE_NO_DUMMY) || (trans->flags & SPI_TRANS_VARIABLE_DUMMY)) {
+        bits += (trans->flags & SPI_TRANS_VARIABLE_DUMMY) ? ext->dummy_bits : dev->cfg.dummy_bits;
+    }
+    bits += trans->length;
+    if (dev->cfg.flags & SPI_DEVICE_HALFDUPLEX) {
+        bits += trans->rxlength;        // 半双工读阶段单独占用总线
+    }
+    return bits;
+}
+
+static uint64_t monotonic_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief 按比例占用总线一段时间（调用者持有bus_lock）
+ * @param host SPI主机
+ * @param wire_ns 线上传输时间
+ * @param submit_ns 事务提交（排队或轮询发起）的时刻
+ * @return 事务在仿真总线时间线上的开始时刻
+ *
+ * 总线忙时提交的事务紧接上一个事务开始，与硬件连续执行队列一致；
+ * 总线空闲后才提交的事务从提交时刻开始，两者之间的空闲即CPU发起传输的延迟。
+ * 开始时刻不取“DMA”线程实际被调度的时刻，主机调度延迟不会累加到仿真时间里。
+ */
+static uint64_t sim_bus_occupy(spi_sim_host_t *host, uint64_t wire_ns, uint64_t submit_ns)
+{
+    uint64_t ns = wire_ns * time_scale_percent / 100;
+    if (ns == 0) return monotonic_ns();
+
+    uint64_t start = submit_ns > host->busy_until_ns ? submit_ns : host->busy_until_ns;
+    host->busy_until_ns = start + ns;
+
+    struct timespec deadline = {
+        .tv_sec = (time_t)(host->busy_until_ns / 1000000000ULL),
+        .tv_nsec = (long)(host->busy_until_ns % 1000000000ULL),
+    };
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL) != 0) {
+    }
+    return start;
+}
+
+/**
+ * @brief 查找挂在设备片选上的从设备模型
+ * @return 找到返回true
+ */
+static bool find_model(int cs_io_num, spi_sim_model_cb_t *cb, void **user_ctx)
+{
+    bool found = false;
+
+    pthread_mutex_lock(&models_lock);
+    for (int i = 0; i < SPI_SIM_MAX_MODELS; i++) {
+        if (models[i].cb != NULL && models[i].cs_io_num == cs_io_num) {
+            *cb = models[i].cb;
+            *user_ctx = models[i].user_ctx;
+            found = true;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&models_lock);
+    return found;
+}
+
+/**
+ * @brief 把事务交给从设备模型：拼出命令+数据相位的MOSI流，模型返回的MISO写回rx
+ */
+static void run_model(spi_device_handle_t dev, spi_transaction_t *trans,
+                      const uint8_t *tx, size_t tx_len, uint8_t *rx, size_t rx_len)
+{
+    spi_sim_model_cb_t cb;
+    void *user_ctx;
+    if (!find_model(dev->cfg.spics_io_num, &cb, &user_ctx)) return;
+
+    const spi_transaction_ext_t *ext = (const spi_transaction_ext_t *)trans;
+    size_t cmd_bits = (trans->flags & SPI_TRANS_VARIABLE_CMD) ? ext->command_bits : dev->cfg.command_bits;
+    size_t cmd_len = (cmd_bits + 7) / 8;
+    bool half_duplex = dev->cfg.flags & SPI_DEVICE_HALFDUPLEX;
+    size_t data_len = half_duplex ? tx_len + rx_len : (tx_len > rx_len ? tx_len : rx_len);
+    size_t len = cmd_len + data_len;
+
+    uint8_t *mosi = calloc(1, len ? len : 1);
+    uint8_t *miso = calloc(1, len ? len : 1);
+    if (mosi == NULL || miso == NULL) {
+        free(mosi);
+        free(miso);
+        return;
+    }
+    for (size_t i = 0; i < cmd_len; i++) {
+        mosi[i] = (uint8_t)(trans->cmd >> (8 * (cmd_len - 1 - i)));
+    }
+    if (tx != NULL) memcpy(mosi + cmd_len, tx, tx_len);
+
+    cb(user_ctx, trans, mosi, cmd_len, len, miso);
+
+    if (rx != NULL && rx_len > 0) {
+        // 半双工时读阶段在写阶段之后；全双工时与数据相位同步
+        memcpy(rx, miso + cmd_len + (half_duplex ? tx_len : 0), rx_len);
+    }
+    free(mosi);
+    free(miso);
+}
+
+/**
+ * @brief 在总线上执行一个事务：pre_cb -> 传输 -> 统计/监视 -> post_cb
+ * @param dev SPI设备
+ * @param trans 事务描述符
+ * @param submit_ns 事务提交时刻
+ */
+static void spi_sim_execute(spi_device_handle_t dev, spi_transaction_t *trans, uint64_t submit_ns)
+{
+    spi_sim_host_t *host = &hosts[dev->host];
+    size_t tx_len = (trans->length + 7) / 8;
+    size_t rx_len = ((trans->rxlength ? trans->rxlength : trans->length) + 7) / 8;
+    const uint8_t *tx = (trans->flags & SPI_TRANS_USE_TXDATA) ? trans->tx_data : trans->tx_buffer;
+    uint8_t *rx = (trans->flags & SPI_TRANS_USE_RXDATA) ? trans->rx_data : trans->rx_buffer;
+
+    pthread_mutex_lock(&host->bus_lock);
+
+    esp_cpu_cycle_count_t pre_call = esp_cpu_get_cycle_count();
+    if (dev->cfg.pre_cb) dev->cfg.pre_cb(trans);
+    esp_cpu_cycle_count_t pre_return = esp_cpu_get_cycle_count();
+
+    // 传输开始时对发送缓冲区做快照，结束时比较，检测“DMA”期间缓冲区被改写（撕裂）
+    uint8_t *snapshot = NULL;
+    if (tx != NULL && tx_len > 0) {
+        snapshot = malloc(tx_len);
+        if (snapshot) memcpy(snapshot, tx, tx_len);
+    }
+
+    uint64_t wire_ns = trans_wire_bits(dev, trans) * 1000000000ULL / (uint64_t)dev->cfg.clock_speed_hz;
+
+    if (rx != NULL && rx_len > 0) {
+        // 没有从设备模型时MISO读到0
+        if (trans->flags & SPI_TRANS_USE_RXDATA) rx_len = sizeof(trans->rx_data) < rx_len ? sizeof(trans->rx_data) : rx_len;
+        memset(rx, 0, rx_len);
+    }
+    // 从设备看到的是传输开始时的数据；模型的处理时间计入线上时间，不额外拉开事务间隔
+    run_model(dev, trans, snapshot != NULL ? snapshot : tx, tx != NULL ? tx_len : 0, rx, rx != NULL ? rx_len : 0);
+
+    uint64_t start_ns = sim_bus_occupy(host, wire_ns, submit_ns);
+    uint64_t end_ns = start_ns + wire_ns * time_scale_percent / 100;
+
+    // 换算到esp_timer时基
+    int64_t now_us = esp_timer_get_time();
+    uint64_t now_ns = monotonic_ns();
+    int64_t start_us = now_us - (int64_t)(now_ns - start_ns) / 1000;
+    int64_t end_us = now_us - (int64_t)(now_ns - end_ns) / 1000;
+
+    bool torn = snapshot != NULL && memcmp(snapshot, tx, tx_len) != 0;
+    free(snapshot);
+
+    pthread_mutex_lock(&host->stats_lock);
+    host->stats.trans_count++;
+    host->stats.tx_bytes += tx != NULL ? tx_len : 0;
+    host->stats.rx_bytes += rx != NULL ? rx_len : 0;
+    host->stats.wire_time_ns += wire_ns;
+    if (torn) host->stats.torn_count++;
+    spi_sim_monitor_cb_t monitor = host->monitor;
+    void *monitor_ctx = host->monitor_ctx;
+    pthread_mutex_unlock(&host->stats_lock);
+
+    if (monitor) monitor(dev->host, trans, start_us, end_us, monitor_ctx);
+    esp_cpu_cycle_count_t post_call = esp_cpu_get_cycle_count();
+    if (dev->cfg.post_cb) dev->cfg.post_cb(trans);
+    esp_cpu_cycle_count_t post_return = esp_cpu_get_cycle_count();
+
+    pthread_mutex_lock(&host->stats_lock);
+    host->stats.cb_cycles_min += (esp_cpu_cycle_count_t)(post_call - pre_return);
+    host->stats.cb_cycles_max += (esp_cpu_cycle_count_t)(post_return - pre_call);
+    pthread_mutex_unlock(&host->stats_lock);
+
+    pthread_mutex_unlock(&host->bus_lock);
+}
+
+/**
+ * @brief 设备“DMA”线程：按排队顺序执行事务并放入完成队列
+ */
+static void *spi_sim_dma_thread(void *arg)
+{
+    spi_device_handle_t dev = arg;
+
+    pthread_mutex_lock(&dev->lock);
+    while (1) {
+        dev_wait(dev, portMAX_DELAY, dev_has_pending);
+        spi_transaction_t *trans = dev->pending[dev->pending_head];
+        uint64_t submit_ns = dev->pending_ns[dev->pending_head];
+        pthread_mutex_unlock(&dev->lock);
+
+        spi_sim_execute(dev, trans, submit_ns);
+
+        pthread_mutex_lock(&dev->lock);
+        dev->pending_head = (dev->pending_head + 1) % dev->cfg.queue_size;
+        dev->pending_count--;
+        dev->done[(dev->done_head + dev->done_count) % dev->cfg.queue_size] = trans;
+        dev->done_count++;
+        pthread_cond_broadcast(&dev->cond);
+    }
+    return NULL;
+}
+
+esp_err_t spi_bus_initialize(spi_host_device_t host_id, const spi_bus_config_t *bus_config, spi_dma_chan_t dma_chan)
+{
+    (void)dma_chan;
+    if (host_id < 0 || host_id >= SPI_HOST_MAX || bus_config == NULL) return ESP_ERR_INVALID_ARG;
+    if (hosts[host_id].initialized) return ESP_ERR_INVALID_STATE;
+
+    hosts[host_id].bus_cfg = *bus_config;
+    hosts[host_id].initialized = true;
+    return ESP_OK;
+}
+
+esp_err_t spi_bus_free(spi_host_device_t host_id)
+{
+    if (host_id < 0 || host_id >= SPI_HOST_MAX) return ESP_ERR_INVALID_ARG;
+    hosts[host_id].initialized = false;
+    return ESP_OK;
+}
+
+esp_err_t spi_bus_add_device(spi_host_device_t host_id, const spi_device_interface_config_t *dev_config, spi_device_handle_t *handle)
+{
+    if (host_id < 0 || host_id >= SPI_HOST_MAX || dev_config == NULL || handle == NULL) return ESP_ERR_INVALID_ARG;
+    if (!hosts[host_id].initialized) return ESP_ERR_INVALID_STATE;
+    if (dev_config->clock_speed_hz <= 0) return ESP_ERR_INVALID_ARG;
+
+    spi_device_handle_t dev = calloc(1, sizeof(*dev));
+    if (dev == NULL) return ESP_ERR_NO_MEM;
+
+    dev->host = host_id;
+    dev->cfg = *dev_config;
+    if (dev->cfg.queue_size <= 0) dev->cfg.queue_size = 1;
+    dev->pending = calloc(dev->cfg.queue_size, sizeof(spi_transaction_t *));
+    dev->pending_ns = calloc(dev->cfg.queue_size, sizeof(uint64_t));
+    dev->done = calloc(dev->cfg.queue_size, sizeof(spi_transaction_t *));
+    if (dev->pending == NULL || dev->pending_ns == NULL || dev->done == NULL) {
+        free(dev->pending);
+        free(dev->pending_ns);
+        free(dev->done);
+        free(dev);
+        return ESP_ERR_NO_MEM;
+    }
+
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&dev->cond, &attr);
+    pthread_condattr_destroy(&attr);
+    pthread_mutex_init(&dev->lock, NULL);
+
+    pthread_create(&dev->dma_thread, NULL, spi_sim_dma_thread, dev);
+    pthread_detach(dev->dma_thread);
+
+    *handle = dev;
+    return ESP_OK;
+}
+
+esp_err_t spi_bus_remove_device(spi_device_handle_t handle)
+{
+    // “DMA”线程已分离且可能仍在等待，仿真中不回收设备内存
+    return handle == NULL ? ESP_ERR_INVALID_ARG : ESP_OK;
+}
+
+esp_err_t spi_device_queue_trans(spi_device_handle_t handle, spi_transaction_t *trans_desc, TickType_t ticks_to_wait)
+{
+    if (handle == NULL || trans_desc == NULL) return ESP_ERR_INVALID_ARG;
+
+    pthread_mutex_lock(&handle->lock);
+    if (!dev_wait(handle, ticks_to_wait, dev_can_queue)) {
+        pthread_mutex_unlock(&handle->lock);
+        return ESP_ERR_TIMEOUT;
+    }
+    spi_sim_host_t *host = &hosts[handle->host];
+    if (host->bypass) {
+        // 只保留驱动可见的行为：回调顺序和完成队列，用于测量驱动本身的开销
+        if (handle->cfg.pre_cb) handle->cfg.pre_cb(trans_desc);
+        pthread_mutex_lock(&host->stats_lock);
+        host->stats.trans_count++;
+        host->stats.tx_bytes += (trans_desc->length + 7) / 8;
+        pthread_mutex_unlock(&host->stats_lock);
+        if (handle->cfg.post_cb) handle->cfg.post_cb(trans_desc);
+
+        handle->done[(handle->done_head + handle->done_count) % handle->cfg.queue_size] = trans_desc;
+        handle->done_count++;
+        handle->in_flight++;
+        pthread_mutex_unlock(&handle->lock);
+        return ESP_OK;
+    }
+
+    int slot = (handle->pending_head + handle->pending_count) % handle->cfg.queue_size;
+    handle->pending[slot] = trans_desc;
+    handle->pending_ns[slot] = monotonic_ns();
+    handle->pending_count++;
+    handle->in_flight++;
+
+    pthread_mutex_lock(&host->stats_lock);
+    if ((uint32_t)handle->in_flight > host->stats.max_in_air) {
+        host->stats.max_in_air = handle->in_flight;
+    }
+    pthread_mutex_unlock(&host->stats_lock);
+
+    pthread_cond_broadcast(&handle->cond);
+    pthread_mutex_unlock(&handle->lock);
+    return ESP_OK;
+}
+
+esp_err_t spi_device_get_trans_result(spi_device_handle_t handle, spi_transaction_t **trans_desc, TickType_t ticks_to_wait)
+{
+    if (handle == NULL || trans_desc == NULL) return ESP_ERR_INVALID_ARG;
+
+    pthread_mutex_lock(&handle->lock);
+    if (!dev_wait(handle, ticks_to_wait, dev_has_done)) {
+        pthread_mutex_unlock(&handle->lock);
+        return ESP_ERR_TIMEOUT;
+    }
+    *trans_desc = handle->done[handle->done_head];
+    handle->done_head = (handle->done_head + 1) % handle->cfg.queue_size;
+    handle->done_count--;
+    handle->in_flight--;
+    pthread_cond_broadcast(&handle->cond);
+    pthread_mutex_unlock(&handle->lock);
+    return ESP_OK;
+}
+
+esp_err_t spi_device_transmit(spi_device_handle_t handle, spi_transaction_t *trans_desc)
+{
+    if (handle == NULL || trans_desc == NULL) return ESP_ERR_INVALID_ARG;
+
+    // 与ESP-IDF一致：同步传输前该设备不能有未取回的队列事务
+    pthread_mutex_lock(&handle->lock);
+    bool busy = handle->in_flight != 0;
+    pthread_mutex_unlock(&handle->lock);
+    if (busy) return ESP_ERR_INVALID_STATE;
+
+    spi_sim_execute(handle, trans_desc, monotonic_ns());
+    return ESP_OK;
+}
+
+esp_err_t spi_device_polling_transmit(spi_device_handle_t handle, spi_transaction_t *trans_desc)
+{
+    return spi_device_transmit(handle, trans_desc);
+}
+
+esp_err_t spi_device_acquire_bus(spi_device_handle_t device, TickType_t wait)
+{
+    (void)wait;
+    if (device == NULL) return ESP_ERR_INVALID_ARG;
+    return ESP_OK;
+}
+
+void spi_device_release_bus(spi_device_handle_t dev)
+{
+    (void)dev;
+}
+
+/**
+ * @brief 把从设备模型挂到某个片选引脚上
+ */
+void spi_sim_attach_model(int cs_io_num, spi_sim_model_cb_t cb, void *user_ctx)
+{
+    pthread_mutex_lock(&models_lock);
+    for (int i = 0; i < SPI_SIM_MAX_MODELS; i++) {
+        if (models[i].cb != NULL && models[i].cs_io_num == cs_io_num) {
+            models[i].cb = NULL;
+        }
+    }
+    for (int i = 0; cb != NULL && i < SPI_SIM_MAX_MODELS; i++) {
+        if (models[i].cb == NULL) {
+            models[i].cs_io_num = cs_io_num;
+            models[i].user_ctx = user_ctx;
+            models[i].cb = cb;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&models_lock);
+}
+
+/**
+ * @brief 设置线上时间的实时缩放比例
+ */
+void spi_sim_set_time_scale(uint32_t percent)
+{
+    time_scale_percent = percent;
+}
+
+/**
+ * @brief 设置直通模式
+ */
+void spi_sim_set_bypass(spi_host_device_t host, bool bypass)
+{
+    hosts[host].bypass = bypass;
+}
+
+/**
+ * @brief 读取总线统计
+ */
+void spi_sim_get_stats(spi_host_device_t host, spi_sim_stats_t *stats)
+{
+    pthread_mutex_lock(&hosts[host].stats_lock);
+    *stats = hosts[host].stats;
+    pthread_mutex_unlock(&hosts[host].stats_lock);
+}
+
+/**
+ * @brief 清零总线统计
+ */
+void spi_sim_reset_stats(spi_host_device_t host)
+{
+    pthread_mutex_lock(&hosts[host].stats_lock);
+    memset(&hosts[host].stats, 0, sizeof(hosts[host].stats));
+    pthread_mutex_unlock(&hosts[host].stats_lock);
+}
+
+/**
+ * @brief 注册事务监视回调
+ */
+void spi_sim_set_monitor(spi_host_device_t host, spi_sim_monitor_cb_t cb, void *user_ctx)
+{
+    pthread_mutex_lock(&hosts[host].stats_lock);
+    hosts[host].monitor = cb;
+    hosts[host].monitor_ctx = user_ctx;
+    pthread_mutex_unlock(&hosts[host].stats_lock);
+}
@@ -0,0 +1,128 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include "driver/gpio.h"
+#include "gpio_sim.h"
+#include "spi_sim.h"
+#include "xpt2046_sim.h"
+
+// 主机仿真：XPT2046触摸控制器模型
+
+#define XPT2046_SIM_START   0x80    // 控制字节起始位
+#define XPT2046_SIM_CH_X    1       // 控制字节A2~A0，与驱动中的命令命名一致
+#define XPT2046_SIM_CH_Z1   3
+#define XPT2046_SIM_CH_Z2   4
+#define XPT2046_SIM_CH_Y    5
+
+typedef struct {
+    pthread_mutex_t lock;
+    int irq_io_num;
+    xpt2046_sim_sample_t *script;   // 当前按下的采样脚本
+    size_t count;
+    size_t index;
+    uint8_t converted;              // 当前采样中已转换的通道位图
+    bool pressed;
+    uint32_t conversions;
+} xpt2046_sim_t;
+
+static xpt2046_sim_t touch = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .irq_io_num = -1,
+};
+
+/**
+ * @brief 对一个通道做一次转换，必要时前进到下一个采样（调用者持有lock）
+ * @return 12位转换结果
+ */
+static uint16_t touch_convert(uint8_t channel)
+{
+    touch.conversions++;
+    if (!touch.pressed || touch.count == 0) return 0;
+
+    if (touch.converted & (1u << channel)) {
+        if (touch.index + 1 < touch.count) touch.index++;
+        touch.converted = 0;
+    }
+    touch.converted |= 1u << channel;
+
+    const xpt2046_sim_sample_t *s = &touch.script[touch.index];
+    switch (channel) {
+    case XPT2046_SIM_CH_X:  return s->x & 0x0FFF;
+    case XPT2046_SIM_CH_Y:  return s->y & 0x0FFF;
+    case XPT2046_SIM_CH_Z1: return s->z1 & 0x0FFF;
+    case XPT2046_SIM_CH_Z2: return s->z2 & 0x0FFF;
+    default:                return 0;
+    }
+}
+
+/**
+ * @brief SPI从设备回调：每个带起始位的控制字节，其结果在随后16个时钟输出
+ *        （1个忙时钟 + 12位数据 + 3个0），与下一个控制字节重叠，支持15时钟流水读
+ */
+static void touch_transfer(void *user_ctx, const spi_transaction_t *trans,
+                           const uint8_t *mosi, size_t cmd_len, size_t len, uint8_t *miso)
+{
+    (void)user_ctx;
+    (void)trans;
+    (void)cmd_len;
+
+    pthread_mutex_lock(&touch.lock);
+    for (size_t i = 0; i < len; i++) {
+        if (!(mosi[i] & XPT2046_SIM_START)) continue;
+
+        uint16_t out = (uint16_t)(touch_convert((mosi[i] >> 4) & 0x07) << 3);
+        if (i + 1 < len) miso[i + 1] |= (uint8_t)(out >> 8);
+        if (i + 2 < len) miso[i + 2] |= (uint8_t)(out & 0xFF);
+    }
+    pthread_mutex_unlock(&touch.lock);
+}
+
+void xpt2046_sim_init(int cs_io_num, int irq_io_num)
+{
+    pthread_mutex_lock(&touch.lock);
+    touch.irq_io_num = irq_io_num;
+    touch.pressed = false;
+    touch.conversions = 0;
+    pthread_mutex_unlock(&touch.lock);
+
+    spi_sim_attach_model(cs_io_num, touch_transfer, NULL);
+    gpio_sim_drive_input(irq_io_num, 1);
+}
+
+void xpt2046_sim_press(const xpt2046_sim_sample_t *samples, size_t count)
+{
+    xpt2046_sim_sample_t *copy = malloc(count * sizeof(*copy));
+    if (copy == NULL && count > 0) return;
+    if (count > 0) memcpy(copy, samples, count * sizeof(*copy));
+
+    pthread_mutex_lock(&touch.lock);
+    free(touch.script);
+    touch.script = copy;
+    touch.count = count;
+    touch.index = 0;
+    touch.converted = 0;
+    touch.pressed = true;
+    int irq = touch.irq_io_num;
+    pthread_mutex_unlock(&touch.lock);
+
+    gpio_sim_drive_input(irq, 0);
+}
+
+void xpt2046_sim_release(void)
+{
+    pthread_mutex_lock(&touch.lock);
+    touch.pressed = false;
+    int irq = touch.irq_io_num;
+    pthread_mutex_unlock(&touch.lock);
+
+    gpio_sim_drive_input(irq, 1);
+}
+
+uint32_t xpt2046_sim_get_conversion_count(void)
+{
+    pthread_mutex_lock(&touch.lock);
+    uint32_t conversions = touch.conversions;
+    pthread_mutex_unlock(&touch.lock);
+    return conversions;
+}
@@ -1,9 +1,12 @@
 #include "disp_spi.h"
 #include <stdint.h>
 #include <string.h>
+#include <stdatomic.h>
 #include "esp_log.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "lvgl.h"
+#include "port_stats.h"
 
 // https://docs.espressif.com/projects/esp-idf/zh_CN/v5.4/esp32/api-reference/peripherals/spi_master.html#id11
 
@@ -12,7 +15,22 @@ static const char *TAG = "DISP_SPI";
 
 // 全局变量
 static spi_device_handle_t spi;                   // SPI设备句柄
-static QueueHandle_t TransactionPool = NULL;      // 事务池队列
+static disp_spi_flush_done_cb_t flush_done_cb = NULL; // 颜色传输完成回调
+static void *flush_done_ctx = NULL;               // 完成回调用户上下文
+
+// 队列事务环：静态分配在可DMA访问的内部RAM中，事务原地构造后直接排队
+// 单生产者（排队）/单消费者（回收结果），ESP-IDF按排队顺序返回结果，槽位按序复用
+_Static_assert((DISP_SPI_TRANS_RING_SIZE & (DISP_SPI_TRANS_RING_SIZE - 1)) == 0,
+               "DISP_SPI_TRANS_RING_SIZE必须是2的幂");
+_Static_assert(DISP_SPI_TRANS_RING_SIZE >= DISP_SPI_TRANS_PER_FLUSH * DISP_SPI_FLUSHES_IN_FLIGHT,
+               "事务环需容纳同时在途的所有刷新块（每块按最多窗口数计）");
+DMA_ATTR static spi_transaction_ext_t trans_ring[DISP_SPI_TRANS_RING_SIZE];
+static atomic_uint ring_head;                     // 下一个空闲槽位，只由生产者递增
+static atomic_uint ring_tail;                     // 最早一个未回收的槽位，只由消费者递增
+static esp_cpu_cycle_count_t trans_start_cycles;  // 正在传输的事务开始的时刻，只在SPI回调中访问
+
+static void IRAM_ATTR disp_spi_pre_transaction_cb(spi_transaction_t *trans);
+static void IRAM_ATTR disp_spi_post_transaction_cb(spi_transaction_t *trans);
 
 /**
  * @brief 初始化SPI总线和设备
@@ -43,35 +61,40 @@ void disp_spi_init(void)
     ESP_LOGI(TAG, "添加SPI设备...");
     // SPI设备配置
     static spi_device_interface_config_t dev_cfg = {
-        .clock_speed_hz = 40 * 1000 * 1000,     // 时钟频率40MHz
+        .clock_speed_hz = LCD_SPI_CLOCK_HZ,     // 时钟频率40MHz
         .mode = LCD_SPI_MODE,                               // SPI模式0
         .spics_io_num = LCD_SPI_CS,              // 片选引脚
-        .queue_size = SPI_TRANSACTION_POOL_SIZE, // 队列大小
-        .pre_cb = NULL,
-        .post_cb= NULL,
+        .queue_size = DISP_SPI_TRANS_RING_SIZE,  // 与事务环等长，排队不会阻塞
+        .pre_cb = disp_spi_pre_transaction_cb,   // 按事务标志切换DC，命令和数据可以连续排队
+        .post_cb = disp_spi_post_transaction_cb, // 传输完成回调，用于通知刷新完成
         .flags = SPI_DEVICE_NO_DUMMY | SPI_DEVICE_HALFDUPLEX,
     };
 
-    spi_bus_add_device(LCD_SPI_HOST,&dev_cfg,&spi);
-
-    // 创建事务池
-    TransactionPool = xQueueCreate(SPI_TRANSACTION_POOL_SIZE, sizeof(spi_transaction_ext_t *));
-    if (TransactionPool == NULL) {
-        ESP_LOGE(TAG, "事务池创建失败");
+    ret = spi_bus_add_device(LCD_SPI_HOST, &dev_cfg, &spi);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "SPI设备添加失败: %s", esp_err_to_name(ret));
         return;
     }
+    ESP_LOGI(TAG, "SPI初始化完成，事务环大小: %d", DISP_SPI_TRANS_RING_SIZE);
+}
 
-    // 预分配事务池内存
-    for (int i = 0; i < SPI_TRANSACTION_POOL_SIZE; i++) {
-        spi_transaction_ext_t *trans = heap_caps_malloc(sizeof(spi_transaction_ext_t), MALLOC_CAP_DMA);
-        if (trans == NULL) {
-            ESP_LOGE(TAG, "事务池内存分配失败（第%d个）", i);
-            continue;                           // 继续分配剩余部分
-        }
-        memset(trans, 0, sizeof(spi_transaction_ext_t));
-        xQueueSend(TransactionPool, &trans, portMAX_DELAY);
+/**
+ * @brief 取回一个已完成的队列事务，释放其在事务环中的槽位
+ * @return true表示成功回收
+ */
+static bool disp_spi_reclaim_one(void)
+{
+    spi_transaction_t *presult;
+
+    LV_PROFILER_BEGIN_TAG("disp_spi_wait");
+    esp_err_t err = spi_device_get_trans_result(spi, &presult, portMAX_DELAY);
+    LV_PROFILER_END_TAG("disp_spi_wait");
+    if (err != ESP_OK) {
+        return false;
     }
-    ESP_LOGI(TAG, "SPI初始化完成");
+    assert(presult == &trans_ring[atomic_load_explicit(&ring_tail, memory_order_relaxed) & (DISP_SPI_TRANS_RING_SIZE - 1)].base);
+    atomic_fetch_add_explicit(&ring_tail, 1, memory_order_release);
+    return true;
 }
 
 /**
@@ -79,12 +102,18 @@ void disp_spi_init(void)
  */
 void disp_wait_for_pending_transactions(void)
 {
-    spi_transaction_t *presult;
-    while (uxQueueMessagesWaiting(TransactionPool) < SPI_TRANSACTION_POOL_SIZE) {
-        if (spi_device_get_trans_result(spi, &presult, 1) == ESP_OK) {
-            xQueueSend(TransactionPool, &presult, portMAX_DELAY);
-        }
+    if (atomic_load_explicit(&ring_head, memory_order_acquire) ==
+        atomic_load_explicit(&ring_tail, memory_order_acquire)) {
+        return;
     }
+
+    esp_cpu_cycle_count_t start = esp_cpu_get_cycle_count();
+    while (atomic_load_explicit(&ring_head, memory_order_acquire) !=
+           atomic_load_explicit(&ring_tail, memory_order_acquire)) {
+        if (!disp_spi_reclaim_one()) break;
+    }
+    port_stats_add_cycles(&port_stats.spi_wait_cycles, start);
+    port_stats_add(&port_stats.spi_waits, 1);
 }
 
 #define DISP_SPI_HALF_DUPLEX
@@ -102,95 +131,166 @@ void disp_spi_transaction(const uint8_t *data, size_t length,
     uint64_t addr, uint8_t dummy_bits)
 {
     if (0 == length) {
-        return;
+        if (!(flags & DISP_SPI_SIGNAL_FLUSH)) {
+            return;
+        }
+        /* nothing goes on the bus, but a flush still has to be reported as done: with earlier chunks of
+         * the same flush still queued, a zero-length marker is queued behind them and post_cb signals
+         * once they are through; otherwise the buffer is already free */
+        if ((flags & (DISP_SPI_SEND_POLLING | DISP_SPI_SEND_SYNCHRONOUS)) ||
+            atomic_load_explicit(&ring_head, memory_order_relaxed) ==
+            atomic_load_explicit(&ring_tail, memory_order_acquire)) {
+            if (flush_done_cb) {
+                flush_done_cb(flush_done_ctx);
+            }
+            return;
+        }
+        data = NULL;
     }
 
-    spi_transaction_ext_t t = {0};
+    /* queued transactions are built in place in the ring, polling ones on the stack */
+    spi_transaction_ext_t local;
+    spi_transaction_ext_t *t = &local;
+    unsigned head = 0;
+
+    if (!(flags & (DISP_SPI_SEND_POLLING | DISP_SPI_SEND_SYNCHRONOUS))) {
+        head = atomic_load_explicit(&ring_head, memory_order_relaxed);
+        unsigned depth = head - atomic_load_explicit(&ring_tail, memory_order_acquire);
+        if (depth == DISP_SPI_TRANS_RING_SIZE) {
+            disp_spi_reclaim_one();	/* ring full: the oldest transaction has to finish first */
+            port_stats_add(&port_stats.spi_ring_full, 1);
+            depth--;
+        }
+        port_stats_add(&port_stats.queue_depth_sum, depth);
+        port_stats_add(&port_stats.queued, 1);
+        port_stats_max(&port_stats.queue_depth_max, depth);
+        t = &trans_ring[head & (DISP_SPI_TRANS_RING_SIZE - 1)];
+    }
+    memset(t, 0, sizeof(*t));
 
     /* transaction length is in bits */
-    t.base.length = length * 8;
+    t->base.length = length * 8;
 
     if (length <= 4 && data != NULL) {
-        t.base.flags = SPI_TRANS_USE_TXDATA;
-        memcpy(t.base.tx_data, data, length);
+        t->base.flags = SPI_TRANS_USE_TXDATA;
+        memcpy(t->base.tx_data, data, length);
     } else {
-        t.base.tx_buffer = data;
+        t->base.tx_buffer = data;
     }
 
     if (flags & DISP_SPI_RECEIVE) {
         assert(out != NULL && (flags & (DISP_SPI_SEND_POLLING | DISP_SPI_SEND_SYNCHRONOUS)));
-        t.base.rx_buffer = out;
+        t->base.rx_buffer = out;
 
 #if defined(DISP_SPI_HALF_DUPLEX)
-		t.base.rxlength = t.base.length;
-		t.base.length = 0;	/* no MOSI phase in half-duplex reads */
+		t->base.rxlength = t->base.length;
+		t->base.length = 0;	/* no MOSI phase in half-duplex reads */
 #else
-		t.base.rxlength = 0; /* in full-duplex mode, zero means same as tx length */
+		t->base.rxlength = 0; /* in full-duplex mode, zero means same as tx length */
 #endif
     }
 
     if (flags & DISP_SPI_ADDRESS_8) {
-        t.address_bits = 8;
+        t->address_bits = 8;
     } else if (flags & DISP_SPI_ADDRESS_16) {
-        t.address_bits = 16;
+        t->address_bits = 16;
     } else if (flags & DISP_SPI_ADDRESS_24) {
-        t.address_bits = 24;
+        t->address_bits = 24;
     } else if (flags & DISP_SPI_ADDRESS_32) {
-        t.address_bits = 32;
+        t->address_bits = 32;
     }
-    if (t.address_bits) {
-        t.base.addr = addr;
-        t.base.flags |= SPI_TRANS_VARIABLE_ADDR;
+    if (t->address_bits) {
+        t->base.addr = addr;
+        t->base.flags |= SPI_TRANS_VARIABLE_ADDR;
     }
 
 #if defined(DISP_SPI_HALF_DUPLEX)
 	if (flags & DISP_SPI_MODE_DIO) {
-		t.base.flags |= SPI_TRANS_MODE_DIO;
+		t->base.flags |= SPI_TRANS_MODE_DIO;
 	} else if (flags & DISP_SPI_MODE_QIO) {
-		t.base.flags |= SPI_TRANS_MODE_QIO;
+		t->base.flags |= SPI_TRANS_MODE_QIO;
 	}
 
 	if (flags & DISP_SPI_MODE_DIOQIO_ADDR) {
-		t.base.flags |= SPI_TRANS_MODE_DIOQIO_ADDR;
+		t->base.flags |= SPI_TRANS_MODE_DIOQIO_ADDR;
 	}
 
 	if ((flags & DISP_SPI_VARIABLE_DUMMY) && dummy_bits) {
-		t.dummy_bits = dummy_bits;
-		t.base.flags |= SPI_TRANS_VARIABLE_DUMMY;
+		t->dummy_bits = dummy_bits;
+		t->base.flags |= SPI_TRANS_VARIABLE_DUMMY;
 	}
 #endif
 
     /* Save flags for pre/post transaction processing */
-    t.base.user = (void *) flags;
+    t->base.user = (void *) flags;
 
     /* Poll/Complete/Queue transaction */
     if (flags & DISP_SPI_SEND_POLLING) {
 		disp_wait_for_pending_transactions();	/* before polling, all previous pending transactions need to be serviced */
-        spi_device_polling_transmit(spi, (spi_transaction_t *) &t);
+        spi_device_polling_transmit(spi, &t->base);
     } else if (flags & DISP_SPI_SEND_SYNCHRONOUS) {
 		disp_wait_for_pending_transactions();	/* before synchronous queueing, all previous pending transactions need to be serviced */
-        spi_device_transmit(spi, (spi_transaction_t *) &t);
+        spi_device_transmit(spi, &t->base);
     } else {
-		
-		/* if necessary, ensure we can queue new transactions by servicing some previous transactions */
-		if(uxQueueMessagesWaiting(TransactionPool) == 0) {
-			spi_transaction_t *presult;
-			while(uxQueueMessagesWaiting(TransactionPool) < SPI_TRANSACTION_POOL_RESERVE) {
-				if (spi_device_get_trans_result(spi, &presult, 1) == ESP_OK) {
-					xQueueSend(TransactionPool, &presult, portMAX_DELAY);	/* back to the pool to be reused */
-				}
-			}
-		}
-
-		spi_transaction_ext_t *pTransaction = NULL;
-		xQueueReceive(TransactionPool, &pTransaction, portMAX_DELAY);
-        memcpy(pTransaction, &t, sizeof(t));
-        if (spi_device_queue_trans(spi, (spi_transaction_t *) pTransaction, portMAX_DELAY) != ESP_OK) {
-			xQueueSend(TransactionPool, &pTransaction, portMAX_DELAY);	/* send failed transaction back to the pool to be reused */
+        /* the device queue is as deep as the ring, so this never blocks */
+        if (spi_device_queue_trans(spi, &t->base, portMAX_DELAY) == ESP_OK) {
+            atomic_store_explicit(&ring_head, head + 1, memory_order_release);	/* publish the slot */
+        } else {
+            ESP_LOGE(TAG, "事务排队失败");
         }
     }
 }
 
+/**
+ * @brief 注册颜色数据传输完成回调
+ * @param cb 回调函数，NULL表示取消
+ * @param user_ctx 用户上下文
+ */
+void disp_spi_set_flush_done_cb(disp_spi_flush_done_cb_t cb, void *user_ctx)
+{
+    flush_done_ctx = user_ctx;
+    flush_done_cb = cb;
+}
+
+/**
+ * @brief SPI事务开始前回调（pre_cb，中断上下文）
+ * @param trans 即将传输的事务
+ *
+ * DC电平随事务一起排队，而不是在排队时直接设置GPIO，
+ * 这样命令、参数和颜色数据可以连续排在前一块DMA之后，不必先等队列排空。
+ */
+static void IRAM_ATTR disp_spi_pre_transaction_cb(spi_transaction_t *trans)
+{
+    disp_spi_send_flag_t flags = (disp_spi_send_flag_t)(uintptr_t)trans->user;
+
+    trans_start_cycles = esp_cpu_get_cycle_count();
+    if (flags & DISP_SPI_DC_CMD) {
+        gpio_set_level(LCD_SPI_DC, 0);
+    } else if (flags & DISP_SPI_DC_DATA) {
+        gpio_set_level(LCD_SPI_DC, 1);
+    }
+}
+
+/**
+ * @brief SPI事务完成回调（post_cb，中断上下文）
+ * @param trans 刚完成的事务
+ *
+ * 颜色数据事务带有DISP_SPI_SIGNAL_FLUSH标志，只有此时DMA才真正读完了LVGL的绘制缓冲区，
+ * 在这里通知上层，上层才能把该缓冲区交还给LVGL继续渲染。
+ */
+static void IRAM_ATTR disp_spi_post_transaction_cb(spi_transaction_t *trans)
+{
+    disp_spi_send_flag_t flags = (disp_spi_send_flag_t)(uintptr_t)trans->user;
+
+    port_stats_add_cycles(&port_stats.spi_busy_cycles, trans_start_cycles);
+    port_stats_add(&port_stats.spi_trans, 1);
+    port_stats_add(&port_stats.spi_bytes, (trans->length + trans->rxlength) / 8);
+
+    if ((flags & DISP_SPI_SIGNAL_FLUSH) && flush_done_cb) {
+        flush_done_cb(flush_done_ctx);
+    }
+}
+
 /**
  * @brief 使用轮询模式发送数据
  * @param data 数据缓冲区
@@ -201,6 +301,18 @@ void disp_spi_send_data(uint8_t *data, size_t length)
     disp_spi_transaction(data, length, DISP_SPI_SEND_POLLING, NULL, 0, 0);
 }
 
+/**
+ * @brief 以队列模式发送一条命令及其参数
+ * @param cmd 命令字节
+ * @param data 参数缓冲区
+ * @param length 参数长度（字节）
+ */
+void disp_spi_queue_cmd(uint8_t cmd, const uint8_t *data, size_t length)
+{
+    disp_spi_transaction(&cmd, 1, DISP_SPI_SEND_QUEUED | DISP_SPI_DC_CMD, NULL, 0, 0);
+    disp_spi_transaction(data, length, DISP_SPI_SEND_QUEUED | DISP_SPI_DC_DATA, NULL, 0, 0);
+}
+
 /**
  * @brief 使用队列模式发送颜色数据
  * @param data 颜色数据缓冲区
@@ -208,5 +320,20 @@ void disp_spi_send_data(uint8_t *data, size_t length)
  */
 void disp_spi_send_colors(uint8_t *data, size_t length)
 {
-    disp_spi_transaction(data, length, DISP_SPI_SEND_QUEUED | DISP_SPI_SIGNAL_FLUSH, NULL, 0, 0);
+    disp_spi_send_colors_chunk(data, length, true);
+}
+
+/**
+ * @brief 使用队列模式发送一块颜色数据中的一段
+ * @param data 本段数据
+ * @param length 本段长度（字节）
+ * @param last 是否为最后一段
+ */
+void disp_spi_send_colors_chunk(uint8_t *data, size_t length, bool last)
+{
+    disp_spi_send_flag_t flags = DISP_SPI_SEND_QUEUED | DISP_SPI_DC_DATA;
+    if (last) {
+        flags |= DISP_SPI_SIGNAL_FLUSH;
+    }
+    disp_spi_transaction(data, length, flags, NULL, 0, 0);
 }
\ No newline at end of file
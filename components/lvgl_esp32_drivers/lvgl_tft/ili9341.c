@@ -1,8 +1,11 @@
 #include "ili9341.h"
 #include "disp_spi.h"       // SPI显示驱动头文件
+#include "rgb565_swap.h"    // RGB565字节交换
+#include "port_stats.h"     // 移植层性能计数器
 #include <stdint.h>
 #include <string.h>
 #include "esp_log.h"        // ESP-IDF日志库
+#include "esp_timer.h"      // 上电时序计时
 #include "driver/gpio.h"    // GPIO驱动头文件
 #include "esp_rom_gpio.h"   // ROM GPIO函数
 #include "freertos/task.h"  // FreeRTOS任务支持
@@ -14,7 +17,7 @@ static const char *TAG = "ILI9341";
 typedef struct {
     uint8_t cmd;           // 命令字节
     uint8_t data[16];      // 数据字节，最多16个
-    uint8_t databytes;     // 数据字节数，低5位表示长度，高位0x80表示需要延时
+    uint8_t databytes;     // 数据字节数，低5位表示长度
 } lcd_init_cmd_t;
 
 // ILI9341初始化命令序列
@@ -41,19 +44,49 @@ static lcd_init_cmd_t ili_init_cmds[] = {
     {0x2C, {0}, 0},                                    // 内存写入
     {0xB7, {0x07}, 1},                                // 进入模式设置
     {0xB6, {0x0A, 0x82, 0x27, 0x00}, 4},              // 显示功能控制
-    {0x11, {0}, 0x80},                                // 退出睡眠模式（需延时）
-    {0x29, {0}, 0x80},                                // 显示开启（需延时）
     {0, {0}, 0xFF},                                   // 序列结束标志
 };
+// 睡眠中接口和GRAM照常工作，配置和第一帧都在退出睡眠（SLPOUT）之前发送，
+// SLPOUT和显示开启（DISPON）由ili9341_power_on_step按数据手册的间隔发送
+
+// 上电时序
+typedef enum {
+    PANEL_RESET,    // 已复位，未配置
+    PANEL_SLEEP,    // 已配置，睡眠中，可以写GRAM
+    PANEL_AWAKE,    // 已退出睡眠，显示未开启
+    PANEL_ON,       // 显示已开启
+} panel_state_t;
+
+static panel_state_t panel_state = PANEL_RESET;
+static int64_t reset_release_us;    // 复位释放的时刻
+static int64_t cmd_allowed_us;      // 在此之前不能发送命令（复位释放、SLPOUT之后各5ms）
 
 // 函数声明
 static void ili9341_send_cmd(uint8_t cmd);
 static void ili9341_send_data(void *data, uint16_t length);
-static void ili9341_send_color(void *data, uint16_t length);
+static void ili9341_send_color(uint8_t *data, size_t length, bool last);
 static void ili9341_set_orientation(uint8_t orientation);
+static void ili9341_prepare(void);
+
+/**
+ * @brief 等到指定时刻：整节拍部分让出CPU，不足一个节拍的部分忙等
+ * @param deadline_us esp_timer时刻
+ */
+static void ili9341_wait_until(int64_t deadline_us)
+{
+    int64_t left_us = deadline_us - esp_timer_get_time();
+    if (left_us >= portTICK_PERIOD_MS * 1000) {
+        vTaskDelay((TickType_t)(left_us / (portTICK_PERIOD_MS * 1000)));
+    }
+    while (esp_timer_get_time() < deadline_us) {
+    }
+}
 
 /**
- * @brief 初始化ILI9341显示屏
+ * @brief 初始化ILI9341显示屏：配置GPIO并复位，立即返回
+ *
+ * 复位脉冲只需数据手册的最短时间；复位释放后5ms才能发送命令，这段时间留给LVGL、触摸等初始化，
+ * 配置命令推迟到第一次发送窗口时（ili9341_prepare）。
  */
 void ili9341_init(void)
 {
@@ -65,13 +98,24 @@ void ili9341_init(void)
         ESP_LOGE(TAG, "GPIO方向设置失败");
         return;
     }
+    rgb565_swap_init();
 
     // 执行硬件复位
     gpio_set_level(LCD_SPI_RST, 0);
-    vTaskDelay(pdMS_TO_TICKS(100));  // 低电平100ms
+    ili9341_wait_until(esp_timer_get_time() + ILI9341_RESET_PULSE_US);
     gpio_set_level(LCD_SPI_RST, 1);
-    vTaskDelay(pdMS_TO_TICKS(100));  // 高电平100ms
+    reset_release_us = esp_timer_get_time();
+    cmd_allowed_us = reset_release_us + ILI9341_RESET_CMD_US;
+    panel_state = PANEL_RESET;
+    ESP_LOGI(TAG, "ILI9341已复位，配置推迟到第一次刷新");
+}
 
+/**
+ * @brief 发送配置命令（复位释放5ms后），面板仍处于睡眠，此后可以写GRAM
+ */
+static void ili9341_configure(void)
+{
+    ili9341_wait_until(cmd_allowed_us);
     ESP_LOGI(TAG, "开始初始化ILI9341显示屏");
 
     // 发送初始化命令序列
@@ -79,13 +123,10 @@ void ili9341_init(void)
     while (ili_init_cmds[cmd].databytes != 0xFF) {
         ili9341_send_cmd(ili_init_cmds[cmd].cmd);
         ili9341_send_data(ili_init_cmds[cmd].data, ili_init_cmds[cmd].databytes & 0x1F);
-        if (ili_init_cmds[cmd].databytes & 0x80) {
-            vTaskDelay(pdMS_TO_TICKS(100));  // 需要延时的命令
-        }
         cmd++;
     }
 
-    // 设置默认方向
+    // 设置默认方向，之后随LVGL的显示旋转由ili9341_set_rotation改变
     ili9341_set_orientation(2);  // 横向
 
     // 设置颜色反转（根据配置宏）
@@ -95,7 +136,49 @@ void ili9341_init(void)
     ili9341_send_cmd(0x20);  // 正常显示
 #endif
 
-    ESP_LOGI(TAG, "ILI9341显示屏初始化完成");
+    panel_state = PANEL_SLEEP;
+    ESP_LOGI(TAG, "ILI9341配置完成，复位后%lld us", (long long)(esp_timer_get_time() - reset_release_us));
+}
+
+/**
+ * @brief 发送命令前调用：完成推迟的配置，并等过SLPOUT后的禁止命令时间
+ */
+static void ili9341_prepare(void)
+{
+    if (panel_state == PANEL_RESET) {
+        ili9341_configure();
+    }
+    ili9341_wait_until(cmd_allowed_us);
+}
+
+/**
+ * @brief 推进上电时序
+ */
+uint32_t ili9341_power_on_step(bool frame_ready)
+{
+    ili9341_prepare();
+    int64_t now = esp_timer_get_time();
+
+    if (panel_state == PANEL_SLEEP) {
+        int64_t due_us = reset_release_us + ILI9341_RESET_SLPOUT_US;
+        if (now < due_us) return (uint32_t)(due_us - now);
+
+        // 同步发送，等之前排队的颜色数据发完，SLPOUT的时刻即为发出的时刻
+        ili9341_send_cmd(0x11);
+        cmd_allowed_us = esp_timer_get_time() + ILI9341_SLPOUT_CMD_US;
+        panel_state = PANEL_AWAKE;
+        ESP_LOGI(TAG, "ILI9341退出睡眠，复位后%lld us", (long long)(esp_timer_get_time() - reset_release_us));
+        return ILI9341_SLPOUT_CMD_US;
+    }
+
+    if (panel_state == PANEL_AWAKE) {
+        // GRAM中还是上电时的随机内容，等第一帧写完再开显示
+        if (!frame_ready) return ILI9341_POWER_POLL_US;
+        ili9341_send_cmd(0x29);
+        panel_state = PANEL_ON;
+        ESP_LOGI(TAG, "ILI9341显示开启，复位后%lld us", (long long)(esp_timer_get_time() - reset_release_us));
+    }
+    return 0;
 }
 
 /**
@@ -124,15 +207,25 @@ static void ili9341_send_data(void *data, uint16_t length)
 
 /**
  * @brief 发送颜色数据到ILI9341（队列模式）
- * @param data 颜色数据缓冲区指针
+ * @param data 颜色数据缓冲区指针（LVGL渲染的小端RGB565）
  * @param length 数据长度（字节）
+ * @param last 是否为本块的最后一个窗口，只有最后一段触发刷新完成通知
+ *
+ * ILI9341按大端接收RGB565。逐段交换字节并立即排队，
+ * 交换下一段时本段（以及上一块刷新的剩余部分）已经在DMA传输中。
  */
-static void ili9341_send_color(void *data, uint16_t length)
+static void ili9341_send_color(uint8_t *data, size_t length, bool last)
 {
     if (length == 0) return;
-    disp_wait_for_pending_transactions();  // 等待挂起事务完成
-    gpio_set_level(LCD_SPI_DC, 1);         // DC高表示数据
-    disp_spi_send_colors(data, length);    // 发送颜色数据
+    while (length > 0) {
+        size_t n = length < DISP_SPI_COLOR_CHUNK_SIZE ? length : DISP_SPI_COLOR_CHUNK_SIZE;
+        esp_cpu_cycle_count_t start = esp_cpu_get_cycle_count();
+        rgb565_swap(data, n / 2);
+        port_stats_add_cycles(&port_stats.swap_cycles, start);
+        disp_spi_send_colors_chunk(data, n, last && n == length);  // DC由pre_cb拉高，排在窗口设置之后
+        data += n;
+        length -= n;
+    }
 }
 
 /**
@@ -142,29 +235,45 @@ static void ili9341_send_color(void *data, uint16_t length)
  * @param color_map 颜色数据缓冲区
  */
 void ili9341_flush(lv_display_t *drv, const lv_area_t *area, unsigned char *color_map)
+{
+    ili9341_flush_window(drv, area, color_map, true);
+}
+
+/**
+ * @brief 发送一个窗口的颜色数据，一块分为多个窗口时只有最后一个触发刷新完成通知
+ * @param drv LVGL显示驱动结构体指针
+ * @param area 窗口区域
+ * @param color_map 颜色数据缓冲区
+ * @param last 是否为本块的最后一个窗口
+ */
+void ili9341_flush_window(lv_display_t *drv, const lv_area_t *area, unsigned char *color_map, bool last)
 {
     uint8_t data[4];
 
+    ili9341_prepare();
+
+    // 窗口设置与颜色数据整体排队，紧跟在上一块的DMA之后发送，不等待队列排空
     // 设置列地址 (X坐标范围)
-    ili9341_send_cmd(0x2A);
     data[0] = (area->x1 >> 8) & 0xFF;  // X起始高字节
     data[1] = area->x1 & 0xFF;         // X起始低字节
     data[2] = (area->x2 >> 8) & 0xFF;  // X结束高字节
     data[3] = area->x2 & 0xFF;         // X结束低字节
-    ili9341_send_data(data, 4);
+    disp_spi_queue_cmd(0x2A, data, 4);
 
     // 设置页面地址 (Y坐标范围)
-    ili9341_send_cmd(0x2B);
     data[0] = (area->y1 >> 8) & 0xFF;  // Y起始高字节
     data[1] = area->y1 & 0xFF;         // Y起始低字节
     data[2] = (area->y2 >> 8) & 0xFF;  // Y结束高字节
     data[3] = area->y2 & 0xFF;         // Y结束低字节
-    ili9341_send_data(data, 4);
+    disp_spi_queue_cmd(0x2B, data, 4);
 
     // 写入颜色数据
-    ili9341_send_cmd(0x2C);
+    disp_spi_queue_cmd(0x2C, NULL, 0);
     uint32_t size = lv_area_get_width(area) * lv_area_get_height(area);  // 计算像素数
-    ili9341_send_color(color_map, size * sizeof(lv_color_t));           // 发送颜色数据
+    uint8_t px_size = lv_color_format_get_size(lv_display_get_color_format(drv)); // RGB565为2字节
+    port_stats_add(&port_stats.windows, 1);
+    port_stats_add(&port_stats.pixels, size);
+    ili9341_send_color(color_map, size * px_size, last);                // 分段交换字节并发送
 }
 
 /**
@@ -173,6 +282,7 @@ void ili9341_flush(lv_display_t *drv, const lv_area_t *area, unsigned char *colo
 void ili9341_sleep_in(void)
 {
     uint8_t data = 0x08;  // 睡眠参数
+    ili9341_prepare();
     ili9341_send_cmd(0x10);  // 睡眠命令
     ili9341_send_data(&data, 1);
     ESP_LOGI(TAG, "ILI9341进入睡眠模式");
@@ -184,6 +294,7 @@ void ili9341_sleep_in(void)
 void ili9341_sleep_out(void)
 {
     uint8_t data = 0x08;  // 唤醒参数
+    ili9341_prepare();
     ili9341_send_cmd(0x11);  // 退出睡眠命令
     ili9341_send_data(&data, 1);
     vTaskDelay(pdMS_TO_TICKS(120));  // 等待显示器稳定
@@ -217,4 +328,27 @@ static void ili9341_set_orientation(uint8_t orientation)
     ESP_LOGI(TAG, "0x36命令值: 0x%02X", data[orientation]);
     ili9341_send_cmd(0x36);  // 内存访问控制命令
     ili9341_send_data((void *)&data[orientation], 1);
+}
+
+/**
+ * @brief 按LVGL的显示旋转设置扫描方向
+ * @param rotation LVGL显示旋转
+ *
+ * 未旋转对应横向（初始化时的方向2）。LVGL旋转90°时逻辑坐标(x, y)应出现在横向的(y, 239 - x)处
+ * （见lv_display_rotate_area），即纵向；180°为横向反转，270°为纵向反转。
+ */
+void ili9341_set_rotation(lv_display_rotation_t rotation)
+{
+    static const uint8_t orientation[] = {
+        [LV_DISPLAY_ROTATION_0] = 2,
+        [LV_DISPLAY_ROTATION_90] = 0,
+        [LV_DISPLAY_ROTATION_180] = 3,
+        [LV_DISPLAY_ROTATION_270] = 1,
+    };
+    if ((unsigned)rotation >= sizeof(orientation)) {
+        ESP_LOGE(TAG, "无效的旋转: %d", (int)rotation);
+        return;
+    }
+    ili9341_prepare();
+    ili9341_set_orientation(orientation[rotation]);
 }
\ No newline at end of file
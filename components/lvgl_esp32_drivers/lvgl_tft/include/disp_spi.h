@@ -2,20 +2,29 @@
 #define __DISP_SPI_H
 
 #include <stdint.h>
+#include <stdbool.h>
 #include "driver/spi_master.h"
 #include "driver/gpio.h"
 
-// SPI事务池配置
-#define SPI_TRANSACTION_POOL_SIZE 50              // 事务池最大容量
-#define SPI_TRANSACTION_POOL_RESERVE_PERCENTAGE 10 // 保留容量百分比
-#define SPI_TRANSACTION_POOL_RESERVE (SPI_TRANSACTION_POOL_SIZE / SPI_TRANSACTION_POOL_RESERVE_PERCENTAGE)
-
 // 显示分辨率和缓冲区配置
 #define LV_HOR_RES_MAX (320)                      // 水平最大分辨率
 #define LV_VER_RES_MAX (240)                      // 垂直最大分辨率
 #define DISP_BUF_SIZE  (LV_HOR_RES_MAX * 40)      // 显示缓冲区大小
 #define SPI_BUS_MAX_TRANSFER_SZ (DISP_BUF_SIZE * 2) // SPI最大传输大小
 
+// 颜色数据分段：每段交换字节后立即排队，下一段的交换与本段的DMA重叠
+#define DISP_SPI_COLOR_CHUNK_SIZE   (LV_HOR_RES_MAX * 8 * 2)  // 每段字节数（整屏宽8行）
+#define DISP_SPI_COLOR_CHUNKS_MAX   ((DISP_BUF_SIZE * 2 + DISP_SPI_COLOR_CHUNK_SIZE - 1) / DISP_SPI_COLOR_CHUNK_SIZE)
+
+// SPI事务环配置：按同时在途的刷新块数确定，而不是固定容量
+// 一块可拆成多个窗口（影子帧缓冲比较，LV_PORT_SHADOW_RECTS_MAX不得超过DISP_SPI_WINDOWS_PER_FLUSH），
+// 每个窗口5条命令事务；各窗口的颜色数据分别分段，每多一个窗口最多多一段不满的颜色数据
+#define DISP_SPI_WINDOWS_PER_FLUSH  8             // 每块刷新最多的窗口数
+#define DISP_SPI_TRANS_PER_FLUSH    (5 * DISP_SPI_WINDOWS_PER_FLUSH + DISP_SPI_COLOR_CHUNKS_MAX + \
+                                     DISP_SPI_WINDOWS_PER_FLUSH - 1) // CASET/PASET各含命令和参数、RAMWR命令、各段颜色数据
+#define DISP_SPI_FLUSHES_IN_FLIGHT  2             // 双缓冲下最多两块同时在途
+#define DISP_SPI_TRANS_RING_SIZE    128           // 2的幂，不小于上两项之积
+
 // SPI主机和引脚配置
 #define LCD_SPI_HOST       SPI2_HOST      // SPI主机设备，通常为SPI2或SPI3
 #define LCD_SPI_MOSI       42             // SPI主输出从输入引脚
@@ -24,6 +33,7 @@
 #define LCD_SPI_SCLK       39             // SPI时钟引脚
 #define LCD_SPI_RST        38             // 显示屏复位引脚
 #define LCD_SPI_MODE       0              // SPI模式0
+#define LCD_SPI_CLOCK_HZ   (40 * 1000 * 1000) // SPI时钟频率40MHz
 
 // SPI传输标志枚举，定义不同的传输模式和选项
 typedef enum {
@@ -32,6 +42,8 @@ typedef enum {
     DISP_SPI_SEND_SYNCHRONOUS   = 0x00000002,  // 同步传输，等待完成
     DISP_SPI_SIGNAL_FLUSH       = 0x00000004,  // 标记需要刷新显示
     DISP_SPI_RECEIVE            = 0x00000008,  // 接收模式
+    DISP_SPI_DC_CMD             = 0x00000010,  // pre_cb中把DC拉低（命令）
+    DISP_SPI_DC_DATA            = 0x00000020,  // pre_cb中把DC拉高（参数/像素数据）
     DISP_SPI_ADDRESS_8          = 0x00000040,  // 8位地址
     DISP_SPI_ADDRESS_16         = 0x00000080,  // 16位地址
     DISP_SPI_ADDRESS_24         = 0x00000100,  // 24位地址
@@ -42,6 +54,12 @@ typedef enum {
     DISP_SPI_VARIABLE_DUMMY     = 0x00002000,  // 可变哑位
 } disp_spi_send_flag_t;
 
+/**
+ * @brief 颜色数据传输完成回调（在SPI post_cb中调用，ESP32上处于中断上下文）
+ * @param user_ctx 注册时传入的用户上下文
+ */
+typedef void (*disp_spi_flush_done_cb_t)(void *user_ctx);
+
 // 函数声明
 /**
  * @brief 初始化SPI总线和设备
@@ -55,6 +73,14 @@ void disp_spi_init(void);
  */
 void disp_spi_send_data(uint8_t *data, size_t length);
 
+/**
+ * @brief 以队列模式发送一条命令及其参数，DC由pre_cb按事务标志切换
+ * @param cmd 命令字节
+ * @param data 参数缓冲区，不超过4字节时复制到事务中，否则须保持有效直到传输完成
+ * @param length 参数长度（字节），0表示无参数
+ */
+void disp_spi_queue_cmd(uint8_t cmd, const uint8_t *data, size_t length);
+
 /**
  * @brief 使用队列模式发送颜色数据
  * @param data 颜色数据缓冲区指针
@@ -62,9 +88,24 @@ void disp_spi_send_data(uint8_t *data, size_t length);
  */
 void disp_spi_send_colors(uint8_t *data, size_t length);
 
+/**
+ * @brief 使用队列模式发送一块颜色数据中的一段
+ * @param data 本段数据指针，须保持有效直到传输完成
+ * @param length 本段长度（字节）
+ * @param last 是否为最后一段，只有最后一段传输完成时调用完成回调
+ */
+void disp_spi_send_colors_chunk(uint8_t *data, size_t length, bool last);
+
 /**
  * @brief 等待所有挂起的事务完成
  */
 void disp_wait_for_pending_transactions(void);
 
+/**
+ * @brief 注册颜色数据传输完成回调
+ * @param cb 回调函数，带DISP_SPI_SIGNAL_FLUSH标志的事务传输完成后调用，NULL表示取消
+ * @param user_ctx 用户上下文
+ */
+void disp_spi_set_flush_done_cb(disp_spi_flush_done_cb_t cb, void *user_ctx);
+
 #endif /* __DISP_SPI_H */
\ No newline at end of file
@@ -2,16 +2,34 @@
 #define __ILI9341_H
 
 #include <stdint.h>
+#include <stdbool.h>
 #include "lvgl.h"          // LVGL图形库头文件
 #include "driver/spi_master.h" // ESP-IDF SPI驱动头文件
 
+// 上电时序（ILI9341数据手册的最小值）
+#define ILI9341_RESET_PULSE_US      10      // RST低电平的最短时间
+#define ILI9341_RESET_CMD_US        5000    // RST释放后到第一条命令
+#define ILI9341_RESET_SLPOUT_US     120000  // RST释放后到退出睡眠（SLPOUT）
+#define ILI9341_SLPOUT_CMD_US       5000    // SLPOUT后到下一条命令
+#define ILI9341_POWER_POLL_US       1000    // 等第一帧写完时的查询间隔
+
 // 函数声明
 
 /**
- * @brief 初始化ILI9341显示屏
+ * @brief 初始化ILI9341显示屏：配置GPIO并发出复位脉冲后立即返回
+ *        配置命令推迟到第一次发送窗口时（复位释放5ms后），面板保持睡眠，
+ *        退出睡眠和开显示由ili9341_power_on_step完成
  */
 void ili9341_init(void);
 
+/**
+ * @brief 推进上电时序：复位释放120ms后发送SLPOUT，再过5ms且第一帧已写入GRAM后发送DISPON
+ *        在LVGL任务中周期调用，每步最多阻塞到已排队的传输结束
+ * @param frame_ready 第一帧是否已全部写入GRAM，之前不开显示，避免显示GRAM中的随机内容
+ * @return 距离下一步的微秒数，0表示显示已开启
+ */
+uint32_t ili9341_power_on_step(bool frame_ready);
+
 /**
  * @brief 刷新显示区域（LVGL显示回调函数）
  * @param drv LVGL显示驱动结构体指针
@@ -20,6 +38,22 @@ void ili9341_init(void);
  */
 void ili9341_flush(lv_display_t *drv, const lv_area_t *area, unsigned char *color_map);
 
+/**
+ * @brief 发送一块中的一个窗口：窗口设置和颜色数据排队，只有last为true时最后一段触发刷新完成通知
+ * @param drv LVGL显示驱动结构体指针
+ * @param area 窗口区域
+ * @param color_map 窗口的颜色数据（行间无填充），发送时原地交换字节
+ * @param last 是否为本块的最后一个窗口
+ */
+void ili9341_flush_window(lv_display_t *drv, const lv_area_t *area, unsigned char *color_map, bool last);
+
+/**
+ * @brief 按LVGL的显示旋转重设扫描方向（0x36 MADCTL），面板直接按旋转后的逻辑坐标寻址，
+ *        flush时不需要软件旋转。等待已排队的传输结束后发送，之后的窗口按新方向写入
+ * @param rotation LVGL显示旋转，LV_DISPLAY_ROTATION_0为横向
+ */
+void ili9341_set_rotation(lv_display_rotation_t rotation);
+
 /**
  * @brief 使ILI9341进入睡眠模式
  */
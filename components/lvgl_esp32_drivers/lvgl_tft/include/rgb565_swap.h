@@ -0,0 +1,44 @@
+#ifndef __RGB565_SWAP_H
+#define __RGB565_SWAP_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// RGB565字节交换：LVGL按小端渲染，ILI9341按大端接收
+// ESP32-S3上打开LV_PORT_RGB565_SWAP_PIE时用PIE向量指令（rgb565_swap_esp32s3.S，尚未在硬件上验证，
+// 默认关闭），否则用按机器字的SWAR实现
+
+#define RGB565_SWAP_PIE_BLOCK   32      // PIE内核每次处理的字节数（两个128位寄存器）
+
+/**
+ * @brief 初始化：使用PIE内核时用参考实现校验一次，不一致时退回SWAR
+ */
+void rgb565_swap_init(void);
+
+/**
+ * @brief 原地交换RGB565像素的高低字节，按平台选择最快的实现
+ * @param buf 像素缓冲区，2字节对齐即可
+ * @param px 像素数
+ */
+void rgb565_swap(void *buf, size_t px);
+
+/**
+ * @brief SWAR实现：按机器字（32位或64位）一次交换多个像素
+ * @param buf 像素缓冲区，2字节对齐即可
+ * @param px 像素数
+ */
+void rgb565_swap_swar(void *buf, size_t px);
+
+/**
+ * @brief 逐像素的参考实现，用于校验
+ * @param buf 像素缓冲区
+ * @param px 像素数
+ */
+void rgb565_swap_ref(void *buf, size_t px);
+
+/**
+ * @brief 当前rgb565_swap使用的实现名称，用于日志和基准测试
+ */
+const char *rgb565_swap_impl_name(void);
+
+#endif /* __RGB565_SWAP_H */
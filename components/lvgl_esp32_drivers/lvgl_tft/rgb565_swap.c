@@ -0,0 +1,151 @@
+#include "rgb565_swap.h"
+#include <stdbool.h>
+#include <string.h>
+#include "esp_log.h"
+
+// 日志标签
+static const char *TAG = "RGB565_SWAP";
+
+// SWAR字宽跟随指针宽度：主机上64位，ESP32-S3上32位
+// may_alias：缓冲区按字节数组声明，以字访问不违反严格别名规则
+#if UINTPTR_MAX > 0xFFFFFFFFu
+typedef uint64_t __attribute__((may_alias)) swar_word_t;
+#define SWAR_HI_BYTES   0xFF00FF00FF00FF00ULL
+#define SWAR_LO_BYTES   0x00FF00FF00FF00FFULL
+#else
+typedef uint32_t __attribute__((may_alias)) swar_word_t;
+#define SWAR_HI_BYTES   0xFF00FF00UL
+#define SWAR_LO_BYTES   0x00FF00FFUL
+#endif
+#define SWAR_PX_PER_WORD    (sizeof(swar_word_t) / 2)
+#define SWAR_SWAP(w)        ((((w) & SWAR_HI_BYTES) >> 8) | (((w) & SWAR_LO_BYTES) << 8))
+
+#if defined(RGB565_SWAP_USE_PIE)
+/**
+ * @brief PIE内核（rgb565_swap_esp32s3.S）
+ * @param buf 16字节对齐的缓冲区
+ * @param blocks RGB565_SWAP_PIE_BLOCK字节块的个数
+ */
+void rgb565_swap_pie(void *buf, size_t blocks);
+
+static bool pie_ok = false;     // PIE内核已通过校验
+#endif
+
+static inline uint16_t swap16(uint16_t v)
+{
+    return (uint16_t)(v << 8 | v >> 8);
+}
+
+/**
+ * @brief 逐像素的参考实现
+ */
+void rgb565_swap_ref(void *buf, size_t px)
+{
+    uint16_t *p = buf;
+    for (size_t i = 0; i < px; i++) {
+        p[i] = swap16(p[i]);
+    }
+}
+
+/**
+ * @brief SWAR实现：先逐像素处理到字对齐，再按字交换，最后处理不足一个字的尾部
+ */
+void rgb565_swap_swar(void *buf, size_t px)
+{
+    uint16_t *p = buf;
+
+    while (px > 0 && ((uintptr_t)p & (sizeof(swar_word_t) - 1)) != 0) {
+        *p = swap16(*p);
+        p++;
+        px--;
+    }
+
+    swar_word_t *w = (swar_word_t *)p;
+    size_t words = px / SWAR_PX_PER_WORD;
+    // 展开4次，加载和移位可以交错执行
+    while (words >= 4) {
+        swar_word_t w0 = w[0], w1 = w[1], w2 = w[2], w3 = w[3];
+        w[0] = SWAR_SWAP(w0);
+        w[1] = SWAR_SWAP(w1);
+        w[2] = SWAR_SWAP(w2);
+        w[3] = SWAR_SWAP(w3);
+        w += 4;
+        words -= 4;
+    }
+    while (words-- > 0) {
+        *w = SWAR_SWAP(*w);
+        w++;
+    }
+
+    p = (uint16_t *)w;
+    px %= SWAR_PX_PER_WORD;
+    while (px-- > 0) {
+        *p = swap16(*p);
+        p++;
+    }
+}
+
+/**
+ * @brief 原地交换RGB565像素的高低字节
+ */
+void rgb565_swap(void *buf, size_t px)
+{
+#if defined(RGB565_SWAP_USE_PIE)
+    if (pie_ok) {
+        uint8_t *p = buf;
+        size_t bytes = px * 2;
+
+        // 头部不足16字节对齐的部分和尾部不足一块的部分用SWAR处理
+        size_t head = (size_t)(-(uintptr_t)p) & 15;
+        if (head > bytes) head = bytes;
+        rgb565_swap_swar(p, head / 2);
+        p += head;
+        bytes -= head;
+
+        size_t blocks = bytes / RGB565_SWAP_PIE_BLOCK;
+        if (blocks > 0) {
+            rgb565_swap_pie(p, blocks);
+            p += blocks * RGB565_SWAP_PIE_BLOCK;
+            bytes -= blocks * RGB565_SWAP_PIE_BLOCK;
+        }
+        rgb565_swap_swar(p, bytes / 2);
+        return;
+    }
+#endif
+    rgb565_swap_swar(buf, px);
+}
+
+/**
+ * @brief 当前使用的实现名称
+ */
+const char *rgb565_swap_impl_name(void)
+{
+#if defined(RGB565_SWAP_USE_PIE)
+    if (pie_ok) return "pie";
+#endif
+    return sizeof(swar_word_t) == 8 ? "swar64" : "swar32";
+}
+
+/**
+ * @brief 初始化，使用PIE内核时先校验
+ */
+void rgb565_swap_init(void)
+{
+#if defined(RGB565_SWAP_USE_PIE)
+    static uint16_t test[3 * RGB565_SWAP_PIE_BLOCK / 2] __attribute__((aligned(16)));
+    static uint16_t expect[3 * RGB565_SWAP_PIE_BLOCK / 2];
+
+    for (size_t i = 0; i < sizeof(test) / sizeof(test[0]); i++) {
+        test[i] = (uint16_t)(i * 0x0102u + 0x8001u);
+    }
+    memcpy(expect, test, sizeof(test));
+    rgb565_swap_ref(expect, sizeof(expect) / sizeof(expect[0]));
+
+    rgb565_swap_pie(test, sizeof(test) / RGB565_SWAP_PIE_BLOCK);
+    pie_ok = memcmp(test, expect, sizeof(test)) == 0;
+    if (!pie_ok) {
+        ESP_LOGW(TAG, "PIE内核校验失败，使用SWAR实现");
+    }
+#endif
+    ESP_LOGI(TAG, "RGB565字节交换实现: %s", rgb565_swap_impl_name());
+}
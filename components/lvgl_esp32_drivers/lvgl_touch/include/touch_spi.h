@@ -26,7 +26,7 @@ void tp_spi_init(void);
 void tp_spi_add_device(spi_host_device_t host);
 
 /**
- * @brief SPI数据交换
+ * @brief SPI数据交换（全双工，不带命令相位）
  * @param data_send 发送数据缓冲区
  * @param data_recv 接收数据缓冲区
  * @param byte_count 数据字节数
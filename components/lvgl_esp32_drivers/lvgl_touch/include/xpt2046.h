@@ -7,7 +7,7 @@
 
 // XPT2046触摸屏配置宏
 #define XPT2046_IRQ             TP_SPI_IRQ      // 中断引脚（IRQ）
-#define XPT2046_AVG             4       // 坐标平均采样次数
+// 默认校准：未调用xpt2046_set_calib时按以下量程线性映射
 #define XPT2046_X_MIN           200     // X轴最小原始值
 #define XPT2046_Y_MIN           120     // Y轴最小原始值
 #define XPT2046_X_MAX           1900    // X轴最大原始值
@@ -20,17 +20,82 @@
 #define XPT2046_TOUCH_IRQ_PRESS 0       // 是否使用IRQ检测触摸压力（0:否, 1:是）
 #define XPT2046_TOUCH_PRESS     0    // 触摸压力检测值
 
+// 滤波管线：突发中值 -> 压力门限 -> 跳变确认 -> 速度自适应IIR（距离均为规范化原始值）
+#define XPT2046_OVERSAMPLE      5       // 每次突发读取中各通道的转换次数，取中值，宜为奇数
+#define XPT2046_PRESSURE_MIN    XPT2046_TOUCH_THRESHOLD // 低于该压力值的采样位置不可信，丢弃
+#define XPT2046_OUTLIER_DIST    256     // 与上一点的距离超过该值时需下一个采样确认
+#define XPT2046_IIR_ALPHA_MIN   64      // 静止时的IIR系数（Q8，256表示不滤波）
+#define XPT2046_IIR_SPEED_GAIN  3       // 每单位位移增加的IIR系数（Q8）
+
+// 采样任务配置：PENIRQ下降沿唤醒，按下期间按固定周期采样，结果经无锁环形缓冲交给LVGL
+#define XPT2046_SAMPLE_PERIOD_MS 10     // 按下期间的采样周期（ms）
+#define XPT2046_RING_SIZE       32      // 采样环形缓冲容量，必须为2的幂
+#define XPT2046_TASK_PRIORITY   6       // 采样任务优先级，高于LVGL任务
+#define XPT2046_TASK_STACK      3072    // 采样任务栈大小（字节）
+#define XPT2046_TASK_CORE       0       // 采样任务所在CPU核心
+
+// 三点仿射校准矩阵，原始坐标为规范化值（与XPT2046_X_MIN同一量纲）：
+//   屏幕x = (a * 原始x + b * 原始y + c) / div
+//   屏幕y = (d * 原始x + e * 原始y + f) / div
+// 屏幕坐标是未旋转（LV_DISPLAY_ROTATION_0）的坐标，显示旋转后由LVGL换算，校准不需要重做；
+// 在旋转后的界面上采集校准点时，须先把点的逻辑坐标换回未旋转的坐标
+typedef struct {
+    int64_t a, b, c;
+    int64_t d, e, f;
+    int64_t div;
+} xpt2046_calib_t;
+
+/**
+ * @brief 新采样点写入环形缓冲后的通知回调（在采样任务中调用）
+ * @param user_ctx 注册时传入的用户上下文
+ */
+typedef void (*xpt2046_ready_cb_t)(void *user_ctx);
+
 /**
  * @brief 初始化XPT2046触摸屏
  */
 void xpt2046_init(void);
 
 /**
- * @brief 读取触摸屏数据（LVGL输入设备回调）
+ * @brief 读取触摸屏数据（LVGL输入设备回调），每次从环形缓冲取出一个采样点
  * @param drv LVGL输入设备驱动结构体指针
- * @param data 触摸数据结构体指针
- * @return 是否有未处理的数据（始终返回false）
+ * @param data 触摸数据结构体指针，缓冲为空时保持上一个点
+ * @return 缓冲中是否还有未处理的采样点
  */
 bool xpt2046_read(lv_indev_t *drv, lv_indev_data_t *data);
 
+/**
+ * @brief 由三组对应点计算仿射校准矩阵（可同时校正缩放、偏移、旋转和XY交换）
+ * @param raw 三个校准点的规范化原始坐标
+ * @param screen 对应的屏幕坐标
+ * @param out 输出校准矩阵
+ * @return 三点共线时返回false
+ */
+bool xpt2046_calib_compute(const lv_point_t raw[3], const lv_point_t screen[3], xpt2046_calib_t *out);
+
+/**
+ * @brief 设置校准矩阵，需在LVGL线程中调用
+ * @param calib 校准矩阵，NULL表示恢复由XPT2046_X_MIN等生成的默认矩阵
+ */
+void xpt2046_set_calib(const xpt2046_calib_t *calib);
+
+/**
+ * @brief 注册新采样点通知回调
+ * @param cb 回调函数，每写入一个按下或松开点后调用，NULL表示取消
+ * @param user_ctx 用户上下文
+ */
+void xpt2046_set_ready_cb(xpt2046_ready_cb_t cb, void *user_ctx);
+
+/**
+ * @brief 查询环形缓冲中待LVGL处理的采样点数
+ * @return 采样点数
+ */
+uint32_t xpt2046_pending(void);
+
+/**
+ * @brief 获取最近一次xpt2046_read取出的采样点的采样时刻
+ * @return esp_timer时间（微秒），尚未取出过采样点时为0
+ */
+int64_t xpt2046_get_last_timestamp(void);
+
 #endif /* __XPT2046_H */
\ No newline at end of file
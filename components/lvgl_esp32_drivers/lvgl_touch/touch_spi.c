@@ -65,19 +65,24 @@ void tp_spi_add_device(spi_host_device_t host)
 }
 
 /**
- * @brief SPI数据交换
+ * @brief SPI数据交换（全双工，不带命令相位，发送和接收逐字节对齐）
  * @param data_send 发送数据缓冲区
  * @param data_recv 接收数据缓冲区
  * @param byte_count 数据字节数
  */
 void tp_spi_xchg(uint8_t* data_send, uint8_t* data_recv, uint8_t byte_count)
 {
-	spi_transaction_t t = {
-		.length = byte_count * 8, // SPI transaction length is in bits
-		.tx_buffer = data_send,
-		.rx_buffer = data_recv};
+	spi_transaction_ext_t t = {
+		.base = {
+			.flags = SPI_TRANS_VARIABLE_CMD, // 覆盖设备的8位命令相位
+			.length = byte_count * 8, // SPI transaction length is in bits
+			.tx_buffer = data_send,
+			.rx_buffer = data_recv,
+		},
+		.command_bits = 0,
+	};
 	
-	esp_err_t ret = spi_device_transmit(spi, &t);
+	esp_err_t ret = spi_device_transmit(spi, &t.base);
 	assert(ret == ESP_OK);
 }
 
@@ -1,9 +1,18 @@
 #include "xpt2046.h"
 #include "touch_spi.h"      // 触摸屏SPI驱动头文件
 #include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
 #include "esp_log.h"        // ESP-IDF日志库
+#include "esp_timer.h"      // 采样时间戳
+#include "esp_attr.h"
 #include "driver/gpio.h"    // GPIO驱动头文件
 #include "esp_system.h"     // ESP系统函数
+#include "port_stats.h"     // 移植层性能计数器
 
 // 日志标签
 static const char *TAG = "XPT2046";
@@ -20,16 +29,77 @@ typedef enum {
     TOUCH_DETECTED = 1,         // 检测到触摸
 } xpt2046_touch_detect_t;
 
-// 静态变量，用于坐标平均计算
-static int16_t avg_buf_x[XPT2046_AVG];  // X坐标平均缓冲区
-static int16_t avg_buf_y[XPT2046_AVG];  // Y坐标平均缓冲区
-static uint8_t avg_last;                // 当前平均值计数
+#define XPT2046_USE_IRQ (XPT2046_TOUCH_IRQ || XPT2046_TOUCH_IRQ_PRESS)
+
+// 突发读取：X、Y、Z1、Z2依次重复XPT2046_OVERSAMPLE次，作为一个全双工事务发送。
+// 每个控制字节的结果在其后16个时钟输出，与下一个控制字节重叠（每次转换15个时钟），
+// 末尾再补1字节时钟取出最后一次结果
+#define BURST_CHANNELS  4
+#define BURST_LEN       (BURST_CHANNELS * XPT2046_OVERSAMPLE * 2 + 1)
+
+_Static_assert(BURST_LEN <= UINT8_MAX, "突发读取长度超出tp_spi_xchg范围");
+
+_Static_assert((XPT2046_RING_SIZE & (XPT2046_RING_SIZE - 1)) == 0, "XPT2046_RING_SIZE必须为2的幂");
+
+// 采样点：坐标为滤波后的规范化原始值，由LVGL侧按校准矩阵映射到屏幕
+typedef struct {
+    int16_t x;
+    int16_t y;
+    lv_indev_state_t state;
+    int64_t timestamp_us;   // 采样时刻（esp_timer时间）
+} xpt2046_point_t;
+
+// 一次突发读取的原始结果：各通道为XPT2046_OVERSAMPLE次转换的中值，
+// 格式与单次读取相同（12位结果左移3位）
+typedef struct {
+    int16_t x;
+    int16_t y;
+    int16_t z1;
+    int16_t z2;
+} xpt2046_raw_t;
+
+// 突发读取缓冲区，只在采样任务中访问
+DMA_ATTR static uint8_t burst_tx[BURST_LEN];
+DMA_ATTR static uint8_t burst_rx[BURST_LEN];
+
+// 滤波状态（只在采样任务中访问）
+typedef struct {
+    int32_t x_q4;           // IIR输出，Q4定点
+    int32_t y_q4;
+    int16_t cand_x;         // 待确认的跳变点
+    int16_t cand_y;
+    bool active;            // 本次按下已有输出
+    bool has_cand;          // 存在待确认的跳变点
+} xpt2046_filter_t;
+
+static xpt2046_filter_t filter;
+
+// 校准矩阵（只在LVGL中访问），div为0表示尚未设置，首次读取时按默认参数生成
+static xpt2046_calib_t calib;
+
+// 采样环形缓冲：采样任务为唯一生产者，LVGL为唯一消费者
+static xpt2046_point_t point_ring[XPT2046_RING_SIZE];
+static atomic_uint ring_head;           // 下一个写入位置，只由采样任务递增
+static atomic_uint ring_tail;           // 下一个读取位置，只由LVGL递增
+static uint32_t dropped_count;          // 缓冲满时丢弃的按下点数（只在采样任务中访问）
+static int64_t last_timestamp_us;       // 最近一次取出的采样时刻（只在LVGL中访问）
+
+static SemaphoreHandle_t irq_sem = NULL;    // PENIRQ下降沿信号
+static xpt2046_ready_cb_t ready_cb = NULL;  // 新采样点通知回调
+static void *ready_ctx = NULL;              // 通知回调用户上下文
 
 // 函数声明
-static xpt2046_touch_detect_t xpt2046_is_touch_detected(void);
-static int16_t xpt2046_cmd(uint8_t cmd);
+static void xpt2046_irq_isr(void *arg);
+static void xpt2046_sample_task(void *arg);
+static bool ring_push(const xpt2046_point_t *point);
+static bool ring_pop(xpt2046_point_t *point);
+static xpt2046_touch_detect_t xpt2046_is_touch_detected(xpt2046_raw_t *raw);
+static void xpt2046_burst_read(xpt2046_raw_t *raw);
+static int16_t xpt2046_median(const uint8_t *rx, int channel);
+static bool xpt2046_filter(const xpt2046_raw_t *raw, int16_t *x, int16_t *y);
+static void xpt2046_default_calib(xpt2046_calib_t *out);
 static void xpt2046_corr(int16_t *x, int16_t *y);
-static void xpt2046_avg(int16_t *x, int16_t *y);
+static void xpt2046_native_res(int32_t *hor_res, int32_t *ver_res);
 
 /**
  * @brief 初始化XPT2046触摸屏
@@ -38,14 +108,31 @@ void xpt2046_init(void)
 {
     ESP_LOGI(TAG, "开始初始化XPT2046触摸屏");
 
-#if XPT2046_TOUCH_IRQ || XPT2046_TOUCH_IRQ_PRESS
-    // 配置IRQ引脚
+    // 突发读取的控制字节序列固定不变，只需生成一次
+    static const uint8_t channels[BURST_CHANNELS] = {CMD_X_READ, CMD_Y_READ, CMD_Z1_READ, CMD_Z2_READ};
+    memset(burst_tx, 0, sizeof(burst_tx));
+    for (int i = 0; i < BURST_CHANNELS * XPT2046_OVERSAMPLE; i++) {
+        burst_tx[2 * i] = channels[i % BURST_CHANNELS];
+    }
+
+    filter.active = false;
+    atomic_store(&ring_head, 0);
+    atomic_store(&ring_tail, 0);
+
+#if XPT2046_USE_IRQ
+    irq_sem = xSemaphoreCreateBinary();
+    if (irq_sem == NULL) {
+        ESP_LOGE(TAG, "IRQ信号量创建失败");
+        return;
+    }
+
+    // 配置IRQ引脚：PENIRQ按下时拉低，下降沿唤醒采样任务
     gpio_config_t irq_config = {
         .pin_bit_mask = BIT64(XPT2046_IRQ),  // 指定IRQ引脚
         .mode = GPIO_MODE_INPUT,             // 输入模式
-        .pull_up_en = GPIO_PULLUP_DISABLE,   // 不启用上拉
+        .pull_up_en = GPIO_PULLUP_ENABLE,    // 启用上拉，未触摸时保持高电平
         .pull_down_en = GPIO_PULLDOWN_DISABLE, // 不启用下拉
-        .intr_type = GPIO_INTR_DISABLE,      // 禁用中断
+        .intr_type = GPIO_INTR_NEGEDGE,      // 下降沿中断
     };
 
     esp_err_t ret = gpio_config(&irq_config);
@@ -53,78 +140,224 @@ void xpt2046_init(void)
         ESP_LOGE(TAG, "IRQ引脚配置失败: %s", esp_err_to_name(ret));
         return;
     }
+
+    // 中断服务可能已由其他驱动安装
+    ret = gpio_install_isr_service(0);
+    if (ret != ESP_OK && ret != ESP_ERR_INVALID_STATE) {
+        ESP_LOGE(TAG, "GPIO中断服务安装失败: %s", esp_err_to_name(ret));
+        return;
+    }
+
+    ret = gpio_isr_handler_add(XPT2046_IRQ, xpt2046_irq_isr, NULL);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "IRQ中断处理函数注册失败: %s", esp_err_to_name(ret));
+        return;
+    }
 #endif
 
-    avg_last = 0;  // 初始化平均计数
+    if (xTaskCreatePinnedToCore(xpt2046_sample_task, "xpt2046", XPT2046_TASK_STACK, NULL,
+                                XPT2046_TASK_PRIORITY, NULL, XPT2046_TASK_CORE) != pdPASS) {
+        ESP_LOGE(TAG, "采样任务创建失败");
+        return;
+    }
+
     ESP_LOGI(TAG, "XPT2046触摸屏初始化完成");
 }
 
 /**
- * @brief 读取触摸屏数据（LVGL回调）
- * @param drv LVGL输入设备驱动结构体指针
- * @param data 触摸数据结构体指针
- * @return 是否有未处理的数据（始终返回false）
+ * @brief PENIRQ下降沿中断，只负责唤醒采样任务
+ * @param arg 未使用
  */
-bool xpt2046_read(lv_indev_t *drv, lv_indev_data_t *data)
+static void IRAM_ATTR xpt2046_irq_isr(void *arg)
 {
-    static int16_t last_x = 0;  // 上次X坐标
-    static int16_t last_y = 0;  // 上次Y坐标
-    bool valid = false;         // 数据有效性标志
+    BaseType_t woken = pdFALSE;
+    xSemaphoreGiveFromISR(irq_sem, &woken);
+    portYIELD_FROM_ISR(woken);
+}
 
-    int16_t x = last_x;
-    int16_t y = last_y;
+/**
+ * @brief 采样任务：等待PENIRQ，按下期间按固定周期采样并写入环形缓冲
+ * @param arg 未使用
+ *
+ * SPI读取和滤波都在本任务中完成，LVGL读回调只取出结果并做校准映射，
+ * 因此LVGL线程阻塞时采样不会中断，也不会增加界面一帧的耗时。
+ */
+static void xpt2046_sample_task(void *arg)
+{
+    TickType_t period = pdMS_TO_TICKS(XPT2046_SAMPLE_PERIOD_MS);
+    if (period == 0) period = 1;
 
-    if (xpt2046_is_touch_detected() == TOUCH_DETECTED) 
-    {
-        valid = true;
+    xpt2046_point_t point = { .state = LV_INDEV_STATE_RELEASED };
+    bool pressed = false;
+    TickType_t last_wake = xTaskGetTickCount();
 
-        // 读取原始坐标
-        x = xpt2046_cmd(CMD_X_READ);
-        y = xpt2046_cmd(CMD_Y_READ);
-        ESP_LOGD(TAG, "原始坐标: P(%d, %d)", x, y);
+    for (;;) {
+        xpt2046_raw_t raw;
+        if (xpt2046_is_touch_detected(&raw) == TOUCH_DETECTED) {
+            int16_t x, y;
+            ESP_LOGD(TAG, "原始坐标: P(%d, %d)", raw.x, raw.y);
 
-        // 规范化坐标（右移4位，去除低位噪声）
-        x = x >> 4;
-        y = y >> 4;
-        ESP_LOGI(TAG, "规范化坐标: P_norm(%d, %d)", x, y);
+            // 被滤波管线拒绝的采样（压力过渡、孤立跳变）不产生点
+            if (xpt2046_filter(&raw, &x, &y)) {
+                point.x = x;
+                point.y = y;
+                point.state = LV_INDEV_STATE_PRESSED;
+                point.timestamp_us = esp_timer_get_time();
+                if (!ring_push(&point)) {
+                    dropped_count++;
+                    ESP_LOGD(TAG, "采样缓冲已满，已丢弃%lu个点", (unsigned long)dropped_count);
+                } else {
+                    port_stats_add(&port_stats.touch_samples, 1);
+                    if (ready_cb) ready_cb(ready_ctx);
+                }
+                pressed = true;
+            }
+            vTaskDelayUntil(&last_wake, period);
+            continue;
+        }
 
-        // 校正和平均处理
-        xpt2046_corr(&x, &y);
-        xpt2046_avg(&x, &y);
-        last_x = x;
-        last_y = y;
+        filter.active = false;  // 无触摸时重置滤波状态
+        filter.has_cand = false;
 
-        ESP_LOGI(TAG, "校正后坐标: x = %d, y = %d", x, y);
-    } else {
-        avg_last = 0;  // 无触摸时重置平均计数
+        if (pressed) {
+            // 松开点保持最后坐标；不能丢失，缓冲满时下一个周期重试
+            point.state = LV_INDEV_STATE_RELEASED;
+            point.timestamp_us = esp_timer_get_time();
+            if (!ring_push(&point)) {
+                vTaskDelay(period);
+                continue;
+            }
+            pressed = false;
+            port_stats_add(&port_stats.touch_samples, 1);
+            if (ready_cb) ready_cb(ready_ctx);
+        }
+
+#if XPT2046_USE_IRQ
+        // PENIRQ为高时等待下降沿；按下期间的下降沿也会置位信号量，醒来后重新判断即可。
+        // PENIRQ为低但压力不足时没有新的边沿，继续按周期检测
+        if (gpio_get_level(XPT2046_IRQ) != 0) {
+            xSemaphoreTake(irq_sem, portMAX_DELAY);
+            last_wake = xTaskGetTickCount();
+            continue;
+        }
+#endif
+        vTaskDelayUntil(&last_wake, period);
+    }
+}
+
+/**
+ * @brief 写入一个采样点（采样任务调用）
+ * @param point 采样点
+ * @return 缓冲已满时返回false
+ */
+static bool ring_push(const xpt2046_point_t *point)
+{
+    unsigned head = atomic_load_explicit(&ring_head, memory_order_relaxed);
+    if (head - atomic_load_explicit(&ring_tail, memory_order_acquire) == XPT2046_RING_SIZE) {
+        return false;
+    }
+    point_ring[head & (XPT2046_RING_SIZE - 1)] = *point;
+    atomic_store_explicit(&ring_head, head + 1, memory_order_release);
+    return true;
+}
+
+/**
+ * @brief 取出一个采样点（LVGL调用）
+ * @param point 输出采样点
+ * @return 缓冲为空时返回false
+ */
+static bool ring_pop(xpt2046_point_t *point)
+{
+    unsigned tail = atomic_load_explicit(&ring_tail, memory_order_relaxed);
+    if (tail == atomic_load_explicit(&ring_head, memory_order_acquire)) {
+        return false;
+    }
+    *point = point_ring[tail & (XPT2046_RING_SIZE - 1)];
+    atomic_store_explicit(&ring_tail, tail + 1, memory_order_release);
+    return true;
+}
+
+/**
+ * @brief 注册新采样点通知回调
+ */
+void xpt2046_set_ready_cb(xpt2046_ready_cb_t cb, void *user_ctx)
+{
+    ready_ctx = user_ctx;
+    ready_cb = cb;
+}
+
+/**
+ * @brief 查询待处理的采样点数
+ */
+uint32_t xpt2046_pending(void)
+{
+    return atomic_load_explicit(&ring_head, memory_order_acquire) -
+           atomic_load_explicit(&ring_tail, memory_order_relaxed);
+}
+
+/**
+ * @brief 获取最近一次取出的采样点的采样时刻
+ */
+int64_t xpt2046_get_last_timestamp(void)
+{
+    return last_timestamp_us;
+}
+
+/**
+ * @brief 读取触摸屏数据（LVGL回调）
+ * @param drv LVGL输入设备驱动结构体指针
+ * @param data 触摸数据结构体指针
+ * @return 缓冲中是否还有未处理的采样点
+ */
+bool xpt2046_read(lv_indev_t *drv, lv_indev_data_t *data)
+{
+    static xpt2046_point_t last = { .state = LV_INDEV_STATE_RELEASED };  // 缓冲为空时保持上一个点
+
+    LV_PROFILER_BEGIN;
+    if (ring_pop(&last)) {
+        last_timestamp_us = last.timestamp_us;
+        // 采样任务可能在另一个核上，延迟用esp_timer而不是周期计数
+        uint32_t latency_us = (uint32_t)(esp_timer_get_time() - last.timestamp_us);
+        port_stats_add(&port_stats.touch_reads, 1);
+        port_stats_add(&port_stats.touch_latency_us, latency_us);
+        port_stats_max(&port_stats.touch_latency_max_us, latency_us);
     }
 
+    int16_t x = last.x;
+    int16_t y = last.y;
+    xpt2046_corr(&x, &y);
+
     // 更新LVGL数据
     data->point.x = x;
     data->point.y = y;
-    data->state = valid == false ? LV_INDEV_STATE_PR : LV_INDEV_STATE_REL;
+    data->state = last.state;
+    data->continue_reading = xpt2046_pending() > 0;
 
-    return false;  // 无需缓冲数据
+    LV_PROFILER_END;
+    return data->continue_reading;
 }
 
 /**
- * @brief 检测触摸状态
+ * @brief 检测触摸状态，检测到触摸时同时给出本次采样结果
+ * @param raw 输出突发读取的原始结果，未触摸时内容未定义
  * @return 触摸检测结果
  */
-static xpt2046_touch_detect_t xpt2046_is_touch_detected(void)
+static xpt2046_touch_detect_t xpt2046_is_touch_detected(xpt2046_raw_t *raw)
 {
-#if XPT2046_TOUCH_IRQ || XPT2046_TOUCH_IRQ_PRESS
-    // 使用IRQ引脚检测触摸
+#if XPT2046_USE_IRQ
+    // 使用IRQ引脚检测触摸，未触摸时不启动转换
     uint8_t irq = gpio_get_level(XPT2046_IRQ);
     if (irq != 0) {
         return TOUCH_NOT_DETECTED;  // IRQ高电平表示无触摸
     }
 #endif
 
+    xpt2046_burst_read(raw);
+
 #if XPT2046_TOUCH_PRESS || XPT2046_TOUCH_IRQ_PRESS
     // 使用压力值检测触摸
-    int16_t z1 = xpt2046_cmd(CMD_Z1_READ) >> 3;
-    int16_t z2 = xpt2046_cmd(CMD_Z2_READ) >> 3;
+    int16_t z1 = raw->z1 >> 3;
+    int16_t z2 = raw->z2 >> 3;
     int16_t z = z1 + 4096 - z2;  // 计算压力值
 
     ESP_LOGD(TAG, "压力值: z1=%d, z2=%d, z=%d", z1, z2, z);
@@ -136,73 +369,223 @@ static xpt2046_touch_detect_t xpt2046_is_touch_detected(void)
 }
 
 /**
- * @brief 发送命令并读取数据
- * @param cmd SPI命令字节
- * @return 16位触摸数据
+ * @brief 在一个SPI事务中完成全部通道的过采样转换
+ * @param raw 输出各通道的平均值
  */
-static int16_t xpt2046_cmd(uint8_t cmd)
+static void xpt2046_burst_read(xpt2046_raw_t *raw)
 {
-    uint8_t data[2];
-    tp_spi_read_reg(cmd, data, 2);
-    return (int16_t)((data[0] << 8) | data[1]);  // 合并高低字节
+    LV_PROFILER_BEGIN;
+    tp_spi_xchg(burst_tx, burst_rx, BURST_LEN);
+
+    raw->x = xpt2046_median(burst_rx, 0);
+    raw->y = xpt2046_median(burst_rx, 1);
+    raw->z1 = xpt2046_median(burst_rx, 2);
+    raw->z2 = xpt2046_median(burst_rx, 3);
+    LV_PROFILER_END;
 }
 
 /**
- * @brief 校正触摸坐标
- * @param x X坐标指针
- * @param y Y坐标指针
+ * @brief 取突发读取中某个通道的中值，可剔除少于一半的单次转换毛刺
+ * @param rx 突发读取的接收缓冲区
+ * @param channel 通道在控制字节序列中的位置（0~3）
+ * @return 中值（偶数个时取两个中间值的平均）
  */
-static void xpt2046_corr(int16_t *x, int16_t *y)
+static int16_t xpt2046_median(const uint8_t *rx, int channel)
 {
-#if XPT2046_XY_SWAP != 0
-    // 交换X和Y坐标
-    int16_t swap_tmp = *x;
-    *x = *y;
-    *y = swap_tmp;
+    int16_t v[XPT2046_OVERSAMPLE];
+
+    // 插入排序，N很小
+    for (int n = 0; n < XPT2046_OVERSAMPLE; n++) {
+        int i = (n * BURST_CHANNELS + channel) * 2;
+        int16_t value = (int16_t)((rx[i + 1] << 8) | rx[i + 2]);  // 合并高低字节
+        int j = n;
+        while (j > 0 && v[j - 1] > value) {
+            v[j] = v[j - 1];
+            j--;
+        }
+        v[j] = value;
+    }
+
+#if XPT2046_OVERSAMPLE % 2
+    return v[XPT2046_OVERSAMPLE / 2];
+#else
+    return (int16_t)((v[XPT2046_OVERSAMPLE / 2 - 1] + v[XPT2046_OVERSAMPLE / 2]) / 2);
 #endif
+}
 
-    // 去除最小值偏移
-    *x = (*x > XPT2046_X_MIN) ? (*x - XPT2046_X_MIN) : 0;
-    *y = (*y > XPT2046_Y_MIN) ? (*y - XPT2046_Y_MIN) : 0;
+/**
+ * @brief 滤波管线：压力门限 -> 跳变确认 -> 速度自适应IIR，全部为整数运算
+ * @param raw 突发读取结果（各通道中值）
+ * @param x 输出滤波后的规范化X坐标
+ * @param y 输出滤波后的规范化Y坐标
+ * @return 采样被接受时返回true
+ */
+static bool xpt2046_filter(const xpt2046_raw_t *raw, int16_t *x, int16_t *y)
+{
+    // 规范化坐标（右移4位，去除低位噪声）
+    int16_t nx = raw->x >> 4;
+    int16_t ny = raw->y >> 4;
+
+    // 按下和抬起的过渡阶段接触电阻大，位置向一侧漂移，直接丢弃
+    int16_t z = (raw->z1 >> 3) + 4096 - (raw->z2 >> 3);
+    if (z < XPT2046_PRESSURE_MIN) {
+        ESP_LOGD(TAG, "压力不足，丢弃采样: z=%d", z);
+        return false;
+    }
 
-    // 映射到显示分辨率
-    *x = (uint32_t)((uint32_t)(*x) * LV_HOR_RES) / (XPT2046_X_MAX - XPT2046_X_MIN);
-    *y = (uint32_t)((uint32_t)(*y) * LV_VER_RES) / (XPT2046_Y_MAX - XPT2046_Y_MIN);
+    if (!filter.active) {
+        // 按下后的第一个点直接输出，不经过IIR的建立过程
+        filter.x_q4 = nx << 4;
+        filter.y_q4 = ny << 4;
+        filter.active = true;
+        filter.has_cand = false;
+    } else {
+        int32_t dist = abs(nx - (filter.x_q4 >> 4)) + abs(ny - (filter.y_q4 >> 4));
+
+        if (dist > XPT2046_OUTLIER_DIST) {
+            // 孤立的大跳变先记为候选，下一个采样落在其附近才认为是真实移动
+            if (!filter.has_cand ||
+                abs(nx - filter.cand_x) + abs(ny - filter.cand_y) > XPT2046_OUTLIER_DIST) {
+                filter.cand_x = nx;
+                filter.cand_y = ny;
+                filter.has_cand = true;
+                ESP_LOGD(TAG, "跳变待确认: P(%d, %d)", nx, ny);
+                return false;
+            }
+            filter.x_q4 = nx << 4;
+            filter.y_q4 = ny << 4;
+        } else {
+            // 移动越快系数越大：静止时抑制抖动，拖动时减少滞后
+            int32_t alpha = XPT2046_IIR_ALPHA_MIN + dist * XPT2046_IIR_SPEED_GAIN;
+            if (alpha > 256) alpha = 256;
+            filter.x_q4 += (((int32_t)nx << 4) - filter.x_q4) * alpha / 256;
+            filter.y_q4 += (((int32_t)ny << 4) - filter.y_q4) * alpha / 256;
+        }
+        filter.has_cand = false;
+    }
+
+    *x = (int16_t)((filter.x_q4 + 8) >> 4);
+    *y = (int16_t)((filter.y_q4 + 8) >> 4);
+    return true;
+}
+
+/**
+ * @brief 由三组对应点计算仿射校准矩阵
+ */
+bool xpt2046_calib_compute(const lv_point_t raw[3], const lv_point_t screen[3], xpt2046_calib_t *out)
+{
+    int64_t x0 = raw[0].x, x1 = raw[1].x, x2 = raw[2].x;
+    int64_t y0 = raw[0].y, y1 = raw[1].y, y2 = raw[2].y;
+    int64_t sx0 = screen[0].x, sx1 = screen[1].x, sx2 = screen[2].x;
+    int64_t sy0 = screen[0].y, sy1 = screen[1].y, sy2 = screen[2].y;
 
+    int64_t div = (x0 - x2) * (y1 - y2) - (x1 - x2) * (y0 - y2);
+    if (div == 0) return false;  // 三点共线
+
+    out->a = (sx0 - sx2) * (y1 - y2) - (sx1 - sx2) * (y0 - y2);
+    out->b = (x0 - x2) * (sx1 - sx2) - (sx0 - sx2) * (x1 - x2);
+    out->c = y0 * (x2 * sx1 - x1 * sx2) + y1 * (x0 * sx2 - x2 * sx0) + y2 * (x1 * sx0 - x0 * sx1);
+    out->d = (sy0 - sy2) * (y1 - y2) - (sy1 - sy2) * (y0 - y2);
+    out->e = (x0 - x2) * (sy1 - sy2) - (sy0 - sy2) * (x1 - x2);
+    out->f = y0 * (x2 * sy1 - x1 * sy2) + y1 * (x0 * sy2 - x2 * sy0) + y2 * (x1 * sy0 - x0 * sy1);
+    out->div = div;
+    return true;
+}
+
+/**
+ * @brief 设置校准矩阵，NULL表示恢复默认
+ */
+void xpt2046_set_calib(const xpt2046_calib_t *c)
+{
+    if (c == NULL) {
+        xpt2046_default_calib(&calib);
+    } else {
+        calib = *c;
+    }
+}
+
+/**
+ * @brief 由XPT2046_X_MIN等默认参数生成校准矩阵，与原先的线性映射等价
+ * @param out 输出校准矩阵
+ */
+static void xpt2046_default_calib(xpt2046_calib_t *out)
+{
+    int32_t hor_res, ver_res;
+    xpt2046_native_res(&hor_res, &ver_res);
+
+    // 取默认量程的三个角，按交换/反转配置给出其屏幕坐标
+    static const int16_t corners[3][2] = {
+        {XPT2046_X_MIN, XPT2046_Y_MIN},
+        {XPT2046_X_MAX, XPT2046_Y_MIN},
+        {XPT2046_X_MIN, XPT2046_Y_MAX},
+    };
+    lv_point_t raw[3], screen[3];
+
+    for (int i = 0; i < 3; i++) {
+        int16_t u = corners[i][0];
+        int16_t v = corners[i][1];
+        screen[i].x = (u == XPT2046_X_MIN) ? 0 : hor_res;
+        screen[i].y = (v == XPT2046_Y_MIN) ? 0 : ver_res;
 #if XPT2046_X_INV != 0
-    *x = LV_HOR_RES - *x;  // 反转X轴
+        screen[i].x = hor_res - screen[i].x;  // 反转X轴
 #endif
-
 #if XPT2046_Y_INV != 0
-    *y = LV_VER_RES - *y;  // 反转Y轴
+        screen[i].y = ver_res - screen[i].y;  // 反转Y轴
 #endif
+#if XPT2046_XY_SWAP != 0
+        raw[i].x = v;  // 交换X和Y坐标
+        raw[i].y = u;
+#else
+        raw[i].x = u;
+        raw[i].y = v;
+#endif
+    }
+    xpt2046_calib_compute(raw, screen, out);
+}
+
+/**
+ * @brief 有符号整数除法，四舍五入到最近的整数
+ */
+static int64_t div_round(int64_t num, int64_t den)
+{
+    if (den < 0) {
+        num = -num;
+        den = -den;
+    }
+    return (num >= 0) ? (num + den / 2) / den : (num - den / 2) / den;
 }
 
 /**
- * @brief 计算触摸坐标平均值以减少噪声
+ * @brief 按校准矩阵把规范化原始坐标映射到屏幕坐标
  * @param x X坐标指针
  * @param y Y坐标指针
  */
-static void xpt2046_avg(int16_t *x, int16_t *y)
+static void xpt2046_corr(int16_t *x, int16_t *y)
 {
-    // 移位缓冲区
-    for (uint8_t i = XPT2046_AVG - 1; i > 0; i--) {
-        avg_buf_x[i] = avg_buf_x[i - 1];
-        avg_buf_y[i] = avg_buf_y[i - 1];
+    if (calib.div == 0) {
+        xpt2046_default_calib(&calib);  // 显示已创建，可以取得分辨率
     }
 
-    // 添加新数据
-    avg_buf_x[0] = *x;
-    avg_buf_y[0] = *y;
-    if (avg_last < XPT2046_AVG) avg_last++;
+    int64_t sx = div_round(calib.a * *x + calib.b * *y + calib.c, calib.div);
+    int64_t sy = div_round(calib.d * *x + calib.e * *y + calib.f, calib.div);
 
-    // 计算平均值
-    int32_t x_sum = 0, y_sum = 0;
-    for (uint8_t i = 0; i < avg_last; i++) {
-        x_sum += avg_buf_x[i];
-        y_sum += avg_buf_y[i];
-    }
+    // 限制在未旋转的屏幕范围内
+    int32_t hor_res, ver_res;
+    xpt2046_native_res(&hor_res, &ver_res);
+    *x = (int16_t)LV_CLAMP(0, sx, hor_res - 1);
+    *y = (int16_t)LV_CLAMP(0, sy, ver_res - 1);
+}
 
-    *x = (int16_t)(x_sum / avg_last);
-    *y = (int16_t)(y_sum / avg_last);
-}
\ No newline at end of file
+/**
+ * @brief 未旋转时的屏幕分辨率
+ *
+ * 触摸屏贴在面板上，不随显示旋转；LVGL按显示的旋转把读到的点换算为逻辑坐标
+ * （lv_indev.c中的indev_pointer_proc），因此校准和坐标都在未旋转的屏幕上。
+ */
+static void xpt2046_native_res(int32_t *hor_res, int32_t *ver_res)
+{
+    lv_display_rotation_t rotation = lv_display_get_rotation(NULL);
+    bool swapped = rotation == LV_DISPLAY_ROTATION_90 || rotation == LV_DISPLAY_ROTATION_270;
+    *hor_res = swapped ? LV_VER_RES : LV_HOR_RES;
+    *ver_res = swapped ? LV_HOR_RES : LV_VER_RES;
+}
@@ -0,0 +1,109 @@
+#!/usr/bin/env python3
+"""把bench_ui_scenes输出的各场景结果与阈值比较，任何一项超出阈值时返回1
+
+    python lv_bench_check.py bench_ui_scenes.json ui_scenes_thresholds.json
+    python lv_bench_check.py bench_ui_scenes.json ui_scenes_thresholds.json --timing
+    python lv_bench_check.py bench_ui_scenes.json ui_scenes_thresholds.json --update
+
+阈值文件按场景名给出各项的上限，未列出的项不检查：
+    {"scenes": {"telemetry": {"render_us_avg": 900, "pixels": 52000, "draw_tasks": 1800, "heap_peak": 60000}}}
+阈值中的场景在结果中不存在也算失败（场景被改名或删除时需要同时更新阈值）。
+阈值文件的display（分辨率、颜色格式、绘制单元数）与结果不同时不比较，直接失败。
+默认只比较与主机速度无关的计数类（像素、绘制任务、堆峰值）；耗时随主机的速度和负载变化，
+只在加--timing时比较，用于在安静的机器上发现数量级的退化。
+--update按本次结果重写阈值：计数类乘以1+margin，平均帧时间乘以time-factor且不低于time-floor
+（空闲场景没有帧，阈值为0时任何一帧都算退化）；单帧最大值受调度影响太大，不生成阈值。
+"""
+
+import argparse
+import json
+import math
+import sys
+
+METRICS = ("render_us_avg", "pixels", "draw_tasks", "heap_peak")     # --update生成阈值的项
+DISPLAY_KEYS = ("hor_res", "ver_res", "color_format", "draw_units")
+
+
+def is_time(metric):
+    return metric.startswith("render_us")
+
+
+def load(path):
+    with open(path, encoding="utf-8") as f:
+        return json.load(f)
+
+
+def check(results, thresholds, timing):
+    """逐项比较，返回失败项的个数，并输出比较表；timing为False时耗时项只列出不比较"""
+    for key in DISPLAY_KEYS:
+        want = thresholds.get("display", {}).get(key)
+        if want is not None and results["display"].get(key) != want:
+            print("显示配置不同：%s为%s，阈值对应%s" % (key, results["display"].get(key), want))
+            return 1
+
+    scenes = {s["name"]: s for s in results["scenes"]}
+    failures = 0
+    print("%-12s %-14s %10s %10s" % ("scene", "metric", "value", "limit"))
+    for name, limits in thresholds["scenes"].items():
+        scene = scenes.get(name)
+        if scene is None:
+            print("%-12s 结果中没有该场景" % name)
+            failures += 1
+            continue
+        for metric, limit in limits.items():
+            value = scene.get(metric)
+            if is_time(metric) and not timing:
+                print("%-12s %-14s %10s %10d (--timing)" % (name, metric, value, limit))
+                continue
+            ok = value is not None and value <= limit
+            print("%-12s %-14s %10s %10d %s" % (name, metric, value, limit, "" if ok else "REGRESSION"))
+            if not ok:
+                failures += 1
+    return failures
+
+
+def update(results, margin, time_factor, time_floor):
+    """按结果生成阈值"""
+    scenes = {}
+    for scene in results["scenes"]:
+        limits = {}
+        for metric in METRICS:
+            if metric not in scene:
+                continue
+            if is_time(metric):
+                limits[metric] = max(int(math.ceil(scene[metric] * time_factor)), time_floor)
+            else:
+                limits[metric] = int(math.ceil(scene[metric] * (1.0 + margin)))
+        scenes[scene["name"]] = limits
+    display = {key: results["display"][key] for key in DISPLAY_KEYS}
+    return {"display": display, "scenes": scenes}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("results", help="bench_ui_scenes输出的JSON")
+    parser.add_argument("thresholds", help="阈值JSON")
+    parser.add_argument("--timing", action="store_true", help="同时比较耗时项（默认只比较计数类）")
+    parser.add_argument("--update", action="store_true", help="按本次结果重写阈值文件")
+    parser.add_argument("--margin", type=float, default=0.1, help="计数类阈值的余量（默认0.1）")
+    parser.add_argument("--time-factor", type=float, default=5.0, help="耗时类阈值的倍数（默认5）")
+    parser.add_argument("--time-floor", type=int, default=1000, help="耗时类阈值的下限，微秒（默认1000）")
+    args = parser.parse_args()
+
+    results = load(args.results)
+    if args.update:
+        with open(args.thresholds, "w", encoding="utf-8") as f:
+            json.dump(update(results, args.margin, args.time_factor, args.time_floor), f, indent=2)
+            f.write("\n")
+        print("已写入%s" % args.thresholds)
+        return 0
+
+    failures = check(results, load(args.thresholds), args.timing)
+    if failures:
+        print("%d项超出阈值" % failures)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,143 @@
+#!/usr/bin/env python3
+"""把LVGL内置分析器的二进制跟踪流（格式见lvgl/src/misc/lv_profiler_builtin.h）转成Chrome/Perfetto的JSON
+
+    python lv_trace2json.py trace.bin -o trace.json
+
+在chrome://tracing或https://ui.perfetto.dev中打开输出。流中可以有多段（每次lv_port_set_trace_output
+重新开始时输出一个头部），各段依次拼接；32位时间戳按线程展开回绕。
+--check时检查每个线程的开始/结束成对嵌套（丢弃过事件的线程不检查），不通过时返回1。
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+MAGIC = b"LVPT"
+VERSION = 1
+HEADER_SIZE = 12
+RECORD_SIZE = 8
+
+
+class Thread:
+    """一个线程的状态：时间戳展开、开始/结束的栈"""
+
+    def __init__(self, index, tid):
+        self.index = index
+        self.tid = tid
+        self.last_tick = None
+        self.wraps = 0
+        self.stack = []
+        self.dropped = 0
+        self.errors = []
+
+    def unwrap(self, tick):
+        if self.last_tick is not None and tick < self.last_tick and self.last_tick - tick > 0x80000000:
+            self.wraps += 1
+        self.last_tick = tick
+        return tick + (self.wraps << 32)
+
+
+def convert(data):
+    """解析二进制流，返回(Chrome跟踪事件列表, 线程字典)"""
+    events = []
+    threads = {}
+    names = {}
+    tick_per_sec = None
+    thread = None
+    segment = 0
+    pos = 0
+
+    while pos < len(data):
+        if data[pos:pos + 4] == MAGIC and pos + HEADER_SIZE <= len(data):
+            version = data[pos + 4]
+            if version != VERSION:
+                raise ValueError("不支持的版本%d（偏移%d）" % (version, pos))
+            tick_per_sec = struct.unpack_from("<I", data, pos + 8)[0]
+            names = {}
+            thread = None
+            segment += 1
+            pos += HEADER_SIZE
+            continue
+        if tick_per_sec is None:
+            raise ValueError("缺少流头部")
+        if pos + RECORD_SIZE > len(data):
+            raise ValueError("记录不完整（偏移%d）" % pos)
+
+        rtype, b1, rid, val = struct.unpack_from("<BBHI", data, pos)
+        rtype = chr(rtype)
+        pos += RECORD_SIZE
+
+        if rtype == "N":
+            names[rid] = data[pos:pos + b1].decode("utf-8", "replace")
+            pos += b1
+        elif rtype == "T":
+            key = (segment, b1)
+            if key not in threads:
+                tid = struct.unpack("<i", struct.pack("<I", val))[0]
+                threads[key] = Thread(len(threads), tid)
+                events.append({"name": "thread_name", "ph": "M", "pid": 1, "tid": threads[key].index,
+                               "args": {"name": "LVGL-%d (%#x)" % (b1, tid & 0xFFFFFFFF)}})
+            thread = threads[key]
+        elif rtype in "BE":
+            if thread is None:
+                raise ValueError("事件之前缺少线程记录（偏移%d）" % (pos - RECORD_SIZE))
+            name = names.get(rid, "?")
+            ts = thread.unwrap(val) * 1e6 / tick_per_sec
+            events.append({"name": name, "ph": rtype, "ts": ts, "pid": 1, "tid": thread.index,
+                           "args": {"cpu": b1}})
+            if rtype == "B":
+                thread.stack.append(name)
+            elif not thread.stack or thread.stack[-1] != name:
+                thread.errors.append("%.3f us: 结束%s，栈顶为%s" % (ts, name, thread.stack[-1] if thread.stack else "空"))
+            else:
+                thread.stack.pop()
+        elif rtype == "D":
+            if b1 != 0xFF:
+                target = threads.get((segment, b1))
+                if target is not None:
+                    target.dropped += val
+            ts = 0
+            if thread is not None and thread.last_tick is not None:
+                ts = (thread.last_tick + (thread.wraps << 32)) * 1e6 / tick_per_sec
+            events.append({"name": "dropped %d" % val, "ph": "i", "s": "t", "ts": ts, "pid": 1,
+                           "tid": thread.index if thread else 0})
+        else:
+            raise ValueError("未知记录类型%r（偏移%d）" % (rtype, pos - RECORD_SIZE))
+
+    return events, threads
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("input", help="二进制跟踪流")
+    parser.add_argument("-o", "--output", help="输出的JSON文件，默认为输入文件名加.json")
+    parser.add_argument("--check", action="store_true", help="检查开始/结束成对嵌套")
+    args = parser.parse_args()
+
+    with open(args.input, "rb") as f:
+        data = f.read()
+    events, threads = convert(data)
+
+    output = args.output or args.input + ".json"
+    with open(output, "w") as f:
+        json.dump({"traceEvents": events, "displayTimeUnit": "ms"}, f)
+
+    count = sum(1 for e in events if e["ph"] in "BE")
+    dropped = sum(t.dropped for t in threads.values())
+    print("%s: %d个事件，%d个线程，丢弃%d个" % (output, count, len(threads), dropped), file=sys.stderr)
+
+    if args.check:
+        failed = False
+        for t in threads.values():
+            if t.dropped == 0 and t.errors:
+                failed = True
+                for error in t.errors[:5]:
+                    print("线程%d: %s" % (t.index, error), file=sys.stderr)
+        if count == 0 or failed:
+            return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
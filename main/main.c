@@ -7,15 +7,6 @@
 
 #define TAG "MAIN"
 
-// LVGL 任务处理函数
-static void lvgl_task(void *arg)
-{
-    while (1) {
-        // 处理 LVGL 事件
-        lv_task_handler();
-        vTaskDelay(pdMS_TO_TICKS(10)); // 每 10ms 调用一次
-    }
-}
 lv_obj_t* home_page = NULL;
 lv_obj_t *status_bar = NULL;
 
@@ -38,7 +29,7 @@ void LVGL_picture_establish(void) {
 
 void app_main(void)
 {
-    // 初始化 LVGL 和硬件
+    // 初始化 LVGL 和硬件（app_main运行在0号核，SPI中断随之分配在LV_PORT_TASK_CORE）
     lv_port_init();
     ESP_LOGI(TAG, "LVGL 和硬件初始化完成");
 
@@ -46,7 +37,7 @@ void app_main(void)
     LVGL_picture_establish();
     ESP_LOGI(TAG, "UI 创建完成");
 
-    // 创建 LVGL 任务
-    xTaskCreate(lvgl_task, "lvgl_task", 4096, NULL, 5, NULL);
+    // 创建 LVGL 任务：按下一个定时器的到期时间睡眠，触摸和外部数据可提前唤醒
+    xTaskCreatePinnedToCore(lv_port_task, "lvgl_task", 4096, NULL, 5, NULL, LV_PORT_TASK_CORE);
     ESP_LOGI(TAG, "LVGL 任务启动");
 }
\ No newline at end of file